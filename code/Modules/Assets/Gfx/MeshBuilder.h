@@ -35,6 +35,7 @@
     @see VertexWriter, ShapeBuilder
 */
 #include "Core/Types.h"
+#include "Core/Containers/Array.h"
 #include "Gfx/Core/Enums.h"
 #include "Gfx/Core/VertexLayout.h"
 #include "Gfx/Core/PrimitiveGroup.h"
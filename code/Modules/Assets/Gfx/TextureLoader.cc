@@ -6,11 +6,36 @@
 #include "IO/IO.h"
 #include "Gfx/Gfx.h"
 #include "IO/Stream/Stream.h"
+#include "IO/Stream/MemoryStream.h"
+#include "Core/Threading/JobSystem.h"
 #define GLIML_ASSERT(x) o_assert(x)
 #include "gliml.h"
+#if ORYOL_HAS_THREADS
+#include <atomic>
+#endif
 
 namespace Oryol {
 
+namespace _priv {
+class textureDecodeResult : public RefCounted {
+    OryolClassDecl(textureDecodeResult);
+public:
+    /// set on the decoding thread when decoding has finished
+    #if ORYOL_HAS_THREADS
+    std::atomic<bool> done{false};
+    #else
+    bool done = false;
+    #endif
+    /// true if the texture data has been parsed successfully
+    bool valid = false;
+    /// the texture setup built from the texture data
+    TextureSetup setup;
+    /// private copy of the loaded texture data
+    Ptr<Stream> stream;
+};
+OryolClassImpl(textureDecodeResult);
+} // namespace _priv
+
 OryolClassImpl(TextureLoader);
 
 //------------------------------------------------------------------------------
@@ -31,6 +56,13 @@ TextureLoader::Cancel() {
         this->ioRequest->SetCancelled();
         this->ioRequest = nullptr;
     }
+    this->decodeResult = nullptr;
+}
+
+//------------------------------------------------------------------------------
+bool
+TextureLoader::NotifiesReady() const {
+    return true;
 }
 
 //------------------------------------------------------------------------------
@@ -40,56 +72,107 @@ TextureLoader::Start() {
     // prepare the Gfx resource
     this->resId = Gfx::Resource().prepareAsync(this->setup);
     
-    // fire IO request to start loading the texture data
+    // fire IO request to start loading the texture data, the texture
+    // data is parsed on the thread which handles the IO request, and
+    // the loader is notified when the texture can be created
     this->ioRequest = IOProtocol::Request::Create();
     this->ioRequest->SetURL(setup.Locator.Location());
     this->ioRequest->SetLane(this->ioLane);
+    this->decodeResult = _priv::textureDecodeResult::Create();
+    // NOTE: the request can't be captured by a Ptr (this would be a
+    // reference cycle), but it is guaranteed to be alive while
+    // its handled-function is called
+    const IOProtocol::Request* req = this->ioRequest.getUnsafe();
+    Ptr<_priv::textureDecodeResult> result = this->decodeResult;
+    const TextureSetup blueprint = this->setup;
+    std::function<void()> readyFunc = this->ReadyFunc();
+    this->ioRequest->SetHandledFunc([req, result, blueprint, readyFunc]() {
+        if (!req->Cancelled() && (IOStatus::OK == req->GetStatus())) {
+            Ptr<Stream> stream = copyData(req->GetStream());
+            if ((InvalidIndex == req->GetActualLane()) && JobSystem::IsValid()) {
+                // an IO cache hit, this is called on the main thread
+                // from inside IO::Put(), don't parse here
+                JobSystem::Run([stream, blueprint, result, readyFunc]() {
+                    decode(stream, blueprint, result.getUnsafe());
+                    result->done = true;
+                    readyFunc();
+                });
+                return;
+            }
+            decode(stream, blueprint, result.getUnsafe());
+        }
+        result->done = true;
+        readyFunc();
+    });
     IO::Put(this->ioRequest);
     
     return this->resId;
 }
 
+//------------------------------------------------------------------------------
+/**
+ The request stream may be shared through the IO cache, so it is only
+ kept open while copying, decoding and texture creation only ever
+ touch the private copy.
+*/
+Ptr<Stream>
+TextureLoader::copyData(const Ptr<Stream>& src) {
+    src->Open(OpenMode::ReadOnly);
+    Ptr<Stream> stream = MemoryStream::Create();
+    stream->Open(OpenMode::WriteOnly);
+    stream->Write(src->MapRead(nullptr), src->Size());
+    stream->Close();
+    src->Close();
+    return stream;
+}
+
+//------------------------------------------------------------------------------
+void
+TextureLoader::decode(const Ptr<Stream>& stream, const TextureSetup& blueprint, _priv::textureDecodeResult* result) {
+    // let gliml parse and validate the texture data,
+    // and build the mipmap layout
+    stream->Open(OpenMode::ReadOnly);
+    const uint8* data = stream->MapRead(nullptr);
+    const int32 numBytes = stream->Size();
+    
+    gliml::context ctx;
+    ctx.enable_dxt(true);
+    ctx.enable_pvrtc(true);
+    ctx.enable_etc2(true);
+    if (ctx.load(data, numBytes)) {
+        result->setup = buildSetup(blueprint, &ctx, data);
+        result->stream = stream;
+        result->valid = true;
+    }
+    stream->Close();
+}
+
 //------------------------------------------------------------------------------
 ResourceState::Code
 TextureLoader::Continue() {
     o_assert_dbg(this->resId.IsValid());
     o_assert_dbg(this->ioRequest.isValid());
+    o_assert_dbg(this->decodeResult.isValid());
     
     ResourceState::Code result = ResourceState::Pending;
     
-    if (this->ioRequest->Handled()) {
-        if (this->ioRequest->GetStatus() == IOStatus::OK) {
-            // yeah, IO is done, let gliml parse the texture data
-            // and create the texture resource
-            const Ptr<Stream>& stream = this->ioRequest->GetStream();
-            stream->Open(OpenMode::ReadOnly);
-            const uint8* data = stream->MapRead(nullptr);
-            const int32 numBytes = stream->Size();
-            
-            gliml::context ctx;
-            ctx.enable_dxt(true);
-            ctx.enable_pvrtc(true);
-            ctx.enable_etc2(true);
-            if (ctx.load(data, numBytes)) {
-                stream->Close();
-                TextureSetup texSetup = this->buildSetup(this->setup, &ctx, data);
-                SetupAndStream<TextureSetup> setupAndStream(texSetup, stream);
-                // NOTE: the prepared texture resource might have already been
-                // destroyed at this point, if this happens, initAsync will
-                // silently fail and return ResourceState::InvalidState
-                // (the same for failedAsync)
-                result = Gfx::Resource().initAsync(this->resId, setupAndStream);
-            }
-            else {
-                stream->Close();
-                result = Gfx::Resource().failedAsync(this->resId);
-            }
+    if (this->decodeResult->done) {
+        if (this->decodeResult->valid) {
+            // texture data has been parsed on the IO thread,
+            // only create the texture resource here
+            SetupAndStream<TextureSetup> setupAndStream(this->decodeResult->setup, this->decodeResult->stream);
+            // NOTE: the prepared texture resource might have already been
+            // destroyed at this point, if this happens, initAsync will
+            // silently fail and return ResourceState::InvalidState
+            // (the same for failedAsync)
+            result = Gfx::Resource().initAsync(this->resId, setupAndStream);
         }
         else {
-            // IO had failed
+            // IO or parsing had failed
             result = Gfx::Resource().failedAsync(this->resId);
         }
         this->ioRequest = nullptr;
+        this->decodeResult = nullptr;
     }
     return result;
 }
@@ -174,7 +257,7 @@ TextureLoader::buildSetup(const TextureSetup& blueprint, const gliml::context* c
             o_error("Unknown texture type!\n");
             break;
     }
-    TextureSetup newSetup = TextureSetup::FromPixelData(w, h, numMips, type, pixelFormat, this->setup);
+    TextureSetup newSetup = TextureSetup::FromPixelData(w, h, numMips, type, pixelFormat, blueprint);
     
     // setup mipmap offsets
     o_assert_dbg(TextureSetup::MaxNumMipMaps >= ctx->num_mipmaps(0));
@@ -4,6 +4,16 @@
     @class Oryol::TextureLoader
     @ingroup Assets
     @brief standard texture loader for most block-compressed texture file formats
+
+    The texture file is parsed and validated on the thread which handles
+    the IO request (usually an IO lane thread), only the creation of
+    the texture resource happens on the main thread in Continue().
+    
+    Requests served from the IO cache are handled on the main thread
+    inside IO::Put(). In this case only the copy of the texture data
+    happens on the main thread, parsing is moved to the JobSystem.
+    If the JobSystem hasn't been setup, cache hits are parsed on the
+    main thread as well.
 */
 #include "Gfx/Resource/TextureLoaderBase.h"
 #include "IO/Stream/Stream.h"
@@ -15,6 +25,10 @@ class context;
 
 namespace Oryol {
 
+namespace _priv {
+class textureDecodeResult;
+}
+
 class TextureLoader : public TextureLoaderBase {
     OryolClassDecl(TextureLoader);
 public:
@@ -28,13 +42,20 @@ public:
     virtual ResourceState::Code Continue();
     /// cancel the load process
     virtual void Cancel();
+    /// the loader is notified when its IO request has been handled
+    virtual bool NotifiesReady() const;
 
 private:
+    /// copy loaded texture data into a private stream (the request stream may be shared through the IO cache)
+    static Ptr<Stream> copyData(const Ptr<Stream>& src);
+    /// parse a private copy of the texture data (called on the IO thread or a JobSystem worker)
+    static void decode(const Ptr<Stream>& stream, const TextureSetup& blueprint, _priv::textureDecodeResult* result);
     /// convert gliml context attrs into a TextureSetup object
-    TextureSetup buildSetup(const TextureSetup& blueprint, const gliml::context* ctx, const uint8* data);
+    static TextureSetup buildSetup(const TextureSetup& blueprint, const gliml::context* ctx, const uint8* data);
     
     Id resId;
     Ptr<IOProtocol::Request> ioRequest;
+    Ptr<_priv::textureDecodeResult> decodeResult;
 };
 
 } // namespace Oryol
\ No newline at end of file
@@ -23,12 +23,13 @@ TEST(ShapeBuilderTest) {
     #if !ORYOL_UNITTESTS_HEADLESS
     
     // setup a GL context
+    auto gfxSetup = GfxSetup::Window(400, 300, "Oryol Test");
     displayMgr displayManager;
-    displayManager.SetupDisplay(GfxSetup::Window(400, 300, "Oryol Test"));
+    displayManager.SetupDisplay(gfxSetup);
     
     // setup a meshFactory object
     class renderer renderer;
-    renderer.setup();
+    renderer.setup(gfxSetup);
     meshPool meshPool;
     meshFactory factory;
     factory.Setup(&renderer, &meshPool);
@@ -0,0 +1,717 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::HashMap
+    @ingroup Core
+    @brief open-addressing hash map for fast key lookup
+
+    A key-value map with O(1) lookup, insertion and erasure, use this
+    instead of Map for big maps on hot paths where the sorted
+    order of Map isn't needed. Keys must be unique.
+
+    The key-value-pairs live in a dense array (like in ArrayMap), so
+    iterating with begin(), end() and accessing elements by index
+    is as fast as with an Array. Erasing swaps the last element into
+    the erased element's index, so indices are NOT stable across
+    erase operations.
+
+    The lookup table uses Robin Hood hashing with linear probing. Each
+    slot has a probe-distance byte and an 8-bit hash fragment, lookups
+    compare a group of 16 slots at once (with SSE2 where available),
+    keys are only compared on matching hash fragments. Erasing
+    does a backward-shift, so there are no tombstones which would slow
+    down lookups over time.
+
+    Growing the lookup table happens incrementally: when the load
+    factor limit is reached, a table with twice the capacity is allocated
+    and each following Add() or Erase() moves a small number of entries
+    over into the new table, so that no single operation has to rehash
+    the whole map.
+
+    The HASHER template parameter is a functor which computes a hash
+    value from a key (the result is mixed again, so a simple identity
+    hash is ok).
+
+    @see Array, ArrayMap, HashSet, Map
+*/
+#include "Core/Config.h"
+#include "Core/Containers/Array.h"
+#include "Core/Containers/KeyValuePair.h"
+#include <functional>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define ORYOL_HASHMAP_SSE2 (1)
+#include <emmintrin.h>
+#endif
+#if ORYOL_WINDOWS
+#include <intrin.h>
+#endif
+
+namespace Oryol {
+
+template<class KEY, class VALUE, class HASHER=std::hash<KEY>> class HashMap {
+public:
+    /// default constructor
+    HashMap();
+    /// copy constructor
+    HashMap(const HashMap& rhs);
+    /// move constructor
+    HashMap(HashMap&& rhs);
+    /// destructor
+    ~HashMap();
+
+    /// copy-assignment operator
+    void operator=(const HashMap& rhs);
+    /// move-assignment operator
+    void operator=(HashMap&& rhs);
+
+    /// get number of elements in map
+    int32 Size() const;
+    /// return true if empty
+    bool Empty() const;
+    /// get capacity of the lookup table
+    int32 Capacity() const;
+    /// return true if an incremental rehash is in progress
+    bool IsRehashing() const;
+
+    /// read/write access single element
+    VALUE& operator[](const KEY& key);
+    /// read-only access single element
+    const VALUE& operator[](const KEY& key) const;
+
+    /// increase capacity to hold at least numElements more elements
+    void Reserve(int32 numElements);
+    /// clear the map (deletes elements, keeps capacity)
+    void Clear();
+
+    /// test if an element exists
+    bool Contains(const KEY& key) const;
+    /// add new element, key must not exist
+    void Add(const KeyValuePair<KEY, VALUE>& kvp);
+    /// add new element with move-semantics, key must not exist
+    void Add(KeyValuePair<KEY, VALUE>&& kvp);
+    /// add new element, key must not exist
+    void Add(const KEY& key, const VALUE& value);
+    /// add new element, return false if element with key already existed
+    bool AddUnique(const KeyValuePair<KEY, VALUE>& kvp);
+    /// add new element with move-semantics, return false if element with key already existed
+    bool AddUnique(KeyValuePair<KEY, VALUE>&& kvp);
+    /// add new element, return false if element with key already existed
+    bool AddUnique(const KEY& key, const VALUE& value);
+    /// erase element matching key, does nothing if key not contained
+    void Erase(const KEY& key);
+
+    /// find an element, returns index, or InvalidIndex
+    int32 FindIndex(const KEY& key) const;
+    /// erase element at index (swaps-in the last element)
+    void EraseIndex(int32 index);
+    /// get key at index
+    const KEY& KeyAtIndex(int32 index) const;
+    /// get value at index (read-only)
+    const VALUE& ValueAtIndex(int32 index) const;
+    /// get value at index (read/write)
+    VALUE& ValueAtIndex(int32 index);
+
+    /// C++ conform begin, MAY RETURN nullptr!
+    KeyValuePair<KEY, VALUE>* begin();
+    /// C++ conform begin, MAY RETURN nullptr!
+    const KeyValuePair<KEY, VALUE>* begin() const;
+    /// C++ conform end,  MAY RETURN nullptr!
+    KeyValuePair<KEY, VALUE>* end();
+    /// C++ conform end, MAY RETURN nullptr!
+    const KeyValuePair<KEY, VALUE>* end() const;
+
+private:
+    /// a lookup table, slot arrays have MaxDistance+GroupSize extra slots at the end (no wrap-around)
+    struct table {
+        uint8* dists = nullptr;     // 0 if slot is empty, otherwise probe distance + 1
+        uint8* frags = nullptr;     // lowest 8 bits of hash
+        int32* indices = nullptr;   // index into entries array
+        int32 capacity = 0;         // number of home slots (2^N)
+        int32 shift = 0;            // right-shift to get home slot from hash
+    };
+    static const int32 MinCapacity = 16;
+    static const int32 GroupSize = 16;
+    static const int32 MaxDistance = 64;
+    static const int32 MigrateStep = 16;
+
+    /// compute hash value of a key
+    static uint32 hashKey(const KEY& key);
+    /// index of lowest set bit
+    static int32 lowestBit(uint32 mask);
+    /// match 16 slots, return hash fragment matches and empty-or-closer slots in outStop
+    static uint32 matchGroup(const uint8* dists, const uint8* frags, uint8 frag, int32 dist, uint32& outStop);
+    /// allocate a lookup table
+    static void allocTable(table& t, int32 capacity);
+    /// free a lookup table
+    static void freeTable(table& t);
+    /// insert an entry index into a lookup table, return false if max probe distance was exceeded
+    static bool insertSlot(table& t, uint32 hash, int32 index);
+    /// remove a slot from a lookup table with backward-shift
+    static void eraseSlot(table& t, int32 slot);
+    /// find slot index of key in a lookup table, or InvalidIndex
+    int32 findSlot(const table& t, uint32 hash, const KEY& key) const;
+    /// find slot index by entry index in a lookup table
+    int32 findSlotByIndex(const table& t, uint32 hash, int32 index) const;
+    /// add lookup table entry for the last added element
+    void addSlot();
+    /// start an incremental rehash into a new table
+    void startRehash(int32 newCapacity);
+    /// move entries into the new table during incremental rehash
+    void migrate(int32 num);
+    /// synchronously rebuild the lookup table with at least minCapacity
+    void rebuild(int32 minCapacity);
+    /// copy content
+    void copy(const HashMap& rhs);
+    /// move content
+    void move(HashMap&& rhs);
+
+    Array<KeyValuePair<KEY, VALUE>> entries;
+    Array<uint32> hashes;
+    table cur;              // complete lookup table
+    table next;             // lookup table being filled by incremental rehash
+    int32 numMigrated;      // entries [0, numMigrated) are in next table
+};
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER>
+HashMap<KEY, VALUE, HASHER>::HashMap() :
+numMigrated(0) {
+    // empty
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER>
+HashMap<KEY, VALUE, HASHER>::HashMap(const HashMap& rhs) :
+numMigrated(0) {
+    this->copy(rhs);
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER>
+HashMap<KEY, VALUE, HASHER>::HashMap(HashMap&& rhs) :
+numMigrated(0) {
+    this->move(std::move(rhs));
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER>
+HashMap<KEY, VALUE, HASHER>::~HashMap() {
+    freeTable(this->cur);
+    freeTable(this->next);
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> void
+HashMap<KEY, VALUE, HASHER>::operator=(const HashMap& rhs) {
+    if (&rhs != this) {
+        this->copy(rhs);
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> void
+HashMap<KEY, VALUE, HASHER>::operator=(HashMap&& rhs) {
+    if (&rhs != this) {
+        this->move(std::move(rhs));
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> void
+HashMap<KEY, VALUE, HASHER>::copy(const HashMap& rhs) {
+    freeTable(this->cur);
+    freeTable(this->next);
+    this->numMigrated = 0;
+    this->entries = rhs.entries;
+    this->hashes = rhs.hashes;
+    if (!this->entries.Empty()) {
+        this->rebuild(MinCapacity);
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> void
+HashMap<KEY, VALUE, HASHER>::move(HashMap&& rhs) {
+    freeTable(this->cur);
+    freeTable(this->next);
+    this->entries = std::move(rhs.entries);
+    this->hashes = std::move(rhs.hashes);
+    this->cur = rhs.cur;
+    this->next = rhs.next;
+    this->numMigrated = rhs.numMigrated;
+    rhs.cur = table();
+    rhs.next = table();
+    rhs.numMigrated = 0;
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> int32
+HashMap<KEY, VALUE, HASHER>::Size() const {
+    return this->entries.Size();
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> bool
+HashMap<KEY, VALUE, HASHER>::Empty() const {
+    return this->entries.Empty();
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> int32
+HashMap<KEY, VALUE, HASHER>::Capacity() const {
+    return this->next.capacity > 0 ? this->next.capacity : this->cur.capacity;
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> bool
+HashMap<KEY, VALUE, HASHER>::IsRehashing() const {
+    return this->next.capacity > 0;
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> uint32
+HashMap<KEY, VALUE, HASHER>::hashKey(const KEY& key) {
+    // murmur3 64-bit finalizer, so that weak hash functions are ok
+    uint64 h = (uint64) HASHER()(key);
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return (uint32) h;
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> int32
+HashMap<KEY, VALUE, HASHER>::lowestBit(uint32 mask) {
+    o_assert_dbg(0 != mask);
+    #if ORYOL_WINDOWS
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return (int32) index;
+    #else
+    return __builtin_ctz(mask);
+    #endif
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> uint32
+HashMap<KEY, VALUE, HASHER>::matchGroup(const uint8* dists, const uint8* frags, uint8 frag, int32 dist, uint32& outStop) {
+    static_assert((MaxDistance + GroupSize) < 128, "probe distances must fit into signed bytes");
+    #if ORYOL_HASHMAP_SSE2
+    // a slot with a probe distance smaller than ours (or empty) ends the search
+    const __m128i expected = _mm_add_epi8(_mm_set1_epi8((char)dist),
+        _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+    const __m128i d = _mm_loadu_si128((const __m128i*) dists);
+    const __m128i f = _mm_loadu_si128((const __m128i*) frags);
+    outStop = (uint32) _mm_movemask_epi8(_mm_cmplt_epi8(d, expected));
+    return (uint32) _mm_movemask_epi8(_mm_cmpeq_epi8(f, _mm_set1_epi8((char)frag)));
+    #else
+    uint32 stop = 0;
+    uint32 match = 0;
+    for (int32 i = 0; i < GroupSize; i++) {
+        stop |= (dists[i] < (dist + i)) ? (1 << i) : 0;
+        match |= (frags[i] == frag) ? (1 << i) : 0;
+    }
+    outStop = stop;
+    return match;
+    #endif
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> void
+HashMap<KEY, VALUE, HASHER>::allocTable(table& t, int32 capacity) {
+    o_assert_dbg(nullptr == t.dists);
+    o_assert_dbg((capacity >= MinCapacity) && (0 == (capacity & (capacity - 1))));
+    const int32 numSlots = capacity + MaxDistance + GroupSize;
+    uint8* ptr = (uint8*) Memory::Alloc(numSlots * (2 + sizeof(int32)));
+    t.indices = (int32*) ptr;
+    t.dists = ptr + numSlots * sizeof(int32);
+    t.frags = t.dists + numSlots;
+    Memory::Clear(t.dists, numSlots * 2);
+    t.capacity = capacity;
+    t.shift = 32;
+    for (int32 c = capacity; c > 1; c >>= 1) {
+        t.shift--;
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> void
+HashMap<KEY, VALUE, HASHER>::freeTable(table& t) {
+    if (t.indices) {
+        Memory::Free(t.indices);
+    }
+    t = table();
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> bool
+HashMap<KEY, VALUE, HASHER>::insertSlot(table& t, uint32 hash, int32 index) {
+    int32 pos = hash >> t.shift;
+    uint8 dist = 1;
+    uint8 frag = (uint8) hash;
+    while (0 != t.dists[pos]) {
+        if (t.dists[pos] < dist) {
+            // Robin Hood: take the slot from the richer entry and continue with that
+            std::swap(dist, t.dists[pos]);
+            std::swap(frag, t.frags[pos]);
+            std::swap(index, t.indices[pos]);
+        }
+        pos++;
+        dist++;
+        if (dist > MaxDistance) {
+            return false;
+        }
+    }
+    t.dists[pos] = dist;
+    t.frags[pos] = frag;
+    t.indices[pos] = index;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> void
+HashMap<KEY, VALUE, HASHER>::eraseSlot(table& t, int32 slot) {
+    o_assert_dbg(0 != t.dists[slot]);
+    int32 pos = slot;
+    while (t.dists[pos + 1] > 1) {
+        t.dists[pos] = t.dists[pos + 1] - 1;
+        t.frags[pos] = t.frags[pos + 1];
+        t.indices[pos] = t.indices[pos + 1];
+        pos++;
+    }
+    t.dists[pos] = 0;
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> int32
+HashMap<KEY, VALUE, HASHER>::findSlot(const table& t, uint32 hash, const KEY& key) const {
+    if (0 == t.capacity) {
+        return InvalidIndex;
+    }
+    const int32 home = hash >> t.shift;
+    const uint8 frag = (uint8) hash;
+    for (int32 dist = 1; dist <= MaxDistance; dist += GroupSize) {
+        const int32 pos = home + dist - 1;
+        uint32 stop;
+        uint32 match = matchGroup(t.dists + pos, t.frags + pos, frag, dist, stop);
+        if (stop) {
+            match &= (stop & (0 - stop)) - 1;
+        }
+        while (match) {
+            const int32 slot = pos + lowestBit(match);
+            const int32 index = t.indices[slot];
+            if ((this->hashes[index] == hash) && (this->entries[index].key == key)) {
+                return slot;
+            }
+            match &= match - 1;
+        }
+        if (stop) {
+            break;
+        }
+    }
+    return InvalidIndex;
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> int32
+HashMap<KEY, VALUE, HASHER>::findSlotByIndex(const table& t, uint32 hash, int32 index) const {
+    int32 pos = hash >> t.shift;
+    while ((0 == t.dists[pos]) || (t.indices[pos] != index)) {
+        pos++;
+        o_assert_dbg(pos < (t.capacity + MaxDistance));
+    }
+    return pos;
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> void
+HashMap<KEY, VALUE, HASHER>::rebuild(int32 minCapacity) {
+    freeTable(this->next);
+    this->numMigrated = 0;
+    const int32 num = this->entries.Size();
+    int32 capacity = MinCapacity;
+    while ((capacity < minCapacity) || (num > ((capacity * 3) / 4))) {
+        capacity <<= 1;
+    }
+    for (;;) {
+        freeTable(this->cur);
+        allocTable(this->cur, capacity);
+        int32 i;
+        for (i = 0; i < num; i++) {
+            if (!insertSlot(this->cur, this->hashes[i], i)) {
+                break;
+            }
+        }
+        if (i == num) {
+            return;
+        }
+        capacity <<= 1;
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> void
+HashMap<KEY, VALUE, HASHER>::startRehash(int32 newCapacity) {
+    o_assert_dbg(0 == this->next.capacity);
+    allocTable(this->next, newCapacity);
+    this->numMigrated = 0;
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> void
+HashMap<KEY, VALUE, HASHER>::migrate(int32 num) {
+    o_assert_dbg(this->next.capacity > 0);
+    const int32 size = this->entries.Size();
+    const int32 end = (this->numMigrated + num) < size ? (this->numMigrated + num) : size;
+    for (int32 i = this->numMigrated; i < end; i++) {
+        if (!insertSlot(this->next, this->hashes[i], i)) {
+            this->rebuild(this->next.capacity << 1);
+            return;
+        }
+    }
+    this->numMigrated = end;
+    if (end == size) {
+        // the new table is complete
+        freeTable(this->cur);
+        this->cur = this->next;
+        this->next = table();
+        this->numMigrated = 0;
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> void
+HashMap<KEY, VALUE, HASHER>::addSlot() {
+    const int32 index = this->entries.Size() - 1;
+    if (0 == this->cur.capacity) {
+        this->rebuild(MinCapacity);
+        return;
+    }
+    if ((0 == this->next.capacity) && (this->entries.Size() > ((this->cur.capacity * 3) / 4))) {
+        this->startRehash(this->cur.capacity << 1);
+    }
+    // new entries only go into the current table, the migration
+    // will pick them up since they are at the end of the entry array
+    if (!insertSlot(this->cur, this->hashes[index], index)) {
+        this->rebuild(this->cur.capacity << 1);
+        return;
+    }
+    if (this->next.capacity > 0) {
+        this->migrate(MigrateStep);
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> VALUE&
+HashMap<KEY, VALUE, HASHER>::operator[](const KEY& key) {
+    const int32 index = this->FindIndex(key);
+    o_assert(InvalidIndex != index);     // not found if this triggers
+    return this->entries[index].value;
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> const VALUE&
+HashMap<KEY, VALUE, HASHER>::operator[](const KEY& key) const {
+    const int32 index = this->FindIndex(key);
+    o_assert(InvalidIndex != index);     // not found if this triggers
+    return this->entries[index].value;
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> void
+HashMap<KEY, VALUE, HASHER>::Reserve(int32 numElements) {
+    const int32 num = this->entries.Size() + numElements;
+    this->entries.Reserve(numElements);
+    this->hashes.Reserve(numElements);
+    if (num > ((this->Capacity() * 3) / 4)) {
+        this->rebuild(MinCapacity);
+        while (num > ((this->cur.capacity * 3) / 4)) {
+            this->rebuild(this->cur.capacity << 1);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> void
+HashMap<KEY, VALUE, HASHER>::Clear() {
+    this->entries.Clear();
+    this->hashes.Clear();
+    if (this->next.capacity > 0) {
+        freeTable(this->cur);
+        this->cur = this->next;
+        this->next = table();
+        this->numMigrated = 0;
+    }
+    if (this->cur.capacity > 0) {
+        Memory::Clear(this->cur.dists, this->cur.capacity + MaxDistance + GroupSize);
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> int32
+HashMap<KEY, VALUE, HASHER>::FindIndex(const KEY& key) const {
+    const int32 slot = this->findSlot(this->cur, hashKey(key), key);
+    return (InvalidIndex != slot) ? this->cur.indices[slot] : InvalidIndex;
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> bool
+HashMap<KEY, VALUE, HASHER>::Contains(const KEY& key) const {
+    return InvalidIndex != this->FindIndex(key);
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> void
+HashMap<KEY, VALUE, HASHER>::Add(const KeyValuePair<KEY, VALUE>& kvp) {
+    const uint32 hash = hashKey(kvp.key);
+    o_assert_dbg(InvalidIndex == this->findSlot(this->cur, hash, kvp.key));
+    this->entries.Add(kvp);
+    this->hashes.Add(hash);
+    this->addSlot();
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> void
+HashMap<KEY, VALUE, HASHER>::Add(KeyValuePair<KEY, VALUE>&& kvp) {
+    const uint32 hash = hashKey(kvp.key);
+    o_assert_dbg(InvalidIndex == this->findSlot(this->cur, hash, kvp.key));
+    this->entries.Add(std::move(kvp));
+    this->hashes.Add(hash);
+    this->addSlot();
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> void
+HashMap<KEY, VALUE, HASHER>::Add(const KEY& key, const VALUE& value) {
+    this->Add(KeyValuePair<KEY, VALUE>(key, value));
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> bool
+HashMap<KEY, VALUE, HASHER>::AddUnique(const KeyValuePair<KEY, VALUE>& kvp) {
+    const uint32 hash = hashKey(kvp.key);
+    if (InvalidIndex != this->findSlot(this->cur, hash, kvp.key)) {
+        return false;
+    }
+    this->entries.Add(kvp);
+    this->hashes.Add(hash);
+    this->addSlot();
+    return true;
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> bool
+HashMap<KEY, VALUE, HASHER>::AddUnique(KeyValuePair<KEY, VALUE>&& kvp) {
+    const uint32 hash = hashKey(kvp.key);
+    if (InvalidIndex != this->findSlot(this->cur, hash, kvp.key)) {
+        return false;
+    }
+    this->entries.Add(std::move(kvp));
+    this->hashes.Add(hash);
+    this->addSlot();
+    return true;
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> bool
+HashMap<KEY, VALUE, HASHER>::AddUnique(const KEY& key, const VALUE& value) {
+    return this->AddUnique(KeyValuePair<KEY, VALUE>(key, value));
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> void
+HashMap<KEY, VALUE, HASHER>::Erase(const KEY& key) {
+    const int32 index = this->FindIndex(key);
+    if (InvalidIndex != index) {
+        this->EraseIndex(index);
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> void
+HashMap<KEY, VALUE, HASHER>::EraseIndex(int32 index) {
+    o_assert_range(index, this->entries.Size());
+    const bool rehashing = this->next.capacity > 0;
+
+    // remove from lookup tables
+    const uint32 hash = this->hashes[index];
+    eraseSlot(this->cur, this->findSlotByIndex(this->cur, hash, index));
+    if (rehashing && (index < this->numMigrated)) {
+        eraseSlot(this->next, this->findSlotByIndex(this->next, hash, index));
+    }
+
+    // the last entry will be moved into the erased entry's index, fix up its slots
+    bool needsRebuild = false;
+    const int32 last = this->entries.Size() - 1;
+    if (index != last) {
+        const uint32 lastHash = this->hashes[last];
+        this->cur.indices[this->findSlotByIndex(this->cur, lastHash, last)] = index;
+        if (rehashing) {
+            if (last < this->numMigrated) {
+                this->next.indices[this->findSlotByIndex(this->next, lastHash, last)] = index;
+            }
+            else if (index < this->numMigrated) {
+                // moves from not-yet-migrated into migrated range
+                needsRebuild = !insertSlot(this->next, lastHash, index);
+            }
+        }
+    }
+    this->entries.EraseSwapBack(index);
+    this->hashes.EraseSwapBack(index);
+
+    if (needsRebuild) {
+        this->rebuild(this->next.capacity << 1);
+    }
+    else if (rehashing) {
+        if (this->numMigrated > this->entries.Size()) {
+            this->numMigrated = this->entries.Size();
+        }
+        this->migrate(MigrateStep);
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> const KEY&
+HashMap<KEY, VALUE, HASHER>::KeyAtIndex(int32 index) const {
+    return this->entries[index].key;
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> const VALUE&
+HashMap<KEY, VALUE, HASHER>::ValueAtIndex(int32 index) const {
+    return this->entries[index].value;
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> VALUE&
+HashMap<KEY, VALUE, HASHER>::ValueAtIndex(int32 index) {
+    return this->entries[index].value;
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> KeyValuePair<KEY, VALUE>*
+HashMap<KEY, VALUE, HASHER>::begin() {
+    return this->entries.begin();
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> const KeyValuePair<KEY, VALUE>*
+HashMap<KEY, VALUE, HASHER>::begin() const {
+    return this->entries.begin();
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> KeyValuePair<KEY, VALUE>*
+HashMap<KEY, VALUE, HASHER>::end() {
+    return this->entries.end();
+}
+
+//------------------------------------------------------------------------------
+template<class KEY, class VALUE, class HASHER> const KeyValuePair<KEY, VALUE>*
+HashMap<KEY, VALUE, HASHER>::end() const {
+    return this->entries.end();
+}
+
+} // namespace Oryol
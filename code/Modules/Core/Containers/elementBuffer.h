@@ -512,6 +512,11 @@ elementBuffer<TYPE>::prepareInsert(int32 index, bool& outSlotConstructed) {
             return this->elmEnd++;
         }
         else if (this->elmStart > this->bufStart) {
+            if (0 == size) {
+                // all elements have been erased from the front, nothing to move
+                outSlotConstructed = false;
+                return --this->elmStart;
+            }
             // make room by moving towards front (this should always be faster then reallocating)
             return this->moveInsertFront(index);
         }
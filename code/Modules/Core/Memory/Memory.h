@@ -15,6 +15,7 @@
 #include "Core/Types.h"
 #include "Core/Config.h"
 #include <utility>
+#include <new>
 
 namespace Oryol {
     
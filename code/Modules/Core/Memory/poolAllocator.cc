@@ -0,0 +1,32 @@
+//------------------------------------------------------------------------------
+//  poolAllocator.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "poolAllocator.h"
+#include "Core/Threading/ThreadLocalPtr.h"
+
+namespace Oryol {
+namespace _priv {
+
+#if ORYOL_HAS_ATOMIC
+std::atomic<uint32> poolAllocatorThreadIndex::counter{0};
+#else
+uint32 poolAllocatorThreadIndex::counter = 0;
+#endif
+
+/// the thread's index plus one, stored as pointer (0 means not assigned yet)
+static ORYOL_THREADLOCAL_PTR(uint8) threadIndex = nullptr;
+
+//------------------------------------------------------------------------------
+uint32
+poolAllocatorThreadIndex::Get() {
+    uint8* ptr = threadIndex;
+    if (nullptr == ptr) {
+        ptr = (uint8*) (uintptr_t) (++counter);
+        threadIndex = ptr;
+    }
+    return (uint32) ((uintptr_t) ptr) - 1;
+}
+
+} // namespace _priv
+} // namespace Oryol
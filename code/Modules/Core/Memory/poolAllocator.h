@@ -3,79 +3,129 @@
 /*
     @class Oryol::_priv::poolAllocator
     @ingroup _priv
- 
+
     Thread-safe pool allocator with placement-new/delete. Uses 32-bit
-    tags with a unique-count masked-in for its forward-linked list 
-    instead of pointers because of the ABA problem (which I was actually 
-    running into with many threads and high object reuse). The pool
-    is split into up to 256 "puddles", where each puddle can hold
-    up to 256 elements. When no elements are in the free list, 
-    a new puddle is allocated. Thus one pool can hold up to
-    65536 elements.
+    node indices and a 64-bit head tag with an update-counter masked-in
+    for its forward-linked free-stack instead of pointers because of the
+    ABA problem (which I was actually running into with many threads and
+    high object reuse).
+
+    The free-stack doesn't hold single nodes, but batches of up to
+    BatchSize nodes, so that moving a whole batch between the global
+    free-stack and a cache only takes one CAS. In front of the free-stack
+    sit a small number of per-thread caches ("magazines"), a thread picks
+    its cache through a thread-local index and only touches the global
+    free-stack when the cache runs empty (refill one batch) or full (flush
+    one batch). If two threads share a cache slot and collide, the loser
+    falls back to the global free-stack, so a cache is never waited on.
+
+    The pool is split into "puddles" of 256 elements each. When no
+    elements are left, a new puddle is allocated. Puddles are tracked in
+    up to 256 lazily allocated puddle tables with 256 puddles each, thus
+    one pool can hold up to 16M elements.
 */
 #include <atomic>
 #include <utility>
 #include "Core/Types.h"
+#include "Core/Assertion.h"
 #include "Core/Memory/Memory.h"
 
 namespace Oryol {
 namespace _priv {
-    
+
+class poolAllocatorThreadIndex {
+public:
+    /// get a small per-thread number which selects a pool allocator cache
+    static uint32 Get();
+private:
+    #if ORYOL_HAS_ATOMIC
+    static std::atomic<uint32> counter;
+    #else
+    static uint32 counter;
+    #endif
+};
+
 template<class TYPE> class poolAllocator {
 public:
     /// constructor
     poolAllocator();
     /// destructor
     ~poolAllocator();
-    
+
     /// allocate and construct an object of type T
     template<typename... ARGS> TYPE* Create(ARGS&&... args);
     /// delete and free an object
     void Destroy(TYPE* obj);
-    
+
 private:
     enum class nodeState : uint8 {
         init, free, used,
     };
-    
-    typedef uint32 nodeTag;    // [16bit counter] | [8bit puddle index ] | [8bit elm_index])
-    static const uint32 invalidTag = 0xFFFFFFFF;
+
+    typedef uint32 nodeIndex;   // [8bit table index] | [8bit puddle index] | [8bit elm index]
+    static const nodeIndex invalidIndex = 0xFFFFFFFF;
+    typedef uint64 stackTag;    // [32bit update counter] | [32bit node index of first node in batch]
 
     struct node {
-        nodeTag next;          // tag of next node
-        nodeTag myTag;        // my own tag
-        nodeState state;       // current state
-        uint8 padding[16 - (2*sizeof(nodeTag) + sizeof(nodeState))];      // pad to 16 bytes
+        nodeIndex next;         // next node in same batch
+        nodeIndex nextBatch;    // first node of next batch (only valid in first node of a batch)
+        nodeIndex myIndex;      // my own index
+        uint16 batchSize;       // number of nodes in batch (only valid in first node of a batch)
+        nodeState state;        // current state
+        uint8 padding[16 - (3*sizeof(nodeIndex) + sizeof(uint16) + sizeof(nodeState))];    // pad to 16 bytes
     };
 
-    /// pop a new node from the free-list, return 0 if empty
+    static const int32 NumCaches = 16;
+    static const int32 CacheSize = 32;
+    static const int32 BatchSize = 16;
+
+    struct cache {
+        #if ORYOL_HAS_ATOMIC
+        std::atomic<bool> locked{false};
+        #else
+        bool locked = false;
+        #endif
+        int32 num = 0;
+        node* items[CacheSize];
+    };
+
+    /// push a batch of nodes linked through 'next' onto the free-stack
+    void pushBatch(node* first);
+    /// pop a batch of nodes from the free-stack, return nullptr if empty
+    node* popBatch();
+    /// pop a single node from the free-stack, allocates new puddle if empty
     node* pop();
-    /// push a node onto the free-list
-    void push(node*);
-    /// allocate a new puddle and add entries to free-list
+    /// try to lock a cache, return false if another thread owns it
+    bool lockCache(cache& c);
+    /// unlock a cache
+    void unlockCache(cache& c);
+    /// refill an empty cache from the free-stack
+    void refillCache(cache& c);
+    /// flush one batch from a full cache back to the free-stack
+    void flushCache(cache& c);
+    /// allocate a new puddle and add entries to free-stack
     void allocPuddle();
-    /// get node address from a tag
-    node* addressFromTag(nodeTag tag) const;
-    /// get tag from a node address
-    nodeTag tagFromAddress(node* n) const;
+    /// get node address from a node index
+    node* addressFromIndex(nodeIndex index) const;
     /// test if a pointer is owned by this allocator (SLOW)
     bool isOwned(TYPE* obj) const;
-    
-    static const uint32 MaxNumPuddles = 256;
+
+    static const uint32 MaxNumPuddleTables = 256;
+    static const uint32 NumTablePuddles = 256;
     static const uint32 NumPuddleElements = 256;
-    
+
     int32 elmSize;                      // offset to next element in bytes
 
     #if ORYOL_HAS_ATOMIC
-        std::atomic<uint32> uniqueCount;
-        std::atomic<nodeTag> head;          // free-list head
+        std::atomic<stackTag> head;         // free-stack head
         std::atomic<uint32> numPuddles;     // current number of puddles
+        std::atomic<uint8**> puddleTables[MaxNumPuddleTables];
     #else
-        uint32 uniqueCount;
-        nodeTag head;
+        stackTag head;
         uint32 numPuddles;
+        uint8** puddleTables[MaxNumPuddleTables];
     #endif
-    uint8* puddles[MaxNumPuddles];
+    cache caches[NumCaches];
 };
 
 //------------------------------------------------------------------------------
@@ -83,14 +133,17 @@ template<class TYPE>
 poolAllocator<TYPE>::poolAllocator()
 {
     static_assert(sizeof(node) == 16, "pool_allocator::node should be 16 bytes!");
+    static_assert((NumCaches & (NumCaches - 1)) == 0, "NumCaches must be 2^N");
+    static_assert((BatchSize <= CacheSize) && (CacheSize <= 0xFFFF), "invalid CacheSize or BatchSize");
 
-    Memory::Clear(this->puddles, sizeof(this->puddles));
+    for (uint32 i = 0; i < MaxNumPuddleTables; i++) {
+        this->puddleTables[i] = nullptr;
+    }
     this->numPuddles = 0;
     this->elmSize = Memory::RoundUp(sizeof(node) + sizeof(TYPE), sizeof(node));
     o_assert((this->elmSize & (sizeof(node) - 1)) == 0);
     o_assert(this->elmSize >= (int32)(2*sizeof(node)));
-    this->uniqueCount = 0;
-    this->head = invalidTag;
+    this->head = invalidIndex;
 }
 
 //------------------------------------------------------------------------------
@@ -99,31 +152,32 @@ poolAllocator<TYPE>::~poolAllocator() {
 
     const uint32 num = this->numPuddles;
     for (uint32 i = 0; i < num; i++) {
-        Memory::Free(this->puddles[i]);
-        this->puddles[i] = 0;
+        uint8** table = this->puddleTables[i / NumTablePuddles];
+        Memory::Free(table[i % NumTablePuddles]);
+    }
+    for (uint32 i = 0; i < MaxNumPuddleTables; i++) {
+        uint8** table = this->puddleTables[i];
+        if (table) {
+            Memory::Free(table);
+            this->puddleTables[i] = nullptr;
+        }
     }
 }
 
 //------------------------------------------------------------------------------
 template<class TYPE>
 typename poolAllocator<TYPE>::node*
-poolAllocator<TYPE>::addressFromTag(nodeTag tag) const {
-    uint32 elmIndex = tag & 0xFF;
-    uint32 puddleIndex = (tag & 0xFF00) >> 8;
-    uint8* ptr = this->puddles[puddleIndex] + elmIndex * elmSize;
-    return (node*) ptr;
-}
-
-//------------------------------------------------------------------------------
-template<class TYPE>
-typename poolAllocator<TYPE>::nodeTag
-poolAllocator<TYPE>::tagFromAddress(node* n) const {
-    o_assert(nullptr != n);
-    nodeTag tag = n->myTag;
-    #if ORYOL_ALLOCATOR_DEBUG
-    o_assert(n == addressFromTag(tag));
+poolAllocator<TYPE>::addressFromIndex(nodeIndex index) const {
+    uint32 elmIndex = index & 0xFF;
+    uint32 puddleIndex = (index & 0xFF00) >> 8;
+    uint32 tableIndex = (index & 0xFF0000) >> 16;
+    #if ORYOL_HAS_ATOMIC
+    uint8** table = this->puddleTables[tableIndex].load(std::memory_order_relaxed);
+    #else
+    uint8** table = this->puddleTables[tableIndex];
     #endif
-    return tag;
+    uint8* ptr = table[puddleIndex] + elmIndex * this->elmSize;
+    return (node*) ptr;
 }
 
 //------------------------------------------------------------------------------
@@ -134,106 +188,209 @@ poolAllocator<TYPE>::allocPuddle() {
     // method can be called from different threads
     #if ORYOL_HAS_ATOMIC
         uint32 newPuddleIndex = this->numPuddles.fetch_add(1, std::memory_order_relaxed);
-    #else 
+    #else
         uint32 newPuddleIndex = this->numPuddles++;
     #endif
-    o_assert(newPuddleIndex < MaxNumPuddles);
-    
+    const uint32 tableIndex = newPuddleIndex / NumTablePuddles;
+    o_assert(tableIndex < MaxNumPuddleTables);
+
+    // lookup or create the puddle table, several threads may race for this
+    #if ORYOL_HAS_ATOMIC
+    uint8** table = this->puddleTables[tableIndex].load(std::memory_order_acquire);
+    if (nullptr == table) {
+        const int32 tableByteSize = NumTablePuddles * sizeof(uint8*);
+        uint8** newTable = (uint8**) Memory::Alloc(tableByteSize);
+        Memory::Clear(newTable, tableByteSize);
+        if (this->puddleTables[tableIndex].compare_exchange_strong(table, newTable)) {
+            table = newTable;
+        }
+        else {
+            Memory::Free(newTable);
+        }
+    }
+    #else
+    uint8** table = this->puddleTables[tableIndex];
+    if (nullptr == table) {
+        const int32 tableByteSize = NumTablePuddles * sizeof(uint8*);
+        table = (uint8**) Memory::Alloc(tableByteSize);
+        Memory::Clear(table, tableByteSize);
+        this->puddleTables[tableIndex] = table;
+    }
+    #endif
+
     // allocate new puddle
     const uint32 puddleByteSize = NumPuddleElements * this->elmSize;
-    this->puddles[newPuddleIndex] = (uint8*) Memory::Alloc(puddleByteSize);
-    Memory::Clear(this->puddles[newPuddleIndex], puddleByteSize);
-    
-    // populate the free stack
-    for (int32 elmIndex = (NumPuddleElements - 1); elmIndex >= 0; elmIndex--) {
-        uint8* ptr = this->puddles[newPuddleIndex] + elmIndex * this->elmSize;
-        node* nodePtr = (node*) ptr;
-        nodePtr->next  = invalidTag;
-        nodePtr->myTag = (newPuddleIndex << 8) | elmIndex;
-        nodePtr->state = nodeState::init;
-        this->push(nodePtr);
+    uint8* puddle = (uint8*) Memory::Alloc(puddleByteSize);
+    Memory::Clear(puddle, puddleByteSize);
+    table[newPuddleIndex % NumTablePuddles] = puddle;
+
+    // populate the free stack, one batch at a time
+    static_assert((NumPuddleElements % BatchSize) == 0, "BatchSize must be a divisor of NumPuddleElements");
+    for (uint32 elmIndex = 0; elmIndex < NumPuddleElements; elmIndex++) {
+        node* nodePtr = (node*) (puddle + elmIndex * this->elmSize);
+        nodePtr->myIndex = (newPuddleIndex << 8) | elmIndex;
+        nodePtr->next = ((elmIndex + 1) % BatchSize) ? (nodePtr->myIndex + 1) : invalidIndex;
+        nodePtr->nextBatch = invalidIndex;
+        nodePtr->batchSize = 0;
+        nodePtr->state = nodeState::free;
+    }
+    for (uint32 elmIndex = 0; elmIndex < NumPuddleElements; elmIndex += BatchSize) {
+        node* nodePtr = (node*) (puddle + elmIndex * this->elmSize);
+        nodePtr->batchSize = BatchSize;
+        this->pushBatch(nodePtr);
     }
 }
 
 //------------------------------------------------------------------------------
 template<class TYPE> void
-poolAllocator<TYPE>::push(node* newHead) {
-    
+poolAllocator<TYPE>::pushBatch(node* first) {
+
     // see http://www.boost.org/doc/libs/1_53_0/boost/lockfree/stack.hpp
-    o_assert((nodeState::init == newHead->state) || (nodeState::used == newHead->state));
-    
-    o_assert(invalidTag == newHead->next);
-    #if ORYOL_ALLOCATOR_DEBUG
-    Memory::Fill((void*) (newHead + 1), sizeof(TYPE), 0xAA);
-    #endif
-    
-    newHead->state = nodeState::free;
-    newHead->myTag = (newHead->myTag & 0x0000FFFF) | (++this->uniqueCount & 0xFFFF) << 16;
+    // the update counter is bumped on each modification to prevent ABA
+    o_assert_dbg((first->batchSize > 0) && (nodeState::free == first->state));
     #if ORYOL_HAS_ATOMIC
-        nodeTag oldHeadTag = this->head.load(std::memory_order_relaxed);
+        stackTag oldHead = this->head.load(std::memory_order_relaxed);
         for (;;) {
-            newHead->next = oldHeadTag;
-            if (this->head.compare_exchange_weak(oldHeadTag, newHead->myTag)) {
+            first->nextBatch = (nodeIndex) oldHead;
+            const stackTag newHead = (((oldHead >> 32) + 1) << 32) | first->myIndex;
+            if (this->head.compare_exchange_weak(oldHead, newHead, std::memory_order_release, std::memory_order_relaxed)) {
                 break;
             }
         }
     #else
-        nodeTag oldHeadTag = this->head;
-        newHead->next = oldHeadTag;
-        this->head = newHead->myTag;
+        first->nextBatch = (nodeIndex) this->head;
+        this->head = first->myIndex;
     #endif
 }
 
 //------------------------------------------------------------------------------
 template<class TYPE>
 typename poolAllocator<TYPE>::node*
-poolAllocator<TYPE>::pop()
-{
+poolAllocator<TYPE>::popBatch() {
+
     // see http://www.boost.org/doc/libs/1_53_0/boost/lockfree/stack.hpp
-    for (;;) {
-        #if ORYOL_HAS_ATOMIC
-            nodeTag oldHeadTag = this->head.load(std::memory_order_consume);
-        #else 
-            nodeTag oldHeadTag = this->head;
-        #endif
-        if (invalidTag == oldHeadTag) {
+    #if ORYOL_HAS_ATOMIC
+        stackTag oldHead = this->head.load(std::memory_order_acquire);
+        for (;;) {
+            const nodeIndex firstIndex = (nodeIndex) oldHead;
+            if (invalidIndex == firstIndex) {
+                return nullptr;
+            }
+            // NOTE: first->nextBatch may be stale if another thread popped
+            // the batch in the meantime, the CAS will fail in that case
+            node* first = this->addressFromIndex(firstIndex);
+            const stackTag newHead = (((oldHead >> 32) + 1) << 32) | first->nextBatch;
+            if (this->head.compare_exchange_weak(oldHead, newHead, std::memory_order_acquire, std::memory_order_acquire)) {
+                return first;
+            }
+        }
+    #else
+        const nodeIndex firstIndex = (nodeIndex) this->head;
+        if (invalidIndex == firstIndex) {
             return nullptr;
         }
-        nodeTag newHeadTag = this->addressFromTag(oldHeadTag)->next;
-        #if ORYOL_HAS_ATOMIC
-        if (this->head.compare_exchange_weak(oldHeadTag, newHeadTag)) {
-        #else
-        this->head = newHeadTag;
-        #endif
-            o_assert(invalidTag != oldHeadTag);
-            node* nodePtr = this->addressFromTag(oldHeadTag);
-            o_assert(nodeState::free == nodePtr->state);
-            #if ORYOL_ALLOCATOR_DEBUG
-            Memory::Fill((void*) (nodePtr+ 1), sizeof(TYPE), 0xBB);
-            #endif
-            nodePtr->next = invalidTag;
-            nodePtr->state = nodeState::used;
-            return nodePtr;
-        #if ORYOL_HAS_ATOMIC
+        node* first = this->addressFromIndex(firstIndex);
+        this->head = first->nextBatch;
+        return first;
+    #endif
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE>
+typename poolAllocator<TYPE>::node*
+poolAllocator<TYPE>::pop() {
+    node* first;
+    while (nullptr == (first = this->popBatch())) {
+        this->allocPuddle();
+    }
+    if (first->batchSize > 1) {
+        // return the rest of the batch to the free-stack
+        node* rest = this->addressFromIndex(first->next);
+        rest->batchSize = first->batchSize - 1;
+        this->pushBatch(rest);
+    }
+    return first;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> bool
+poolAllocator<TYPE>::lockCache(cache& c) {
+    #if ORYOL_HAS_ATOMIC
+    return !c.locked.load(std::memory_order_relaxed) && !c.locked.exchange(true, std::memory_order_acquire);
+    #else
+    return true;
+    #endif
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> void
+poolAllocator<TYPE>::unlockCache(cache& c) {
+    #if ORYOL_HAS_ATOMIC
+    c.locked.store(false, std::memory_order_release);
+    #endif
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> void
+poolAllocator<TYPE>::refillCache(cache& c) {
+    o_assert_dbg(0 == c.num);
+    node* first;
+    while (nullptr == (first = this->popBatch())) {
+        this->allocPuddle();
+    }
+    const int32 num = first->batchSize;
+    o_assert_dbg(num <= CacheSize);
+    node* cur = first;
+    for (int32 i = num - 1; i >= 0; i--) {
+        c.items[i] = cur;
+        if (i > 0) {
+            cur = this->addressFromIndex(cur->next);
         }
-        #endif
     }
+    c.num = num;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> void
+poolAllocator<TYPE>::flushCache(cache& c) {
+    o_assert_dbg(c.num >= BatchSize);
+
+    // hand out the least recently freed nodes, the hot ones stay in the cache
+    for (int32 i = 0; i < BatchSize; i++) {
+        c.items[i]->next = (i < (BatchSize - 1)) ? c.items[i + 1]->myIndex : invalidIndex;
+    }
+    c.items[0]->batchSize = BatchSize;
+    this->pushBatch(c.items[0]);
+    c.num -= BatchSize;
+    Memory::Move(&c.items[BatchSize], &c.items[0], c.num * sizeof(node*));
 }
 
 //------------------------------------------------------------------------------
 template<class TYPE>
 template<typename... ARGS> TYPE*
 poolAllocator<TYPE>::Create(ARGS&&... args) {
-    
-    // pop a new node from the free-stack
-    node* n = this->pop();
-    if (nullptr == n) {
-        // need to allocate a new puddle
-        this->allocPuddle();
+
+    // first try the thread's cache, fall back to the global free-stack
+    node* n = nullptr;
+    cache& c = this->caches[poolAllocatorThreadIndex::Get() & (NumCaches - 1)];
+    if (this->lockCache(c)) {
+        if (0 == c.num) {
+            this->refillCache(c);
+        }
+        n = c.items[--c.num];
+        this->unlockCache(c);
+    }
+    else {
         n = this->pop();
     }
     o_assert(nullptr != n);
-    
+    o_assert(nodeState::free == n->state);
+    #if ORYOL_ALLOCATOR_DEBUG
+    Memory::Fill((void*) (n + 1), sizeof(TYPE), 0xBB);
+    #endif
+    n->next = invalidIndex;
+    n->state = nodeState::used;
+
     // construct with placement new
     void* objPtr = (void*) (n + 1);
     TYPE* obj = new(objPtr) TYPE(std::forward<ARGS>(args)...);
@@ -246,8 +403,13 @@ template<class TYPE> bool
 poolAllocator<TYPE>::isOwned(TYPE* obj) const {
     const uint32 num = this->numPuddles;
     for (uint32 i = 0; i < num; i++) {
-        const uint8* start = this->puddles[i];
-        const uint8* end = this->puddles[i] + NumPuddleElements * this->elmSize;
+        uint8** table = this->puddleTables[i / NumTablePuddles];
+        const uint8* start = table ? table[i % NumTablePuddles] : nullptr;
+        if (nullptr == start) {
+            // puddle is currently being allocated by another thread
+            continue;
+        }
+        const uint8* end = start + NumPuddleElements * this->elmSize;
         const uint8* ptr = (uint8*) obj;
         if ((ptr >= start) && (ptr < end)) {
             return true;
@@ -259,18 +421,36 @@ poolAllocator<TYPE>::isOwned(TYPE* obj) const {
 //------------------------------------------------------------------------------
 template<class TYPE> void
 poolAllocator<TYPE>::Destroy(TYPE* obj) {
-    
+
     #if ORYOL_ALLOCATOR_DEBUG
     // make sure this object has been allocated by us
     o_assert(this->isOwned(obj));
     #endif
-    
+
     // call destructor on obj
     obj->~TYPE();
-    
-    // push the pool element back on the free-stack
+
     node* n = ((node*)obj) - 1;
-    push(n);
+    o_assert(nodeState::used == n->state);
+    o_assert(invalidIndex == n->next);
+    #if ORYOL_ALLOCATOR_DEBUG
+    Memory::Fill((void*) (n + 1), sizeof(TYPE), 0xAA);
+    #endif
+    n->state = nodeState::free;
+
+    // put the pool element into the thread's cache, or back on the free-stack
+    cache& c = this->caches[poolAllocatorThreadIndex::Get() & (NumCaches - 1)];
+    if (this->lockCache(c)) {
+        if (CacheSize == c.num) {
+            this->flushCache(c);
+        }
+        c.items[c.num++] = n;
+        this->unlockCache(c);
+    }
+    else {
+        n->batchSize = 1;
+        this->pushBatch(n);
+    }
 }
 
 } // namespace _priv
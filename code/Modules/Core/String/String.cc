@@ -5,6 +5,7 @@
 #include <cstring>
 #include "String.h"
 #include "StringAtom.h"
+#include "Core/Memory/Memory.h"
 
 namespace Oryol {
 
@@ -6,8 +6,9 @@
     @brief immutable, unique strings for fast comparison
     
     A unique string, relatively slow on creation, but fast for comparison.
-    String atoms are stored in thread-local stringAtomTables and comparison
-    is fastest in the creator thread.
+    String atoms are stored in a global, lock-free stringAtomTable,
+    each string exists only once, so comparing string atoms is a pointer
+    comparison, even when they have been created on different threads.
     
     @see String
 */
@@ -28,7 +29,7 @@ public:
     StringAtom(const char* str);
     /// construct from raw string (slow)
     StringAtom(const uchar* str);
-    /// copy-constructor (fast if rhs was created in same thread)
+    /// copy-constructor (fast)
     StringAtom(const StringAtom& rhs);
     /// move-constructor
     StringAtom(StringAtom&& rhs);
@@ -166,6 +167,12 @@ StringAtom::operator=(const uchar* rhs) {
     this->setupFromCString((const char*)rhs);
 }
 
+//------------------------------------------------------------------------------
+inline bool
+StringAtom::operator==(const StringAtom& rhs) const {
+    return this->data == rhs.data;
+}
+
 //------------------------------------------------------------------------------
 inline bool
 StringAtom::operator!=(const StringAtom& rhs) const {
@@ -175,10 +182,6 @@ StringAtom::operator!=(const StringAtom& rhs) const {
 //------------------------------------------------------------------------------
 inline bool
 StringAtom::operator<(const StringAtom& rhs) const {
-    if (rhs.data && this->data) {
-        // it is forbidden to compare string from different threads!
-        o_assert(this->data->table == rhs.data->table);
-    }
     return this->data < rhs.data;
 }
 
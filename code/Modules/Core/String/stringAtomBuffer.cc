@@ -6,64 +6,84 @@
 #include "stringAtomBuffer.h"
 #include "Core/Memory/Memory.h"
 #include "Core/Assertion.h"
-#if ORYOL_USE_VLD
-#include "vld.h"
-#endif
 
 namespace Oryol {
-    
+
+//------------------------------------------------------------------------------
+stringAtomBuffer::stringAtomBuffer() :
+curChunk(nullptr) {
+    static_assert(sizeof(chunk) <= chunkHeaderSize, "stringAtomBuffer::chunk header too big");
+}
+
 //------------------------------------------------------------------------------
 stringAtomBuffer::~stringAtomBuffer() {
     // release all our allocated chunks
-    for (const int8* p : this->chunks) {
-        Memory::Free((void*)p);
+    chunk* c = this->curChunk.load(std::memory_order_acquire);
+    while (c) {
+        chunk* prev = c->prev;
+        c->~chunk();
+        Memory::Free(c);
+        c = prev;
     }
-    this->chunks.Clear();
-    this->curPointer = 0;
+    this->curChunk = nullptr;
 }
-    
+
+//------------------------------------------------------------------------------
+int8*
+stringAtomBuffer::chunkData(chunk* c) {
+    return ((int8*)c) + chunkHeaderSize;
+}
+
 //------------------------------------------------------------------------------
-void
-stringAtomBuffer::allocChunk() {
-    // need to turn off leak detection for the string atom system, since
-    // string atom buffer are never released
-    int8* newChunk = (int8*) Memory::Alloc(this->chunkSize);
-    this->chunks.Add(newChunk);
-    this->curPointer = newChunk;
+stringAtomBuffer::chunk*
+stringAtomBuffer::allocChunk(chunk* prev, int32 reserveBytes) {
+    chunk* c = (chunk*) Memory::Alloc(chunkSize);
+    new(c) chunk();
+    c->prev = prev;
+    c->used.store(reserveBytes, std::memory_order_relaxed);
+    return c;
 }
 
 //------------------------------------------------------------------------------
 const stringAtomBuffer::Header*
-stringAtomBuffer::AddString(stringAtomTable* table, int32 hash, const char* str) {
-    o_assert(nullptr != table);
+stringAtomBuffer::AddString(int32 hash, const char* str) {
     o_assert(nullptr != str);
     
-    // no chunks allocated yet?
-    if (0 == this->curPointer) {
-        this->allocChunk();
-    }
-    
-    // compute length of new entry (header + string len + 0 terminator byte)
+    // compute length of new entry (header + string len + 0 terminator byte),
+    // rounded up so that the next header is aligned
     const int32 strLen = int32(std::strlen(str));
-    size_t requiredSize = strLen + sizeof(Header) + 1;
-    o_assert(requiredSize < this->chunkSize);
-    
-    // check if there's enough room in the current chunk
-    if ((this->curPointer + requiredSize) >= (this->chunks.Back() + this->chunkSize)) {
-        this->allocChunk();
+    const int32 requiredSize = Memory::RoundUp(strLen + int32(sizeof(Header)) + 1, sizeof(Header));
+    o_assert(requiredSize <= (chunkSize - chunkHeaderSize));
+
+    // reserve space in the current chunk, or allocate a new chunk
+    int8* ptr = nullptr;
+    chunk* c = this->curChunk.load(std::memory_order_acquire);
+    while (nullptr == ptr) {
+        if (c) {
+            const int32 offset = c->used.fetch_add(requiredSize, std::memory_order_relaxed);
+            if ((offset + requiredSize) <= (chunkSize - chunkHeaderSize)) {
+                ptr = chunkData(c) + offset;
+                break;
+            }
+        }
+        // current chunk is full (the remaining bytes are lost), try to publish a new one
+        chunk* newChunk = this->allocChunk(c, requiredSize);
+        if (this->curChunk.compare_exchange_strong(c, newChunk, std::memory_order_acq_rel, std::memory_order_acquire)) {
+            ptr = chunkData(newChunk);
+        }
+        else {
+            // another thread was quicker, c now is the new current chunk
+            newChunk->~chunk();
+            Memory::Free(newChunk);
+        }
     }
-    
+
     // copy over data
-    Header* head = (Header*) this->curPointer;
-    head->table = table;
+    Header* head = (Header*) ptr;
     head->hash = hash;
-    head->length  = strLen;
-    head->str  = (char*) this->curPointer + sizeof(Header);
+    head->length = strLen;
+    head->str = (char*) ptr + sizeof(Header);
     std::strcpy((char*)head->str, str);
-    
-    // set curPointer to the next aligned position
-    this->curPointer = (int8*) Memory::Align(this->curPointer + requiredSize, sizeof(Header));
-    
     return head;
 }
 
@@ -3,43 +3,52 @@
 /*
     private class, do not use
     
-    A growable buffer for raw string data for the StringAtom system.
+    A growable, append-only buffer for raw string data for the StringAtom
+    system. Strings can be added from any thread without locking, space
+    is reserved with an atomic add in the current chunk, and whoever
+    overflows the current chunk allocates and publishes a new one.
+    Chunks are never released, since StringAtoms point into them.
 */
 #include "Core/Types.h"
-#include "Core/Containers/Array.h"
+#include <atomic>
 
 namespace Oryol {
 
-class stringAtomTable;
-
 class stringAtomBuffer {
 public:
     // header data for a single entry (string data starts at end of header)
     struct Header {
         // default constructor
-        Header() : table(0), hash(0), length(0), str(0) { };
+        Header() : hash(0), length(0), str(0) { };
         /// constructor
-        Header(const stringAtomTable* t, int32 hsh, int32 len, const char* s) : table(t), hash(hsh), length(len), str(s) { };
+        Header(int32 hsh, int32 len, const char* s) : hash(hsh), length(len), str(s) { };
     
-        const stringAtomTable* table;
         int32 hash;
         int32 length;
         const char* str;
     };
 
+    /// constructor
+    stringAtomBuffer();
     /// destructor
     ~stringAtomBuffer();
     
-    /// add a new string to the buffer, return pointer to start of header
-    const Header* AddString(stringAtomTable* table, int32 hash, const char* str);
+    /// add a new string to the buffer (thread-safe), return pointer to start of header
+    const Header* AddString(int32 hash, const char* str);
     
 private:
+    struct chunk {
+        chunk* prev;                // previous chunk
+        std::atomic<int32> used;    // number of used bytes after the chunk header
+    };
     /// allocate a new chunk
-    void allocChunk();
+    chunk* allocChunk(chunk* prev, int32 reserveBytes);
+    /// get pointer to chunk's data area
+    static int8* chunkData(chunk* c);
 
-    static const int32 chunkSize = (1<<14);    // careful with this: each thread has its own stringbuffer!
-    Array<int8*> chunks;
-    int8* curPointer = 0;        // this is always aligned to min(sizeof(header), ORYOL_MAX_PLATFORM_ALIGN)
+    static const int32 chunkSize = (1<<16);
+    static const int32 chunkHeaderSize = 2 * sizeof(Header);
+    std::atomic<chunk*> curChunk;
 };
     
 } // namespace Oryol
@@ -4,26 +4,58 @@
 #include "Pre.h"
 #include <cstring>
 #include "stringAtomTable.h"
+#include "Core/Memory/Memory.h"
+#include "Core/Assertion.h"
+#if ORYOL_HAS_THREADS
+#include <thread>
+#endif
 #if ORYOL_USE_VLD
 #include "vld.h"
 #endif
 
 namespace Oryol {
 
-ORYOL_THREADLOCAL_PTR(stringAtomTable) stringAtomTable::ptr = nullptr;
+std::atomic<stringAtomTable*> stringAtomTable::instance{nullptr};
+
+//------------------------------------------------------------------------------
+stringAtomTable::stringAtomTable() :
+curIndex(nullptr),
+growing(false),
+numInserters(0) {
+    this->curIndex = allocIndex(InitialCapacity);
+}
+
+//------------------------------------------------------------------------------
+stringAtomTable::~stringAtomTable() {
+    index* idx = this->curIndex.load();
+    while (idx) {
+        index* prev = idx->prev;
+        freeIndex(idx);
+        idx = prev;
+    }
+    this->curIndex = nullptr;
+}
 
 //------------------------------------------------------------------------------
 stringAtomTable*
-stringAtomTable::threadLocalPtr() {
-    // NOTE: this object can never be released, even if a thread is left
-    // since StringAtom object can move to other threads, thus memory
+stringAtomTable::Instance() {
+    // NOTE: this object can never be released, since StringAtom objects
+    // may live until the very end of the program, thus memory
     // leak detectors will complain about these allocations on program
     // exit
-    if (!ptr) {
+    stringAtomTable* ptr = instance.load(std::memory_order_acquire);
+    if (nullptr == ptr) {
         #if ORYOL_USE_VLD
         VLDDisable();
         #endif
-        ptr = Memory::New<stringAtomTable>();
+        stringAtomTable* newPtr = Memory::New<stringAtomTable>();
+        if (instance.compare_exchange_strong(ptr, newPtr, std::memory_order_acq_rel, std::memory_order_acquire)) {
+            ptr = newPtr;
+        }
+        else {
+            // another thread was quicker
+            Memory::Delete(newPtr);
+        }
         #if ORYOL_USE_VLD
         VLDEnable();
         #endif
@@ -31,45 +63,155 @@ stringAtomTable::threadLocalPtr() {
     return ptr;
 }
 
+//------------------------------------------------------------------------------
+stringAtomTable::index*
+stringAtomTable::allocIndex(int32 capacity) {
+    o_assert_dbg(0 == (capacity & (capacity - 1)));
+    index* idx = Memory::New<index>();
+    idx->prev = nullptr;
+    idx->capacity = capacity;
+    idx->count = 0;
+    idx->slots = (std::atomic<const stringAtomBuffer::Header*>*) Memory::Alloc(capacity * sizeof(std::atomic<const stringAtomBuffer::Header*>));
+    for (int32 i = 0; i < capacity; i++) {
+        new(&idx->slots[i]) std::atomic<const stringAtomBuffer::Header*>(nullptr);
+    }
+    return idx;
+}
+
+//------------------------------------------------------------------------------
+void
+stringAtomTable::freeIndex(index* idx) {
+    Memory::Free(idx->slots);
+    Memory::Delete(idx);
+}
+
+//------------------------------------------------------------------------------
+bool
+stringAtomTable::matches(const stringAtomBuffer::Header* head, int32 hash, const char* str) {
+    // if hashes differ, the entries are definitely not equal,
+    // if hashes are identical, need to do a strcmp
+    return (head->hash == hash) && (0 == std::strcmp(head->str, str));
+}
+
 //------------------------------------------------------------------------------
 const stringAtomBuffer::Header*
 stringAtomTable::Find(int32 hash, const char* str) const {
-    
-    // need to create a temp object for searching in the set
-    stringAtomBuffer::Header dummyHead(this, hash, 0, str);
-    Entry dummyEntry(&dummyHead);
-    auto ptr = this->table.Find(dummyEntry);
-    if (nullptr == ptr) {
-        return nullptr;
+    const index* idx = this->curIndex.load(std::memory_order_acquire);
+    const int32 mask = idx->capacity - 1;
+    for (int32 i = hash & mask; ; i = (i + 1) & mask) {
+        const stringAtomBuffer::Header* head = idx->slots[i].load(std::memory_order_acquire);
+        if (nullptr == head) {
+            return nullptr;
+        }
+        else if (matches(head, hash, str)) {
+            return head;
+        }
     }
-    else {
-        o_assert(nullptr != ptr->header);
-        return ptr->header;
+}
+
+//------------------------------------------------------------------------------
+const stringAtomBuffer::Header*
+stringAtomTable::insert(index* idx, int32 hash, const char* str) {
+    const stringAtomBuffer::Header* newHead = nullptr;
+    const int32 mask = idx->capacity - 1;
+    for (int32 i = hash & mask; ; i = (i + 1) & mask) {
+        const stringAtomBuffer::Header* head = idx->slots[i].load(std::memory_order_acquire);
+        if (nullptr == head) {
+            if (nullptr == newHead) {
+                newHead = this->buffer.AddString(hash, str);
+            }
+            if (idx->slots[i].compare_exchange_strong(head, newHead, std::memory_order_acq_rel, std::memory_order_acquire)) {
+                idx->count.fetch_add(1, std::memory_order_relaxed);
+                return newHead;
+            }
+            // another thread has claimed the slot, head is now its entry
+            // (if it is the same string, the space for newHead is lost)
+        }
+        if (matches(head, hash, str)) {
+            return head;
+        }
     }
 }
 
 //------------------------------------------------------------------------------
 const stringAtomBuffer::Header*
 stringAtomTable::Add(int32 hash, const char* str) {
-    
-    #if ORYOL_DEBUG
-    o_assert(nullptr == this->Find(hash, str));
-    #endif    
+    o_assert_dbg(nullptr != str);
     #if ORYOL_USE_VLD
     VLDDisable();
     #endif
 
-    // add new string to the string buffer
-    const stringAtomBuffer::Header* newHeader = this->buffer.AddString(this, hash, str);
-    o_assert(nullptr != newHeader);
-    
-    // add new entry to our lookup table
-    this->table.Add(Entry(newHeader));
+    const stringAtomBuffer::Header* result = nullptr;
+    index* idx = nullptr;
+    while (nullptr == result) {
+        // register as inserter, unless the index is currently being grown
+        this->numInserters.fetch_add(1);
+        if (this->growing.load()) {
+            this->numInserters.fetch_sub(1);
+            while (this->growing.load(std::memory_order_acquire)) {
+                yield();
+            }
+            continue;
+        }
+        idx = this->curIndex.load(std::memory_order_acquire);
+        result = this->insert(idx, hash, str);
+        this->numInserters.fetch_sub(1, std::memory_order_release);
+    }
+    if (idx->count.load(std::memory_order_relaxed) > (idx->capacity / 2)) {
+        this->grow(idx);
+    }
 
     #if ORYOL_USE_VLD
     VLDEnable();
     #endif
-    return newHeader;
+    return result;
+}
+
+//------------------------------------------------------------------------------
+void
+stringAtomTable::grow(index* idx) {
+    bool expected = false;
+    if (!this->growing.compare_exchange_strong(expected, true)) {
+        // another thread is already growing the index
+        return;
+    }
+    if (this->curIndex.load() != idx) {
+        // another thread has grown the index in the meantime
+        this->growing.store(false);
+        return;
+    }
+    // wait for running inserts into the old index to finish
+    while (0 != this->numInserters.load()) {
+        yield();
+    }
+
+    // copy entries into new index and publish it
+    index* newIdx = allocIndex(idx->capacity * 2);
+    newIdx->prev = idx;
+    const int32 newMask = newIdx->capacity - 1;
+    int32 count = 0;
+    for (int32 i = 0; i < idx->capacity; i++) {
+        const stringAtomBuffer::Header* head = idx->slots[i].load(std::memory_order_relaxed);
+        if (head) {
+            int32 slot = head->hash & newMask;
+            while (nullptr != newIdx->slots[slot].load(std::memory_order_relaxed)) {
+                slot = (slot + 1) & newMask;
+            }
+            newIdx->slots[slot].store(head, std::memory_order_relaxed);
+            count++;
+        }
+    }
+    newIdx->count.store(count, std::memory_order_relaxed);
+    this->curIndex.store(newIdx, std::memory_order_release);
+    this->growing.store(false, std::memory_order_release);
+}
+
+//------------------------------------------------------------------------------
+void
+stringAtomTable::yield() {
+    #if ORYOL_HAS_THREADS
+    std::this_thread::yield();
+    #endif
 }
 
 //------------------------------------------------------------------------------
@@ -92,38 +234,4 @@ stringAtomTable::HashForString(const char* str) {
     return h;
 }
 
-//------------------------------------------------------------------------------
-bool
-stringAtomTable::Entry::operator==(const Entry& rhs) const {
-
-    #if ORYOL_DEBUG
-    o_assert(this->header != 0 && rhs.header != 0);
-    o_assert(this->header->hash != 0 && rhs.header->hash != 0);
-    o_assert(this->header->str != 0 && rhs.header->str != 0);
-    #endif
-    
-    if (this->header->hash != rhs.header->hash) {
-        // if hashes differ, the entries are definitely not equal
-        return false;
-    }
-    else {
-        // if hashes are identical, need to do a strcmp
-        return (0 == std::strcmp(this->header->str, rhs.header->str));
-    }
-}
-
-//------------------------------------------------------------------------------
-bool
-stringAtomTable::Entry::operator<(const Entry& rhs) const {
-        
-    #if ORYOL_DEBUG
-    o_assert(this->header != 0 && rhs.header != 0);
-    o_assert(this->header->hash != 0 && rhs.header->hash != 0);
-    o_assert(this->header->str != 0 && rhs.header->str != 0);
-    #endif
-    return std::strcmp(this->header->str, rhs.header->str) < 0;
-}
-
 } // namespace Oryol
-
-
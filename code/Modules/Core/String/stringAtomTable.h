@@ -3,51 +3,71 @@
 /*
     private class, do not use
     
-    A thread-local StringAtom table.
+    The global StringAtom table, shared by all threads.
+
+    Strings live in an append-only stringAtomBuffer, the lookup index is
+    an open-addressed hash table of atomic header pointers with linear
+    probing. Lookups never lock, new strings are added with a CAS on an
+    empty index slot (if two threads race to add the same string, both
+    end up with the header of the winner). Since each string exists only
+    once, StringAtoms can be compared by pointer on any thread.
+
+    When the index becomes half full, it is replaced by an index with
+    twice the capacity. Adding new strings (but not looking them up)
+    waits while the index is being copied, this happens only a
+    handful of times over the lifetime of an application. Old indices
+    are kept alive, because other threads may still be probing them.
 */
 #include "Core/Types.h"
 #include "Core/String/stringAtomBuffer.h"
-#include "Core/Containers/HashSet.h"
-#include "Core/Threading/ThreadLocalPtr.h"
+#include <atomic>
 
 namespace Oryol {
 
 class stringAtomTable {
 public:
-    /// access to thread-local stringAtomTable (created on demand)
-    static stringAtomTable* threadLocalPtr();
+    /// constructor
+    stringAtomTable();
+    /// destructor
+    ~stringAtomTable();
+
+    /// access to the global stringAtomTable (created on demand)
+    static stringAtomTable* Instance();
     /// compute hash value for string
     static int32 HashForString(const char* str);
-    /// find a matching buffer header in the table
+    /// find a matching buffer header in the table (thread-safe)
     const stringAtomBuffer::Header* Find(int32 hash, const char* str) const;
-    /// add a string to the atom table
+    /// add a string to the atom table, or return existing entry (thread-safe)
     const stringAtomBuffer::Header* Add(int32 hash, const char* str);
     
 private:
-    static ORYOL_THREADLOCAL_PTR(stringAtomTable) ptr;
-
-    /// a bucket entry
-    struct Entry {
-        /// default constructor
-        Entry() : header(0) { };
-        /// constructor with header ptr
-        Entry(const stringAtomBuffer::Header* h) : header(h) { };
-        /// equality operator
-        bool operator==(const Entry& rhs) const;
-        /// less-then operator
-        bool operator<(const Entry& rhs) const;
-        
-        const stringAtomBuffer::Header* header;
-    };
-    
-    /// hash function for bucket entry
-    struct Hasher {
-        int32 operator()(const Entry& e) const {
-            return e.header->hash;
-        };
+    /// an open-addressed lookup index
+    struct index {
+        index* prev;        // previous (smaller) index, kept alive for readers
+        int32 capacity;     // number of slots (2^N)
+        std::atomic<int32> count;
+        std::atomic<const stringAtomBuffer::Header*>* slots;
     };
+    /// allocate a new index
+    static index* allocIndex(int32 capacity);
+    /// free an index
+    static void freeIndex(index* idx);
+    /// test if a header matches a string
+    static bool matches(const stringAtomBuffer::Header* head, int32 hash, const char* str);
+    /// find or insert string in index
+    const stringAtomBuffer::Header* insert(index* idx, int32 hash, const char* str);
+    /// replace index with a bigger one
+    void grow(index* idx);
+    /// wait a little while the index is being grown
+    static void yield();
+
+    static const int32 InitialCapacity = 4096;
+    static std::atomic<stringAtomTable*> instance;
+
     stringAtomBuffer buffer;
-    HashSet<Entry, Hasher, 1024> table;
+    std::atomic<index*> curIndex;
+    std::atomic<bool> growing;
+    std::atomic<int32> numInserters;
 };
 
 } // namespace Oryol
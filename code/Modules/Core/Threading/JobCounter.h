@@ -0,0 +1,52 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::JobCounter
+    @ingroup Core
+    @brief completion counter for JobSystem jobs
+
+    A JobCounter is incremented when a job which references it is
+    started, and decremented when the job has finished. JobSystem::Wait()
+    blocks (and helps running jobs) until the counter is back to zero,
+    and JobSystem::RunAfter() defers a job until a counter reaches zero,
+    which is how small task graphs are expressed. Since the counter is
+    incremented when a job is submitted, the jobs of a graph must be
+    submitted in dependency order.
+
+    The counter must stay alive until all jobs referencing it have
+    finished (e.g. until JobSystem::Wait() has returned).
+*/
+#include "Core/Types.h"
+#include <atomic>
+
+namespace Oryol {
+
+namespace _priv {
+struct job;
+}
+
+class JobCounter {
+public:
+    /// constructor
+    JobCounter() : count(0), lock(false), waiting(nullptr) { };
+    /// return true if no jobs are pending on the counter
+    bool Done() const {
+        return (0 == this->count.load(std::memory_order_acquire)) && !this->lock.load(std::memory_order_acquire);
+    };
+    /// get number of jobs pending on the counter
+    int32 Value() const {
+        return this->count.load(std::memory_order_relaxed);
+    };
+
+private:
+    friend class JobSystem;
+
+    JobCounter(const JobCounter&) = delete;
+    void operator=(const JobCounter&) = delete;
+
+    std::atomic<int32> count;
+    std::atomic<bool> lock;
+    _priv::job* waiting;    // jobs which run when the counter reaches zero
+};
+
+} // namespace Oryol
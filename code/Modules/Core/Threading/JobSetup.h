@@ -0,0 +1,22 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::JobSetup
+    @ingroup Core
+    @brief setup parameters for the JobSystem
+*/
+#include "Core/Types.h"
+
+namespace Oryol {
+
+class JobSetup {
+public:
+    /// number of worker threads, 0 means one per CPU core minus the main thread
+    int32 NumWorkers = 0;
+    /// capacity of each per-thread job deque (must be power of 2)
+    int32 QueueCapacity = 4096;
+    /// let the main thread help draining jobs in the post-frame runloop
+    bool DrainAtFrameEnd = true;
+};
+
+} // namespace Oryol
@@ -0,0 +1,452 @@
+//------------------------------------------------------------------------------
+//  JobSystem.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "JobSystem.h"
+#include "Core/Core.h"
+#include "Core/RunLoop.h"
+#include "Core/Containers/Array.h"
+#include "Core/Containers/Queue.h"
+#include "Core/Memory/poolAllocator.h"
+#include "Core/Threading/jobDeque.h"
+#include "Core/Threading/wakeupEvent.h"
+#include "Core/Threading/ThreadLocalPtr.h"
+#if ORYOL_HAS_THREADS
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#endif
+
+namespace Oryol {
+
+namespace _priv {
+
+/// a job, either a plain function or a sub-range of a ParallelFor
+struct job {
+    JobSystem::Func func;
+    const JobSystem::RangeFunc* rangeFunc = nullptr;
+    int32 begin = 0;
+    int32 end = 0;
+    int32 grainSize = 0;
+    JobCounter* counter = nullptr;
+    job* next = nullptr;
+};
+
+/// per-thread state of the main thread and each worker thread
+struct jobContext {
+    jobDeque<job> deque;
+    int32 index = 0;
+    uint32 seed = 0;
+    #if ORYOL_HAS_THREADS
+    std::thread thread;
+    #endif
+};
+
+} // namespace _priv
+
+using namespace _priv;
+
+struct JobSystem::_state {
+    int32 numWorkers = 0;
+    Array<jobContext*> contexts;    // main thread is the last context
+    poolAllocator<job> jobAllocator;
+    std::atomic<int32> numQueued{0};
+    std::atomic<bool> stopRequested{false};
+    int32 runLoopId = RunLoop::InvalidId;
+    #if ORYOL_HAS_THREADS
+    std::mutex injectLock;
+    Queue<job*> injectQueue;
+    std::atomic<int32> numInjected{0};
+    std::mutex sleepLock;
+    std::condition_variable sleepCond;
+    std::atomic<int32> numSleeping{0};
+    #endif
+};
+
+JobSystem::_state* JobSystem::state = nullptr;
+
+/// the job context of the current thread, nullptr on non-job threads
+static ORYOL_THREADLOCAL_PTR(jobContext) curContext = nullptr;
+
+/// number of unsuccessful find() calls before a worker goes to sleep
+static const int32 MaxIdleSpins = 256;
+
+//------------------------------------------------------------------------------
+void
+JobSystem::Setup(const JobSetup& setup) {
+    o_assert(!IsValid());
+    o_assert(setup.QueueCapacity > 0);
+    state = Memory::New<_state>();
+
+    #if ORYOL_HAS_THREADS
+    if (setup.NumWorkers > 0) {
+        state->numWorkers = setup.NumWorkers;
+    }
+    else {
+        const int32 numCores = std::thread::hardware_concurrency();
+        state->numWorkers = numCores > 2 ? numCores - 1 : 1;
+    }
+    #endif
+
+    // one context per worker, plus one for the main thread
+    const int32 numContexts = state->numWorkers + 1;
+    state->contexts.Reserve(numContexts);
+    for (int32 i = 0; i < numContexts; i++) {
+        jobContext* ctx = Memory::New<jobContext>();
+        ctx->deque.Setup(setup.QueueCapacity);
+        ctx->index = i;
+        ctx->seed = 0x9E3779B9 * (i + 1);
+        state->contexts.Add(ctx);
+    }
+    curContext = state->contexts.Back();
+
+    // start the worker threads
+    #if ORYOL_HAS_THREADS
+    for (int32 i = 0; i < state->numWorkers; i++) {
+        jobContext* ctx = state->contexts[i];
+        ctx->thread = std::thread(workerFunc, ctx);
+    }
+    #endif
+
+    if (setup.DrainAtFrameEnd && Core::IsValid()) {
+        state->runLoopId = Core::PostRunLoop()->Add([] { Drain(); });
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+JobSystem::Discard() {
+    o_assert(IsValid());
+    o_assert_dbg(curContext == state->contexts.Back());
+
+    if (RunLoop::InvalidId != state->runLoopId) {
+        Core::PostRunLoop()->Remove(state->runLoopId);
+    }
+
+    // help finishing any queued jobs, then stop the workers
+    Drain();
+    state->stopRequested = true;
+    #if ORYOL_HAS_THREADS
+    {
+        std::lock_guard<std::mutex> lock(state->sleepLock);
+        state->sleepCond.notify_all();
+    }
+    for (int32 i = 0; i < state->numWorkers; i++) {
+        state->contexts[i]->thread.join();
+    }
+    #endif
+    Drain();
+    o_assert(0 == state->numQueued);
+
+    curContext = nullptr;
+    for (jobContext* ctx : state->contexts) {
+        Memory::Delete(ctx);
+    }
+    state->contexts.Clear();
+    Memory::Delete(state);
+    state = nullptr;
+}
+
+//------------------------------------------------------------------------------
+bool
+JobSystem::IsValid() {
+    return nullptr != state;
+}
+
+//------------------------------------------------------------------------------
+int32
+JobSystem::NumWorkers() {
+    o_assert_dbg(IsValid());
+    return state->numWorkers;
+}
+
+//------------------------------------------------------------------------------
+void
+JobSystem::Run(Func func, JobCounter* counter) {
+    o_assert_dbg(IsValid());
+    o_assert_dbg(func);
+    job* j = state->jobAllocator.Create();
+    j->func = std::move(func);
+    j->counter = counter;
+    incr(counter);
+    push(j);
+}
+
+//------------------------------------------------------------------------------
+/**
+ The job is parked on the dependency counter, and pushed by whatever
+ thread decrements the counter to zero. If the counter is already zero,
+ the job is pushed right away.
+*/
+void
+JobSystem::RunAfter(JobCounter& dep, Func func, JobCounter* counter) {
+    o_assert_dbg(IsValid());
+    o_assert_dbg(func);
+    o_assert_dbg(&dep != counter);
+    job* j = state->jobAllocator.Create();
+    j->func = std::move(func);
+    j->counter = counter;
+    incr(counter);
+
+    while (dep.lock.exchange(true, std::memory_order_acquire)) {
+        wakeupEvent::Pause();
+    }
+    if (0 == dep.count.load(std::memory_order_relaxed)) {
+        dep.lock.store(false, std::memory_order_release);
+        push(j);
+    }
+    else {
+        j->next = dep.waiting;
+        dep.waiting = j;
+        dep.lock.store(false, std::memory_order_release);
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+ The whole range starts as one job which is executed right away on the
+ calling thread. Executing a range job splits off the upper half onto
+ the deque until the range is at most grainSize, so thieves always
+ steal the biggest remaining chunk, and only O(log(num/grainSize))
+ jobs per thread are alive at any time.
+*/
+void
+JobSystem::ParallelFor(int32 num, int32 grainSize, const RangeFunc& func) {
+    o_assert_dbg(IsValid());
+    o_assert_dbg(func);
+    if (num <= 0) {
+        return;
+    }
+    if (grainSize <= 0) {
+        grainSize = num / ((state->numWorkers + 1) * 8);
+        if (grainSize < 1) {
+            grainSize = 1;
+        }
+    }
+    JobCounter counter;
+    job* j = state->jobAllocator.Create();
+    j->rangeFunc = &func;
+    j->begin = 0;
+    j->end = num;
+    j->grainSize = grainSize;
+    j->counter = &counter;
+    incr(&counter);
+    execute(j);
+    Wait(counter);
+}
+
+//------------------------------------------------------------------------------
+void
+JobSystem::Wait(JobCounter& counter) {
+    o_assert_dbg(IsValid());
+    int32 numIdle = 0;
+    while (!counter.Done()) {
+        job* j = find();
+        if (j) {
+            execute(j);
+            numIdle = 0;
+        }
+        else if (++numIdle < MaxIdleSpins) {
+            wakeupEvent::Pause();
+        }
+        else {
+            // the remaining jobs are running on other threads
+            #if ORYOL_HAS_THREADS
+            std::this_thread::yield();
+            #endif
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+JobSystem::Drain() {
+    o_assert_dbg(IsValid());
+    job* j = nullptr;
+    while (nullptr != (j = find())) {
+        execute(j);
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+JobSystem::push(job* j) {
+    jobContext* ctx = curContext;
+    if (ctx) {
+        if (!ctx->deque.Push(j)) {
+            // our deque is full, just run the job right here
+            execute(j);
+            return;
+        }
+    }
+    else {
+        #if ORYOL_HAS_THREADS
+        std::lock_guard<std::mutex> lock(state->injectLock);
+        state->injectQueue.Enqueue(j);
+        state->numInjected++;
+        #else
+        o_error("JobSystem: push from non-job thread!\n");
+        #endif
+    }
+    state->numQueued.fetch_add(1, std::memory_order_seq_cst);
+    #if ORYOL_HAS_THREADS
+    if (state->numSleeping.load(std::memory_order_seq_cst) > 0) {
+        std::lock_guard<std::mutex> lock(state->sleepLock);
+        state->sleepCond.notify_one();
+    }
+    #endif
+}
+
+//------------------------------------------------------------------------------
+job*
+JobSystem::find() {
+    jobContext* ctx = curContext;
+    job* j = nullptr;
+
+    // first try our own deque
+    if (ctx) {
+        j = ctx->deque.Pop();
+    }
+
+    // then try to steal, start at a random victim
+    if (nullptr == j) {
+        const int32 numContexts = state->contexts.Size();
+        uint32 start = 0;
+        if (ctx) {
+            ctx->seed ^= ctx->seed << 13;
+            ctx->seed ^= ctx->seed >> 17;
+            ctx->seed ^= ctx->seed << 5;
+            start = ctx->seed;
+        }
+        for (int32 i = 0; i < numContexts; i++) {
+            jobContext* victim = state->contexts[(start + i) % numContexts];
+            if (victim != ctx) {
+                j = victim->deque.Steal();
+                if (j) {
+                    break;
+                }
+            }
+        }
+    }
+
+    // finally check the injection queue for jobs from non-job threads
+    #if ORYOL_HAS_THREADS
+    if ((nullptr == j) && (state->numInjected.load(std::memory_order_relaxed) > 0)) {
+        std::lock_guard<std::mutex> lock(state->injectLock);
+        if (!state->injectQueue.Empty()) {
+            j = state->injectQueue.Dequeue();
+            state->numInjected--;
+        }
+    }
+    #endif
+
+    if (j) {
+        state->numQueued.fetch_sub(1, std::memory_order_relaxed);
+    }
+    return j;
+}
+
+//------------------------------------------------------------------------------
+void
+JobSystem::execute(job* j) {
+    o_assert_dbg(j);
+    if (j->rangeFunc) {
+        // split off upper halves until the range is small enough
+        while ((j->end - j->begin) > j->grainSize) {
+            const int32 mid = j->begin + (j->end - j->begin) / 2;
+            job* split = state->jobAllocator.Create();
+            split->rangeFunc = j->rangeFunc;
+            split->begin = mid;
+            split->end = j->end;
+            split->grainSize = j->grainSize;
+            split->counter = j->counter;
+            incr(split->counter);
+            push(split);
+            j->end = mid;
+        }
+        (*j->rangeFunc)(j->begin, j->end);
+    }
+    else {
+        j->func();
+    }
+    JobCounter* counter = j->counter;
+    state->jobAllocator.Destroy(j);
+    decr(counter);
+}
+
+//------------------------------------------------------------------------------
+void
+JobSystem::incr(JobCounter* counter) {
+    if (counter) {
+        counter->count.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+ NOTE: the counter is decremented under its lock, and JobCounter::Done()
+ also checks the lock, so that a thread returning from Wait() can't
+ destroy the counter while it is still touched here.
+*/
+void
+JobSystem::decr(JobCounter* counter) {
+    if (nullptr == counter) {
+        return;
+    }
+    while (counter->lock.exchange(true, std::memory_order_acquire)) {
+        wakeupEvent::Pause();
+    }
+    job* waiting = nullptr;
+    if (1 == counter->count.fetch_sub(1, std::memory_order_acq_rel)) {
+        waiting = counter->waiting;
+        counter->waiting = nullptr;
+    }
+    counter->lock.store(false, std::memory_order_release);
+
+    // push jobs which depended on this counter
+    while (waiting) {
+        job* next = waiting->next;
+        waiting->next = nullptr;
+        push(waiting);
+        waiting = next;
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+JobSystem::sleep() {
+    #if ORYOL_HAS_THREADS
+    std::unique_lock<std::mutex> lock(state->sleepLock);
+    state->numSleeping.fetch_add(1, std::memory_order_seq_cst);
+    if ((0 == state->numQueued.load(std::memory_order_seq_cst)) && !state->stopRequested) {
+        state->sleepCond.wait(lock);
+    }
+    state->numSleeping.fetch_sub(1, std::memory_order_relaxed);
+    #endif
+}
+
+//------------------------------------------------------------------------------
+void
+JobSystem::workerFunc(jobContext* ctx) {
+    Core::EnterThread();
+    curContext = ctx;
+    int32 numIdle = 0;
+    while (!state->stopRequested) {
+        job* j = find();
+        if (j) {
+            execute(j);
+            numIdle = 0;
+        }
+        else if (++numIdle < MaxIdleSpins) {
+            wakeupEvent::Pause();
+        }
+        else {
+            sleep();
+            numIdle = 0;
+        }
+    }
+    curContext = nullptr;
+    Core::LeaveThread();
+}
+
+} // namespace Oryol
@@ -0,0 +1,89 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::JobSystem
+    @ingroup Core
+    @brief work-stealing job system for fanning out CPU work
+
+    The JobSystem runs a pool of worker threads, each with its own
+    Chase-Lev work-stealing deque (the main thread owns a deque as well).
+    Jobs pushed by a worker or the main thread go onto that thread's
+    own deque, idle workers steal from the other deques. Jobs pushed
+    from other threads (e.g. IO lanes) go through a small locked
+    injection queue.
+
+    - Run(): start a fire-and-forget job, optionally tracked by a JobCounter
+    - RunAfter(): start a job once a JobCounter has reached zero, this
+      is how dependencies in small task graphs are expressed
+    - ParallelFor(): call a function over sub-ranges of [0, num) in
+      parallel, ranges are split recursively so that stealing threads
+      pick up big chunks first, returns when all ranges are done
+    - Wait(): block until a JobCounter is zero, the waiting thread
+      executes jobs while waiting instead of going idle
+
+    With DrainAtFrameEnd enabled in the JobSetup, the main thread
+    executes queued jobs in the Core post-frame runloop.
+
+    On platforms without threads no workers are created and all jobs
+    run on the main thread in Wait() or at frame end.
+*/
+#include "Core/Types.h"
+#include "Core/Threading/JobSetup.h"
+#include "Core/Threading/JobCounter.h"
+#include <functional>
+
+namespace Oryol {
+
+namespace _priv {
+struct job;
+struct jobContext;
+}
+
+class JobSystem {
+public:
+    /// job function
+    typedef std::function<void()> Func;
+    /// range job function, called with [begin, end)
+    typedef std::function<void(int32 begin, int32 end)> RangeFunc;
+
+    /// setup the job system
+    static void Setup(const JobSetup& setup);
+    /// discard the job system (waits for running jobs to finish)
+    static void Discard();
+    /// check if job system has been setup
+    static bool IsValid();
+    /// get number of worker threads (not counting the main thread)
+    static int32 NumWorkers();
+
+    /// run a job asynchronously, counter is optional
+    static void Run(Func func, JobCounter* counter=nullptr);
+    /// run a job after the dependency counter has reached zero, counter is optional
+    static void RunAfter(JobCounter& dependency, Func func, JobCounter* counter=nullptr);
+    /// call func on sub-ranges of [0, num) in parallel and wait for completion (grainSize 0: automatic)
+    static void ParallelFor(int32 num, int32 grainSize, const RangeFunc& func);
+    /// wait until counter reaches zero, executes jobs while waiting
+    static void Wait(JobCounter& counter);
+    /// execute queued jobs on the calling thread until no more work is found
+    static void Drain();
+
+private:
+    /// worker thread function
+    static void workerFunc(_priv::jobContext* ctx);
+    /// push a job to the current thread's deque or the injection queue
+    static void push(_priv::job* j);
+    /// find a job to execute on the current thread
+    static _priv::job* find();
+    /// execute and free a job
+    static void execute(_priv::job* j);
+    /// increment a job counter
+    static void incr(JobCounter* counter);
+    /// decrement a job counter, and push waiting jobs if it reached zero
+    static void decr(JobCounter* counter);
+    /// put the calling worker thread to sleep until new jobs arrive
+    static void sleep();
+
+    struct _state;
+    static _state* state;
+};
+
+} // namespace Oryol
@@ -0,0 +1,174 @@
+#pragma once
+//------------------------------------------------------------------------------
+/*
+    @class Oryol::_priv::jobDeque
+    @ingroup _priv
+    @brief fixed-capacity Chase-Lev work-stealing deque
+
+    The owner thread pushes and pops items at the bottom end (LIFO, which
+    keeps recently spawned work hot in the cache), any other thread
+    may steal items from the top end (FIFO, which tends to steal the
+    biggest chunks of work first). Only Steal() and the last-item case
+    of Pop() need a CAS, the common push/pop path is wait-free.
+
+    This follows "Correct and Efficient Work-Stealing for Weak Memory
+    Models" (Le, Pop, Cohen, Zappa Nardelli 2013), but doesn't grow,
+    Push() returns false when the deque is full and the caller is
+    expected to run the item directly.
+*/
+#include "Core/Types.h"
+#include "Core/Assertion.h"
+#include "Core/Memory/Memory.h"
+#include <atomic>
+
+namespace Oryol {
+namespace _priv {
+
+template<class TYPE> class jobDeque {
+public:
+    /// constructor
+    jobDeque();
+    /// destructor
+    ~jobDeque();
+
+    /// setup with a power-of-2 capacity
+    void Setup(int32 capacity);
+    /// discard the deque
+    void Discard();
+    /// return true if deque has been setup
+    bool IsValid() const;
+
+    /// push an item at the bottom (owner thread only), return false if full
+    bool Push(TYPE* item);
+    /// pop an item from the bottom (owner thread only), return nullptr if empty
+    TYPE* Pop();
+    /// steal an item from the top (any thread), return nullptr if empty or lost a race
+    TYPE* Steal();
+    /// approximate number of items in the deque
+    int32 Size() const;
+
+private:
+    static const int32 CacheLineSize = 64;
+
+    std::atomic<TYPE*>* items;
+    int64 mask;
+    uint8 pad0[CacheLineSize];
+    std::atomic<int64> top;         // touched by thieves
+    uint8 pad1[CacheLineSize - sizeof(std::atomic<int64>)];
+    std::atomic<int64> bottom;      // touched by owner
+    uint8 pad2[CacheLineSize - sizeof(std::atomic<int64>)];
+};
+
+//------------------------------------------------------------------------------
+template<class TYPE>
+jobDeque<TYPE>::jobDeque() :
+items(nullptr),
+mask(0),
+top(0),
+bottom(0) {
+    // empty
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE>
+jobDeque<TYPE>::~jobDeque() {
+    if (this->IsValid()) {
+        this->Discard();
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> void
+jobDeque<TYPE>::Setup(int32 capacity) {
+    o_assert(!this->IsValid());
+    o_assert((capacity >= 2) && (0 == (capacity & (capacity - 1))));
+    this->items = (std::atomic<TYPE*>*) Memory::Alloc(capacity * sizeof(std::atomic<TYPE*>));
+    for (int32 i = 0; i < capacity; i++) {
+        new(&this->items[i]) std::atomic<TYPE*>(nullptr);
+    }
+    this->mask = capacity - 1;
+    this->top.store(0, std::memory_order_relaxed);
+    this->bottom.store(0, std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> void
+jobDeque<TYPE>::Discard() {
+    o_assert(this->IsValid());
+    Memory::Free(this->items);
+    this->items = nullptr;
+    this->mask = 0;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> bool
+jobDeque<TYPE>::IsValid() const {
+    return nullptr != this->items;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> bool
+jobDeque<TYPE>::Push(TYPE* item) {
+    o_assert_dbg(this->IsValid());
+    const int64 b = this->bottom.load(std::memory_order_relaxed);
+    const int64 t = this->top.load(std::memory_order_acquire);
+    if ((b - t) > this->mask) {
+        return false;
+    }
+    this->items[b & this->mask].store(item, std::memory_order_relaxed);
+    this->bottom.store(b + 1, std::memory_order_release);
+    return true;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> TYPE*
+jobDeque<TYPE>::Pop() {
+    o_assert_dbg(this->IsValid());
+    const int64 b = this->bottom.load(std::memory_order_relaxed) - 1;
+    this->bottom.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64 t = this->top.load(std::memory_order_relaxed);
+    TYPE* item = nullptr;
+    if (t <= b) {
+        item = this->items[b & this->mask].load(std::memory_order_relaxed);
+        if (t == b) {
+            // last item, race against thieves
+            if (!this->top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                item = nullptr;
+            }
+            this->bottom.store(b + 1, std::memory_order_relaxed);
+        }
+    }
+    else {
+        // deque was empty
+        this->bottom.store(b + 1, std::memory_order_relaxed);
+    }
+    return item;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> TYPE*
+jobDeque<TYPE>::Steal() {
+    o_assert_dbg(this->IsValid());
+    int64 t = this->top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const int64 b = this->bottom.load(std::memory_order_acquire);
+    if (t < b) {
+        TYPE* item = this->items[t & this->mask].load(std::memory_order_relaxed);
+        if (this->top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            return item;
+        }
+    }
+    return nullptr;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> int32
+jobDeque<TYPE>::Size() const {
+    const int64 b = this->bottom.load(std::memory_order_relaxed);
+    const int64 t = this->top.load(std::memory_order_relaxed);
+    return b > t ? int32(b - t) : 0;
+}
+
+} // namespace _priv
+} // namespace Oryol
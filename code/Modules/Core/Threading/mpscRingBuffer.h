@@ -0,0 +1,187 @@
+#pragma once
+//------------------------------------------------------------------------------
+/*
+    @class Oryol::_priv::mpscRingBuffer
+    @ingroup _priv
+    @brief bounded lock-free multi-producer / single-consumer ring buffer
+
+    A fixed-capacity ring of elements where Enqueue() may be called
+    from any number of threads concurrently, and Dequeue() may only
+    be called from a single consumer thread. Each cell carries a
+    sequence number which tells producers and the consumer whether
+    the cell is free, being written, or ready to be read (this is
+    Dmitry Vyukov's bounded queue design, simplified for a single
+    consumer). Enqueue() and Dequeue() never block, they return false
+    if the ring is full or empty.
+
+    The capacity must be a power of 2, elements must be default-constructible
+    and move-assignable, and are moved in and out of the ring.
+*/
+#include "Core/Types.h"
+#include "Core/Config.h"
+#include "Core/Assertion.h"
+#include "Core/Memory/Memory.h"
+#include <atomic>
+#include <utility>
+
+namespace Oryol {
+namespace _priv {
+
+template<class TYPE> class mpscRingBuffer {
+public:
+    /// constructor
+    mpscRingBuffer();
+    /// destructor
+    ~mpscRingBuffer();
+
+    /// setup the ring with a power-of-2 capacity
+    void Setup(int32 capacity);
+    /// discard the ring (destroys any remaining elements)
+    void Discard();
+    /// return true if the ring has been setup
+    bool IsValid() const;
+    /// get the capacity of the ring
+    int32 Capacity() const;
+
+    /// move an element into the ring (any thread), return false if full
+    bool Enqueue(TYPE&& elm);
+    /// move an element out of the ring (consumer thread only), return false if empty
+    bool Dequeue(TYPE& outElm);
+    /// test if the ring is empty (only exact on consumer thread)
+    bool Empty() const;
+
+private:
+    static const int32 CacheLineSize = 64;
+
+    struct cell {
+        std::atomic<uint32> seq;
+        TYPE value;
+    };
+    cell* cells;
+    uint32 mask;
+    uint8 pad0[CacheLineSize];
+    std::atomic<uint32> enqueuePos;     // shared by all producers
+    uint8 pad1[CacheLineSize - sizeof(std::atomic<uint32>)];
+    uint32 dequeuePos;                  // only touched by consumer
+    uint8 pad2[CacheLineSize - sizeof(uint32)];
+};
+
+//------------------------------------------------------------------------------
+template<class TYPE>
+mpscRingBuffer<TYPE>::mpscRingBuffer() :
+cells(nullptr),
+mask(0),
+enqueuePos(0),
+dequeuePos(0) {
+    // empty
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE>
+mpscRingBuffer<TYPE>::~mpscRingBuffer() {
+    if (this->IsValid()) {
+        this->Discard();
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> void
+mpscRingBuffer<TYPE>::Setup(int32 capacity) {
+    o_assert(!this->IsValid());
+    o_assert((capacity >= 2) && (0 == (capacity & (capacity - 1))));
+
+    this->cells = (cell*) Memory::Alloc(capacity * sizeof(cell));
+    for (int32 i = 0; i < capacity; i++) {
+        new(&this->cells[i]) cell();
+        this->cells[i].seq.store(i, std::memory_order_relaxed);
+    }
+    this->mask = capacity - 1;
+    this->enqueuePos.store(0, std::memory_order_relaxed);
+    this->dequeuePos = 0;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> void
+mpscRingBuffer<TYPE>::Discard() {
+    o_assert(this->IsValid());
+    const int32 capacity = this->Capacity();
+    for (int32 i = 0; i < capacity; i++) {
+        this->cells[i].~cell();
+    }
+    Memory::Free(this->cells);
+    this->cells = nullptr;
+    this->mask = 0;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> bool
+mpscRingBuffer<TYPE>::IsValid() const {
+    return nullptr != this->cells;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> int32
+mpscRingBuffer<TYPE>::Capacity() const {
+    return this->IsValid() ? int32(this->mask + 1) : 0;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> bool
+mpscRingBuffer<TYPE>::Enqueue(TYPE&& elm) {
+    o_assert_dbg(this->IsValid());
+
+    cell* c = nullptr;
+    uint32 pos = this->enqueuePos.load(std::memory_order_relaxed);
+    for (;;) {
+        c = &this->cells[pos & this->mask];
+        const uint32 seq = c->seq.load(std::memory_order_acquire);
+        const int32 diff = int32(seq - pos);
+        if (0 == diff) {
+            // cell is free, try to claim it
+            if (this->enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        }
+        else if (diff < 0) {
+            // cell still holds an element from the previous lap, ring is full
+            return false;
+        }
+        else {
+            // another producer got here first
+            pos = this->enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+    c->value = std::move(elm);
+    c->seq.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> bool
+mpscRingBuffer<TYPE>::Dequeue(TYPE& outElm) {
+    o_assert_dbg(this->IsValid());
+
+    const uint32 pos = this->dequeuePos;
+    cell* c = &this->cells[pos & this->mask];
+    const uint32 seq = c->seq.load(std::memory_order_acquire);
+    if (int32(seq - (pos + 1)) < 0) {
+        // empty, or the producer hasn't finished writing the cell yet
+        return false;
+    }
+    outElm = std::move(c->value);
+    c->seq.store(pos + this->mask + 1, std::memory_order_release);
+    this->dequeuePos = pos + 1;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+template<class TYPE> bool
+mpscRingBuffer<TYPE>::Empty() const {
+    o_assert_dbg(this->IsValid());
+    const uint32 pos = this->dequeuePos;
+    const uint32 seq = this->cells[pos & this->mask].seq.load(std::memory_order_acquire);
+    return int32(seq - (pos + 1)) < 0;
+}
+
+} // namespace _priv
+} // namespace Oryol
@@ -0,0 +1,92 @@
+//------------------------------------------------------------------------------
+//  wakeupEvent.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "wakeupEvent.h"
+#if ORYOL_HAS_THREADS
+#if ORYOL_LINUX
+#include <ctime>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#else
+#include <chrono>
+#endif
+#endif
+#if ORYOL_WINDOWS
+#include <intrin.h>
+#endif
+
+namespace Oryol {
+namespace _priv {
+
+//------------------------------------------------------------------------------
+void
+wakeupEvent::Signal() {
+    // pairs with the fence in PrepareWait(), the caller's publish
+    // must be visible before we check for sleeping consumers
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if ((0 != this->waiting.load(std::memory_order_relaxed)) &&
+        (0 != this->waiting.exchange(0, std::memory_order_relaxed))) {
+        #if ORYOL_HAS_THREADS
+            #if ORYOL_LINUX
+            this->epoch.fetch_add(1, std::memory_order_release);
+            syscall(SYS_futex, (uint32*)&this->epoch, FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+            #else
+            {
+                std::lock_guard<std::mutex> lock(this->mutex);
+                this->epoch.fetch_add(1, std::memory_order_release);
+            }
+            this->condVar.notify_all();
+            #endif
+        #else
+        this->epoch.fetch_add(1, std::memory_order_release);
+        #endif
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+wakeupEvent::CommitWait(uint32 key, uint32 timeoutMilliSec) {
+    #if ORYOL_HAS_THREADS
+        #if ORYOL_LINUX
+        // NOTE: the futex syscall returns immediately if the epoch
+        // has already moved on since PrepareWait()
+        static_assert(sizeof(std::atomic<uint32>) == sizeof(uint32), "futex needs a plain 32-bit word");
+        if (0 != timeoutMilliSec) {
+            struct timespec ts;
+            ts.tv_sec = timeoutMilliSec / 1000;
+            ts.tv_nsec = (timeoutMilliSec % 1000) * 1000000;
+            syscall(SYS_futex, (uint32*)&this->epoch, FUTEX_WAIT_PRIVATE, key, &ts, nullptr, 0);
+        }
+        else {
+            syscall(SYS_futex, (uint32*)&this->epoch, FUTEX_WAIT_PRIVATE, key, nullptr, nullptr, 0);
+        }
+        #else
+        std::unique_lock<std::mutex> lock(this->mutex);
+        auto signalled = [this, key] { return this->epoch.load(std::memory_order_acquire) != key; };
+        if (0 != timeoutMilliSec) {
+            this->condVar.wait_for(lock, std::chrono::milliseconds(timeoutMilliSec), signalled);
+        }
+        else {
+            this->condVar.wait(lock, signalled);
+        }
+        #endif
+    #endif
+    this->waiting.store(0, std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+void
+wakeupEvent::Pause() {
+    #if ORYOL_WINDOWS
+    _mm_pause();
+    #elif (__i386__ || __x86_64__)
+    __builtin_ia32_pause();
+    #elif (__arm__ || __aarch64__)
+    __asm__ __volatile__("yield");
+    #endif
+}
+
+} // namespace _priv
+} // namespace Oryol
@@ -0,0 +1,92 @@
+#pragma once
+//------------------------------------------------------------------------------
+/*
+    @class Oryol::_priv::wakeupEvent
+    @ingroup _priv
+    @brief lightweight sleep/wakeup primitive for one consumer thread
+
+    Lets a consumer thread go to sleep until a producer signals that
+    new work is available, without taking a lock on the producer side
+    when the consumer is awake. The consumer spins for a short while
+    before actually going to sleep, on Linux sleeping happens on
+    a futex, on other platforms on a condition variable.
+
+    Waiting is split into 2 steps so that the consumer can re-check
+    its work queue after registering itself as waiter, this closes
+    the race where a producer signals between the check and the sleep:
+
+        uint32 key = event.PrepareWait();
+        if (queueIsEmpty) {
+            event.CommitWait(key, timeoutMs);
+        }
+        else {
+            event.CancelWait();
+        }
+
+    Producers call Signal() after publishing work, this is a fence and
+    a relaxed load when the consumer isn't sleeping, and only the first
+    Signal() after the consumer went to sleep pays for the actual wakeup.
+*/
+#include "Core/Types.h"
+#include "Core/Config.h"
+#include <atomic>
+#if ORYOL_HAS_THREADS && !ORYOL_LINUX
+#include <mutex>
+#include <condition_variable>
+#endif
+
+namespace Oryol {
+namespace _priv {
+
+class wakeupEvent {
+public:
+    /// constructor
+    wakeupEvent();
+
+    /// wake up the consumer if it is sleeping (any thread)
+    void Signal();
+    /// register the consumer as waiter, return key for CommitWait()
+    uint32 PrepareWait();
+    /// sleep until signalled or timeout (0 means infinite), must follow PrepareWait()
+    void CommitWait(uint32 key, uint32 timeoutMilliSec);
+    /// unregister the consumer as waiter, must follow PrepareWait()
+    void CancelWait();
+    /// spin-wait hint for busy loops
+    static void Pause();
+
+private:
+    std::atomic<uint32> epoch;
+    std::atomic<int32> waiting;
+    #if ORYOL_HAS_THREADS && !ORYOL_LINUX
+    std::mutex mutex;
+    std::condition_variable condVar;
+    #endif
+};
+
+//------------------------------------------------------------------------------
+inline
+wakeupEvent::wakeupEvent() :
+epoch(0),
+waiting(0) {
+    // empty
+}
+
+//------------------------------------------------------------------------------
+inline uint32
+wakeupEvent::PrepareWait() {
+    const uint32 key = this->epoch.load(std::memory_order_acquire);
+    this->waiting.store(1, std::memory_order_relaxed);
+    // pairs with the fence in Signal(), the caller's re-check of its
+    // work queue must not be reordered before the waiter registration
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    return key;
+}
+
+//------------------------------------------------------------------------------
+inline void
+wakeupEvent::CancelWait() {
+    this->waiting.store(0, std::memory_order_relaxed);
+}
+
+} // namespace _priv
+} // namespace Oryol
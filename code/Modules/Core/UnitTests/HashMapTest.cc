@@ -0,0 +1,248 @@
+//------------------------------------------------------------------------------
+//  HashMapTest.cc
+//  Test HashMap functionality and performance.
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "UnitTest++/src/UnitTest++.h"
+#include "Core/Containers/HashMap.h"
+#include "Core/Containers/Map.h"
+#include "Core/Containers/ArrayMap.h"
+#include "Core/Containers/HashSet.h"
+#include "Core/Log.h"
+#include <chrono>
+
+using namespace Oryol;
+
+// a deliberately bad hash function, all keys collide
+struct BadHasher {
+    uint32 operator()(int32 val) const {
+        return val & 1;
+    };
+};
+
+struct IntIdentityHasher {
+    uint32 operator()(int32 val) const {
+        return val;
+    };
+};
+
+//------------------------------------------------------------------------------
+static uint32
+nextRandom(uint32& x) {
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return x;
+}
+
+//------------------------------------------------------------------------------
+TEST(HashMapTest) {
+
+    HashMap<int32, int32> map;
+    CHECK(map.Size() == 0);
+    CHECK(map.Empty());
+    CHECK(map.Capacity() == 0);
+    CHECK(!map.Contains(1));
+    CHECK(map.FindIndex(1) == InvalidIndex);
+    map.Add(0, 0);
+    map.Add(3, 3);
+    map.Add(8, 8);
+    map.Add(6, 6);
+    map.Add(KeyValuePair<int32, int32>(4, 4));
+    CHECK(map.Size() == 5);
+    CHECK(!map.Empty());
+    CHECK(map.Capacity() >= 5);
+    CHECK(map.Contains(0));
+    CHECK(map.Contains(3));
+    CHECK(map.Contains(8));
+    CHECK(map.Contains(6));
+    CHECK(map.Contains(4));
+    CHECK(!map.Contains(1));
+    CHECK(map[8] == 8);
+    map[8] = 80;
+    CHECK(map[8] == 80);
+    CHECK(!map.AddUnique(3, 30));
+    CHECK(map[3] == 3);
+    CHECK(map.AddUnique(1, 1));
+
+    // elements are stored in the order they have been added
+    CHECK(map.KeyAtIndex(0) == 0);
+    CHECK(map.KeyAtIndex(1) == 3);
+    CHECK(map.ValueAtIndex(2) == 80);
+    CHECK(map.FindIndex(6) == 3);
+    int32 sum = 0;
+    for (const auto& kvp : map) {
+        sum += kvp.Value();
+    }
+    CHECK(sum == 0 + 3 + 80 + 6 + 4 + 1);
+
+    // erase swaps in the last element
+    map.Erase(3);
+    CHECK(map.Size() == 5);
+    CHECK(!map.Contains(3));
+    CHECK(map.KeyAtIndex(1) == 1);
+    CHECK(map.FindIndex(1) == 1);
+    map.Erase(3);
+    CHECK(map.Size() == 5);
+    map.EraseIndex(map.FindIndex(0));
+    CHECK(!map.Contains(0));
+    CHECK(map.Size() == 4);
+
+    // copy and move
+    HashMap<int32, int32> map1(map);
+    CHECK(map1.Size() == 4);
+    CHECK(map1[8] == 80);
+    HashMap<int32, int32> map2(std::move(map1));
+    CHECK(map1.Empty());
+    CHECK(!map1.Contains(8));
+    CHECK(map2.Size() == 4);
+    CHECK(map2[8] == 80);
+    map1 = map2;
+    CHECK(map1.Size() == 4);
+    CHECK(map1.Contains(6));
+    map2.Clear();
+    CHECK(map2.Empty());
+    CHECK(!map2.Contains(6));
+    CHECK(map2.Capacity() > 0);
+    map2.Add(6, 7);
+    CHECK(map2[6] == 7);
+
+    // lots of colliding keys must still work
+    HashMap<int32, int32, BadHasher> badMap;
+    for (int32 i = 0; i < 40; i++) {
+        badMap.Add(i, i * 2);
+    }
+    bool allFound = true;
+    for (int32 i = 0; i < 40; i++) {
+        allFound &= badMap[i] == i * 2;
+    }
+    CHECK(allFound);
+    badMap.Erase(10);
+    CHECK(!badMap.Contains(10));
+    CHECK(badMap.Size() == 39);
+}
+
+//------------------------------------------------------------------------------
+TEST(HashMapRandomizedTest) {
+
+    // compare against Map with random adds and erases, this will
+    // go through many incremental rehashes
+    HashMap<int32, int32, IntIdentityHasher> hashMap;
+    Map<int32, int32> map;
+    uint32 rnd = 12345;
+    bool rehashed = false;
+    bool allOk = true;
+    for (int32 i = 0; i < 200000; i++) {
+        const int32 key = nextRandom(rnd) % 20000;
+        const uint32 op = nextRandom(rnd) % 3;
+        if (op < 2) {
+            const bool added = hashMap.AddUnique(key, i);
+            allOk &= (added == map.AddUnique(key, i));
+        }
+        else {
+            hashMap.Erase(key);
+            map.Erase(key);
+        }
+        rehashed |= hashMap.IsRehashing();
+        if (0 == (i % 1000)) {
+            allOk &= (hashMap.Size() == map.Size());
+            for (const auto& kvp : map) {
+                const int32 index = hashMap.FindIndex(kvp.Key());
+                allOk &= (InvalidIndex != index) && (hashMap.ValueAtIndex(index) == kvp.Value());
+            }
+        }
+    }
+    CHECK(rehashed);
+    CHECK(allOk);
+    CHECK(hashMap.Size() == map.Size());
+    for (const auto& kvp : hashMap) {
+        CHECK(map[kvp.Key()] == kvp.Value());
+    }
+}
+
+//------------------------------------------------------------------------------
+TEST(HashMapBenchmark) {
+    using namespace std::chrono;
+
+    const int32 sizes[] = { 1000, 10000, 100000, 1000000 };
+    for (int32 num : sizes) {
+
+        // random keys in random order
+        Array<int32> keys;
+        keys.Reserve(num);
+        uint32 rnd = 0x1234567;
+        for (int32 i = 0; i < num; i++) {
+            keys.Add(int32(nextRandom(rnd) & 0x7FFFFFFF));
+        }
+
+        // HashMap
+        HashMap<int32, int32, IntIdentityHasher> hashMap;
+        auto start = high_resolution_clock::now();
+        for (int32 i = 0; i < num; i++) {
+            hashMap.AddUnique(keys[i], i);
+        }
+        duration<double> addDur = high_resolution_clock::now() - start;
+        start = high_resolution_clock::now();
+        int32 found = 0;
+        for (int32 i = 0; i < num; i++) {
+            found += hashMap.Contains(keys[i]) ? 1 : 0;
+        }
+        duration<double> findDur = high_resolution_clock::now() - start;
+        Log::Info("%8d elements, HashMap:  add %8.2f ns, find %8.2f ns (%d found)\n",
+            num, addDur.count() * 1e9 / num, findDur.count() * 1e9 / num, found);
+
+        // Map (sorted array, filled in bulk-mode to avoid O(N^2) insertion)
+        Map<int32, int32> map;
+        start = high_resolution_clock::now();
+        map.BeginBulk();
+        for (int32 i = 0; i < num; i++) {
+            map.AddBulk(keys[i], i);
+        }
+        map.EndBulk();
+        addDur = high_resolution_clock::now() - start;
+        start = high_resolution_clock::now();
+        found = 0;
+        for (int32 i = 0; i < num; i++) {
+            found += map.Contains(keys[i]) ? 1 : 0;
+        }
+        findDur = high_resolution_clock::now() - start;
+        Log::Info("%8d elements, Map:      add %8.2f ns, find %8.2f ns (%d found)\n",
+            num, addDur.count() * 1e9 / num, findDur.count() * 1e9 / num, found);
+
+        // ArrayMap (sorted index map, no bulk-mode, insertion is O(N^2))
+        if (num <= 10000) {
+            ArrayMap<int32, int32> arrayMap;
+            start = high_resolution_clock::now();
+            for (int32 i = 0; i < num; i++) {
+                arrayMap.Add(keys[i], i);
+            }
+            addDur = high_resolution_clock::now() - start;
+            start = high_resolution_clock::now();
+            found = 0;
+            for (int32 i = 0; i < num; i++) {
+                found += arrayMap.Contains(keys[i]) ? 1 : 0;
+            }
+            findDur = high_resolution_clock::now() - start;
+            Log::Info("%8d elements, ArrayMap: add %8.2f ns, find %8.2f ns (%d found)\n",
+                num, addDur.count() * 1e9 / num, findDur.count() * 1e9 / num, found);
+        }
+
+        // HashSet (fixed number of sorted buckets)
+        if (num <= 100000) {
+            HashSet<int32, IntIdentityHasher, 1024> hashSet;
+            start = high_resolution_clock::now();
+            for (int32 i = 0; i < num; i++) {
+                hashSet.Add(keys[i]);
+            }
+            addDur = high_resolution_clock::now() - start;
+            start = high_resolution_clock::now();
+            found = 0;
+            for (int32 i = 0; i < num; i++) {
+                found += hashSet.Contains(keys[i]) ? 1 : 0;
+            }
+            findDur = high_resolution_clock::now() - start;
+            Log::Info("%8d elements, HashSet:  add %8.2f ns, find %8.2f ns (%d found)\n",
+                num, addDur.count() * 1e9 / num, findDur.count() * 1e9 / num, found);
+        }
+    }
+}
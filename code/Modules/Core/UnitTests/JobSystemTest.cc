@@ -0,0 +1,164 @@
+//------------------------------------------------------------------------------
+//  JobSystemTest.cc
+//  Test JobSystem functionality and scaling.
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "UnitTest++/src/UnitTest++.h"
+#include "Core/Log.h"
+#include "Core/Threading/JobSystem.h"
+#include "Core/Threading/jobDeque.h"
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+using namespace Oryol;
+using namespace Oryol::_priv;
+
+//------------------------------------------------------------------------------
+TEST(JobDequeTest) {
+    int values[8] = { 0, 1, 2, 3, 4, 5, 6, 7 };
+    jobDeque<int> deque;
+    deque.Setup(4);
+    CHECK(deque.Size() == 0);
+    CHECK(deque.Pop() == nullptr);
+    CHECK(deque.Steal() == nullptr);
+    CHECK(deque.Push(&values[0]));
+    CHECK(deque.Push(&values[1]));
+    CHECK(deque.Push(&values[2]));
+    CHECK(deque.Push(&values[3]));
+    CHECK(!deque.Push(&values[4]));
+    CHECK(deque.Size() == 4);
+    // owner pops LIFO, thieves steal FIFO
+    CHECK(deque.Pop() == &values[3]);
+    CHECK(deque.Steal() == &values[0]);
+    CHECK(deque.Push(&values[5]));
+    CHECK(deque.Steal() == &values[1]);
+    CHECK(deque.Pop() == &values[5]);
+    CHECK(deque.Pop() == &values[2]);
+    CHECK(deque.Pop() == nullptr);
+    CHECK(deque.Size() == 0);
+    deque.Discard();
+}
+
+//------------------------------------------------------------------------------
+TEST(JobSystemTest) {
+    JobSetup setup;
+    setup.NumWorkers = 3;
+    JobSystem::Setup(setup);
+    CHECK(JobSystem::IsValid());
+    CHECK(JobSystem::NumWorkers() == 3);
+
+    // simple jobs with a counter
+    std::atomic<int32> sum(0);
+    JobCounter counter;
+    for (int32 i = 0; i < 1000; i++) {
+        JobSystem::Run([&sum, i] { sum += i; }, &counter);
+    }
+    JobSystem::Wait(counter);
+    CHECK(counter.Done());
+    CHECK(sum == 499500);
+
+    // jobs spawning jobs
+    sum = 0;
+    for (int32 i = 0; i < 100; i++) {
+        JobSystem::Run([&sum, &counter] {
+            for (int32 j = 0; j < 10; j++) {
+                JobSystem::Run([&sum] { sum++; }, &counter);
+            }
+        }, &counter);
+    }
+    JobSystem::Wait(counter);
+    CHECK(sum == 1000);
+
+    // parallel-for, each index must be visited exactly once
+    const int32 num = 100000;
+    static uint8 visited[num];
+    Memory::Clear(visited, sizeof(visited));
+    JobSystem::ParallelFor(num, 0, [](int32 begin, int32 end) {
+        for (int32 i = begin; i < end; i++) {
+            visited[i]++;
+        }
+    });
+    bool allVisitedOnce = true;
+    for (int32 i = 0; i < num; i++) {
+        if (1 != visited[i]) {
+            allVisitedOnce = false;
+        }
+    }
+    CHECK(allVisitedOnce);
+
+    // a small task graph: a -> (b, c) -> d, submitted in dependency order
+    int32 a = 0, b = 0, c = 0, d = 0;
+    JobCounter aDone, bcDone, dDone;
+    JobSystem::Run([&] { std::this_thread::sleep_for(std::chrono::milliseconds(10)); a = 1; }, &aDone);
+    JobSystem::RunAfter(aDone, [&] { b = a * 2; }, &bcDone);
+    JobSystem::RunAfter(aDone, [&] { c = a * 3; }, &bcDone);
+    JobSystem::RunAfter(bcDone, [&] { d = b + c; }, &dDone);
+    JobSystem::Wait(dDone);
+    CHECK(a == 1);
+    CHECK(b == 2);
+    CHECK(c == 3);
+    CHECK(d == 5);
+
+    // fire-and-forget jobs are finished by Drain() or Discard()
+    sum = 0;
+    for (int32 i = 0; i < 100; i++) {
+        JobSystem::Run([&sum] { sum++; });
+    }
+    JobSystem::Discard();
+    CHECK(!JobSystem::IsValid());
+    CHECK(sum == 100);
+}
+
+//------------------------------------------------------------------------------
+TEST(JobSystemScalingBenchmark) {
+
+    // some CPU-heavy per-element work
+    const int32 num = 1<<20;
+    static float32 values[num];
+    auto calc = [](int32 i) -> float32 {
+        float32 v = float32(i);
+        for (int32 k = 0; k < 16; k++) {
+            v = std::sqrt(v * v + 1.0f);
+        }
+        return v;
+    };
+    auto work = [calc](int32 begin, int32 end) {
+        for (int32 i = begin; i < end; i++) {
+            values[i] = calc(i);
+        }
+    };
+
+    int32 maxWorkers = std::thread::hardware_concurrency();
+    if (maxWorkers < 2) {
+        maxWorkers = 2;
+    }
+    for (int32 numWorkers = 1; numWorkers <= maxWorkers; numWorkers++) {
+        JobSetup setup;
+        setup.NumWorkers = numWorkers;
+        JobSystem::Setup(setup);
+        std::chrono::time_point<std::chrono::high_resolution_clock> start = std::chrono::high_resolution_clock::now();
+        for (int32 run = 0; run < 4; run++) {
+            JobSystem::ParallelFor(num, 1024, work);
+        }
+        std::chrono::duration<double> dur = std::chrono::high_resolution_clock::now() - start;
+        Log::Info("JobSystem: ParallelFor(%d) x4 with %d workers: %f sec\n", num, numWorkers, dur.count());
+        for (int32 i = 0; i < num; i += 997) {
+            CHECK_CLOSE(calc(i), values[i], 0.001f);
+        }
+
+        // many small jobs
+        start = std::chrono::high_resolution_clock::now();
+        std::atomic<int32> count(0);
+        JobCounter counter;
+        for (int32 i = 0; i < 100000; i++) {
+            JobSystem::Run([&count] { count++; }, &counter);
+        }
+        JobSystem::Wait(counter);
+        CHECK(count == 100000);
+        dur = std::chrono::high_resolution_clock::now() - start;
+        Log::Info("JobSystem: 100000 small jobs with %d workers: %f sec\n", numWorkers, dur.count());
+        JobSystem::Discard();
+    }
+}
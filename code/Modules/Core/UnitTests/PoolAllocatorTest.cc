@@ -9,6 +9,9 @@
 #include "Core/RefCounted.h"
 #include "Core/Ptr.h"
 #include "Core/Memory/poolAllocator.h"
+#include "Core/Containers/Array.h"
+#include <chrono>
+#include <thread>
 
 using namespace Oryol;
 using namespace Oryol::_priv;
@@ -28,3 +31,98 @@ TEST(PoolAllocator) {
     CHECK(obj == obj1);
     allocatorOne.Destroy(obj1);
 }
+
+// more elements than the old 256x256 puddle limit
+TEST(PoolAllocatorGrowth) {
+
+    struct elm {
+        int32 value = 0;
+    };
+    poolAllocator<elm> allocator;
+    const int32 num = 100000;
+    Array<elm*> elms;
+    elms.Reserve(num);
+    for (int32 i = 0; i < num; i++) {
+        elm* e = allocator.Create();
+        e->value = i;
+        elms.Add(e);
+    }
+    bool allValid = true;
+    for (int32 i = 0; i < num; i++) {
+        allValid &= (elms[i]->value == i);
+    }
+    CHECK(allValid);
+    for (elm* e : elms) {
+        allocator.Destroy(e);
+    }
+
+    // free on other threads than the allocating thread
+    elms.Clear();
+    for (int32 i = 0; i < num; i++) {
+        elms.Add(allocator.Create());
+    }
+    std::thread t0([&elms, &allocator] {
+        for (int32 i = 0; i < elms.Size(); i += 2) {
+            allocator.Destroy(elms[i]);
+        }
+    });
+    std::thread t1([&elms, &allocator] {
+        for (int32 i = 1; i < elms.Size(); i += 2) {
+            allocator.Destroy(elms[i]);
+        }
+    });
+    t0.join();
+    t1.join();
+    elms.Clear();
+    for (int32 i = 0; i < num; i++) {
+        elms.Add(allocator.Create());
+    }
+    for (elm* e : elms) {
+        allocator.Destroy(e);
+    }
+}
+
+// multi-threaded alloc/free benchmark, pool allocator vs Memory::New/Delete
+TEST(PoolAllocatorMultiThreadBenchmark) {
+
+    struct elm {
+        int32 value[4];
+    };
+    const int32 numRounds = 4000;
+    const int32 numLive = 64;
+    poolAllocator<elm> allocator;
+    using namespace std::chrono;
+
+    const int32 maxThreads = 8;
+    for (int32 numThreads = 1; numThreads <= maxThreads; numThreads *= 2) {
+        for (int32 usePool = 0; usePool < 2; usePool++) {
+            auto start = high_resolution_clock::now();
+            std::thread threads[maxThreads];
+            for (int32 t = 0; t < numThreads; t++) {
+                threads[t] = std::thread([&allocator, usePool, numRounds, numLive] {
+                    elm* live[numLive];
+                    for (int32 round = 0; round < numRounds; round++) {
+                        for (int32 i = 0; i < numLive; i++) {
+                            live[i] = usePool ? allocator.Create() : Memory::New<elm>();
+                        }
+                        for (int32 i = 0; i < numLive; i++) {
+                            if (usePool) {
+                                allocator.Destroy(live[i]);
+                            }
+                            else {
+                                Memory::Delete(live[i]);
+                            }
+                        }
+                    }
+                });
+            }
+            for (int32 t = 0; t < numThreads; t++) {
+                threads[t].join();
+            }
+            duration<double> dur = high_resolution_clock::now() - start;
+            const double numOps = double(numThreads) * numRounds * numLive;
+            Log::Info("%s, %d threads: %.2f ns per Create/Destroy pair\n",
+                usePool ? "poolAllocator" : "Memory::New/Delete", numThreads, (dur.count() * 1e9) / numOps);
+        }
+    }
+}
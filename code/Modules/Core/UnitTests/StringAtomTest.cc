@@ -7,10 +7,13 @@
 #include "Core/String/StringAtom.h"
 #include "Core/String/String.h"
 #include "Core/Core.h"
+#include "Core/Containers/Array.h"
+#include "Core/Containers/StaticArray.h"
 
 #include <cstring>
 #include <thread>
 #include <array>
+#include <cstdio>
 
 using namespace std;
 using namespace Oryol;
@@ -56,15 +59,15 @@ TEST(StringAtomSingleThreaded) {
 }
 
 #if ORYOL_HAS_THREADS
-// must use reference, the copy would fail since there is no thread-local
-// string-atom table yet
 static void threadFunc(const StringAtom& a0) {
     
     Oryol::Core::EnterThread();
     
-    // transfer into a thread-local string atom
+    // string atoms are global, copies and new atoms share the same string
     StringAtom a1(a0);
-    StringAtom a2(a0);
+    StringAtom a2("BLOB");
+    CHECK(a1.AsCStr() == a0.AsCStr());
+    CHECK(a2.AsCStr() == a0.AsCStr());
     CHECK(a0 == a1);
     CHECK(a1 == a2);
     CHECK(a1.AsString() == "BLOB");
@@ -109,4 +112,60 @@ TEST(StringAtomPerformance) {
         chrono::duration<double> dur = end - start;
         Log::Info("run %d: %dx StringAtoms created: %f sec\n", i, numStringAtoms, dur.count());
     }
-}
\ No newline at end of file
+}
+#if ORYOL_HAS_THREADS
+// test interning of many unique strings on several threads, and
+// comparing string atoms created on different threads
+TEST(StringAtomMultiThreadedPerformance) {
+
+    const int32 numStrings = 100000;
+    const int32 numThreads = 4;
+    Array<String> strings;
+    strings.Reserve(numStrings);
+    char buf[64];
+    for (int32 i = 0; i < numStrings; i++) {
+        std::snprintf(buf, sizeof(buf), "res:textures/level%d/tex_%d.dds", i & 7, i);
+        strings.Add(String(buf));
+    }
+
+    // each thread interns all strings twice (cold and warm)
+    StaticArray<Array<StringAtom>, numThreads> atoms;
+    double coldTime[numThreads], warmTime[numThreads];
+    std::thread threads[numThreads];
+    for (int32 t = 0; t < numThreads; t++) {
+        threads[t] = std::thread([&strings, &atoms, &coldTime, &warmTime, t] {
+            Array<StringAtom>& threadAtoms = atoms[t];
+            threadAtoms.Reserve(strings.Size());
+            auto start = chrono::high_resolution_clock::now();
+            for (const String& str : strings) {
+                threadAtoms.Add(StringAtom(str.AsCStr()));
+            }
+            chrono::duration<double> dur = chrono::high_resolution_clock::now() - start;
+            coldTime[t] = dur.count();
+            start = chrono::high_resolution_clock::now();
+            for (const String& str : strings) {
+                StringAtom atom(str.AsCStr());
+            }
+            dur = chrono::high_resolution_clock::now() - start;
+            warmTime[t] = dur.count();
+        });
+    }
+    for (int32 t = 0; t < numThreads; t++) {
+        threads[t].join();
+        Log::Info("thread %d: %d StringAtoms, cold: %f sec, warm: %f sec\n", t, numStrings, coldTime[t], warmTime[t]);
+    }
+
+    // compare string atoms created on different threads
+    bool allEqual = true;
+    auto start = chrono::high_resolution_clock::now();
+    for (int32 t = 1; t < numThreads; t++) {
+        for (int32 i = 0; i < numStrings; i++) {
+            allEqual &= (atoms[0][i] == atoms[t][i]);
+            allEqual &= !(atoms[0][i] != atoms[t][i]);
+        }
+    }
+    chrono::duration<double> dur = chrono::high_resolution_clock::now() - start;
+    CHECK(allEqual);
+    Log::Info("%d cross-thread StringAtom compares: %f sec\n", (numThreads - 1) * numStrings * 2, dur.count());
+}
+#endif
@@ -200,7 +200,7 @@ debugTextRenderer::setupTextMesh() {
         .Add(VertexAttr::Position, VertexFormat::UByte4)
         .Add(VertexAttr::Color0, VertexFormat::UByte4N);
     o_assert(sizeof(this->vertexData) == maxNumVerts * this->vertexLayout.ByteSize());
-    MeshSetup setup = MeshSetup::Empty(maxNumVerts, Usage::Stream);
+    MeshSetup setup = MeshSetup::Streamed(maxNumVerts);
     setup.Layout = this->vertexLayout;
     this->textMesh = Gfx::Resource().Create(setup);
     o_assert(this->textMesh.IsValid());
@@ -6,7 +6,8 @@
 */
 #include "Core/Types.h"
 #include "Core/Assertion.h"
-#if ORYOL_OPENGL
+#if (ORYOL_OPENGL || ORYOL_GFX_NULL)
+// the null backend uses the GL enum values as opaque constants
 #include "Gfx/gl/glEnums.h"
 #endif
 
@@ -18,7 +19,7 @@ namespace Oryol {
     @ingroup Gfx
     @brief selects 16- or 32-bit indices
 */
-#if ORYOL_OPENGL
+#if (ORYOL_OPENGL || ORYOL_GFX_NULL)
 class IndexType : public _priv::glIndexType {
 #endif
 public:
@@ -299,7 +300,7 @@ public:
     @ingroup Gfx
     @brief primitive type enum (triangle strips, lists, etc...)
 */
-#if ORYOL_OPENGL
+#if (ORYOL_OPENGL || ORYOL_GFX_NULL)
 class PrimitiveType : public _priv::glPrimitiveType { };
 #endif
 
@@ -334,7 +335,7 @@ public:
     @ingroup Gfx
     @brief shader types (vertex shader, fragment shader)
 */
-#if ORYOL_OPENGL
+#if (ORYOL_OPENGL || ORYOL_GFX_NULL)
 class ShaderType : public _priv::glShaderType { };
 #endif
 
@@ -344,7 +345,7 @@ class ShaderType : public _priv::glShaderType { };
     @ingroup Gfx
     @brief texture sampling filter mode
 */
-#if ORYOL_OPENGL
+#if (ORYOL_OPENGL || ORYOL_GFX_NULL)
 class TextureFilterMode  : public _priv::glTextureFilterMode { };
 #endif
    
@@ -354,7 +355,7 @@ class TextureFilterMode  : public _priv::glTextureFilterMode { };
     @ingroup Gfx
     @brief texture type (2D, 3D, Cube)
 */
-#if ORYOL_OPENGL
+#if (ORYOL_OPENGL || ORYOL_GFX_NULL)
 class TextureType : public _priv::glTextureType { };
 #endif
 
@@ -364,7 +365,7 @@ class TextureType : public _priv::glTextureType { };
     @ingroup Gfx
     @brief texture coordinate wrapping modes
 */
-#if ORYOL_OPENGL
+#if (ORYOL_OPENGL || ORYOL_GFX_NULL)
 class TextureWrapMode : public _priv::glTextureWrapMode { };
 #endif
 
@@ -374,7 +375,7 @@ class TextureWrapMode : public _priv::glTextureWrapMode { };
     @ingroup Gfx
     @brief graphics resource usage types
 */
-#if ORYOL_OPENGL
+#if (ORYOL_OPENGL || ORYOL_GFX_NULL)
 class Usage : public _priv::glUsage { };
 #endif
 
@@ -650,4 +651,57 @@ public:
     };
 };
 
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::UniformType
+    @ingroup Gfx
+    @brief shader uniform value types
+*/
+class UniformType {
+public:
+    /// type enum
+    enum Code {
+        Float = 0,      ///< float32
+        Vec2,           ///< glm::vec2
+        Vec3,           ///< glm::vec3
+        Vec4,           ///< glm::vec4
+        Int,            ///< int32
+        IVec2,          ///< glm::ivec2
+        IVec3,          ///< glm::ivec3
+        IVec4,          ///< glm::ivec4
+        Mat2,           ///< glm::mat2
+        Mat3,           ///< glm::mat3
+        Mat4,           ///< glm::mat4
+
+        NumUniformTypes,
+        InvalidUniformType,
+    };
+
+    /// get the byte size of a uniform type (CPU side, without padding)
+    static int32 ByteSize(Code c) {
+        switch (c) {
+            case Float:
+            case Int:
+                return 4;
+            case Vec2:
+            case IVec2:
+                return 8;
+            case Vec3:
+            case IVec3:
+                return 12;
+            case Vec4:
+            case IVec4:
+            case Mat2:
+                return 16;
+            case Mat3:
+                return 36;
+            case Mat4:
+                return 64;
+            default:
+                o_error("UniformType::ByteSize() called with invalid type!\n");
+                return 0;
+        }
+    }
+};
+
 } // namespace Oryol
@@ -0,0 +1,209 @@
+//------------------------------------------------------------------------------
+//  GfxCommandBuffer.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "GfxCommandBuffer.h"
+
+namespace Oryol {
+
+using namespace _priv;
+
+//------------------------------------------------------------------------------
+GfxCommandBuffer::GfxCommandBuffer() :
+buffer(nullptr),
+size(0),
+capacity(0),
+numCommands(0),
+numDraws(0) {
+    // empty
+}
+
+//------------------------------------------------------------------------------
+GfxCommandBuffer::GfxCommandBuffer(GfxCommandBuffer&& rhs) :
+buffer(rhs.buffer),
+size(rhs.size),
+capacity(rhs.capacity),
+numCommands(rhs.numCommands),
+numDraws(rhs.numDraws) {
+    rhs.buffer = nullptr;
+    rhs.size = 0;
+    rhs.capacity = 0;
+    rhs.numCommands = 0;
+    rhs.numDraws = 0;
+}
+
+//------------------------------------------------------------------------------
+GfxCommandBuffer::~GfxCommandBuffer() {
+    if (this->buffer) {
+        Memory::Free(this->buffer);
+        this->buffer = nullptr;
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+GfxCommandBuffer::operator=(GfxCommandBuffer&& rhs) {
+    if (this != &rhs) {
+        if (this->buffer) {
+            Memory::Free(this->buffer);
+        }
+        this->buffer = rhs.buffer;
+        this->size = rhs.size;
+        this->capacity = rhs.capacity;
+        this->numCommands = rhs.numCommands;
+        this->numDraws = rhs.numDraws;
+        rhs.buffer = nullptr;
+        rhs.size = 0;
+        rhs.capacity = 0;
+        rhs.numCommands = 0;
+        rhs.numDraws = 0;
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+GfxCommandBuffer::Reserve(int32 numBytes) {
+    if ((this->size + numBytes) > this->capacity) {
+        this->grow(numBytes);
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+GfxCommandBuffer::grow(int32 numBytes) {
+    // grow by at least 50%, but start with a reasonable minimum
+    int32 newCapacity = this->capacity + (this->capacity >> 1);
+    if (newCapacity < 4096) {
+        newCapacity = 4096;
+    }
+    if (newCapacity < (this->size + numBytes)) {
+        newCapacity = Memory::RoundUp(this->size + numBytes, 4096);
+    }
+    this->buffer = (uint8*) Memory::ReAlloc(this->buffer, newCapacity);
+    this->capacity = newCapacity;
+}
+
+//------------------------------------------------------------------------------
+void
+GfxCommandBuffer::Reset() {
+    this->size = 0;
+    this->numCommands = 0;
+    this->numDraws = 0;
+}
+
+//------------------------------------------------------------------------------
+/**
+ Appends the recorded commands of another command buffer, this is
+ used to merge command buffers which have been recorded in parallel
+ into a single buffer.
+*/
+void
+GfxCommandBuffer::Append(const GfxCommandBuffer& other) {
+    o_assert_dbg(&other != this);
+    if (other.size > 0) {
+        this->Reserve(other.size);
+        Memory::Copy(other.buffer, this->buffer + this->size, other.size);
+        this->size += other.size;
+        this->numCommands += other.numCommands;
+        this->numDraws += other.numDraws;
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+GfxCommandBuffer::recordId(gfxCmd::Code code, int32 arg0, const Id& id) {
+    uint8* payload = this->alloc(code, 0, arg0, 0, sizeof(uint64));
+    *(uint64*)payload = id.Value;
+}
+
+//------------------------------------------------------------------------------
+void
+GfxCommandBuffer::ApplyDefaultRenderTarget() {
+    this->alloc(gfxCmd::ApplyDefaultRenderTarget, 0, 0, 0, 0);
+}
+
+//------------------------------------------------------------------------------
+void
+GfxCommandBuffer::ApplyOffscreenRenderTarget(const Id& id) {
+    this->recordId(gfxCmd::ApplyOffscreenRenderTarget, 0, id);
+}
+
+//------------------------------------------------------------------------------
+void
+GfxCommandBuffer::ApplyViewPort(int32 x, int32 y, int32 width, int32 height) {
+    gfxCmd::rect* r = (gfxCmd::rect*) this->alloc(gfxCmd::ApplyViewPort, 0, 0, 0, sizeof(gfxCmd::rect));
+    r->X = x;
+    r->Y = y;
+    r->Width = width;
+    r->Height = height;
+}
+
+//------------------------------------------------------------------------------
+void
+GfxCommandBuffer::ApplyScissorRect(int32 x, int32 y, int32 width, int32 height) {
+    gfxCmd::rect* r = (gfxCmd::rect*) this->alloc(gfxCmd::ApplyScissorRect, 0, 0, 0, sizeof(gfxCmd::rect));
+    r->X = x;
+    r->Y = y;
+    r->Width = width;
+    r->Height = height;
+}
+
+//------------------------------------------------------------------------------
+void
+GfxCommandBuffer::ApplyBlendColor(const glm::vec4& blendColor) {
+    float32* c = (float32*) this->alloc(gfxCmd::ApplyBlendColor, 0, 0, 0, 4 * sizeof(float32));
+    c[0] = blendColor.x;
+    c[1] = blendColor.y;
+    c[2] = blendColor.z;
+    c[3] = blendColor.w;
+}
+
+//------------------------------------------------------------------------------
+void
+GfxCommandBuffer::ApplyDrawState(const Id& id) {
+    this->recordId(gfxCmd::ApplyDrawState, 0, id);
+}
+
+//------------------------------------------------------------------------------
+void
+GfxCommandBuffer::UpdateVertices(const Id& id, int32 numBytes, const void* data) {
+    o_assert_dbg(data && (numBytes > 0));
+    uint8* payload = this->alloc(gfxCmd::UpdateVertices, 0, 0, numBytes, sizeof(uint64) + numBytes);
+    *(uint64*)payload = id.Value;
+    Memory::Copy(data, payload + sizeof(uint64), numBytes);
+}
+
+//------------------------------------------------------------------------------
+void
+GfxCommandBuffer::Clear(PixelChannel::Mask channels, const glm::vec4& color, float32 depth, uint8 stencil) {
+    gfxCmd::clear* c = (gfxCmd::clear*) this->alloc(gfxCmd::Clear, 0, 0, 0, sizeof(gfxCmd::clear));
+    c->Color[0] = color.x;
+    c->Color[1] = color.y;
+    c->Color[2] = color.z;
+    c->Color[3] = color.w;
+    c->Depth = depth;
+    c->Channels = channels;
+    c->Stencil = stencil;
+}
+
+//------------------------------------------------------------------------------
+void
+GfxCommandBuffer::Draw(const PrimitiveGroup& primGroup) {
+    gfxCmd::primGroup* pg = (gfxCmd::primGroup*) this->alloc(gfxCmd::DrawPrimGroup, 0, 0, 0, sizeof(gfxCmd::primGroup));
+    pg->PrimType = primGroup.PrimType;
+    pg->BaseElement = primGroup.BaseElement;
+    pg->NumElements = primGroup.NumElements;
+    this->numDraws++;
+}
+
+//------------------------------------------------------------------------------
+void
+GfxCommandBuffer::DrawInstanced(const PrimitiveGroup& primGroup, int32 numInstances) {
+    gfxCmd::primGroup* pg = (gfxCmd::primGroup*) this->alloc(gfxCmd::DrawInstancedPrimGroup, 0, 0, numInstances, sizeof(gfxCmd::primGroup));
+    pg->PrimType = primGroup.PrimType;
+    pg->BaseElement = primGroup.BaseElement;
+    pg->NumElements = primGroup.NumElements;
+    this->numDraws++;
+}
+
+} // namespace Oryol
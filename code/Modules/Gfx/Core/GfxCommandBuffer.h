@@ -0,0 +1,228 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::GfxCommandBuffer
+    @ingroup Gfx
+    @brief record Gfx render commands for deferred submission
+
+    A GfxCommandBuffer records the same render commands as the
+    Gfx facade (ApplyDrawState, ApplyVariable, Draw, ...) as compact
+    POD packets into a linear memory buffer instead of executing
+    them right away. Recording doesn't touch the renderer or any
+    resource, so separate command buffers can be recorded on separate
+    threads (e.g. from JobSystem jobs). Recorded command buffers are
+    then submitted on the main thread in order with
+    Gfx::SubmitCommandBuffer(), or merged with Append().
+
+    Resource Ids are stored as is and only resolved when the buffer
+    is submitted. Variable arrays and vertex data are copied into
+    the command buffer.
+
+    Reset() clears the recorded commands but keeps the allocated
+    memory, so that a command buffer can be reused each frame without
+    allocations.
+
+    @see Gfx
+*/
+#include "Core/Types.h"
+#include "Core/Assertion.h"
+#include "Core/Memory/Memory.h"
+#include "Resource/Id.h"
+#include "Gfx/Core/Enums.h"
+#include "Gfx/Core/PrimitiveGroup.h"
+#include "Gfx/Core/gfxCmd.h"
+#include "Gfx/Core/uniformTypeOf.h"
+#include "glm/vec4.hpp"
+
+namespace Oryol {
+
+class GfxCommandBuffer {
+public:
+    /// constructor
+    GfxCommandBuffer();
+    /// move constructor
+    GfxCommandBuffer(GfxCommandBuffer&& rhs);
+    /// destructor
+    ~GfxCommandBuffer();
+    /// move-assignment
+    void operator=(GfxCommandBuffer&& rhs);
+
+    /// reserve memory for a number of bytes
+    void Reserve(int32 numBytes);
+    /// discard all recorded commands, keeps allocated memory
+    void Reset();
+    /// append the commands of another command buffer
+    void Append(const GfxCommandBuffer& other);
+
+    /// return true if no commands have been recorded
+    bool Empty() const;
+    /// get number of recorded commands
+    int32 NumCommands() const;
+    /// get number of recorded draw commands
+    int32 NumDraws() const;
+    /// get number of used bytes
+    int32 Size() const;
+    /// get number of allocated bytes
+    int32 Capacity() const;
+    /// get pointer to start of recorded commands
+    const uint8* Data() const;
+
+    /// record make the default render target current
+    void ApplyDefaultRenderTarget();
+    /// record apply an offscreen render target
+    void ApplyOffscreenRenderTarget(const Id& id);
+    /// record apply view port
+    void ApplyViewPort(int32 x, int32 y, int32 width, int32 height);
+    /// record apply scissor rect
+    void ApplyScissorRect(int32 x, int32 y, int32 width, int32 height);
+    /// record apply blend color
+    void ApplyBlendColor(const glm::vec4& blendColor);
+    /// record apply draw state
+    void ApplyDrawState(const Id& id);
+    /// record apply a shader variable
+    template<class T> void ApplyVariable(int32 index, const T& value);
+    /// record apply a shader variable array (values will be copied)
+    template<class T> void ApplyVariableArray(int32 index, const T* values, int32 numValues);
+    /// record apply a uniform block (block will be copied)
+    template<class T> void ApplyUniformBlock(const T& block);
+    /// record apply a uniform block by slot index and raw data (data will be copied)
+    void ApplyUniformBlock(int32 slotIndex, const void* data, int32 numBytes);
+    /// record update dynamic vertex data (data will be copied)
+    void UpdateVertices(const Id& id, int32 numBytes, const void* data);
+    /// record clear the current render target
+    void Clear(PixelChannel::Mask channels, const glm::vec4& color, float32 depth=1.0f, uint8 stencil=0);
+    /// record a draw call with primitive group index in current mesh
+    void Draw(int32 primGroupIndex);
+    /// record a draw call with direct primitive group
+    void Draw(const PrimitiveGroup& primGroup);
+    /// record an instanced draw call
+    void DrawInstanced(int32 primGroupIndex, int32 numInstances);
+    /// record an instanced draw call with direct primitive group
+    void DrawInstanced(const PrimitiveGroup& primGroup, int32 numInstances);
+
+    /// command buffers can't be copied
+    GfxCommandBuffer(const GfxCommandBuffer& rhs) = delete;
+    /// command buffers can't be copy-assigned
+    void operator=(const GfxCommandBuffer& rhs) = delete;
+
+private:
+    /// allocate a new packet and write header, returns pointer to payload
+    uint8* alloc(_priv::gfxCmd::Code code, uint16 type, int32 arg0, int32 arg1, int32 payloadSize);
+    /// grow buffer so that at least numBytes more bytes fit
+    void grow(int32 numBytes);
+    /// record a packet with an Id payload
+    void recordId(_priv::gfxCmd::Code code, int32 arg0, const Id& id);
+
+    uint8* buffer;
+    int32 size;
+    int32 capacity;
+    int32 numCommands;
+    int32 numDraws;
+};
+
+//------------------------------------------------------------------------------
+inline bool
+GfxCommandBuffer::Empty() const {
+    return 0 == this->size;
+}
+
+//------------------------------------------------------------------------------
+inline int32
+GfxCommandBuffer::NumCommands() const {
+    return this->numCommands;
+}
+
+//------------------------------------------------------------------------------
+inline int32
+GfxCommandBuffer::NumDraws() const {
+    return this->numDraws;
+}
+
+//------------------------------------------------------------------------------
+inline int32
+GfxCommandBuffer::Size() const {
+    return this->size;
+}
+
+//------------------------------------------------------------------------------
+inline int32
+GfxCommandBuffer::Capacity() const {
+    return this->capacity;
+}
+
+//------------------------------------------------------------------------------
+inline const uint8*
+GfxCommandBuffer::Data() const {
+    return this->buffer;
+}
+
+//------------------------------------------------------------------------------
+inline uint8*
+GfxCommandBuffer::alloc(_priv::gfxCmd::Code code, uint16 type, int32 arg0, int32 arg1, int32 payloadSize) {
+    const int32 packetSize = Memory::RoundUp(int32(sizeof(_priv::gfxCmd::header)) + payloadSize, _priv::gfxCmd::Alignment);
+    if ((this->size + packetSize) > this->capacity) {
+        this->grow(packetSize);
+    }
+    uint8* ptr = this->buffer + this->size;
+    _priv::gfxCmd::header* hdr = (_priv::gfxCmd::header*) ptr;
+    hdr->Code = code;
+    hdr->Type = type;
+    hdr->Arg0 = arg0;
+    hdr->Arg1 = arg1;
+    hdr->Size = packetSize;
+    this->size += packetSize;
+    this->numCommands++;
+    return ptr + sizeof(_priv::gfxCmd::header);
+}
+
+//------------------------------------------------------------------------------
+template<> inline void
+GfxCommandBuffer::ApplyVariable(int32 index, const Id& texResId) {
+    this->recordId(_priv::gfxCmd::ApplyTexture, index, texResId);
+}
+
+//------------------------------------------------------------------------------
+template<class T> inline void
+GfxCommandBuffer::ApplyVariable(int32 index, const T& value) {
+    uint8* payload = this->alloc(_priv::gfxCmd::ApplyVariable, _priv::uniformTypeOf<T>::Type, index, 1, sizeof(T));
+    Memory::Copy(&value, payload, sizeof(T));
+}
+
+//------------------------------------------------------------------------------
+template<class T> inline void
+GfxCommandBuffer::ApplyVariableArray(int32 index, const T* values, int32 numValues) {
+    o_assert_dbg(values && (numValues > 0));
+    const int32 numBytes = numValues * int32(sizeof(T));
+    uint8* payload = this->alloc(_priv::gfxCmd::ApplyVariableArray, _priv::uniformTypeOf<T>::Type, index, numValues, numBytes);
+    Memory::Copy(values, payload, numBytes);
+}
+
+//------------------------------------------------------------------------------
+template<class T> inline void
+GfxCommandBuffer::ApplyUniformBlock(const T& block) {
+    this->ApplyUniformBlock(T::_bindSlotIndex, &block, int32(sizeof(T)));
+}
+
+//------------------------------------------------------------------------------
+inline void
+GfxCommandBuffer::ApplyUniformBlock(int32 slotIndex, const void* data, int32 numBytes) {
+    o_assert_dbg(data && (numBytes > 0));
+    uint8* payload = this->alloc(_priv::gfxCmd::ApplyUniformBlock, 0, slotIndex, numBytes, numBytes);
+    Memory::Copy(data, payload, numBytes);
+}
+
+//------------------------------------------------------------------------------
+inline void
+GfxCommandBuffer::Draw(int32 primGroupIndex) {
+    this->alloc(_priv::gfxCmd::Draw, 0, primGroupIndex, 0, 0);
+    this->numDraws++;
+}
+
+//------------------------------------------------------------------------------
+inline void
+GfxCommandBuffer::DrawInstanced(int32 primGroupIndex, int32 numInstances) {
+    this->alloc(_priv::gfxCmd::DrawInstanced, 0, primGroupIndex, numInstances, 0);
+    this->numDraws++;
+}
+
+} // namespace Oryol
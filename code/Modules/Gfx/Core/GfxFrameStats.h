@@ -0,0 +1,89 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::GfxFrameStats
+    @ingroup Gfx
+    @brief per-frame rendering statistics
+
+    The renderer counts Gfx calls, the state changes which actually
+    had to be applied, the state changes which have been filtered
+    by the state cache, and the number of bytes uploaded to the GPU.
+    Gfx::FrameStats() returns the counters of the last committed frame.
+
+    Resource creation outside of a frame is counted into the next
+    frame's upload counters.
+*/
+#include "Core/Types.h"
+
+namespace Oryol {
+
+struct GfxFrameStats {
+    /// number of ApplyDefaultRenderTarget/ApplyOffscreenRenderTarget calls
+    int32 NumApplyRenderTarget{0};
+    /// number of ApplyDrawState calls
+    int32 NumApplyDrawState{0};
+    /// number of ApplyVariable and ApplyVariableArray calls (without textures)
+    int32 NumApplyVariable{0};
+    /// number of texture ApplyVariable calls
+    int32 NumApplyTexture{0};
+    /// number of Clear calls
+    int32 NumClears{0};
+    /// number of non-instanced draw calls
+    int32 NumDraws{0};
+    /// number of instanced draw calls
+    int32 NumDrawsInstanced{0};
+    /// number of instances rendered by instanced draw calls
+    int32 NumInstances{0};
+    /// number of rendered elements (vertices or indices) over all draw calls
+    int32 NumElements{0};
+    /// number of UpdateVertices calls
+    int32 NumUpdateVertices{0};
+    /// number of UpdateIndices calls
+    int32 NumUpdateIndices{0};
+    /// number of ApplyUniformBlock calls
+    int32 NumApplyUniformBlock{0};
+
+    /// render target switches
+    int32 NumRenderTargetChanges{0};
+    /// viewport changes
+    int32 NumViewPortChanges{0};
+    /// scissor rect changes
+    int32 NumScissorRectChanges{0};
+    /// blend color changes
+    int32 NumBlendColorChanges{0};
+    /// depth-stencil state changes
+    int32 NumDepthStencilStateChanges{0};
+    /// blend state changes
+    int32 NumBlendStateChanges{0};
+    /// rasterizer state changes
+    int32 NumRasterizerStateChanges{0};
+    /// shader program switches
+    int32 NumProgramChanges{0};
+    /// vertex/index buffer binding changes
+    int32 NumMeshChanges{0};
+    /// texture binding changes
+    int32 NumTextureChanges{0};
+    /// uniform blocks which have been uploaded because their content changed
+    int32 NumUniformBlockUpdates{0};
+    /// state changes which have been filtered by the state cache
+    int32 NumRedundantStateChanges{0};
+    /// state changes which have been skipped by a GfxRenderQueue
+    int32 NumElidedStateChanges{0};
+    /// draws which have been merged into instanced draws by a GfxRenderQueue
+    int32 NumMergedDraws{0};
+    /// times the CPU had to wait for the GPU to release shared stream buffer memory
+    int32 NumStreamBufferWaits{0};
+
+    /// bytes written to shader uniforms
+    int32 UniformBytes{0};
+    /// bytes written by UpdateVertices
+    int32 VertexUpdateBytes{0};
+    /// bytes written by UpdateIndices
+    int32 IndexUpdateBytes{0};
+    /// bytes sub-allocated from the shared stream buffers (including alignment padding)
+    int32 StreamBufferBytes{0};
+    /// bytes of vertex, index and pixel data uploaded during resource creation
+    int32 ResourceUploadBytes{0};
+};
+
+} // namespace Oryol
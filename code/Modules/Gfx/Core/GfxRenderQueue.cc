@@ -0,0 +1,228 @@
+//------------------------------------------------------------------------------
+//  GfxRenderQueue.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "GfxRenderQueue.h"
+
+namespace Oryol {
+
+//------------------------------------------------------------------------------
+GfxRenderQueue::GfxRenderQueue() :
+instData(nullptr),
+instDataSize(0),
+instDataCapacity(0),
+instScratch(nullptr),
+instScratchCapacity(0),
+autoInstancing(true),
+inDraw(false) {
+    // empty
+}
+
+//------------------------------------------------------------------------------
+GfxRenderQueue::~GfxRenderQueue() {
+    if (this->instData) {
+        Memory::Free(this->instData);
+        this->instData = nullptr;
+    }
+    if (this->instScratch) {
+        Memory::Free(this->instScratch);
+        this->instScratch = nullptr;
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+ The key layout from most to least significant bits is:
+
+ - 8 bits pass index
+ - 12 bits program bundle slot index
+ - 12 bits mesh slot index
+ - 12 bits draw state slot index
+ - 20 bits depth
+
+ Sorting by program before mesh and draw state minimizes the
+ expensive program switches, the draw state slot groups draws which
+ can skip ApplyDrawState(). Slot indices beyond 12 bits wrap around,
+ this only degrades the sort order, not the rendering result.
+*/
+uint64
+GfxRenderQueue::MakeSortKey(int32 passIndex, const Id& program, const Id& mesh, const Id& drawState, float32 depth) {
+    o_assert_dbg((passIndex >= 0) && (passIndex < MaxNumPasses));
+    if (depth < 0.0f) {
+        depth = 0.0f;
+    }
+    else if (depth > 1.0f) {
+        depth = 1.0f;
+    }
+    const uint64 depthBits = uint64(depth * float32(0xFFFFF));
+    return (uint64(passIndex) << 56) |
+           (uint64(program.SlotIndex & 0xFFF) << 44) |
+           (uint64(mesh.SlotIndex & 0xFFF) << 32) |
+           (uint64(drawState.SlotIndex & 0xFFF) << 20) |
+           depthBits;
+}
+
+//------------------------------------------------------------------------------
+void
+GfxRenderQueue::Reserve(int32 numDraws) {
+    this->items.Reserve(numDraws);
+    this->sortEntries.Reserve(numDraws);
+    this->sortScratch.Reserve(numDraws);
+}
+
+//------------------------------------------------------------------------------
+void
+GfxRenderQueue::Reset() {
+    o_assert_dbg(!this->inDraw);
+    this->passes.Clear();
+    this->items.Clear();
+    this->vars.Reset();
+    this->instDataSize = 0;
+}
+
+//------------------------------------------------------------------------------
+void
+GfxRenderQueue::beginPass(const Id& renderTarget) {
+    o_assert_dbg(!this->inDraw);
+    o_assert(this->passes.Size() < MaxNumPasses);
+    this->passes.Add();
+    pass& p = this->passes.Back();
+    p.renderTarget = renderTarget;
+}
+
+//------------------------------------------------------------------------------
+void
+GfxRenderQueue::ApplyDefaultRenderTarget() {
+    this->beginPass(Id::InvalidId());
+}
+
+//------------------------------------------------------------------------------
+void
+GfxRenderQueue::ApplyOffscreenRenderTarget(const Id& id) {
+    o_assert_dbg(id.IsValid());
+    this->beginPass(id);
+}
+
+//------------------------------------------------------------------------------
+void
+GfxRenderQueue::Clear(PixelChannel::Mask channels, const glm::vec4& color, float32 depth, uint8 stencil) {
+    o_assert_dbg(!this->inDraw);
+    o_assert_dbg(!this->passes.Empty());
+    pass& p = this->passes.Back();
+    o_assert_dbg(0 == p.numDraws);
+    p.clearChannels = channels;
+    p.clearColor = color;
+    p.clearDepth = depth;
+    p.clearStencil = stencil;
+}
+
+//------------------------------------------------------------------------------
+void
+GfxRenderQueue::BeginDraw(const Id& drawState, float32 depth) {
+    o_assert_dbg(!this->inDraw);
+    o_assert_dbg(!this->passes.Empty());
+    o_assert_dbg(drawState.IsValid());
+    this->items.Add();
+    item& it = this->items.Back();
+    it.drawState = drawState;
+    it.depth = depth;
+    it.passIndex = this->passes.Size() - 1;
+    it.varOffset = this->vars.Size();
+    it.numVars = this->vars.NumCommands();
+    it.instOffset = this->instDataSize;
+    this->inDraw = true;
+}
+
+//------------------------------------------------------------------------------
+void
+GfxRenderQueue::endDraw(int32 primGroupIndex, int32 numInstances) {
+    o_assert_dbg(this->inDraw);
+    item& it = this->items.Back();
+    it.varSize = this->vars.Size() - it.varOffset;
+    it.numVars = this->vars.NumCommands() - it.numVars;
+    it.instSize = this->instDataSize - it.instOffset;
+    o_assert2_dbg((0 == it.instSize) || (0 == numInstances), "draws with instance data must use Draw()\n");
+    it.primGroupIndex = primGroupIndex;
+    it.numInstances = numInstances;
+    this->passes.Back().numDraws++;
+    this->inDraw = false;
+}
+
+//------------------------------------------------------------------------------
+void
+GfxRenderQueue::ApplyInstanceData(const void* data, int32 numBytes) {
+    o_assert_dbg(this->inDraw);
+    o_assert_dbg(data && (numBytes > 0));
+    if ((this->instDataSize + numBytes) > this->instDataCapacity) {
+        this->instData = reserveBytes(this->instData, this->instDataCapacity, this->instDataSize + numBytes);
+    }
+    Memory::Copy(data, this->instData + this->instDataSize, numBytes);
+    this->instDataSize += numBytes;
+}
+
+//------------------------------------------------------------------------------
+/**
+ Grows a byte buffer by at least 50% so that numBytes fit, and keeps
+ its content.
+*/
+uint8*
+GfxRenderQueue::reserveBytes(uint8* buf, int32& capacity, int32 numBytes) {
+    if (numBytes > capacity) {
+        int32 newCapacity = capacity + (capacity >> 1);
+        if (newCapacity < numBytes) {
+            newCapacity = Memory::RoundUp(numBytes, 4096);
+        }
+        buf = (uint8*) Memory::ReAlloc(buf, newCapacity);
+        capacity = newCapacity;
+    }
+    return buf;
+}
+
+//------------------------------------------------------------------------------
+/**
+ LSD radix sort over the 8 bytes of the sort keys. Digits where all
+ keys are identical (usually the pass index and the upper slot bits)
+ are skipped. The sort is stable, so items with identical keys keep
+ their recording order.
+*/
+const GfxRenderQueue::sortEntry*
+GfxRenderQueue::sort() {
+    o_assert_dbg(!this->inDraw);
+    const int32 num = this->items.Size();
+    this->sortEntries.Clear();
+    this->sortScratch.Clear();
+    if (0 == num) {
+        return nullptr;
+    }
+    for (int32 i = 0; i < num; i++) {
+        const sortEntry entry = { this->items[i].key, i };
+        this->sortEntries.Add(entry);
+        this->sortScratch.Add(entry);
+    }
+    sortEntry* src = &this->sortEntries[0];
+    sortEntry* dst = &this->sortScratch[0];
+    for (int32 shift = 0; shift < 64; shift += 8) {
+        int32 offsets[256] = { };
+        for (int32 i = 0; i < num; i++) {
+            offsets[(src[i].key >> shift) & 0xFF]++;
+        }
+        if (offsets[(src[0].key >> shift) & 0xFF] == num) {
+            continue;
+        }
+        int32 offset = 0;
+        for (int32 digit = 0; digit < 256; digit++) {
+            const int32 count = offsets[digit];
+            offsets[digit] = offset;
+            offset += count;
+        }
+        for (int32 i = 0; i < num; i++) {
+            dst[offsets[(src[i].key >> shift) & 0xFF]++] = src[i];
+        }
+        sortEntry* tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+    return src;
+}
+
+} // namespace Oryol
@@ -0,0 +1,241 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::GfxRenderQueue
+    @ingroup Gfx
+    @brief sort draw calls by state and replay them with minimal state changes
+
+    A GfxRenderQueue collects draw items grouped into render passes.
+    A pass is started with ApplyDefaultRenderTarget() or
+    ApplyOffscreenRenderTarget() and may be cleared once before its
+    first draw. Each draw item is started with BeginDraw() (draw state
+    and a normalized depth value), followed by the shader variables
+    and uniform blocks of the draw, and is finished with Draw() or
+    DrawInstanced():
+
+    @code
+    queue.ApplyDefaultRenderTarget();
+    queue.Clear(PixelChannel::All, glm::vec4(0.0f));
+    queue.BeginDraw(drawState, depth);
+    queue.ApplyVariable(Shaders::Main::ModelViewProjection, mvp);
+    queue.Draw(0);
+    Gfx::SubmitRenderQueue(queue);
+    @endcode
+
+    On submission each item gets a 64-bit sort key (see MakeSortKey()),
+    the items are radix-sorted by their keys, and are replayed pass by
+    pass. ApplyDrawState() is skipped if consecutive items use the same
+    draw state, and the shader variables of an item are skipped if
+    they are byte-identical to the previous item with the same draw
+    state. The number of skipped state changes is reported in
+    GfxFrameStats::NumElidedStateChanges.
+
+    Passes are always replayed in recording order, and items with equal
+    sort keys keep their recording order. Pass 1.0 - depth for
+    back-to-front sorting of translucent geometry.
+
+    Draws of meshes with an instance data mesh (MeshSetup::InstanceMesh)
+    can record per-draw instance data with ApplyInstanceData() instead
+    of per-draw shader variables. The instance data of a draw must match
+    the vertex layout of the instance mesh. On submission, consecutive
+    draws with the same draw state, primitive group and shader variables
+    are merged into a single instanced draw: their instance data is
+    gathered and written into the instance mesh with UpdateVertices(),
+    and the merged draw count is reported in GfxFrameStats::NumMergedDraws.
+    A batch is split when it exceeds the instance mesh's vertex capacity.
+    With SetAutoInstancing(false) each draw becomes an instanced draw
+    with a single instance.
+
+    Like a GfxCommandBuffer, recording a queue doesn't touch the renderer.
+    Reset() discards the recorded items but keeps the allocated memory.
+
+    @see Gfx, GfxCommandBuffer
+*/
+#include "Core/Types.h"
+#include "Core/Assertion.h"
+#include "Core/Containers/Array.h"
+#include "Resource/Id.h"
+#include "Gfx/Core/Enums.h"
+#include "Gfx/Core/GfxCommandBuffer.h"
+#include "glm/vec4.hpp"
+
+namespace Oryol {
+
+class Gfx;
+
+class GfxRenderQueue {
+public:
+    /// maximum number of render passes in a queue
+    static const int32 MaxNumPasses = 256;
+
+    /// constructor
+    GfxRenderQueue();
+    /// destructor
+    ~GfxRenderQueue();
+
+    /// build a sort key from pass index, resource ids and normalized depth
+    static uint64 MakeSortKey(int32 passIndex, const Id& program, const Id& mesh, const Id& drawState, float32 depth);
+
+    /// reserve memory for a number of draw items
+    void Reserve(int32 numDraws);
+    /// discard all recorded passes and draws, keeps allocated memory
+    void Reset();
+
+    /// get number of recorded passes
+    int32 NumPasses() const;
+    /// get number of recorded draws
+    int32 NumDraws() const;
+
+    /// enable or disable merging draws with instance data (default: enabled)
+    void SetAutoInstancing(bool b);
+    /// return true if auto-instancing is enabled
+    bool AutoInstancing() const;
+
+    /// start a new pass on the default render target
+    void ApplyDefaultRenderTarget();
+    /// start a new pass on an offscreen render target
+    void ApplyOffscreenRenderTarget(const Id& id);
+    /// clear the render target of the current pass (before the first draw)
+    void Clear(PixelChannel::Mask channels, const glm::vec4& color, float32 depth=1.0f, uint8 stencil=0);
+    /// begin a new draw item
+    void BeginDraw(const Id& drawState, float32 depth=0.0f);
+    /// apply a shader variable to the current draw item
+    template<class T> void ApplyVariable(int32 index, const T& value);
+    /// apply a shader variable array to the current draw item (values will be copied)
+    template<class T> void ApplyVariableArray(int32 index, const T* values, int32 numValues);
+    /// apply a uniform block to the current draw item (block will be copied)
+    template<class T> void ApplyUniformBlock(const T& block);
+    /// append per-instance data of the current draw item (value will be copied)
+    template<class T> void ApplyInstanceData(const T& value);
+    /// append raw per-instance data of the current draw item (data will be copied)
+    void ApplyInstanceData(const void* data, int32 numBytes);
+    /// finish the current draw item with a primitive group index
+    void Draw(int32 primGroupIndex);
+    /// finish the current draw item as instanced draw
+    void DrawInstanced(int32 primGroupIndex, int32 numInstances);
+
+    /// render queues can't be copied
+    GfxRenderQueue(const GfxRenderQueue& rhs) = delete;
+    /// render queues can't be copy-assigned
+    void operator=(const GfxRenderQueue& rhs) = delete;
+
+private:
+    friend class Gfx;
+
+    /// a render pass
+    struct pass {
+        Id renderTarget;
+        PixelChannel::Mask clearChannels = 0;
+        glm::vec4 clearColor;
+        float32 clearDepth = 1.0f;
+        uint8 clearStencil = 0;
+        int32 numDraws = 0;
+    };
+    /// a draw item
+    struct item {
+        uint64 key = 0;
+        Id drawState;
+        float32 depth = 0.0f;
+        int32 passIndex = 0;
+        int32 varOffset = 0;
+        int32 varSize = 0;
+        int32 numVars = 0;
+        int32 instOffset = 0;
+        int32 instSize = 0;
+        int32 primGroupIndex = 0;
+        int32 numInstances = 0;
+    };
+    /// a radix sort entry
+    struct sortEntry {
+        uint64 key;
+        int32 index;
+    };
+
+    /// start a new pass
+    void beginPass(const Id& renderTarget);
+    /// finish the current draw item
+    void endDraw(int32 primGroupIndex, int32 numInstances);
+    /// radix-sort the items by their sort keys, returns sorted entries
+    const sortEntry* sort();
+    /// make room for at least numBytes in a growable byte buffer
+    static uint8* reserveBytes(uint8* buf, int32& capacity, int32 numBytes);
+
+    Array<pass> passes;
+    Array<item> items;
+    Array<sortEntry> sortEntries;
+    Array<sortEntry> sortScratch;
+    GfxCommandBuffer vars;
+    uint8* instData;
+    int32 instDataSize;
+    int32 instDataCapacity;
+    uint8* instScratch;
+    int32 instScratchCapacity;
+    bool autoInstancing;
+    bool inDraw;
+};
+
+//------------------------------------------------------------------------------
+inline int32
+GfxRenderQueue::NumPasses() const {
+    return this->passes.Size();
+}
+
+//------------------------------------------------------------------------------
+inline int32
+GfxRenderQueue::NumDraws() const {
+    return this->items.Size();
+}
+
+//------------------------------------------------------------------------------
+inline void
+GfxRenderQueue::SetAutoInstancing(bool b) {
+    this->autoInstancing = b;
+}
+
+//------------------------------------------------------------------------------
+inline bool
+GfxRenderQueue::AutoInstancing() const {
+    return this->autoInstancing;
+}
+
+//------------------------------------------------------------------------------
+template<class T> inline void
+GfxRenderQueue::ApplyVariable(int32 index, const T& value) {
+    o_assert_dbg(this->inDraw);
+    this->vars.ApplyVariable(index, value);
+}
+
+//------------------------------------------------------------------------------
+template<class T> inline void
+GfxRenderQueue::ApplyVariableArray(int32 index, const T* values, int32 numValues) {
+    o_assert_dbg(this->inDraw);
+    this->vars.ApplyVariableArray(index, values, numValues);
+}
+
+//------------------------------------------------------------------------------
+template<class T> inline void
+GfxRenderQueue::ApplyUniformBlock(const T& block) {
+    o_assert_dbg(this->inDraw);
+    this->vars.ApplyUniformBlock(block);
+}
+
+//------------------------------------------------------------------------------
+template<class T> inline void
+GfxRenderQueue::ApplyInstanceData(const T& value) {
+    this->ApplyInstanceData(&value, int32(sizeof(T)));
+}
+
+//------------------------------------------------------------------------------
+inline void
+GfxRenderQueue::Draw(int32 primGroupIndex) {
+    this->endDraw(primGroupIndex, 0);
+}
+
+//------------------------------------------------------------------------------
+inline void
+GfxRenderQueue::DrawInstanced(int32 primGroupIndex, int32 numInstances) {
+    o_assert_dbg(numInstances > 0);
+    this->endDraw(primGroupIndex, numInstances);
+}
+
+} // namespace Oryol
@@ -0,0 +1,200 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::_priv::cmdExecutor
+    @ingroup _priv
+    @brief replay the commands recorded in a GfxCommandBuffer
+
+    The cmdExecutor walks the packets of a GfxCommandBuffer in order
+    and calls the matching method on a HANDLER object. Gfx uses a
+    handler which forwards to the renderer, other handlers can be used
+    to inspect or count recorded commands without a renderer.
+
+    The HANDLER must implement the same methods as GfxCommandBuffer
+    (ApplyDefaultRenderTarget(), ApplyOffscreenRenderTarget(), ...,
+    DrawInstanced()), including ApplyVariable() and ApplyVariableArray()
+    templates for all uniform value types and Id (textures), and the
+    untyped ApplyUniformBlock(slotIndex, data, numBytes).
+*/
+#include "Core/Assertion.h"
+#include "Gfx/Core/GfxCommandBuffer.h"
+#include "glm/vec2.hpp"
+#include "glm/vec3.hpp"
+#include "glm/vec4.hpp"
+#include "glm/mat2x2.hpp"
+#include "glm/mat3x3.hpp"
+#include "glm/mat4x4.hpp"
+
+namespace Oryol {
+namespace _priv {
+
+template<class HANDLER> class cmdExecutor {
+public:
+    /// replay all commands in a command buffer, returns number of executed commands
+    static int32 Execute(const GfxCommandBuffer& cmdBuffer, HANDLER& handler);
+    /// replay a range of recorded command packets, returns number of executed commands
+    static int32 Execute(const uint8* data, int32 numBytes, HANDLER& handler);
+
+private:
+    /// replay a single shader variable
+    static void applyVariable(const gfxCmd::header* hdr, const uint8* payload, HANDLER& handler);
+    /// replay a shader variable array
+    static void applyVariableArray(const gfxCmd::header* hdr, const uint8* payload, HANDLER& handler);
+    /// build an Id from a payload
+    static Id toId(const uint8* payload);
+    /// build a PrimitiveGroup from a payload
+    static PrimitiveGroup toPrimGroup(const uint8* payload);
+};
+
+//------------------------------------------------------------------------------
+template<class HANDLER> int32
+cmdExecutor<HANDLER>::Execute(const GfxCommandBuffer& cmdBuffer, HANDLER& handler) {
+    return Execute(cmdBuffer.Data(), cmdBuffer.Size(), handler);
+}
+
+//------------------------------------------------------------------------------
+template<class HANDLER> int32
+cmdExecutor<HANDLER>::Execute(const uint8* data, int32 numBytes, HANDLER& handler) {
+    const uint8* ptr = data;
+    const uint8* end = ptr + numBytes;
+    int32 numExecuted = 0;
+    while (ptr < end) {
+        const gfxCmd::header* hdr = (const gfxCmd::header*) ptr;
+        const uint8* payload = ptr + sizeof(gfxCmd::header);
+        o_assert_dbg((hdr->Size >= int32(sizeof(gfxCmd::header))) && ((ptr + hdr->Size) <= end));
+        switch (hdr->Code) {
+            case gfxCmd::ApplyDefaultRenderTarget:
+                handler.ApplyDefaultRenderTarget();
+                break;
+            case gfxCmd::ApplyOffscreenRenderTarget:
+                handler.ApplyOffscreenRenderTarget(toId(payload));
+                break;
+            case gfxCmd::ApplyViewPort:
+                {
+                    const gfxCmd::rect* r = (const gfxCmd::rect*) payload;
+                    handler.ApplyViewPort(r->X, r->Y, r->Width, r->Height);
+                }
+                break;
+            case gfxCmd::ApplyScissorRect:
+                {
+                    const gfxCmd::rect* r = (const gfxCmd::rect*) payload;
+                    handler.ApplyScissorRect(r->X, r->Y, r->Width, r->Height);
+                }
+                break;
+            case gfxCmd::ApplyBlendColor:
+                {
+                    const float32* c = (const float32*) payload;
+                    handler.ApplyBlendColor(glm::vec4(c[0], c[1], c[2], c[3]));
+                }
+                break;
+            case gfxCmd::ApplyDrawState:
+                handler.ApplyDrawState(toId(payload));
+                break;
+            case gfxCmd::ApplyTexture:
+                handler.ApplyVariable(hdr->Arg0, toId(payload));
+                break;
+            case gfxCmd::ApplyVariable:
+                applyVariable(hdr, payload, handler);
+                break;
+            case gfxCmd::ApplyVariableArray:
+                applyVariableArray(hdr, payload, handler);
+                break;
+            case gfxCmd::Clear:
+                {
+                    const gfxCmd::clear* c = (const gfxCmd::clear*) payload;
+                    handler.Clear((PixelChannel::Mask) c->Channels,
+                                  glm::vec4(c->Color[0], c->Color[1], c->Color[2], c->Color[3]),
+                                  c->Depth,
+                                  (uint8) c->Stencil);
+                }
+                break;
+            case gfxCmd::Draw:
+                handler.Draw(hdr->Arg0);
+                break;
+            case gfxCmd::DrawPrimGroup:
+                handler.Draw(toPrimGroup(payload));
+                break;
+            case gfxCmd::DrawInstanced:
+                handler.DrawInstanced(hdr->Arg0, hdr->Arg1);
+                break;
+            case gfxCmd::DrawInstancedPrimGroup:
+                handler.DrawInstanced(toPrimGroup(payload), hdr->Arg1);
+                break;
+            case gfxCmd::UpdateVertices:
+                handler.UpdateVertices(toId(payload), hdr->Arg1, payload + sizeof(uint64));
+                break;
+            case gfxCmd::ApplyUniformBlock:
+                handler.ApplyUniformBlock(hdr->Arg0, payload, hdr->Arg1);
+                break;
+            default:
+                o_error("cmdExecutor: invalid command code '%d'!\n", hdr->Code);
+                break;
+        }
+        ptr += hdr->Size;
+        numExecuted++;
+    }
+    return numExecuted;
+}
+
+//------------------------------------------------------------------------------
+template<class HANDLER> void
+cmdExecutor<HANDLER>::applyVariable(const gfxCmd::header* hdr, const uint8* payload, HANDLER& handler) {
+    const int32 index = hdr->Arg0;
+    switch (hdr->Type) {
+        case UniformType::Float:    handler.ApplyVariable(index, *(const float32*)payload); break;
+        case UniformType::Vec2:     handler.ApplyVariable(index, *(const glm::vec2*)payload); break;
+        case UniformType::Vec3:     handler.ApplyVariable(index, *(const glm::vec3*)payload); break;
+        case UniformType::Vec4:     handler.ApplyVariable(index, *(const glm::vec4*)payload); break;
+        case UniformType::Int:      handler.ApplyVariable(index, *(const int32*)payload); break;
+        case UniformType::IVec2:    handler.ApplyVariable(index, *(const glm::ivec2*)payload); break;
+        case UniformType::IVec3:    handler.ApplyVariable(index, *(const glm::ivec3*)payload); break;
+        case UniformType::IVec4:    handler.ApplyVariable(index, *(const glm::ivec4*)payload); break;
+        case UniformType::Mat2:     handler.ApplyVariable(index, *(const glm::mat2*)payload); break;
+        case UniformType::Mat3:     handler.ApplyVariable(index, *(const glm::mat3*)payload); break;
+        case UniformType::Mat4:     handler.ApplyVariable(index, *(const glm::mat4*)payload); break;
+        default:
+            o_error("cmdExecutor: invalid uniform type '%d'!\n", hdr->Type);
+            break;
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class HANDLER> void
+cmdExecutor<HANDLER>::applyVariableArray(const gfxCmd::header* hdr, const uint8* payload, HANDLER& handler) {
+    const int32 index = hdr->Arg0;
+    const int32 num = hdr->Arg1;
+    switch (hdr->Type) {
+        case UniformType::Float:    handler.ApplyVariableArray(index, (const float32*)payload, num); break;
+        case UniformType::Vec2:     handler.ApplyVariableArray(index, (const glm::vec2*)payload, num); break;
+        case UniformType::Vec3:     handler.ApplyVariableArray(index, (const glm::vec3*)payload, num); break;
+        case UniformType::Vec4:     handler.ApplyVariableArray(index, (const glm::vec4*)payload, num); break;
+        case UniformType::Int:      handler.ApplyVariableArray(index, (const int32*)payload, num); break;
+        case UniformType::IVec2:    handler.ApplyVariableArray(index, (const glm::ivec2*)payload, num); break;
+        case UniformType::IVec3:    handler.ApplyVariableArray(index, (const glm::ivec3*)payload, num); break;
+        case UniformType::IVec4:    handler.ApplyVariableArray(index, (const glm::ivec4*)payload, num); break;
+        case UniformType::Mat2:     handler.ApplyVariableArray(index, (const glm::mat2*)payload, num); break;
+        case UniformType::Mat3:     handler.ApplyVariableArray(index, (const glm::mat3*)payload, num); break;
+        case UniformType::Mat4:     handler.ApplyVariableArray(index, (const glm::mat4*)payload, num); break;
+        default:
+            o_error("cmdExecutor: invalid uniform type '%d'!\n", hdr->Type);
+            break;
+    }
+}
+
+//------------------------------------------------------------------------------
+template<class HANDLER> Id
+cmdExecutor<HANDLER>::toId(const uint8* payload) {
+    Id id;
+    id.Value = *(const uint64*)payload;
+    return id;
+}
+
+//------------------------------------------------------------------------------
+template<class HANDLER> PrimitiveGroup
+cmdExecutor<HANDLER>::toPrimGroup(const uint8* payload) {
+    const gfxCmd::primGroup* pg = (const gfxCmd::primGroup*) payload;
+    return PrimitiveGroup((PrimitiveType::Code) pg->PrimType, pg->BaseElement, pg->NumElements);
+}
+
+} // namespace _priv
+} // namespace Oryol
@@ -9,7 +9,13 @@
     GL context creation, and usually processes host window system
     events (such as input events) and forwards them to Oryol.
 */
-#if (ORYOL_WINDOWS || ORYOL_MACOS || ORYOL_LINUX)
+#if ORYOL_GFX_NULL
+#include "Gfx/Core/displayMgrBase.h"
+namespace Oryol {
+namespace _priv {
+class displayMgr : public displayMgrBase { };
+} }
+#elif (ORYOL_WINDOWS || ORYOL_MACOS || ORYOL_LINUX)
 #include "Gfx/glfw/glfwDisplayMgr.h"
 namespace Oryol {
 namespace _priv {
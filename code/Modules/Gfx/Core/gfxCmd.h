@@ -0,0 +1,80 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::_priv::gfxCmd
+    @ingroup _priv
+    @brief command packet layouts of the GfxCommandBuffer
+
+    Each command in a GfxCommandBuffer is a POD packet starting with a
+    16-byte header, followed by an optional payload. Packets are padded
+    to 8 bytes so that the next header and all payloads are properly
+    aligned. The payload layout depends on the command code.
+
+    @see GfxCommandBuffer, cmdExecutor
+*/
+#include "Core/Types.h"
+
+namespace Oryol {
+namespace _priv {
+
+class gfxCmd {
+public:
+    /// command codes
+    enum Code : uint16 {
+        ApplyDefaultRenderTarget = 0,   ///< no payload
+        ApplyOffscreenRenderTarget,     ///< payload: uint64 Id::Value
+        ApplyViewPort,                  ///< payload: rect
+        ApplyScissorRect,               ///< payload: rect
+        ApplyBlendColor,                ///< payload: float32[4]
+        ApplyDrawState,                 ///< payload: uint64 Id::Value
+        ApplyTexture,                   ///< Arg0: index, payload: uint64 Id::Value
+        ApplyVariable,                  ///< Arg0: index, Type: UniformType, payload: value
+        ApplyVariableArray,             ///< Arg0: index, Arg1: numValues, Type: UniformType, payload: values
+        Clear,                          ///< payload: clear
+        Draw,                           ///< Arg0: primGroupIndex
+        DrawPrimGroup,                  ///< payload: primGroup
+        DrawInstanced,                  ///< Arg0: primGroupIndex, Arg1: numInstances
+        DrawInstancedPrimGroup,         ///< Arg1: numInstances, payload: primGroup
+        UpdateVertices,                 ///< Arg1: numBytes, payload: uint64 Id::Value + data
+        ApplyUniformBlock,              ///< Arg0: slotIndex, Arg1: numBytes, payload: block data
+
+        NumCodes,
+        InvalidCode = 0xFFFF,
+    };
+
+    /// packet alignment
+    static const int32 Alignment = 8;
+
+    /// packet header
+    struct header {
+        uint16 Code;
+        uint16 Type;
+        int32 Arg0;
+        int32 Arg1;
+        int32 Size;         ///< size of the complete packet, including header and padding
+    };
+    /// viewport and scissor rect payload
+    struct rect {
+        int32 X;
+        int32 Y;
+        int32 Width;
+        int32 Height;
+    };
+    /// clear payload
+    struct clear {
+        float32 Color[4];
+        float32 Depth;
+        int32 Channels;
+        int32 Stencil;
+    };
+    /// primitive group payload
+    struct primGroup {
+        int32 PrimType;
+        int32 BaseElement;
+        int32 NumElements;
+    };
+};
+static_assert(sizeof(gfxCmd::header) == 16, "gfxCmd::header must be 16 bytes");
+
+} // namespace _priv
+} // namespace Oryol
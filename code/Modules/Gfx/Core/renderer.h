@@ -5,7 +5,13 @@
     @ingroup _priv
     @brief main rendering API wrapper
  */
-#if ORYOL_OPENGL
+#if ORYOL_GFX_NULL
+#include "Gfx/null/nullRenderer.h"
+namespace Oryol {
+namespace _priv {
+class renderer : public nullRenderer { };
+} }
+#elif ORYOL_OPENGL
 #include "Gfx/gl/glRenderer.h"
 namespace Oryol {
 namespace _priv {
@@ -0,0 +1,129 @@
+//------------------------------------------------------------------------------
+//  streamRingAllocator.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "streamRingAllocator.h"
+#include "Core/Assertion.h"
+#include "Core/Memory/Memory.h"
+
+namespace Oryol {
+namespace _priv {
+
+//------------------------------------------------------------------------------
+streamRingAllocator::streamRingAllocator() :
+cap(0),
+head(0),
+tail(0),
+used(0),
+curFrameBytes(0),
+pendingStart(0),
+numPending(0) {
+    for (int32 i = 0; i < MaxNumPendingFrames; i++) {
+        this->pendingFrameBytes[i] = 0;
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+streamRingAllocator::setup(int32 capacity) {
+    o_assert_dbg(!this->isValid());
+    o_assert_dbg(capacity > 0);
+    this->cap = capacity;
+    this->reset();
+}
+
+//------------------------------------------------------------------------------
+void
+streamRingAllocator::discard() {
+    o_assert_dbg(this->isValid());
+    this->reset();
+    this->cap = 0;
+}
+
+//------------------------------------------------------------------------------
+void
+streamRingAllocator::reset() {
+    this->head = 0;
+    this->tail = 0;
+    this->used = 0;
+    this->curFrameBytes = 0;
+    this->pendingStart = 0;
+    this->numPending = 0;
+}
+
+//------------------------------------------------------------------------------
+/**
+ The free space is either one range between head and tail, or (if
+ head is behind tail) the range from head to the end of the buffer
+ plus the range from the buffer start to tail. An allocation which
+ doesn't fit into the end of the buffer wraps around to offset 0,
+ the skipped bytes at the end are accounted to the current frame.
+*/
+int32
+streamRingAllocator::alloc(int32 numBytes, int32 alignment) {
+    o_assert_dbg(this->isValid());
+    o_assert_dbg(numBytes > 0);
+    o_assert_dbg((alignment > 0) && (0 == (alignment & (alignment - 1))));
+    if ((numBytes > this->cap) || (this->used == this->cap)) {
+        return InvalidIndex;
+    }
+    int32 offset = Memory::RoundUp(this->head, alignment);
+    int32 end = offset + numBytes;
+    if (this->head >= this->tail) {
+        if (end > this->cap) {
+            // wrap around to the start of the buffer
+            offset = 0;
+            end = numBytes;
+            if (end > this->tail) {
+                return InvalidIndex;
+            }
+        }
+    }
+    else if (end > this->tail) {
+        return InvalidIndex;
+    }
+    // head may have wrapped around, then the padding covers the end of the buffer
+    const int32 numUsedBytes = (offset >= this->head) ? (end - this->head) : ((this->cap - this->head) + end);
+    this->head = end;
+    this->used += numUsedBytes;
+    this->curFrameBytes += numUsedBytes;
+    return offset;
+}
+
+//------------------------------------------------------------------------------
+bool
+streamRingAllocator::commitFrame() {
+    o_assert_dbg(this->isValid());
+    if (0 == this->curFrameBytes) {
+        return false;
+    }
+    o_assert2(this->numPending < MaxNumPendingFrames, "streamRingAllocator: too many pending frames, retire frames first!\n");
+    const int32 index = (this->pendingStart + this->numPending) % MaxNumPendingFrames;
+    this->pendingFrameBytes[index] = this->curFrameBytes;
+    this->numPending++;
+    this->curFrameBytes = 0;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+void
+streamRingAllocator::retireFrame() {
+    o_assert_dbg(this->isValid());
+    o_assert_dbg(this->numPending > 0);
+    const int32 numBytes = this->pendingFrameBytes[this->pendingStart];
+    this->pendingStart = (this->pendingStart + 1) % MaxNumPendingFrames;
+    this->numPending--;
+    this->used -= numBytes;
+    o_assert_dbg(this->used >= 0);
+    if (0 == this->used) {
+        // ring is empty, restart at the front for the largest contiguous range
+        this->head = 0;
+        this->tail = 0;
+    }
+    else {
+        this->tail = (this->tail + numBytes) % this->cap;
+    }
+}
+
+} // namespace _priv
+} // namespace Oryol
@@ -0,0 +1,101 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::_priv::streamRingAllocator
+    @ingroup _priv
+    @brief private: frame-fenced ring allocator for shared streaming buffers
+
+    Hands out byte ranges of a fixed-size buffer in ring order. All
+    ranges allocated between two commitFrame() calls belong to the
+    same frame, and are only released as a whole when the renderer
+    calls retireFrame() for the oldest pending frame (e.g. after its
+    GPU fence has signaled). alloc() never blocks, it returns
+    InvalidIndex if the range would overlap memory of a pending frame,
+    it is up to the caller to retire a frame (or orphan the whole
+    buffer with reset()) and try again.
+
+    The allocator doesn't own any memory, it only does the book-keeping.
+*/
+#include "Core/Types.h"
+
+namespace Oryol {
+namespace _priv {
+
+class streamRingAllocator {
+public:
+    /// max number of committed frames which can be pending
+    static const int32 MaxNumPendingFrames = 4;
+    /// alignment of vertex and index data ranges
+    static const int32 DefaultAlignment = 16;
+
+    /// constructor
+    streamRingAllocator();
+
+    /// setup with buffer size in bytes
+    void setup(int32 capacity);
+    /// discard the allocator
+    void discard();
+    /// return true if allocator has been setup
+    bool isValid() const;
+
+    /// allocate an aligned range, returns byte offset or InvalidIndex if no room
+    int32 alloc(int32 numBytes, int32 alignment);
+    /// finish the current frame, returns false if the frame has no allocations
+    bool commitFrame();
+    /// release the ranges of the oldest pending frame
+    void retireFrame();
+    /// release everything, e.g. after the buffer has been orphaned
+    void reset();
+
+    /// get buffer size in bytes
+    int32 capacity() const;
+    /// get number of committed, not yet retired frames
+    int32 numPendingFrames() const;
+    /// get number of used bytes (including alignment and wrap-around padding)
+    int32 numUsedBytes() const;
+    /// get number of bytes allocated in the current frame
+    int32 numFrameBytes() const;
+
+private:
+    int32 cap;
+    int32 head;
+    int32 tail;
+    int32 used;
+    int32 curFrameBytes;
+    int32 pendingFrameBytes[MaxNumPendingFrames];
+    int32 pendingStart;
+    int32 numPending;
+};
+
+//------------------------------------------------------------------------------
+inline bool
+streamRingAllocator::isValid() const {
+    return this->cap > 0;
+}
+
+//------------------------------------------------------------------------------
+inline int32
+streamRingAllocator::capacity() const {
+    return this->cap;
+}
+
+//------------------------------------------------------------------------------
+inline int32
+streamRingAllocator::numPendingFrames() const {
+    return this->numPending;
+}
+
+//------------------------------------------------------------------------------
+inline int32
+streamRingAllocator::numUsedBytes() const {
+    return this->used;
+}
+
+//------------------------------------------------------------------------------
+inline int32
+streamRingAllocator::numFrameBytes() const {
+    return this->curFrameBytes;
+}
+
+} // namespace _priv
+} // namespace Oryol
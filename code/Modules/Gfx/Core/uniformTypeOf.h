@@ -0,0 +1,37 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::_priv::uniformTypeOf
+    @ingroup _priv
+    @brief map a C++ uniform value type to its UniformType code
+    
+    Only specialized for the value types that can be applied with
+    Gfx::ApplyVariable(), using any other type is a compile error.
+*/
+#include "Core/Types.h"
+#include "Gfx/Core/Enums.h"
+#include "glm/vec2.hpp"
+#include "glm/vec3.hpp"
+#include "glm/vec4.hpp"
+#include "glm/mat2x2.hpp"
+#include "glm/mat3x3.hpp"
+#include "glm/mat4x4.hpp"
+
+namespace Oryol {
+namespace _priv {
+
+template<class T> struct uniformTypeOf;
+template<> struct uniformTypeOf<float32> { static const UniformType::Code Type = UniformType::Float; };
+template<> struct uniformTypeOf<glm::vec2> { static const UniformType::Code Type = UniformType::Vec2; };
+template<> struct uniformTypeOf<glm::vec3> { static const UniformType::Code Type = UniformType::Vec3; };
+template<> struct uniformTypeOf<glm::vec4> { static const UniformType::Code Type = UniformType::Vec4; };
+template<> struct uniformTypeOf<int32> { static const UniformType::Code Type = UniformType::Int; };
+template<> struct uniformTypeOf<glm::ivec2> { static const UniformType::Code Type = UniformType::IVec2; };
+template<> struct uniformTypeOf<glm::ivec3> { static const UniformType::Code Type = UniformType::IVec3; };
+template<> struct uniformTypeOf<glm::ivec4> { static const UniformType::Code Type = UniformType::IVec4; };
+template<> struct uniformTypeOf<glm::mat2> { static const UniformType::Code Type = UniformType::Mat2; };
+template<> struct uniformTypeOf<glm::mat3> { static const UniformType::Code Type = UniformType::Mat3; };
+template<> struct uniformTypeOf<glm::mat4> { static const UniformType::Code Type = UniformType::Mat4; };
+
+} // namespace _priv
+} // namespace Oryol
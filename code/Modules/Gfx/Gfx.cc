@@ -4,6 +4,8 @@
 #include "Pre.h"
 #include "Gfx.h"
 #include "Core/Core.h"
+#include "Gfx/Core/cmdExecutor.h"
+#include <cstring>
 
 namespace Oryol {
 
@@ -11,6 +13,59 @@ using namespace _priv;
 
 Gfx::_state* Gfx::state = nullptr;
 
+//------------------------------------------------------------------------------
+/**
+ Command buffer replay handler, forwards the recorded commands
+ to the Gfx facade methods.
+*/
+struct gfxReplayHandler {
+    void ApplyDefaultRenderTarget() {
+        Gfx::ApplyDefaultRenderTarget();
+    }
+    void ApplyOffscreenRenderTarget(const Id& id) {
+        Gfx::ApplyOffscreenRenderTarget(id);
+    }
+    void ApplyViewPort(int32 x, int32 y, int32 w, int32 h) {
+        Gfx::ApplyViewPort(x, y, w, h);
+    }
+    void ApplyScissorRect(int32 x, int32 y, int32 w, int32 h) {
+        Gfx::ApplyScissorRect(x, y, w, h);
+    }
+    void ApplyBlendColor(const glm::vec4& color) {
+        Gfx::ApplyBlendColor(color);
+    }
+    void ApplyDrawState(const Id& id) {
+        Gfx::ApplyDrawState(id);
+    }
+    template<class T> void ApplyVariable(int32 index, const T& value) {
+        Gfx::ApplyVariable(index, value);
+    }
+    template<class T> void ApplyVariableArray(int32 index, const T* values, int32 num) {
+        Gfx::ApplyVariableArray(index, values, num);
+    }
+    void ApplyUniformBlock(int32 slotIndex, const void* data, int32 numBytes) {
+        Gfx::ApplyUniformBlock(slotIndex, data, numBytes);
+    }
+    void UpdateVertices(const Id& id, int32 numBytes, const void* data) {
+        Gfx::UpdateVertices(id, numBytes, data);
+    }
+    void Clear(PixelChannel::Mask channels, const glm::vec4& color, float32 depth, uint8 stencil) {
+        Gfx::Clear(channels, color, depth, stencil);
+    }
+    void Draw(int32 primGroupIndex) {
+        Gfx::Draw(primGroupIndex);
+    }
+    void Draw(const PrimitiveGroup& primGroup) {
+        Gfx::Draw(primGroup);
+    }
+    void DrawInstanced(int32 primGroupIndex, int32 numInstances) {
+        Gfx::DrawInstanced(primGroupIndex, numInstances);
+    }
+    void DrawInstanced(const PrimitiveGroup& primGroup, int32 numInstances) {
+        Gfx::DrawInstanced(primGroup, numInstances);
+    }
+};
+
 //------------------------------------------------------------------------------
 void
 Gfx::Setup(const class GfxSetup& setup) {
@@ -18,7 +73,7 @@ Gfx::Setup(const class GfxSetup& setup) {
     state = Memory::New<_state>();
     state->gfxSetup = setup;
     state->displayManager.SetupDisplay(setup);
-    state->renderer.setup();
+    state->renderer.setup(setup);
     state->resourceContainer.setup(setup, &state->renderer, &state->displayManager);
     state->runLoopId = Core::PreRunLoop()->Add([] {
         state->displayManager.ProcessSystemEvents();
@@ -131,7 +186,34 @@ Gfx::UpdateVertices(const Id& id, int32 numBytes, const void* data) {
     o_trace_scoped(Gfx_UpdateVertices);
     o_assert_dbg(IsValid());
     mesh* msh = state->resourceContainer.lookupMesh(id);
-    state->renderer.updateVertices(msh, numBytes, data);
+    state->renderer.updateVertices(msh, 0, numBytes, data);
+}
+
+//------------------------------------------------------------------------------
+void
+Gfx::UpdateVertices(const Id& id, int32 byteOffset, int32 numBytes, const void* data) {
+    o_trace_scoped(Gfx_UpdateVertices);
+    o_assert_dbg(IsValid());
+    mesh* msh = state->resourceContainer.lookupMesh(id);
+    state->renderer.updateVertices(msh, byteOffset, numBytes, data);
+}
+
+//------------------------------------------------------------------------------
+void
+Gfx::UpdateIndices(const Id& id, int32 numBytes, const void* data) {
+    o_trace_scoped(Gfx_UpdateIndices);
+    o_assert_dbg(IsValid());
+    mesh* msh = state->resourceContainer.lookupMesh(id);
+    state->renderer.updateIndices(msh, 0, numBytes, data);
+}
+
+//------------------------------------------------------------------------------
+void
+Gfx::UpdateIndices(const Id& id, int32 byteOffset, int32 numBytes, const void* data) {
+    o_trace_scoped(Gfx_UpdateIndices);
+    o_assert_dbg(IsValid());
+    mesh* msh = state->resourceContainer.lookupMesh(id);
+    state->renderer.updateIndices(msh, byteOffset, numBytes, data);
 }
 
 //------------------------------------------------------------------------------
@@ -181,4 +263,160 @@ Gfx::DrawInstanced(const PrimitiveGroup& primGroup, int32 numInstances) {
     state->renderer.drawInstanced(primGroup, numInstances);
 }
 
+//------------------------------------------------------------------------------
+void
+Gfx::SubmitCommandBuffer(const GfxCommandBuffer& cmdBuffer) {
+    o_trace_scoped(Gfx_SubmitCommandBuffer);
+    o_assert_dbg(IsValid());
+    gfxReplayHandler handler;
+    cmdExecutor<gfxReplayHandler>::Execute(cmdBuffer, handler);
+}
+
+//------------------------------------------------------------------------------
+/**
+ Submit command buffers which have been recorded in parallel, the
+ command buffers are replayed in array order.
+*/
+void
+Gfx::SubmitCommandBuffers(const GfxCommandBuffer* cmdBuffers, int32 numCmdBuffers) {
+    o_trace_scoped(Gfx_SubmitCommandBuffer);
+    o_assert_dbg(IsValid());
+    o_assert_dbg(cmdBuffers && (numCmdBuffers >= 0));
+    gfxReplayHandler handler;
+    for (int32 i = 0; i < numCmdBuffers; i++) {
+        cmdExecutor<gfxReplayHandler>::Execute(cmdBuffers[i], handler);
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+ Build the sort keys of the queued draws, sort them and replay them
+ pass by pass. ApplyDrawState() is skipped for consecutive draws with
+ the same draw state, and shader variables are skipped if they are
+ identical to the previous draw with the same draw state. This is safe
+ because nothing else changes render state between the draws of a pass.
+
+ Draws with instance data are merged with the following draws which
+ only differ in their instance data. Writing the instance mesh rotates
+ its vertex buffer slot, so the draw state of an instanced batch is
+ always re-applied after the update.
+*/
+void
+Gfx::SubmitRenderQueue(GfxRenderQueue& queue) {
+    o_trace_scoped(Gfx_SubmitRenderQueue);
+    o_assert_dbg(IsValid());
+    o_assert_dbg(!queue.inDraw);
+
+    // the program and mesh of a draw are only known through its draw state
+    for (GfxRenderQueue::item& item : queue.items) {
+        Id prog, msh;
+        const drawState* ds = state->resourceContainer.lookupDrawState(item.drawState);
+        if (nullptr != ds) {
+            prog = ds->Setup.Program;
+            msh = ds->Setup.Mesh;
+        }
+        item.key = GfxRenderQueue::MakeSortKey(item.passIndex, prog, msh, item.drawState, item.depth);
+    }
+    const GfxRenderQueue::sortEntry* sorted = queue.sort();
+
+    gfxReplayHandler handler;
+    const uint8* varData = queue.vars.Data();
+    const int32 numItems = queue.items.Size();
+    int32 numElided = 0;
+    int32 numMerged = 0;
+    int32 sortIndex = 0;
+    for (int32 passIndex = 0; passIndex < queue.passes.Size(); passIndex++) {
+        const GfxRenderQueue::pass& pass = queue.passes[passIndex];
+        if ((0 == pass.numDraws) && (0 == pass.clearChannels)) {
+            numElided++;
+            continue;
+        }
+        if (pass.renderTarget.IsValid()) {
+            ApplyOffscreenRenderTarget(pass.renderTarget);
+        }
+        else {
+            ApplyDefaultRenderTarget();
+        }
+        if (0 != pass.clearChannels) {
+            Clear(pass.clearChannels, pass.clearColor, pass.clearDepth, pass.clearStencil);
+        }
+        const GfxRenderQueue::item* prev = nullptr;
+        while ((sortIndex < numItems) && (queue.items[sorted[sortIndex].index].passIndex == passIndex)) {
+            const int32 batchStart = sortIndex++;
+            const GfxRenderQueue::item& item = queue.items[sorted[batchStart].index];
+            if (item.instSize > 0) {
+                const drawState* ds = state->resourceContainer.lookupDrawState(item.drawState);
+                o_assert_dbg(ds && ds->mesh);
+                const Id& instMeshId = ds->mesh->Setup.InstanceMesh;
+                o_assert2(instMeshId.IsValid(), "GfxRenderQueue: instance data requires a mesh with an InstanceMesh!\n");
+                const VertexBufferAttrs& instAttrs = state->resourceContainer.lookupMesh(instMeshId)->vertexBufferAttrs;
+                o_assert2_dbg(item.instSize == instAttrs.Layout.ByteSize(), "GfxRenderQueue: instance data doesn't match instance mesh layout!\n");
+
+                // find the following draws which can be merged into this one
+                const int32 maxInstances = queue.autoInstancing ? instAttrs.NumVertices : 1;
+                int32 numInstances = 1;
+                while ((numInstances < maxInstances) && (sortIndex < numItems)) {
+                    const GfxRenderQueue::item& next = queue.items[sorted[sortIndex].index];
+                    if ((next.passIndex != passIndex) ||
+                        (next.drawState != item.drawState) ||
+                        (next.primGroupIndex != item.primGroupIndex) ||
+                        (next.numInstances != 0) ||
+                        (next.instSize != item.instSize) ||
+                        (next.varSize != item.varSize) ||
+                        ((item.varSize > 0) && (0 != std::memcmp(varData + next.varOffset, varData + item.varOffset, item.varSize)))) {
+                        break;
+                    }
+                    numInstances++;
+                    sortIndex++;
+                }
+
+                // gather the instance data and render the batch
+                const int32 numBytes = numInstances * item.instSize;
+                queue.instScratch = GfxRenderQueue::reserveBytes(queue.instScratch, queue.instScratchCapacity, numBytes);
+                uint8* dst = queue.instScratch;
+                for (int32 i = batchStart; i < sortIndex; i++) {
+                    const GfxRenderQueue::item& batchItem = queue.items[sorted[i].index];
+                    Memory::Copy(queue.instData + batchItem.instOffset, dst, batchItem.instSize);
+                    dst += batchItem.instSize;
+                }
+                UpdateVertices(instMeshId, numBytes, queue.instScratch);
+                ApplyDrawState(item.drawState);
+                if (item.varSize > 0) {
+                    cmdExecutor<gfxReplayHandler>::Execute(varData + item.varOffset, item.varSize, handler);
+                }
+                DrawInstanced(item.primGroupIndex, numInstances);
+                numMerged += numInstances - 1;
+                prev = &queue.items[sorted[sortIndex - 1].index];
+                continue;
+            }
+            const bool sameDrawState = (nullptr != prev) && (prev->drawState == item.drawState);
+            if (sameDrawState) {
+                numElided++;
+            }
+            else {
+                ApplyDrawState(item.drawState);
+            }
+            if (item.varSize > 0) {
+                if (sameDrawState &&
+                    (prev->varSize == item.varSize) &&
+                    (0 == std::memcmp(varData + prev->varOffset, varData + item.varOffset, item.varSize))) {
+                    numElided += item.numVars;
+                }
+                else {
+                    cmdExecutor<gfxReplayHandler>::Execute(varData + item.varOffset, item.varSize, handler);
+                }
+            }
+            if (item.numInstances > 0) {
+                DrawInstanced(item.primGroupIndex, item.numInstances);
+            }
+            else {
+                Draw(item.primGroupIndex);
+            }
+            prev = &item;
+        }
+    }
+    state->renderer.addElidedStateChanges(numElided);
+    state->renderer.addMergedDraws(numMerged);
+}
+
 } // namespace Oryol
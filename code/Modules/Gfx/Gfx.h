@@ -15,6 +15,9 @@
 #include "Gfx/Setup/GfxSetup.h"
 #include "Gfx/Core/Enums.h"
 #include "Gfx/Core/PrimitiveGroup.h"
+#include "Gfx/Core/GfxCommandBuffer.h"
+#include "Gfx/Core/GfxFrameStats.h"
+#include "Gfx/Core/GfxRenderQueue.h"
 #include "Gfx/Core/renderer.h"
 #include "Gfx/Setup/MeshSetup.h"
 #include "glm/vec4.hpp"
@@ -46,6 +49,8 @@ public:
     static const struct DisplayAttrs& RenderTargetAttrs();
     /// test if an optional feature is supported
     static bool Supports(GfxFeature::Code feat);
+    /// get the rendering statistics of the last committed frame
+    static const GfxFrameStats& FrameStats();
     
     /// resource management
     static GfxResourceContainer& Resource();
@@ -62,17 +67,23 @@ public:
     static void ApplyBlendColor(const glm::vec4& blendColor);
     /// apply draw state to use for rendering
     static void ApplyDrawState(const Id& id);
-    /// apply a shader constant block
-    static void ApplyConstantBlock(const Id& id);
+    /// apply a uniform block (generated by the shader code generator)
+    template<class T> static void ApplyUniformBlock(const T& block);
+    /// apply a uniform block by slot index and raw data
+    static void ApplyUniformBlock(int32 slotIndex, const void* data, int32 numBytes);
     /// apply a shader variable
     template<class T> static void ApplyVariable(int32 index, const T& value);
     /// apply a shader variable array
     template<class T> static void ApplyVariableArray(int32 index, const T* values, int32 numValues);
     
-    /// update dynamic vertex data (only complete replace possible at the moment)
+    /// update dynamic vertex data (complete replace)
     static void UpdateVertices(const Id& id, int32 numBytes, const void* data);
-    /// update dynamic index data (only complete replace possible at the moment)
+    /// update a byte range of dynamic vertex data (not for streamed meshes)
+    static void UpdateVertices(const Id& id, int32 byteOffset, int32 numBytes, const void* data);
+    /// update dynamic index data (complete replace)
     static void UpdateIndices(const Id& id, int32 numBytes, const void* data);
+    /// update a byte range of dynamic index data (not for streamed meshes)
+    static void UpdateIndices(const Id& id, int32 byteOffset, int32 numBytes, const void* data);
     /// read current framebuffer pixels into client memory, this means a PIPELINE STALL!!
     static void ReadPixels(void* ptr, int32 numBytes);
     
@@ -87,6 +98,13 @@ public:
     /// submit a draw call for instanced rendering with direct primitive group
     static void DrawInstanced(const PrimitiveGroup& primGroup, int32 numInstances);
 
+    /// replay the commands recorded in a command buffer
+    static void SubmitCommandBuffer(const GfxCommandBuffer& cmdBuffer);
+    /// replay several command buffers in order
+    static void SubmitCommandBuffers(const GfxCommandBuffer* cmdBuffers, int32 numCmdBuffers);
+    /// sort and replay a render queue with minimal state changes
+    static void SubmitRenderQueue(GfxRenderQueue& queue);
+
     /// commit (and display) the current frame
     static void CommitFrame();
     /// reset internal state (must be called when directly rendering through GL; FIXME: better name?)
@@ -131,6 +149,19 @@ Gfx::ApplyVariableArray(int32 index, const T* values, int32 numValues) {
     state->renderer.applyVariableArray(index, values, numValues);
 }
 
+//------------------------------------------------------------------------------
+template<class T> inline void
+Gfx::ApplyUniformBlock(const T& block) {
+    ApplyUniformBlock(T::_bindSlotIndex, &block, int32(sizeof(T)));
+}
+
+//------------------------------------------------------------------------------
+inline void
+Gfx::ApplyUniformBlock(int32 slotIndex, const void* data, int32 numBytes) {
+    o_assert_dbg(IsValid());
+    state->renderer.applyUniformBlock(slotIndex, data, numBytes);
+}
+
 //------------------------------------------------------------------------------
 inline bool
 Gfx::Supports(GfxFeature::Code feat) {
@@ -138,6 +169,13 @@ Gfx::Supports(GfxFeature::Code feat) {
     return state->renderer.supports(feat);
 }
 
+//------------------------------------------------------------------------------
+inline const GfxFrameStats&
+Gfx::FrameStats() {
+    o_assert_dbg(IsValid());
+    return state->renderer.frameStats();
+}
+
 //------------------------------------------------------------------------------
 inline GfxResourceContainer&
 Gfx::Resource() {
@@ -15,7 +15,8 @@ using namespace _priv;
 GfxResourceContainer::GfxResourceContainer() :
 renderer(nullptr),
 displayMgr(nullptr),
-runLoopId(RunLoop::InvalidId) {
+runLoopId(RunLoop::InvalidId),
+loaderFrameBudget(0) {
     // empty
 }
 
@@ -39,6 +40,8 @@ GfxResourceContainer::setup(const GfxSetup& setup, class renderer* rendr, class
     this->texturePool.Setup(GfxResourceType::Texture, setup.PoolSize(GfxResourceType::Texture));
     this->drawStateFactory.Setup(&this->meshPool, &this->programBundlePool);
     this->drawStatePool.Setup(GfxResourceType::DrawState, setup.PoolSize(GfxResourceType::DrawState));
+    this->loaderScheduler.setup();
+    this->loaderFrameBudget = setup.LoaderFrameBudget;
     
     this->runLoopId = Core::PostRunLoop()->Add([this]() {
         this->update();
@@ -53,10 +56,7 @@ GfxResourceContainer::discard() {
     o_assert_dbg(this->isValid());
     
     Core::PostRunLoop()->Remove(this->runLoopId);
-    for (const auto& loader : this->pendingLoaders) {
-        loader->Cancel();
-    }
-    this->pendingLoaders.Clear();
+    this->loaderScheduler.discard();
     
     resourceContainerBase::discard();
 
@@ -305,8 +305,7 @@ GfxResourceContainer::Load(const Ptr<ResourceLoader>& loader) {
         return resId;
     }
     else {
-        this->pendingLoaders.Add(loader);
-        resId = loader->Start();
+        resId = this->loaderScheduler.add(loader);
         return resId;
     }
 }
@@ -404,14 +403,8 @@ GfxResourceContainer::update() {
     this->texturePool.Update();
     this->drawStatePool.Update();
     
-    // trigger loaders, and remove from pending array if finished
-    for (int32 i = this->pendingLoaders.Size() - 1; i >= 0; i--) {
-        const auto& loader = this->pendingLoaders[i];
-        ResourceState::Code state = loader->Continue();
-        if (ResourceState::Pending != state) {
-            this->pendingLoaders.Erase(i);
-        }
-    }
+    // continue ready loaders within the per-frame time budget
+    this->loaderScheduler.update(this->loaderFrameBudget);
 }
 
 //------------------------------------------------------------------------------
@@ -466,6 +459,14 @@ GfxResourceContainer::QueryPoolInfo(GfxResourceType::Code resType) const {
     }
 }
 
+//------------------------------------------------------------------------------
+const ResourceLoaderStats&
+GfxResourceContainer::QueryLoaderStats() const {
+    o_assert_dbg(this->isValid());
+    o_assert_dbg(Core::IsMainThread());
+    return this->loaderScheduler.stats();
+}
+
 //------------------------------------------------------------------------------
 int32
 GfxResourceContainer::QueryFreeSlots(GfxResourceType::Code resourceType) const {
@@ -13,6 +13,8 @@
 #include "Resource/Core/resourceContainerBase.h"
 #include "Resource/Core/SetupAndStream.h"
 #include "Resource/ResourceInfo.h"
+#include "Resource/ResourceLoaderStats.h"
+#include "Resource/Core/loaderScheduler.h"
 #include "Gfx/Setup/GfxSetup.h"
 #include "Gfx/Resource/meshPool.h"
 #include "Gfx/Resource/meshFactory.h"
@@ -53,6 +55,8 @@ public:
     ResourceInfo QueryResourceInfo(const Id& id) const;
     /// query resource pool info (slow)
     ResourcePoolInfo QueryPoolInfo(GfxResourceType::Code resType) const;
+    /// query statistics of the asynchronous resource loaders
+    const ResourceLoaderStats& QueryLoaderStats() const;
     /// destroy resources by label
     void Destroy(ResourceLabel label);
     
@@ -94,7 +98,8 @@ private:
     class _priv::texturePool texturePool;
     class _priv::drawStatePool drawStatePool;
     RunLoop::Id runLoopId;
-    Array<Ptr<ResourceLoader>> pendingLoaders;
+    _priv::loaderScheduler loaderScheduler;
+    int32 loaderFrameBudget;
 };
 
 //------------------------------------------------------------------------------
@@ -9,7 +9,13 @@
     index buffer, and one or more primitive groups.
     @todo: describe mesh creation etc...
 */
-#if ORYOL_OPENGL
+#if ORYOL_GFX_NULL
+#include "Gfx/null/nullMesh.h"
+namespace Oryol {
+namespace _priv {
+class mesh : public nullMesh { };
+} }
+#elif ORYOL_OPENGL
 #include "Gfx/gl/glMesh.h"
 namespace Oryol {
 namespace _priv {
@@ -9,7 +9,10 @@ namespace _priv {
 
 //------------------------------------------------------------------------------
 meshBase::meshBase() :
-numPrimGroups(0) {
+numPrimGroups(0),
+streamVertexOffset(InvalidIndex),
+streamIndexOffset(InvalidIndex),
+streamFrameIndex(InvalidIndex) {
     // empty
 }
 
@@ -20,6 +23,9 @@ meshBase::Clear() {
     this->indexBufferAttrs = IndexBufferAttrs();
     this->primGroups.Fill(PrimitiveGroup());
     this->numPrimGroups = 0;
+    this->streamVertexOffset = InvalidIndex;
+    this->streamIndexOffset = InvalidIndex;
+    this->streamFrameIndex = InvalidIndex;
     resourceBase::Clear();
 }
 
@@ -33,6 +33,12 @@ public:
     int32 numPrimGroups;
     /// primitive groups (FIXME: replace with StaticArray<>)
     StaticArray<PrimitiveGroup, MaxNumPrimGroups> primGroups;
+    /// vertex data offset in the shared stream vertex buffer (only UseSharedStreamBuffers)
+    int32 streamVertexOffset;
+    /// index data offset in the shared stream index buffer (only UseSharedStreamBuffers)
+    int32 streamIndexOffset;
+    /// renderer frame index of the last stream buffer update, data is only valid in that frame
+    int32 streamFrameIndex;
     
     /// clear the object
     void Clear();
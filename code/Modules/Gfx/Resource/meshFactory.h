@@ -6,7 +6,12 @@
     @brief private: resource factory for Mesh objects
     @todo describe meshFactory
 */
-#if ORYOL_OPENGL
+#if ORYOL_GFX_NULL
+#include "Gfx/null/nullMeshFactory.h"
+namespace Oryol {
+namespace _priv {
+class meshFactory : public nullMeshFactory { };
+#elif ORYOL_OPENGL
 #include "Gfx/gl/glMeshFactory.h"
 namespace Oryol {
 namespace _priv {
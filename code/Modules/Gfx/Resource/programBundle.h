@@ -11,7 +11,14 @@
     bundle also maps shader variables to common slot indices across
     all contained programs.
 */
-#if ORYOL_OPENGL
+#if ORYOL_GFX_NULL
+#include "Gfx/null/nullProgramBundle.h"
+namespace Oryol {
+namespace _priv {
+class programBundle : public nullProgramBundle { };
+} // namespace _priv
+} // namespace Oryol
+#elif ORYOL_OPENGL
 #include "Gfx/gl/glProgramBundle.h"
 namespace Oryol {
 namespace _priv {
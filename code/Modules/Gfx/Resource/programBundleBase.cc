@@ -0,0 +1,93 @@
+//------------------------------------------------------------------------------
+//  programBundleBase.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "programBundleBase.h"
+#include "Core/Memory/Memory.h"
+#include <cstring>
+
+namespace Oryol {
+namespace _priv {
+
+//------------------------------------------------------------------------------
+programBundleBase::programBundleBase() :
+blockShadows(nullptr),
+blockShadowStride(0),
+numBlockShadowPrograms(0) {
+    for (int32 i = 0; i < ProgramBundleSetup::MaxNumUniformBlocks; i++) {
+        this->blockOffsets[i] = 0;
+        this->blockSizes[i] = 0;
+    }
+}
+
+//------------------------------------------------------------------------------
+programBundleBase::~programBundleBase() {
+    if (this->blockShadows) {
+        Memory::Free(this->blockShadows);
+        this->blockShadows = nullptr;
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+programBundleBase::Clear() {
+    if (this->blockShadows) {
+        Memory::Free(this->blockShadows);
+        this->blockShadows = nullptr;
+    }
+    this->blockShadowStride = 0;
+    this->numBlockShadowPrograms = 0;
+    for (int32 i = 0; i < ProgramBundleSetup::MaxNumUniformBlocks; i++) {
+        this->blockOffsets[i] = 0;
+        this->blockSizes[i] = 0;
+    }
+    resourceBase::Clear();
+}
+
+//------------------------------------------------------------------------------
+/**
+ Each program gets a flag per block slot which is set once the block has
+ been uploaded, followed by the shadow copies of its blocks.
+*/
+void
+programBundleBase::setupUniformBlocks(int32 numPrograms) {
+    o_assert_dbg(nullptr == this->blockShadows);
+    o_assert_dbg(numPrograms > 0);
+
+    int32 offset = ProgramBundleSetup::MaxNumUniformBlocks;
+    const int32 numBlocks = this->Setup.NumUniformBlocks();
+    for (int32 i = 0; i < numBlocks; i++) {
+        const int16 slotIndex = this->Setup.UniformBlockSlot(i);
+        o_assert_dbg(0 == this->blockSizes[slotIndex]);
+        this->blockOffsets[slotIndex] = offset;
+        this->blockSizes[slotIndex] = this->Setup.UniformBlockSize(i);
+        offset += this->blockSizes[slotIndex];
+    }
+    if (numBlocks > 0) {
+        this->blockShadowStride = offset;
+        this->numBlockShadowPrograms = numPrograms;
+        const int32 allocSize = numPrograms * offset;
+        this->blockShadows = (uint8*) Memory::Alloc(allocSize);
+        Memory::Clear(this->blockShadows, allocSize);
+    }
+}
+
+//------------------------------------------------------------------------------
+bool
+programBundleBase::updateUniformBlock(int32 progIndex, int32 slotIndex, const void* data, int32 numBytes) {
+    o_assert_range_dbg(progIndex, this->numBlockShadowPrograms);
+    o_assert_range_dbg(slotIndex, ProgramBundleSetup::MaxNumUniformBlocks);
+    o_assert_dbg(data && (numBytes == this->blockSizes[slotIndex]));
+
+    uint8* progShadow = this->blockShadows + progIndex * this->blockShadowStride;
+    uint8* blockShadow = progShadow + this->blockOffsets[slotIndex];
+    if (progShadow[slotIndex] && (0 == std::memcmp(blockShadow, data, numBytes))) {
+        return false;
+    }
+    progShadow[slotIndex] = 1;
+    Memory::Copy(data, blockShadow, numBytes);
+    return true;
+}
+
+} // namespace _priv
+} // namespace Oryol
@@ -4,12 +4,48 @@
     @class Oryol::_priv::programBundleBase
     @ingroup _priv
     @brief private: program bundle resource base class
+
+    Keeps a CPU-side shadow copy of the last uploaded content of each
+    uniform block in each program, so that the renderer only needs
+    to upload uniform blocks which have actually changed.
 */
 #include "Resource/Core/resourceBase.h"
 #include "Gfx/Setup/ProgramBundleSetup.h"
 
 namespace Oryol {
 namespace _priv {
-class programBundleBase : public resourceBase<ProgramBundleSetup> { };
+
+class programBundleBase : public resourceBase<ProgramBundleSetup> {
+public:
+    /// constructor
+    programBundleBase();
+    /// destructor
+    ~programBundleBase();
+
+    /// clear the object, frees the uniform block shadow copies
+    void Clear();
+
+    /// allocate uniform block shadow copies for a number of programs (from Setup)
+    void setupUniformBlocks(int32 numPrograms);
+    /// get byte size of a uniform block slot (0 if the slot isn't used)
+    int32 getUniformBlockSize(int32 slotIndex) const;
+    /// compare with and update the shadow copy, return true if the block must be uploaded
+    bool updateUniformBlock(int32 progIndex, int32 slotIndex, const void* data, int32 numBytes);
+
+private:
+    uint8* blockShadows;
+    int32 blockShadowStride;
+    int32 numBlockShadowPrograms;
+    int32 blockOffsets[ProgramBundleSetup::MaxNumUniformBlocks];
+    int32 blockSizes[ProgramBundleSetup::MaxNumUniformBlocks];
+};
+
+//------------------------------------------------------------------------------
+inline int32
+programBundleBase::getUniformBlockSize(int32 slotIndex) const {
+    o_assert_range_dbg(slotIndex, ProgramBundleSetup::MaxNumUniformBlocks);
+    return this->blockSizes[slotIndex];
+}
+
 } // namespace _priv
 } // namespace Oryol
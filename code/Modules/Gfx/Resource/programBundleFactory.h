@@ -5,7 +5,14 @@
     @ingroup _priv
     @brief private: resource factory for program bundle objects
 */
-#if ORYOL_OPENGL
+#if ORYOL_GFX_NULL
+#include "Gfx/null/nullProgramBundleFactory.h"
+namespace Oryol {
+namespace _priv {
+class programBundleFactory : public nullProgramBundleFactory { };
+} // namespace _priv
+} // namespace Oryol
+#elif ORYOL_OPENGL
 #include "Gfx/gl/glProgramBundleFactory.h"
 namespace Oryol {
 namespace _priv {
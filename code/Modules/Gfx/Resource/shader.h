@@ -8,7 +8,14 @@
     A shader object holds a compiled vertex- or fragment-shader. Alone it
     is useless, but it is the basis for linked shader programs.
 */
-#if ORYOL_OPENGL
+#if ORYOL_GFX_NULL
+#include "Gfx/Resource/shaderBase.h"
+namespace Oryol {
+namespace _priv {
+class shader : public shaderBase { };
+} // namespace _priv
+} // namespace Oryol
+#elif ORYOL_OPENGL
 #include "Gfx/gl/glShader.h"
 namespace Oryol {
 namespace _priv {
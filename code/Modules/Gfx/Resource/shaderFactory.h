@@ -5,7 +5,14 @@
     @ingroup _priv
     @brief private: resource factory for shader objects
 */
-#if ORYOL_OPENGL
+#if ORYOL_GFX_NULL
+#include "Gfx/null/nullShaderFactory.h"
+namespace Oryol {
+namespace _priv {
+class shaderFactory : public nullShaderFactory { };
+} // namespace _priv
+} // namespace Oryol
+#elif ORYOL_OPENGL
 #include "Gfx/gl/glShaderFactory.h"
 namespace Oryol {
 namespace _priv {
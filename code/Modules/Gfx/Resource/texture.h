@@ -8,7 +8,13 @@
     A texture object can be a normal 2D, 3D or cube texture, as well
     as a render target with optional depth buffer.
 */
-#if ORYOL_OPENGL
+#if ORYOL_GFX_NULL
+#include "Gfx/Resource/textureBase.h"
+namespace Oryol {
+namespace _priv {
+class texture : public textureBase { };
+} }
+#elif ORYOL_OPENGL
 #include "Gfx/gl/glTexture.h"
 namespace Oryol {
 namespace _priv {
@@ -6,7 +6,12 @@
     @brief private: resource factory to texture objects
     @todo describe texture factory
 */
-#if ORYOL_OPENGL
+#if ORYOL_GFX_NULL
+#include "Gfx/null/nullTextureFactory.h"
+namespace Oryol {
+namespace _priv {
+class textureFactory : public nullTextureFactory { };
+#elif ORYOL_OPENGL
 #include "Gfx/gl/glTextureFactory.h"
 namespace Oryol {
 namespace _priv {
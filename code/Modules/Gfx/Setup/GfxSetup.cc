@@ -11,7 +11,6 @@ namespace Oryol {
 GfxSetup::GfxSetup() {
     for (int32 i = 0; i < GfxResourceType::NumResourceTypes; i++) {
         this->poolSizes[i] = DefaultPoolSize;
-        this->throttling[i] = 0;    // unthrottled
     }
 }
 
@@ -90,18 +89,4 @@ GfxSetup::PoolSize(GfxResourceType::Code type) const {
     return this->poolSizes[type];
 }
     
-//------------------------------------------------------------------------------
-void
-GfxSetup::SetThrottling(GfxResourceType::Code type, int32 maxCreatePerFrame) {
-    o_assert_range(type, GfxResourceType::NumResourceTypes);
-    this->throttling[type] = maxCreatePerFrame;
-}
-    
-//------------------------------------------------------------------------------
-int32
-GfxSetup::Throttling(GfxResourceType::Code type) const {
-    o_assert_range(type, GfxResourceType::NumResourceTypes);
-    return this->throttling[type];
-}
-    
 } // namespace Oryol
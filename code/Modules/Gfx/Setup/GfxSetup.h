@@ -44,14 +44,10 @@ public:
     /// window title
     String Title = "Oryol";
     
-    /// tweak resource pool size for a rendering resource type
+    /// tweak initial resource pool size for a rendering resource type (pools grow on demand)
     void SetPoolSize(GfxResourceType::Code type, int32 poolSize);
     /// get resource pool size for a rendering resource type
     int32 PoolSize(GfxResourceType::Code type) const;
-    /// tweak resource throttling value for a resource type, 0 means unthrottled
-    void SetThrottling(GfxResourceType::Code type, int32 maxCreatePerFrame);
-    /// get resource throttling value
-    int32 Throttling(GfxResourceType::Code type) const;
     
     /// initial resource label stack capacity
     int32 ResourceLabelStackCapacity = 256;
@@ -59,6 +55,12 @@ public:
     int32 ResourceRegistryCapacity = 256;
     /// number of resource creation threads (must be == number of IO lanes)
     int32 NumResourceCreationThreads = 4;
+    /// size of the shared stream vertex buffer in bytes (see MeshSetup::Streamed())
+    int32 StreamVertexBufferSize = 4 * 1024 * 1024;
+    /// size of the shared stream index buffer in bytes (see MeshSetup::Streamed())
+    int32 StreamIndexBufferSize = 1024 * 1024;
+    /// max time in microseconds spent per frame continuing async resource loaders (0: unlimited)
+    int32 LoaderFrameBudget = 0;
 
     /// get DisplayAttrs object initialized to setup values
     DisplayAttrs GetDisplayAttrs() const;
@@ -70,7 +72,6 @@ private:
     static const int32 DefaultPoolSize = 128;
     
     int32 poolSizes[GfxResourceType::NumResourceTypes];
-    int32 throttling[GfxResourceType::NumResourceTypes];
 };
     
 } // namespace Oryol
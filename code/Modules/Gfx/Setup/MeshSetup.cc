@@ -13,6 +13,7 @@ IndexUsage(Usage::InvalidUsage),
 NumVertices(0),
 NumIndices(0),
 IndicesType(IndexType::None),
+UseSharedStreamBuffers(false),
 Locator(Locator::NonShared()),
 StreamVertexOffset(0),
 StreamIndexOffset(InvalidIndex),
@@ -74,6 +75,20 @@ MeshSetup::Empty(int32 numVertices,
     return setup;
 }
 
+//------------------------------------------------------------------------------
+/**
+ A streamed mesh doesn't own any GPU buffers, each UpdateVertices()
+ and UpdateIndices() sub-allocates a new range in the shared stream
+ buffers. The data is only valid until the end of the frame, so a
+ streamed mesh must be updated in each frame it is rendered.
+*/
+MeshSetup
+MeshSetup::Streamed(int32 numVertices, IndexType::Code indexType, int32 numIndices) {
+    MeshSetup setup = Empty(numVertices, Usage::Stream, indexType, numIndices, Usage::Stream);
+    setup.UseSharedStreamBuffers = true;
+    return setup;
+}
+
 //------------------------------------------------------------------------------
 MeshSetup
 MeshSetup::FullScreenQuad() {
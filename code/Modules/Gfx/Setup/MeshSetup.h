@@ -24,6 +24,8 @@ public:
     static MeshSetup FromStream(const MeshSetup& blueprint);
     /// setup empty mesh (mostly for dynamic streaming)
     static MeshSetup Empty(int32 numVertices, Usage::Code vertexUsage, IndexType::Code indexType=IndexType::None, int32 numIndices=0, Usage::Code indexUsage=Usage::InvalidUsage);
+    /// setup empty stream mesh which lives in the shared stream buffers
+    static MeshSetup Streamed(int32 numVertices, IndexType::Code indexType=IndexType::None, int32 numIndices=0);
     /// setup a fullscreen quad mesh
     static MeshSetup FullScreenQuad();
     
@@ -62,6 +64,8 @@ public:
     
     /// optional instance data mesh
     Id InstanceMesh;
+    /// sub-allocate vertex and index data from the shared stream buffers (see GfxSetup)
+    bool UseSharedStreamBuffers;
     
     /// resource locator (only for LoadFromFile)
     class Locator Locator;
@@ -11,7 +11,8 @@ namespace Oryol {
 ProgramBundleSetup::ProgramBundleSetup() :
 Locator(Locator::NonShared()),
 numProgramEntries(0),
-numUniformEntries(0) {
+numUniformEntries(0),
+numUniformBlockEntries(0) {
     // empty
 }
 
@@ -19,7 +20,8 @@ numUniformEntries(0) {
 ProgramBundleSetup::ProgramBundleSetup(const class Locator& locator) :
 Locator(locator),
 numProgramEntries(0),
-numUniformEntries(0) {
+numUniformEntries(0),
+numUniformBlockEntries(0) {
     // empty
 }
 
@@ -86,6 +88,20 @@ ProgramBundleSetup::AddTextureUniform(const String& uniformName, int16 slotIndex
     entry.isTexture = true;
 }
 
+//------------------------------------------------------------------------------
+void
+ProgramBundleSetup::AddUniformBlock(const String& blockName, int16 slotIndex, int32 byteSize) {
+    o_assert(this->numUniformBlockEntries < MaxNumUniformBlocks);
+    o_assert(blockName.IsValid());
+    o_assert_range(slotIndex, MaxNumUniformBlocks);
+    o_assert((byteSize > 0) && (0 == (byteSize & 15)));
+
+    uniformBlockEntry& entry = this->uniformBlockEntries[this->numUniformBlockEntries++];
+    entry.blockName = blockName;
+    entry.slotIndex = slotIndex;
+    entry.byteSize = byteSize;
+}
+
 //------------------------------------------------------------------------------
 int32
 ProgramBundleSetup::NumPrograms() const {
@@ -156,4 +172,31 @@ ProgramBundleSetup::IsTextureUniform(int32 uniformIndex) const {
     return this->uniformEntries[uniformIndex].isTexture;
 }
 
+//------------------------------------------------------------------------------
+int32
+ProgramBundleSetup::NumUniformBlocks() const {
+    return this->numUniformBlockEntries;
+}
+
+//------------------------------------------------------------------------------
+const String&
+ProgramBundleSetup::UniformBlockName(int32 blockIndex) const {
+    o_assert_range(blockIndex, this->numUniformBlockEntries);
+    return this->uniformBlockEntries[blockIndex].blockName;
+}
+
+//------------------------------------------------------------------------------
+int16
+ProgramBundleSetup::UniformBlockSlot(int32 blockIndex) const {
+    o_assert_range(blockIndex, this->numUniformBlockEntries);
+    return this->uniformBlockEntries[blockIndex].slotIndex;
+}
+
+//------------------------------------------------------------------------------
+int32
+ProgramBundleSetup::UniformBlockSize(int32 blockIndex) const {
+    o_assert_range(blockIndex, this->numUniformBlockEntries);
+    return this->uniformBlockEntries[blockIndex].byteSize;
+}
+
 } // namespace Oryol
@@ -15,6 +15,9 @@ namespace Oryol {
     
 class ProgramBundleSetup {
 public:
+    /// maximum number of uniform blocks in a program bundle
+    static const int32 MaxNumUniformBlocks = 4;
+
     /// default constructor
     ProgramBundleSetup();
     /// construct with resource locator
@@ -31,6 +34,8 @@ public:
     void AddUniform(const String& uniformName, int16 slotIndex);
     /// bind a shader uniform name to a texture variable slot
     void AddTextureUniform(const String& uniformName, int16 slotIndex);
+    /// bind a shader uniform block name to a block slot (byte size must be a multiple of 16)
+    void AddUniformBlock(const String& blockName, int16 slotIndex, int32 byteSize);
     
     /// get number of programs
     int32 NumPrograms() const;
@@ -53,6 +58,15 @@ public:
     bool IsTextureUniform(int32 uniformIndex) const;
     /// get uniform slot index
     int16 UniformSlot(int32 uniformIndex) const;
+
+    /// get number of uniform blocks
+    int32 NumUniformBlocks() const;
+    /// get uniform block name at index
+    const String& UniformBlockName(int32 blockIndex) const;
+    /// get uniform block slot index
+    int16 UniformBlockSlot(int32 blockIndex) const;
+    /// get uniform block byte size
+    int32 UniformBlockSize(int32 blockIndex) const;
     
 private:
     static const int32 MaxNumProgramEntries = 8;
@@ -77,10 +91,19 @@ private:
         int16 slotIndex;
     };
     
+    struct uniformBlockEntry {
+        uniformBlockEntry() : slotIndex(InvalidIndex), byteSize(0) {};
+        String blockName;
+        int16 slotIndex;
+        int32 byteSize;
+    };
+    
     int32 numProgramEntries;
     int32 numUniformEntries;
+    int32 numUniformBlockEntries;
     programEntry programEntries[MaxNumProgramEntries];
     uniformEntry uniformEntries[MaxNumUniformEntries];
+    uniformBlockEntry uniformBlockEntries[MaxNumUniformBlocks];
 };
     
 } // namespace Oryol
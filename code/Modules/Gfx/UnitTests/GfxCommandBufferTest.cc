@@ -0,0 +1,315 @@
+//------------------------------------------------------------------------------
+//  GfxCommandBufferTest.cc
+//  Test command buffer recording and replay, and measure record and
+//  replay cost per draw (CPU only, doesn't need a renderer).
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "UnitTest++/src/UnitTest++.h"
+#include "Core/Log.h"
+#include "Core/Threading/JobSystem.h"
+#include "Gfx/Core/GfxCommandBuffer.h"
+#include "Gfx/Core/cmdExecutor.h"
+#include "glm/mat4x4.hpp"
+#include <chrono>
+
+using namespace Oryol;
+using namespace Oryol::_priv;
+
+// a replay handler which checks and counts the replayed commands
+class countingHandler {
+public:
+    int32 NumCommands = 0;
+    int32 NumDraws = 0;
+    int32 NumInstances = 0;
+    uint64 LastDrawState = 0;
+    uint64 LastTexture = 0;
+    int32 LastTextureIndex = -1;
+    int32 ViewPort[4] = { 0, 0, 0, 0 };
+    int32 ScissorRect[4] = { 0, 0, 0, 0 };
+    glm::vec4 BlendColor;
+    glm::vec4 ClearColor;
+    float32 ClearDepth = 0.0f;
+    int32 ClearStencil = 0;
+    PixelChannel::Mask ClearChannels = 0;
+    float64 FloatSum = 0.0;
+    int32 IntSum = 0;
+    int32 NumArrayValues = 0;
+    int32 NumVertexBytes = 0;
+    int32 LastBlockSlot = -1;
+    float32 BlockSum = 0.0f;
+    PrimitiveGroup LastPrimGroup;
+
+    void ApplyDefaultRenderTarget() {
+        this->NumCommands++;
+    }
+    void ApplyOffscreenRenderTarget(const Id& id) {
+        this->NumCommands++;
+    }
+    void ApplyViewPort(int32 x, int32 y, int32 w, int32 h) {
+        this->NumCommands++;
+        this->ViewPort[0] = x; this->ViewPort[1] = y; this->ViewPort[2] = w; this->ViewPort[3] = h;
+    }
+    void ApplyScissorRect(int32 x, int32 y, int32 w, int32 h) {
+        this->NumCommands++;
+        this->ScissorRect[0] = x; this->ScissorRect[1] = y; this->ScissorRect[2] = w; this->ScissorRect[3] = h;
+    }
+    void ApplyBlendColor(const glm::vec4& color) {
+        this->NumCommands++;
+        this->BlendColor = color;
+    }
+    void ApplyDrawState(const Id& id) {
+        this->NumCommands++;
+        this->LastDrawState = id.Value;
+    }
+    void ApplyVariable(int32 index, const Id& id) {
+        this->NumCommands++;
+        this->LastTextureIndex = index;
+        this->LastTexture = id.Value;
+    }
+    void ApplyVariable(int32 index, const float32& val) {
+        this->NumCommands++;
+        this->FloatSum += val;
+    }
+    void ApplyVariable(int32 index, const int32& val) {
+        this->NumCommands++;
+        this->IntSum += val;
+    }
+    void ApplyVariable(int32 index, const glm::vec4& val) {
+        this->NumCommands++;
+        this->FloatSum += val.x + val.y + val.z + val.w;
+    }
+    void ApplyVariable(int32 index, const glm::mat4& val) {
+        this->NumCommands++;
+        this->FloatSum += val[3][0] + val[3][1] + val[3][2];
+    }
+    template<class T> void ApplyVariable(int32 index, const T& val) {
+        this->NumCommands++;
+    }
+    template<class T> void ApplyVariableArray(int32 index, const T* values, int32 num) {
+        this->NumCommands++;
+        this->NumArrayValues += num;
+    }
+    void ApplyUniformBlock(int32 slotIndex, const void* data, int32 numBytes) {
+        this->NumCommands++;
+        this->LastBlockSlot = slotIndex;
+        const float32* values = (const float32*) data;
+        for (int32 i = 0; i < int32(numBytes / sizeof(float32)); i++) {
+            this->BlockSum += values[i];
+        }
+    }
+    void UpdateVertices(const Id& id, int32 numBytes, const void* data) {
+        this->NumCommands++;
+        this->NumVertexBytes += numBytes;
+    }
+    void Clear(PixelChannel::Mask channels, const glm::vec4& color, float32 depth, uint8 stencil) {
+        this->NumCommands++;
+        this->ClearChannels = channels;
+        this->ClearColor = color;
+        this->ClearDepth = depth;
+        this->ClearStencil = stencil;
+    }
+    void Draw(int32 primGroupIndex) {
+        this->NumCommands++;
+        this->NumDraws++;
+    }
+    void Draw(const PrimitiveGroup& primGroup) {
+        this->NumCommands++;
+        this->NumDraws++;
+        this->LastPrimGroup = primGroup;
+    }
+    void DrawInstanced(int32 primGroupIndex, int32 numInstances) {
+        this->NumCommands++;
+        this->NumDraws++;
+        this->NumInstances += numInstances;
+    }
+    void DrawInstanced(const PrimitiveGroup& primGroup, int32 numInstances) {
+        this->NumCommands++;
+        this->NumDraws++;
+        this->NumInstances += numInstances;
+        this->LastPrimGroup = primGroup;
+    }
+};
+
+//------------------------------------------------------------------------------
+static void
+recordDraws(GfxCommandBuffer& cmdBuffer, int32 first, int32 num) {
+    const Id drawState(1, 2, 3);
+    glm::mat4 mvp;
+    for (int32 i = first; i < (first + num); i++) {
+        // a typical per-object draw: draw state, model-view-proj, color, draw
+        if (0 == (i & 15)) {
+            cmdBuffer.ApplyDrawState(drawState);
+        }
+        mvp[3][0] = float32(i);
+        cmdBuffer.ApplyVariable(0, mvp);
+        cmdBuffer.ApplyVariable(1, glm::vec4(1.0f, 0.0f, 0.0f, 1.0f));
+        cmdBuffer.Draw(0);
+    }
+}
+
+//------------------------------------------------------------------------------
+TEST(GfxCommandBufferTest) {
+    GfxCommandBuffer cmdBuffer;
+    CHECK(cmdBuffer.Empty());
+    CHECK(cmdBuffer.NumCommands() == 0);
+    CHECK(cmdBuffer.Capacity() == 0);
+
+    const Id ds(1, 2, 3);
+    const Id tex(4, 5, 6);
+    const float32 floats[3] = { 1.0f, 2.0f, 3.0f };
+    const uint8 vertices[20] = { 0 };
+    const glm::vec4 block[2] = { glm::vec4(1.0f, 2.0f, 3.0f, 4.0f), glm::vec4(5.0f) };
+    cmdBuffer.ApplyDefaultRenderTarget();
+    cmdBuffer.ApplyViewPort(1, 2, 3, 4);
+    cmdBuffer.ApplyScissorRect(5, 6, 7, 8);
+    cmdBuffer.ApplyBlendColor(glm::vec4(0.5f, 0.25f, 0.125f, 1.0f));
+    cmdBuffer.Clear(PixelChannel::RGBA, glm::vec4(0.1f, 0.2f, 0.3f, 0.4f), 0.5f, 7);
+    cmdBuffer.ApplyDrawState(ds);
+    cmdBuffer.ApplyVariable(3, tex);
+    cmdBuffer.ApplyVariable(0, 1.5f);
+    cmdBuffer.ApplyVariable(1, 3);
+    cmdBuffer.ApplyVariable(2, glm::vec4(1.0f, 1.0f, 1.0f, 1.0f));
+    cmdBuffer.ApplyVariable(4, glm::vec3(1.0f, 2.0f, 3.0f));
+    cmdBuffer.ApplyVariableArray(5, floats, 3);
+    cmdBuffer.ApplyUniformBlock(1, block, sizeof(block));
+    cmdBuffer.UpdateVertices(ds, sizeof(vertices), vertices);
+    cmdBuffer.Draw(0);
+    cmdBuffer.Draw(PrimitiveGroup(PrimitiveType::Triangles, 3, 6));
+    cmdBuffer.DrawInstanced(0, 10);
+    cmdBuffer.DrawInstanced(PrimitiveGroup(PrimitiveType::Lines, 9, 12), 5);
+    CHECK(!cmdBuffer.Empty());
+    CHECK(cmdBuffer.NumCommands() == 18);
+    CHECK(cmdBuffer.NumDraws() == 4);
+    CHECK((cmdBuffer.Size() & 7) == 0);
+
+    countingHandler handler;
+    CHECK(cmdExecutor<countingHandler>::Execute(cmdBuffer, handler) == 18);
+    CHECK(handler.NumCommands == 18);
+    CHECK(handler.NumDraws == 4);
+    CHECK(handler.NumInstances == 15);
+    CHECK(handler.ViewPort[0] == 1 && handler.ViewPort[3] == 4);
+    CHECK(handler.ScissorRect[0] == 5 && handler.ScissorRect[3] == 8);
+    CHECK(handler.BlendColor == glm::vec4(0.5f, 0.25f, 0.125f, 1.0f));
+    CHECK(handler.ClearChannels == PixelChannel::RGBA);
+    CHECK(handler.ClearColor == glm::vec4(0.1f, 0.2f, 0.3f, 0.4f));
+    CHECK(handler.ClearDepth == 0.5f);
+    CHECK(handler.ClearStencil == 7);
+    CHECK(handler.LastDrawState == ds.Value);
+    CHECK(handler.LastTextureIndex == 3);
+    CHECK(handler.LastTexture == tex.Value);
+    CHECK(handler.FloatSum == 5.5f);
+    CHECK(handler.IntSum == 3);
+    CHECK(handler.NumArrayValues == 3);
+    CHECK(handler.NumVertexBytes == 20);
+    CHECK(handler.LastBlockSlot == 1);
+    CHECK(handler.BlockSum == 30.0f);
+    CHECK(handler.LastPrimGroup.PrimType == PrimitiveType::Lines);
+    CHECK(handler.LastPrimGroup.BaseElement == 9);
+    CHECK(handler.LastPrimGroup.NumElements == 12);
+
+    // merge command buffers
+    GfxCommandBuffer merged;
+    merged.Append(cmdBuffer);
+    merged.Append(cmdBuffer);
+    CHECK(merged.NumCommands() == 36);
+    CHECK(merged.NumDraws() == 8);
+    CHECK(merged.Size() == 2 * cmdBuffer.Size());
+    countingHandler mergedHandler;
+    CHECK(cmdExecutor<countingHandler>::Execute(merged, mergedHandler) == 36);
+    CHECK(mergedHandler.NumInstances == 30);
+
+    // reset keeps memory
+    const int32 capacity = cmdBuffer.Capacity();
+    cmdBuffer.Reset();
+    CHECK(cmdBuffer.Empty());
+    CHECK(cmdBuffer.NumCommands() == 0);
+    CHECK(cmdBuffer.NumDraws() == 0);
+    CHECK(cmdBuffer.Capacity() == capacity);
+    countingHandler emptyHandler;
+    CHECK(cmdExecutor<countingHandler>::Execute(cmdBuffer, emptyHandler) == 0);
+
+    // growing must preserve content
+    recordDraws(cmdBuffer, 0, 10000);
+    CHECK(cmdBuffer.NumDraws() == 10000);
+    CHECK(cmdBuffer.Capacity() > capacity);
+    countingHandler bigHandler;
+    cmdExecutor<countingHandler>::Execute(cmdBuffer, bigHandler);
+    CHECK(bigHandler.NumDraws == 10000);
+    CHECK(bigHandler.NumCommands == cmdBuffer.NumCommands());
+
+    // move
+    GfxCommandBuffer moved(std::move(cmdBuffer));
+    CHECK(cmdBuffer.Empty());
+    CHECK(cmdBuffer.Capacity() == 0);
+    CHECK(moved.NumDraws() == 10000);
+}
+
+//------------------------------------------------------------------------------
+TEST(GfxCommandBufferBenchmark) {
+    using namespace std::chrono;
+
+    const int32 numDraws = 200000;
+    const int32 numBuffers = 16;
+    const int32 drawsPerBuffer = numDraws / numBuffers;
+
+    // expected sum over all mvp[3][0] values (0 + 1 + ... + numDraws-1) + 2 per vec4
+    const float64 expected = (float64(numDraws - 1) * numDraws) / 2.0 + 2.0 * numDraws;
+
+    // single-threaded recording
+    GfxCommandBuffer single;
+    recordDraws(single, 0, numDraws);
+    single.Reset();
+    auto start = high_resolution_clock::now();
+    recordDraws(single, 0, numDraws);
+    duration<double> recordDur = high_resolution_clock::now() - start;
+
+    countingHandler handler;
+    start = high_resolution_clock::now();
+    cmdExecutor<countingHandler>::Execute(single, handler);
+    duration<double> replayDur = high_resolution_clock::now() - start;
+    CHECK(handler.NumDraws == numDraws);
+    Log::Info("GfxCommandBuffer: 1 thread, %d draws (%d bytes): record %.2f ns/draw, replay %.2f ns/draw\n",
+        numDraws, single.Size(), recordDur.count() * 1e9 / numDraws, replayDur.count() * 1e9 / numDraws);
+
+    // multi-threaded recording into per-job command buffers, replayed in order
+    JobSetup jobSetup;
+    jobSetup.NumWorkers = 3;
+    JobSystem::Setup(jobSetup);
+    GfxCommandBuffer buffers[numBuffers];
+    auto record = [&buffers, drawsPerBuffer](int32 begin, int32 end) {
+        for (int32 i = begin; i < end; i++) {
+            buffers[i].Reset();
+            recordDraws(buffers[i], i * drawsPerBuffer, drawsPerBuffer);
+        }
+    };
+    JobSystem::ParallelFor(numBuffers, 1, record);
+    start = high_resolution_clock::now();
+    JobSystem::ParallelFor(numBuffers, 1, record);
+    recordDur = high_resolution_clock::now() - start;
+    JobSystem::Discard();
+
+    countingHandler mtHandler;
+    int32 numCommands = 0;
+    start = high_resolution_clock::now();
+    for (int32 i = 0; i < numBuffers; i++) {
+        numCommands += cmdExecutor<countingHandler>::Execute(buffers[i], mtHandler);
+    }
+    replayDur = high_resolution_clock::now() - start;
+    CHECK(numCommands == single.NumCommands());
+    CHECK(mtHandler.NumDraws == numDraws);
+    CHECK(mtHandler.FloatSum == expected);
+    Log::Info("GfxCommandBuffer: %d jobs, %d draws: record %.2f ns/draw, replay %.2f ns/draw\n",
+        numBuffers, numDraws, recordDur.count() * 1e9 / numDraws, replayDur.count() * 1e9 / numDraws);
+
+    // merging the per-job buffers into one
+    GfxCommandBuffer merged;
+    start = high_resolution_clock::now();
+    merged.Reserve(numBuffers * buffers[0].Size());
+    for (int32 i = 0; i < numBuffers; i++) {
+        merged.Append(buffers[i]);
+    }
+    duration<double> mergeDur = high_resolution_clock::now() - start;
+    CHECK(merged.NumDraws() == numDraws);
+    Log::Info("GfxCommandBuffer: merge %d buffers (%d bytes): %.2f ns/draw\n",
+        numBuffers, merged.Size(), mergeDur.count() * 1e9 / numDraws);
+}
@@ -0,0 +1,197 @@
+//------------------------------------------------------------------------------
+//  GfxRenderQueueTest.cc
+//  Test render queue sort keys, and sorted replay with state elision
+//  on the null backend.
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "UnitTest++/src/UnitTest++.h"
+#include "Gfx/Gfx.h"
+#include "Gfx/Core/GfxRenderQueue.h"
+#include "IO/Stream/MemoryStream.h"
+#include "glm/mat4x4.hpp"
+
+using namespace Oryol;
+
+TEST(GfxRenderQueueSortKeyTest) {
+    const Id p0(0, 0, 0), p1(0, 1, 0);
+    const Id m0(0, 0, 0), m1(0, 1, 0);
+    const Id d0(0, 0, 0), d1(0, 1, 0);
+
+    // pass index has highest priority, then program, mesh, draw state, depth
+    CHECK(GfxRenderQueue::MakeSortKey(0, p1, m1, d1, 1.0f) < GfxRenderQueue::MakeSortKey(1, p0, m0, d0, 0.0f));
+    CHECK(GfxRenderQueue::MakeSortKey(0, p0, m1, d1, 1.0f) < GfxRenderQueue::MakeSortKey(0, p1, m0, d0, 0.0f));
+    CHECK(GfxRenderQueue::MakeSortKey(0, p0, m0, d1, 1.0f) < GfxRenderQueue::MakeSortKey(0, p0, m1, d0, 0.0f));
+    CHECK(GfxRenderQueue::MakeSortKey(0, p0, m0, d0, 1.0f) < GfxRenderQueue::MakeSortKey(0, p0, m0, d1, 0.0f));
+    CHECK(GfxRenderQueue::MakeSortKey(0, p0, m0, d0, 0.25f) < GfxRenderQueue::MakeSortKey(0, p0, m0, d0, 0.5f));
+
+    // depth is clamped to 0..1
+    CHECK(GfxRenderQueue::MakeSortKey(0, p0, m0, d0, -1.0f) == GfxRenderQueue::MakeSortKey(0, p0, m0, d0, 0.0f));
+    CHECK(GfxRenderQueue::MakeSortKey(0, p0, m0, d0, 2.0f) == GfxRenderQueue::MakeSortKey(0, p0, m0, d0, 1.0f));
+    CHECK(GfxRenderQueue::MakeSortKey(0, p0, m0, d0, 1.0f) < GfxRenderQueue::MakeSortKey(0, p0, m0, d1, 0.0f));
+
+    // recording
+    GfxRenderQueue queue;
+    queue.Reserve(16);
+    queue.ApplyDefaultRenderTarget();
+    queue.Clear(PixelChannel::RGBA, glm::vec4(0.0f));
+    queue.BeginDraw(d0, 0.5f);
+    queue.ApplyVariable(0, glm::mat4());
+    queue.Draw(0);
+    queue.BeginDraw(d1);
+    queue.DrawInstanced(0, 4);
+    CHECK(queue.NumPasses() == 1);
+    CHECK(queue.NumDraws() == 2);
+    queue.Reset();
+    CHECK(queue.NumPasses() == 0);
+    CHECK(queue.NumDraws() == 0);
+}
+
+#if ORYOL_GFX_NULL
+TEST(GfxRenderQueueTest) {
+    Gfx::Setup(GfxSetup::Window(400, 300, "Oryol RenderQueue Test"));
+
+    // 2 meshes, 2 programs, and draw states for all combinations
+    Id m0 = Gfx::Resource().Create(MeshSetup::FullScreenQuad());
+    Id m1 = Gfx::Resource().Create(MeshSetup::FullScreenQuad());
+    Id prog[2];
+    for (int32 i = 0; i < 2; i++) {
+        ProgramBundleSetup progSetup;
+        progSetup.AddProgramFromSources(0, ShaderLang::GLSL100, "vs", "fs");
+        progSetup.AddUniform("mvp", 0);
+        prog[i] = Gfx::Resource().Create(progSetup);
+    }
+    Id ds[4];
+    ds[0] = Gfx::Resource().Create(DrawStateSetup::FromMeshAndProg(m0, prog[0]));
+    ds[1] = Gfx::Resource().Create(DrawStateSetup::FromMeshAndProg(m1, prog[1]));
+    ds[2] = Gfx::Resource().Create(DrawStateSetup::FromMeshAndProg(m1, prog[0]));
+    ds[3] = Gfx::Resource().Create(DrawStateSetup::FromMeshAndProg(m0, prog[1]));
+    Id rt = Gfx::Resource().Create(TextureSetup::RenderTarget(64, 64));
+    Gfx::CommitFrame();
+
+    // queue 16 draws in worst-case order, and an empty pass
+    GfxRenderQueue queue;
+    queue.ApplyDefaultRenderTarget();
+    queue.Clear(PixelChannel::RGBA, glm::vec4(0.0f));
+    for (int32 i = 0; i < 16; i++) {
+        queue.BeginDraw(ds[i & 3], float32(15 - i) / 15.0f);
+        queue.ApplyVariable(0, glm::mat4());
+        queue.Draw(0);
+    }
+    queue.ApplyOffscreenRenderTarget(rt);
+    Gfx::SubmitRenderQueue(queue);
+    Gfx::CommitFrame();
+    const GfxFrameStats sorted = Gfx::FrameStats();
+    CHECK(sorted.NumApplyRenderTarget == 1);
+    CHECK(sorted.NumClears == 1);
+    CHECK(sorted.NumDraws == 16);
+    CHECK(sorted.NumApplyDrawState == 4);
+    CHECK(sorted.NumApplyVariable == 4);
+    CHECK(sorted.NumProgramChanges == 2);
+    CHECK(sorted.NumMeshChanges == 4);
+    CHECK(sorted.NumElidedStateChanges == 25);    // 12 draw states, 12 variables, 1 pass
+
+    // the same draws directly in recording order
+    Gfx::ApplyDefaultRenderTarget();
+    Gfx::Clear(PixelChannel::RGBA, glm::vec4(0.0f));
+    for (int32 i = 0; i < 16; i++) {
+        Gfx::ApplyDrawState(ds[i & 3]);
+        Gfx::ApplyVariable(0, glm::mat4());
+        Gfx::Draw(0);
+    }
+    Gfx::CommitFrame();
+    const GfxFrameStats unsorted = Gfx::FrameStats();
+    CHECK(unsorted.NumDraws == 16);
+    CHECK(unsorted.NumApplyDrawState == 16);
+    CHECK(unsorted.NumApplyVariable == 16);
+    CHECK(unsorted.NumProgramChanges == 16);
+    CHECK(unsorted.NumMeshChanges == 9);
+    CHECK(unsorted.NumElidedStateChanges == 0);
+
+    // a reset queue can be reused
+    queue.Reset();
+    queue.ApplyDefaultRenderTarget();
+    queue.BeginDraw(ds[0]);
+    queue.DrawInstanced(0, 8);
+    Gfx::SubmitRenderQueue(queue);
+    Gfx::CommitFrame();
+    CHECK(Gfx::FrameStats().NumDrawsInstanced == 1);
+    CHECK(Gfx::FrameStats().NumInstances == 8);
+
+    Gfx::Discard();
+}
+
+TEST(GfxRenderQueueInstancingTest) {
+    Gfx::Setup(GfxSetup::Window(400, 300, "Oryol RenderQueue Instancing Test"));
+
+    // a quad with an instance data mesh for 8 instances
+    auto instSetup = MeshSetup::Empty(8, Usage::Stream);
+    instSetup.Layout.Add(VertexAttr::Instance0, VertexFormat::Float4);
+    Id instMesh = Gfx::Resource().Create(instSetup);
+    Ptr<Stream> vertices = MemoryStream::Create();
+    vertices->Open(OpenMode::WriteOnly);
+    Memory::Clear(vertices->MapWrite(6 * 12), 6 * 12);
+    vertices->UnmapWrite();
+    vertices->Close();
+    auto quadSetup = MeshSetup::FromStream();
+    quadSetup.NumVertices = 6;
+    quadSetup.Layout.Add(VertexAttr::Position, VertexFormat::Float3);
+    quadSetup.AddPrimitiveGroup(PrimitiveGroup(PrimitiveType::Triangles, 0, 6));
+    quadSetup.InstanceMesh = instMesh;
+    Id quad = Gfx::Resource().Create(quadSetup, vertices);
+    ProgramBundleSetup progSetup;
+    progSetup.AddProgramFromSources(0, ShaderLang::GLSL100, "vs", "fs");
+    progSetup.AddUniform("color", 0);
+    Id prog = Gfx::Resource().Create(progSetup);
+    Id ds = Gfx::Resource().Create(DrawStateSetup::FromMeshAndProg(quad, prog));
+    Gfx::CommitFrame();
+
+    // 20 draws which only differ in their instance data,
+    // are merged into batches of 8, 8 and 4 instances
+    GfxRenderQueue queue;
+    queue.ApplyDefaultRenderTarget();
+    for (int32 i = 0; i < 20; i++) {
+        queue.BeginDraw(ds, float32(i) / 20.0f);
+        queue.ApplyVariable(0, glm::vec4(1.0f));
+        queue.ApplyInstanceData(glm::vec4(float32(i), 0.0f, 0.0f, 0.0f));
+        queue.Draw(0);
+    }
+    Gfx::SubmitRenderQueue(queue);
+    Gfx::CommitFrame();
+    const GfxFrameStats merged = Gfx::FrameStats();
+    CHECK(merged.NumDraws == 0);
+    CHECK(merged.NumDrawsInstanced == 3);
+    CHECK(merged.NumInstances == 20);
+    CHECK(merged.NumMergedDraws == 17);
+    CHECK(merged.NumUpdateVertices == 3);
+    CHECK(merged.VertexUpdateBytes == 20 * 16);
+    CHECK(merged.NumApplyDrawState == 3);
+    CHECK(merged.NumApplyVariable == 3);
+
+    // different shader variables split a batch
+    queue.Reset();
+    queue.ApplyDefaultRenderTarget();
+    for (int32 i = 0; i < 6; i++) {
+        queue.BeginDraw(ds);
+        queue.ApplyVariable(0, glm::vec4(float32(i / 3)));
+        queue.ApplyInstanceData(glm::vec4(float32(i)));
+        queue.Draw(0);
+    }
+    Gfx::SubmitRenderQueue(queue);
+    Gfx::CommitFrame();
+    CHECK(Gfx::FrameStats().NumDrawsInstanced == 2);
+    CHECK(Gfx::FrameStats().NumInstances == 6);
+    CHECK(Gfx::FrameStats().NumMergedDraws == 4);
+
+    // without auto-instancing each draw is an instanced draw of its own
+    queue.SetAutoInstancing(false);
+    CHECK(!queue.AutoInstancing());
+    Gfx::SubmitRenderQueue(queue);
+    Gfx::CommitFrame();
+    CHECK(Gfx::FrameStats().NumDrawsInstanced == 6);
+    CHECK(Gfx::FrameStats().NumInstances == 6);
+    CHECK(Gfx::FrameStats().NumMergedDraws == 0);
+    CHECK(Gfx::FrameStats().NumUpdateVertices == 6);
+
+    Gfx::Discard();
+}
+#endif
@@ -29,7 +29,7 @@ TEST(MeshFactoryTest) {
     
     // setup a meshFactory object
     class renderer renderer;
-    renderer.setup();
+    renderer.setup(gfxSetup);
     meshPool meshPool;
     meshFactory factory;
     factory.Setup(&renderer, &meshPool);
@@ -0,0 +1,114 @@
+//------------------------------------------------------------------------------
+//  NullGfxTest.cc
+//  Run the Gfx facade, resource container and state cache on the
+//  headless null backend and check the recorded frame statistics.
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "UnitTest++/src/UnitTest++.h"
+#include "Gfx/Gfx.h"
+#include "IO/Stream/MemoryStream.h"
+#include "glm/mat4x4.hpp"
+
+using namespace Oryol;
+
+TEST(NullGfxTest) {
+    Gfx::Setup(GfxSetup::Window(400, 300, "Oryol NullGfx Test"));
+    CHECK(Gfx::DisplayAttrs().FramebufferWidth == 400);
+    CHECK(Gfx::DisplayAttrs().FramebufferHeight == 300);
+    CHECK(Gfx::Supports(GfxFeature::Instancing));
+
+    // a fullscreen quad mesh (4 vertices * 20 bytes + 6 indices * 2 bytes)
+    Id quad = Gfx::Resource().Create(MeshSetup::FullScreenQuad());
+    CHECK(Gfx::Resource().QueryResourceInfo(quad).State == ResourceState::Valid);
+
+    // a double-buffered stream mesh
+    auto dynSetup = MeshSetup::Empty(16, Usage::Stream);
+    dynSetup.Layout.Add(VertexAttr::Position, VertexFormat::Float3);
+    dynSetup.AddPrimitiveGroup(PrimitiveGroup(PrimitiveType::Triangles, 0, 6));
+    Id dynMesh = Gfx::Resource().Create(dynSetup);
+    CHECK(Gfx::Resource().QueryResourceInfo(dynMesh).State == ResourceState::Valid);
+
+    // a 4x4 RGBA8 texture from pixel data (64 bytes)
+    Ptr<Stream> pixels = MemoryStream::Create();
+    pixels->Open(OpenMode::WriteOnly);
+    Memory::Fill(pixels->MapWrite(64), 64, 0xFF);
+    pixels->UnmapWrite();
+    pixels->Close();
+    auto texSetup = TextureSetup::FromPixelData(4, 4, 1, TextureType::Texture2D, PixelFormat::RGBA8);
+    texSetup.ImageSizes[0][0] = 64;
+    Id tex = Gfx::Resource().Create(texSetup, pixels);
+    CHECK(Gfx::Resource().QueryResourceInfo(tex).State == ResourceState::Valid);
+
+    // a render target
+    auto rtSetup = TextureSetup::RenderTarget(128, 64);
+    rtSetup.ColorFormat = PixelFormat::RGBA8;
+    Id rt = Gfx::Resource().Create(rtSetup);
+    CHECK(Gfx::Resource().QueryResourceInfo(rt).State == ResourceState::Valid);
+
+    // a program bundle with one matrix and one texture uniform, and draw states
+    ProgramBundleSetup progSetup;
+    progSetup.AddProgramFromSources(0, ShaderLang::GLSL100, "vs", "fs");
+    progSetup.AddUniform("mvp", 0);
+    progSetup.AddTextureUniform("tex", 1);
+    Id prog = Gfx::Resource().Create(progSetup);
+    Id ds0 = Gfx::Resource().Create(DrawStateSetup::FromMeshAndProg(quad, prog));
+    auto dss1 = DrawStateSetup::FromMeshAndProg(dynMesh, prog);
+    dss1.BlendState.BlendEnabled = true;
+    Id ds1 = Gfx::Resource().Create(dss1);
+
+    // render a frame
+    Gfx::ApplyOffscreenRenderTarget(rt);
+    CHECK(Gfx::RenderTargetAttrs().FramebufferWidth == 128);
+    Gfx::Clear(PixelChannel::RGBA, glm::vec4(0.0f));
+    for (int32 i = 0; i < 10; i++) {
+        Gfx::ApplyDrawState(ds0);
+        Gfx::ApplyVariable(0, glm::mat4());
+        Gfx::ApplyVariable(1, tex);
+        Gfx::Draw(0);
+    }
+    Gfx::ApplyDefaultRenderTarget();
+    Gfx::ApplyDrawState(ds1);
+    float32 vertices[16 * 3] = { };
+    Gfx::UpdateVertices(dynMesh, sizeof(vertices), vertices);
+    Gfx::ApplyDrawState(ds1);
+    Gfx::DrawInstanced(0, 5);
+    Gfx::Draw(7);   // out of range, ignored
+    uint8 readBuf[16] = { 1, 2, 3, 4 };
+    Gfx::ReadPixels(readBuf, sizeof(readBuf));
+    CHECK((readBuf[0] == 0) && (readBuf[15] == 0));
+    Gfx::CommitFrame();
+
+    const GfxFrameStats& stats = Gfx::FrameStats();
+    CHECK(stats.NumApplyRenderTarget == 2);
+    CHECK(stats.NumApplyDrawState == 12);
+    CHECK(stats.NumApplyVariable == 10);
+    CHECK(stats.NumApplyTexture == 10);
+    CHECK(stats.NumClears == 1);
+    CHECK(stats.NumDraws == 10);
+    CHECK(stats.NumDrawsInstanced == 1);
+    CHECK(stats.NumInstances == 5);
+    CHECK(stats.NumElements == 90);
+    CHECK(stats.NumUpdateVertices == 1);
+    CHECK(stats.NumRenderTargetChanges == 2);
+    CHECK(stats.NumViewPortChanges == 2);
+    CHECK(stats.NumScissorRectChanges == 0);
+    CHECK(stats.NumBlendColorChanges == 0);
+    CHECK(stats.NumDepthStencilStateChanges == 0);
+    CHECK(stats.NumBlendStateChanges == 1);
+    CHECK(stats.NumRasterizerStateChanges == 0);
+    CHECK(stats.NumProgramChanges == 1);
+    CHECK(stats.NumMeshChanges == 3);   // quad, dynMesh, dynMesh after buffer rotation
+    CHECK(stats.NumTextureChanges == 1);
+    CHECK(stats.NumRedundantStateChanges == 64);
+    CHECK(stats.UniformBytes == 640);
+    CHECK(stats.VertexUpdateBytes == 192);
+    CHECK(stats.ResourceUploadBytes == 156);
+
+    // an empty frame resets all counters
+    Gfx::CommitFrame();
+    CHECK(Gfx::FrameStats().NumApplyDrawState == 0);
+    CHECK(Gfx::FrameStats().NumRedundantStateChanges == 0);
+    CHECK(Gfx::FrameStats().ResourceUploadBytes == 0);
+
+    Gfx::Discard();
+}
@@ -0,0 +1,133 @@
+//------------------------------------------------------------------------------
+//  StreamBufferTest.cc
+//  Test the frame-fenced stream ring allocator, and streamed meshes
+//  on the null backend.
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "UnitTest++/src/UnitTest++.h"
+#include "Gfx/Gfx.h"
+#include "Gfx/Core/streamRingAllocator.h"
+
+using namespace Oryol;
+using namespace _priv;
+
+TEST(StreamRingAllocatorTest) {
+    streamRingAllocator ring;
+    CHECK(!ring.isValid());
+    ring.setup(256);
+    CHECK(ring.isValid());
+    CHECK(ring.capacity() == 256);
+    CHECK(ring.numPendingFrames() == 0);
+    CHECK(ring.numUsedBytes() == 0);
+
+    // frame 0: allocations are aligned, padding counts as used
+    CHECK(ring.alloc(100, 16) == 0);
+    CHECK(ring.alloc(10, 16) == 112);
+    CHECK(ring.numFrameBytes() == 122);
+    CHECK(ring.commitFrame());
+    CHECK(!ring.commitFrame());
+    CHECK(ring.numPendingFrames() == 1);
+
+    // frame 1: no room for a wrap-around while frame 0 is pending
+    CHECK(ring.alloc(100, 16) == 128);
+    CHECK(ring.alloc(64, 16) == InvalidIndex);
+    CHECK(ring.commitFrame());
+    CHECK(ring.numPendingFrames() == 2);
+    CHECK(ring.numUsedBytes() == 228);
+
+    // frame 2: retiring frame 0 makes room at the front
+    ring.retireFrame();
+    CHECK(ring.numPendingFrames() == 1);
+    CHECK(ring.alloc(64, 16) == 0);
+    CHECK(ring.numFrameBytes() == 92);
+    CHECK(ring.alloc(64, 16) == InvalidIndex);
+    CHECK(ring.commitFrame());
+
+    // retire everything, the ring restarts at the front
+    ring.retireFrame();
+    ring.retireFrame();
+    CHECK(ring.numPendingFrames() == 0);
+    CHECK(ring.numUsedBytes() == 0);
+    CHECK(ring.alloc(256, 16) == 0);
+    CHECK(ring.alloc(1, 16) == InvalidIndex);
+    CHECK(ring.alloc(257, 16) == InvalidIndex);
+    ring.reset();
+    CHECK(ring.numUsedBytes() == 0);
+    CHECK(ring.numFrameBytes() == 0);
+    CHECK(ring.alloc(16, 16) == 0);
+    ring.discard();
+    CHECK(!ring.isValid());
+}
+
+#if ORYOL_GFX_NULL
+TEST(StreamBufferTest) {
+    auto gfxSetup = GfxSetup::Window(400, 300, "Oryol StreamBuffer Test");
+    gfxSetup.StreamVertexBufferSize = 1024;
+    gfxSetup.StreamIndexBufferSize = 384;
+    Gfx::Setup(gfxSetup);
+
+    // 2 streamed meshes in the shared stream buffers
+    auto meshSetup = MeshSetup::Streamed(16, IndexType::Index16, 24);
+    meshSetup.Layout.Add(VertexAttr::Position, VertexFormat::Float4);
+    meshSetup.AddPrimitiveGroup(PrimitiveGroup(PrimitiveType::Triangles, 0, 12));
+    Id m0 = Gfx::Resource().Create(meshSetup);
+    Id m1 = Gfx::Resource().Create(meshSetup);
+    ProgramBundleSetup progSetup;
+    progSetup.AddProgramFromSources(0, ShaderLang::GLSL100, "vs", "fs");
+    Id prog = Gfx::Resource().Create(progSetup);
+    Id ds0 = Gfx::Resource().Create(DrawStateSetup::FromMeshAndProg(m0, prog));
+    Id ds1 = Gfx::Resource().Create(DrawStateSetup::FromMeshAndProg(m1, prog));
+    Gfx::CommitFrame();
+
+    uint8 vertices[256] = { 0 };
+    uint16 indices[24] = { 0 };
+
+    // the ring buffers never run full with 2 emulated frames in flight
+    for (int32 frame = 0; frame < 8; frame++) {
+        Gfx::UpdateVertices(m0, 128, vertices);
+        Gfx::UpdateIndices(m0, 48, indices);
+        Gfx::UpdateVertices(m1, 128, vertices);
+        Gfx::UpdateIndices(m1, 48, indices);
+        Gfx::ApplyDefaultRenderTarget();
+        Gfx::ApplyDrawState(ds0);
+        Gfx::Draw(0);
+        Gfx::ApplyDrawState(ds1);
+        Gfx::Draw(0);
+        Gfx::CommitFrame();
+        const GfxFrameStats& stats = Gfx::FrameStats();
+        CHECK(stats.NumUpdateVertices == 2);
+        CHECK(stats.NumUpdateIndices == 2);
+        CHECK(stats.VertexUpdateBytes == 256);
+        CHECK(stats.IndexUpdateBytes == 96);
+        CHECK(stats.StreamBufferBytes == 352);
+        CHECK(stats.NumStreamBufferWaits == 0);
+        CHECK(stats.NumDraws == 2);
+        CHECK(stats.NumMeshChanges == 2);
+    }
+
+    // 2 frames of 256 bytes are pending, the third update
+    // must wait for the oldest frame
+    for (int32 i = 0; i < 3; i++) {
+        Gfx::UpdateVertices(m0, 256, vertices);
+    }
+    Gfx::CommitFrame();
+    CHECK(Gfx::FrameStats().NumUpdateVertices == 3);
+    CHECK(Gfx::FrameStats().StreamBufferBytes == 768);
+    CHECK(Gfx::FrameStats().NumStreamBufferWaits == 1);
+
+    // partial updates of a dynamic mesh don't touch the stream buffers
+    auto dynSetup = MeshSetup::Empty(16, Usage::Dynamic, IndexType::Index16, 24, Usage::Dynamic);
+    dynSetup.Layout.Add(VertexAttr::Position, VertexFormat::Float4);
+    Id dyn = Gfx::Resource().Create(dynSetup);
+    Gfx::UpdateVertices(dyn, 64, 32, vertices);
+    Gfx::UpdateIndices(dyn, 16, 16, indices);
+    Gfx::CommitFrame();
+    CHECK(Gfx::FrameStats().NumUpdateVertices == 1);
+    CHECK(Gfx::FrameStats().NumUpdateIndices == 1);
+    CHECK(Gfx::FrameStats().VertexUpdateBytes == 32);
+    CHECK(Gfx::FrameStats().IndexUpdateBytes == 16);
+    CHECK(Gfx::FrameStats().StreamBufferBytes == 0);
+
+    Gfx::Discard();
+}
+#endif
@@ -26,7 +26,7 @@ TEST(RenderTargetCreationTest) {
     // setup a meshFactory object
     texturePool texPool;
     class renderer renderer;
-    renderer.setup();
+    renderer.setup(gfxSetup);
     textureFactory factory;
     factory.Setup(&renderer, &displayManager, &texPool);
     
@@ -0,0 +1,120 @@
+//------------------------------------------------------------------------------
+//  UniformBlockTest.cc
+//  Test uniform block setup, recording, and the dirty tracking of
+//  uniform block uploads on the null backend.
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "UnitTest++/src/UnitTest++.h"
+#include "Gfx/Gfx.h"
+#include "Gfx/Core/GfxRenderQueue.h"
+#include "glm/mat4x4.hpp"
+
+using namespace Oryol;
+
+// a uniform block like the shader code generator creates it
+struct testBlock {
+    static const int32 _bindSlotIndex = 1;
+    glm::mat4 ModelViewProj;
+    glm::vec4 Color;
+};
+
+TEST(UniformBlockSetupTest) {
+    ProgramBundleSetup setup;
+    CHECK(setup.NumUniformBlocks() == 0);
+    setup.AddUniformBlock("frame", 0, 64);
+    setup.AddUniformBlock("object", 2, 80);
+    CHECK(setup.NumUniformBlocks() == 2);
+    CHECK(setup.UniformBlockName(0) == "frame");
+    CHECK(setup.UniformBlockSlot(0) == 0);
+    CHECK(setup.UniformBlockSize(0) == 64);
+    CHECK(setup.UniformBlockName(1) == "object");
+    CHECK(setup.UniformBlockSlot(1) == 2);
+    CHECK(setup.UniformBlockSize(1) == 80);
+
+    // blocks are recorded into command buffers as raw data
+    GfxCommandBuffer cmdBuffer;
+    testBlock block;
+    cmdBuffer.ApplyUniformBlock(block);
+    CHECK(cmdBuffer.NumCommands() == 1);
+    CHECK(cmdBuffer.Size() == int32(16 + sizeof(testBlock)));
+}
+
+#if ORYOL_GFX_NULL
+TEST(UniformBlockTest) {
+    Gfx::Setup(GfxSetup::Window(400, 300, "Oryol UniformBlock Test"));
+
+    Id msh = Gfx::Resource().Create(MeshSetup::FullScreenQuad());
+    Id prog[2];
+    for (int32 i = 0; i < 2; i++) {
+        ProgramBundleSetup progSetup;
+        progSetup.AddProgramFromSources(0, ShaderLang::GLSL100, "vs", "fs");
+        progSetup.AddUniformBlock("block", testBlock::_bindSlotIndex, sizeof(testBlock));
+        prog[i] = Gfx::Resource().Create(progSetup);
+    }
+    Id ds0 = Gfx::Resource().Create(DrawStateSetup::FromMeshAndProg(msh, prog[0]));
+    Id ds1 = Gfx::Resource().Create(DrawStateSetup::FromMeshAndProg(msh, prog[1]));
+    Gfx::CommitFrame();
+
+    // unchanged blocks are only uploaded once per program
+    testBlock block;
+    block.Color = glm::vec4(1.0f);
+    Gfx::ApplyDefaultRenderTarget();
+    for (int32 i = 0; i < 8; i++) {
+        Gfx::ApplyDrawState(ds0);
+        Gfx::ApplyUniformBlock(block);
+        Gfx::Draw(0);
+        Gfx::ApplyDrawState(ds1);
+        Gfx::ApplyUniformBlock(block);
+        Gfx::Draw(0);
+    }
+    Gfx::CommitFrame();
+    CHECK(Gfx::FrameStats().NumApplyUniformBlock == 16);
+    CHECK(Gfx::FrameStats().NumUniformBlockUpdates == 2);
+    CHECK(Gfx::FrameStats().UniformBytes == 2 * int32(sizeof(testBlock)));
+
+    // the shadow copies survive the frame, changed blocks are uploaded
+    Gfx::ApplyDefaultRenderTarget();
+    Gfx::ApplyDrawState(ds0);
+    for (int32 i = 0; i < 8; i++) {
+        block.Color.x = float32(i & 1);
+        Gfx::ApplyUniformBlock(block);
+        Gfx::Draw(0);
+    }
+    Gfx::CommitFrame();
+    CHECK(Gfx::FrameStats().NumApplyUniformBlock == 8);
+    CHECK(Gfx::FrameStats().NumUniformBlockUpdates == 8);
+
+    // blocks in a render queue are replayed and elided like shader variables
+    GfxRenderQueue queue;
+    block.Color.y = 2.0f;
+    queue.ApplyDefaultRenderTarget();
+    for (int32 i = 0; i < 4; i++) {
+        queue.BeginDraw(ds1);
+        queue.ApplyUniformBlock(block);
+        queue.Draw(0);
+    }
+    Gfx::SubmitRenderQueue(queue);
+    Gfx::CommitFrame();
+    CHECK(Gfx::FrameStats().NumApplyUniformBlock == 1);
+    CHECK(Gfx::FrameStats().NumUniformBlockUpdates == 1);
+    CHECK(Gfx::FrameStats().NumElidedStateChanges == 6);   // 3 draw states, 3 blocks
+
+    // recreated programs start with clean shadow copies
+    Gfx::Resource().Destroy(ResourceLabel::All);
+    msh = Gfx::Resource().Create(MeshSetup::FullScreenQuad());
+    ProgramBundleSetup progSetup;
+    progSetup.AddProgramFromSources(0, ShaderLang::GLSL100, "vs", "fs");
+    progSetup.AddUniformBlock("block", testBlock::_bindSlotIndex, sizeof(testBlock));
+    prog[0] = Gfx::Resource().Create(progSetup);
+    ds0 = Gfx::Resource().Create(DrawStateSetup::FromMeshAndProg(msh, prog[0]));
+    Gfx::CommitFrame();
+    Gfx::ApplyDefaultRenderTarget();
+    Gfx::ApplyDrawState(ds0);
+    Gfx::ApplyUniformBlock(block);
+    Gfx::Draw(0);
+    Gfx::CommitFrame();
+    CHECK(Gfx::FrameStats().NumUniformBlockUpdates == 1);
+
+    Gfx::Discard();
+}
+#endif
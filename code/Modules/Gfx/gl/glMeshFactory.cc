@@ -121,6 +121,9 @@ glMeshFactory::createVertexBuffer(const void* vertexData, uint32 vertexDataSize,
     this->renderer->bindVertexBuffer(vb);
     ::glBufferData(GL_ARRAY_BUFFER, vertexDataSize, vertexData, usage);
     ORYOL_GL_CHECK_ERROR();
+    if (vertexData) {
+        this->renderer->addUploadBytes(vertexDataSize);
+    }
     this->renderer->invalidateMeshState();
     return vb;
 }
@@ -143,6 +146,9 @@ glMeshFactory::createIndexBuffer(const void* indexData, uint32 indexDataSize, Us
     this->renderer->bindIndexBuffer(ib);
     ::glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexDataSize, indexData, usage);
     ORYOL_GL_CHECK_ERROR();
+    if (indexData) {
+        this->renderer->addUploadBytes(indexDataSize);
+    }
     this->renderer->invalidateMeshState();
     return ib;
 }
@@ -156,6 +162,7 @@ glMeshFactory::attachInstanceBuffer(mesh& msh) {
         const mesh* instMesh = this->meshPool->Lookup(instMeshId);
         o_assert_dbg(instMesh);
         msh.instanceMesh = instMesh;
+        o_assert2_dbg(!instMesh->Setup.UseSharedStreamBuffers, "streamed meshes can't be used as instance mesh!\n");
         
         // verify that there are no colliding vertex components
         #if ORYOL_DEBUG
@@ -447,6 +454,15 @@ glMeshFactory::createEmptyMesh(mesh& mesh) {
         }
     }
     
+    // a streamed mesh has no buffers of its own, it lives in the
+    // renderer's shared stream buffers, the vertex attributes are only
+    // setup once, and pointed at the current buffer range when applied
+    if (setup.UseSharedStreamBuffers) {
+        o_assert_dbg(!setup.InstanceMesh.IsValid());
+        this->glSetupVertexAttrs(mesh);
+        return ResourceState::Valid;
+    }
+    
     // if this is a stream update mesh, we actually create 2 vertex buffers for double-buffered updated
     if (Usage::Stream == vbAttrs.BufferUsage) {
         const uint8 numSlots = 2;
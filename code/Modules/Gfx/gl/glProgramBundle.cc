@@ -18,6 +18,9 @@ glProgramBundle::~glProgramBundle() {
     #if !ORYOL_NO_ASSERT
     for (int32 i = 0; i < this->numProgramEntries; i++) {
         o_assert_dbg(0 == this->programEntries[i].program);
+        for (int32 j = 0; j < ProgramBundleSetup::MaxNumUniformBlocks; j++) {
+            o_assert_dbg(0 == this->programEntries[i].blockBuffers[j]);
+        }
     }
     #endif
 }
@@ -41,6 +44,10 @@ glProgramBundle::Clear() {
             entry.attribMapping[i] = -1;
         }
         #endif
+        for (int32 i = 0; i < ProgramBundleSetup::MaxNumUniformBlocks; i++) {
+            entry.blockMapping[i] = -1;
+            entry.blockBuffers[i] = 0;
+        }
     }
     programBundleBase::Clear();
 }
@@ -87,6 +94,22 @@ glProgramBundle::bindAttribLocation(int32 progIndex, VertexAttr::Code attr, GLin
 }
 #endif
 
+//------------------------------------------------------------------------------
+void
+glProgramBundle::bindUniformBlockLocation(int32 progIndex, int32 slotIndex, GLint glUniformLocation) {
+    o_assert_range_dbg(progIndex, this->numProgramEntries);
+    o_assert_range_dbg(slotIndex, ProgramBundleSetup::MaxNumUniformBlocks);
+    this->programEntries[progIndex].blockMapping[slotIndex] = glUniformLocation;
+}
+
+//------------------------------------------------------------------------------
+void
+glProgramBundle::bindUniformBlockBuffer(int32 progIndex, int32 slotIndex, GLuint glBuffer) {
+    o_assert_range_dbg(progIndex, this->numProgramEntries);
+    o_assert_range_dbg(slotIndex, ProgramBundleSetup::MaxNumUniformBlocks);
+    this->programEntries[progIndex].blockBuffers[slotIndex] = glBuffer;
+}
+
 //------------------------------------------------------------------------------
 int32
 glProgramBundle::getNumPrograms() const {
@@ -100,5 +123,13 @@ glProgramBundle::getProgramAtIndex(int32 progIndex) const {
     return this->programEntries[progIndex].program;
 }
 
+//------------------------------------------------------------------------------
+GLuint
+glProgramBundle::getUniformBlockBufferAtIndex(int32 progIndex, int32 slotIndex) const {
+    o_assert_range_dbg(progIndex, this->numProgramEntries);
+    o_assert_range_dbg(slotIndex, ProgramBundleSetup::MaxNumUniformBlocks);
+    return this->programEntries[progIndex].blockBuffers[slotIndex];
+}
+
 } // namespace _priv
 } // namespace Oryol
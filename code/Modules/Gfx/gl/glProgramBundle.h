@@ -32,11 +32,17 @@ public:
     /// bind a vertex attribute location
     void bindAttribLocation(int32 progIndex, VertexAttr::Code attrib, GLint attribLocation);
     #endif
+    /// bind the vec4-array uniform location of a uniform block (no UBO support)
+    void bindUniformBlockLocation(int32 progIndex, int32 slotIndex, GLint glUniformLocation);
+    /// bind the uniform buffer object of a uniform block
+    void bindUniformBlockBuffer(int32 progIndex, int32 slotIndex, GLuint glBuffer);
     
     /// select program in the bundle
     bool selectProgram(uint32 mask);
     /// get the current selection mask
     uint32 getSelectionMask() const;
+    /// get the index of the currently selected program
+    int32 getSelectionIndex() const;
     /// get the currently selected GL program
     GLuint getProgram() const;
     /// get uniform location by slot index in currently selected program (-1 if not exists)
@@ -47,11 +53,17 @@ public:
     /// get a vertex attribute location
     GLint getAttribLocation(VertexAttr::Code attrib) const;
     #endif
+    /// get vec4-array uniform location of a uniform block in currently selected program (-1 if not exists)
+    GLint getUniformBlockLocation(int32 slotIndex) const;
+    /// get uniform buffer object of a uniform block in currently selected program (0 if not exists)
+    GLuint getUniformBlockBuffer(int32 slotIndex) const;
     
     /// get number of programs
     int32 getNumPrograms() const;
     /// get program at index
     GLuint getProgramAtIndex(int32 progIndex) const;
+    /// get uniform buffer object of a uniform block at program index
+    GLuint getUniformBlockBufferAtIndex(int32 progIndex, int32 slotIndex) const;
     
 private:
     static const int32 MaxNumUniforms = 16;
@@ -65,6 +77,8 @@ private:
         #if ORYOL_GL_USE_GETATTRIBLOCATION
         GLint attribMapping[VertexAttr::NumVertexAttrs];
         #endif
+        GLint blockMapping[ProgramBundleSetup::MaxNumUniformBlocks];
+        GLuint blockBuffers[ProgramBundleSetup::MaxNumUniformBlocks];
     };
     uint32 selMask;
     int32 selIndex;
@@ -78,6 +92,12 @@ glProgramBundle::getSelectionMask() const {
     return this->selMask;
 }
 
+//------------------------------------------------------------------------------
+inline int32
+glProgramBundle::getSelectionIndex() const {
+    return this->selIndex;
+}
+
 //------------------------------------------------------------------------------
 inline bool
 glProgramBundle::selectProgram(uint32 mask) {
@@ -122,6 +142,20 @@ glProgramBundle::getAttribLocation(VertexAttr::Code attrib) const {
     return this->programEntries[this->selIndex].attribMapping[attrib];
 }
 #endif
+
+//------------------------------------------------------------------------------
+inline GLint
+glProgramBundle::getUniformBlockLocation(int32 slotIndex) const {
+    o_assert_range_dbg(slotIndex, ProgramBundleSetup::MaxNumUniformBlocks);
+    return this->programEntries[this->selIndex].blockMapping[slotIndex];
+}
+
+//------------------------------------------------------------------------------
+inline GLuint
+glProgramBundle::getUniformBlockBuffer(int32 slotIndex) const {
+    o_assert_range_dbg(slotIndex, ProgramBundleSetup::MaxNumUniformBlocks);
+    return this->programEntries[this->selIndex].blockBuffers[slotIndex];
+}
     
 } // namespace _priv
 } // namespace Oryol
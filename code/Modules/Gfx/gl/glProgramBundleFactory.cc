@@ -10,6 +10,7 @@
 #include "Gfx/gl/gl_impl.h"
 #include "Gfx/gl/glInfo.h"
 #include "Core/Memory/Memory.h"
+#include "Core/String/StringBuilder.h"
 
 namespace Oryol {
 namespace _priv {
@@ -181,6 +182,32 @@ glProgramBundleFactory::SetupResource(programBundle& progBundle) {
             }
         }
         
+        // resolve uniform blocks, with UBOs on GL core profile, otherwise
+        // a uniform block is a vec4 array which is updated with a single glUniform4fv
+        const int32 numBlocks = setup.NumUniformBlocks();
+        for (int32 i = 0; i < numBlocks; i++) {
+            const String& name = setup.UniformBlockName(i);
+            const int16 slotIndex = setup.UniformBlockSlot(i);
+            #if ORYOL_OPENGL_CORE_PROFILE
+            StringBuilder strBuilder(name);
+            strBuilder.Append("_block");
+            const GLuint glBlockIndex = ::glGetUniformBlockIndex(glProg, strBuilder.AsCStr());
+            if (GL_INVALID_INDEX != glBlockIndex) {
+                ::glUniformBlockBinding(glProg, glBlockIndex, slotIndex);
+                GLuint glBuffer = 0;
+                ::glGenBuffers(1, &glBuffer);
+                ::glBindBuffer(GL_UNIFORM_BUFFER, glBuffer);
+                ::glBufferData(GL_UNIFORM_BUFFER, setup.UniformBlockSize(i), nullptr, GL_STREAM_DRAW);
+                ::glBindBuffer(GL_UNIFORM_BUFFER, 0);
+                ORYOL_GL_CHECK_ERROR();
+                progBundle.bindUniformBlockBuffer(progIndex, slotIndex, glBuffer);
+            }
+            #else
+            const GLint glLocation = ::glGetUniformLocation(glProg, name.AsCStr());
+            progBundle.bindUniformBlockLocation(progIndex, slotIndex, glLocation);
+            #endif
+        }
+        
         #if ORYOL_GL_USE_GETATTRIBLOCATION
         // resolve attrib locations
         for (int32 i = 0; i < VertexAttr::NumVertexAttrs; i++) {
@@ -190,6 +217,7 @@ glProgramBundleFactory::SetupResource(programBundle& progBundle) {
         #endif
     }
     this->renderer->invalidateProgramState();
+    progBundle.setupUniformBlocks(numProgs);
     
     return ResourceState::Valid;
 }
@@ -207,6 +235,14 @@ glProgramBundleFactory::DestroyResource(programBundle& progBundle) {
             ::glDeleteProgram(glProg);
             ORYOL_GL_CHECK_ERROR();
         }
+        for (int32 slotIndex = 0; slotIndex < ProgramBundleSetup::MaxNumUniformBlocks; slotIndex++) {
+            GLuint glBuffer = progBundle.getUniformBlockBufferAtIndex(progIndex, slotIndex);
+            if (0 != glBuffer) {
+                this->renderer->invalidateUniformBlockState();
+                ::glDeleteBuffers(1, &glBuffer);
+                ORYOL_GL_CHECK_ERROR();
+            }
+        }
     }
     progBundle.Clear();
 }
@@ -99,11 +99,19 @@ viewPortHeight(0),
 vertexBuffer(0),
 indexBuffer(0),
 vertexArrayObject(0),
-program(0) {
+attrMesh(nullptr),
+attrMeshSlot(0),
+attrMeshOffset(InvalidIndex),
+program(0),
+frameIndex(0),
+streamVAO(0) {
     for (int32 i = 0; i < MaxTextureSamplers; i++) {
         this->samplers2D[i] = 0;
         this->samplersCube[i] = 0;
     }
+    for (int32 i = 0; i < ProgramBundleSetup::MaxNumUniformBlocks; i++) {
+        this->uniformBuffers[i] = 0;
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -113,11 +121,12 @@ glRenderer::~glRenderer() {
 
 //------------------------------------------------------------------------------
 void
-glRenderer::setup() {
+glRenderer::setup(const GfxSetup& setup) {
     o_assert_dbg(!this->valid);
     o_assert_dbg(Core::IsMainThread());
     
     this->valid = true;
+    this->frameIndex = 0;
 
     #if ORYOL_GL_USE_GETATTRIBLOCATION
     o_warn("glStateWrapper: ORYOL_GL_USE_GETATTRIBLOCATION is ON\n");
@@ -135,6 +144,23 @@ glRenderer::setup() {
     this->setupDepthStencilState();
     this->setupBlendState();
     this->setupRasterizerState();    
+
+    // setup the shared stream buffers, streamed meshes share one
+    // vertex array object which is re-pointed at their buffer ranges
+    this->invalidateMeshState();
+    if (setup.StreamVertexBufferSize > 0) {
+        this->streamVertexBuffer.setup(GL_ARRAY_BUFFER, setup.StreamVertexBufferSize);
+    }
+    if (setup.StreamIndexBufferSize > 0) {
+        this->streamIndexBuffer.setup(GL_ELEMENT_ARRAY_BUFFER, setup.StreamIndexBufferSize);
+    }
+    if (glExt::HasExtension(glExt::VertexArrayObject)) {
+        glExt::GenVertexArrays(1, &this->streamVAO);
+        glExt::BindVertexArray(this->streamVAO);
+        ::glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, this->streamIndexBuffer.glBuffer());
+        ORYOL_GL_CHECK_ERROR();
+    }
+    this->invalidateMeshState();
 }
 
 //------------------------------------------------------------------------------
@@ -146,10 +172,22 @@ glRenderer::discard() {
     this->invalidateMeshState();
     this->invalidateProgramState();
     this->invalidateTextureState();
+    this->invalidateUniformBlockState();
     this->curRenderTarget = nullptr;
     this->curMesh = nullptr;
     this->curProgramBundle = nullptr;
     
+    if (0 != this->streamVAO) {
+        glExt::DeleteVertexArrays(1, &this->streamVAO);
+        this->streamVAO = 0;
+    }
+    if (this->streamVertexBuffer.isValid()) {
+        this->streamVertexBuffer.discard();
+    }
+    if (this->streamIndexBuffer.isValid()) {
+        this->streamIndexBuffer.discard();
+    }
+    
     #if ORYOL_MACOS
     ::glDeleteVertexArrays(1, &this->globalVAO);
     this->globalVAO = 0;
@@ -176,6 +214,7 @@ glRenderer::resetStateCache() {
     this->invalidateMeshState();
     this->invalidateProgramState();
     this->invalidateTextureState();
+    this->invalidateUniformBlockState();
 }
 
 //------------------------------------------------------------------------------
@@ -215,6 +254,15 @@ glRenderer::commitFrame() {
     o_assert_dbg(Core::IsMainThread());
     
     this->rtValid = false;
+    this->lastFrameStats = this->curFrameStats;
+    this->curFrameStats = GfxFrameStats();
+    if (this->streamVertexBuffer.isValid()) {
+        this->streamVertexBuffer.commitFrame();
+    }
+    if (this->streamIndexBuffer.isValid()) {
+        this->streamIndexBuffer.commitFrame();
+    }
+    this->frameIndex++;
 }
 
 //------------------------------------------------------------------------------
@@ -233,6 +281,10 @@ glRenderer::applyViewPort(int32 x, int32 y, int32 width, int32 height) {
         this->viewPortWidth = width;
         this->viewPortHeight = height;
         ::glViewport(x, y, width, height);
+        this->curFrameStats.NumViewPortChanges++;
+    }
+    else {
+        this->curFrameStats.NumRedundantStateChanges++;
     }
 }
 
@@ -243,6 +295,8 @@ glRenderer::applyRenderTarget(displayMgr* displayManager, texture* rt) {
     o_assert_dbg(Core::IsMainThread());
     o_assert_dbg(displayManager);
     
+    this->curFrameStats.NumApplyRenderTarget++;
+    
     // also update view port to cover full render target
     if (nullptr == rt) {
         this->rtAttrs = displayManager->GetDisplayAttrs();
@@ -273,6 +327,10 @@ glRenderer::applyRenderTarget(displayMgr* displayManager, texture* rt) {
             ::glBindFramebuffer(GL_FRAMEBUFFER, rt->glFramebuffer);
             ORYOL_GL_CHECK_ERROR();
         }
+        this->curFrameStats.NumRenderTargetChanges++;
+    }
+    else {
+        this->curFrameStats.NumRedundantStateChanges++;
     }
     this->curRenderTarget = rt;
     this->rtValid = true;
@@ -303,6 +361,10 @@ glRenderer::applyScissorRect(int32 x, int32 y, int32 width, int32 height) {
         this->scissorWidth = width;
         this->scissorHeight = height;
         ::glScissor(x, y, width, height);
+        this->curFrameStats.NumScissorRectChanges++;
+    }
+    else {
+        this->curFrameStats.NumRedundantStateChanges++;
     }
 }
 
@@ -315,6 +377,10 @@ glRenderer::applyBlendColor(const glm::vec4& c) {
     if (c != this->blendColor) {
         this->blendColor = c;
         ::glBlendColor(c.x, c.y, c.z, c.w);
+        this->curFrameStats.NumBlendColorChanges++;
+    }
+    else {
+        this->curFrameStats.NumRedundantStateChanges++;
     }
 }
 
@@ -327,6 +393,12 @@ glRenderer::applyProgramBundle(programBundle* progBundle, uint32 mask) {
     progBundle->selectProgram(mask);
     GLuint glProg = progBundle->getProgram();
     o_assert_dbg(0 != glProg);
+    if (glProg != this->program) {
+        this->curFrameStats.NumProgramChanges++;
+    }
+    else {
+        this->curFrameStats.NumRedundantStateChanges++;
+    }
     this->useProgram(glProg);
 }
 
@@ -340,9 +412,10 @@ glRenderer::applyMesh(const mesh* msh, const programBundle* progBundle) {
     if (nullptr == msh) {
         this->invalidateMeshState();
     }
+    else if (msh->Setup.UseSharedStreamBuffers) {
+        this->applyStreamMesh(msh);
+    }
     else {
-        // FIXME: record and compare against a 'current mesh pointer' whether
-        // mesh state must be reapplied
         const uint8 vaoIndex = msh->getActiveVAOSlot();
         
     #if ORYOL_GL_USE_GETATTRIBLOCATION
@@ -385,9 +458,23 @@ glRenderer::applyMesh(const mesh* msh, const programBundle* progBundle) {
         if (glExt::HasExtension(glExt::VertexArrayObject)) {
             GLuint vao = msh->glVAOs[vaoIndex];
             o_assert_dbg(0 != vao);
+            if (vao != this->vertexArrayObject) {
+                this->curFrameStats.NumMeshChanges++;
+            }
+            else {
+                this->curFrameStats.NumRedundantStateChanges++;
+            }
             this->bindVertexArrayObject(vao);
         }
+        else if ((msh == this->attrMesh) && (vaoIndex == this->attrMeshSlot) && (msh->glIndexBuffer == this->indexBuffer)) {
+            // without VAOs the vertex attributes only need to be
+            // re-applied when the mesh or its active buffer slot changes
+            this->curFrameStats.NumRedundantStateChanges++;
+        }
         else {
+            this->curFrameStats.NumMeshChanges++;
+            this->attrMesh = msh;
+            this->attrMeshSlot = vaoIndex;
             GLuint vb = 0;
             const GLuint ib = msh->glIndexBuffer;
             this->bindIndexBuffer(ib);
@@ -417,6 +504,57 @@ glRenderer::applyMesh(const mesh* msh, const programBundle* progBundle) {
     }
 }
 
+//------------------------------------------------------------------------------
+/**
+ Streamed meshes don't have their own vertex array objects, instead
+ the vertex attributes (in the shared streamVAO if VAOs are supported)
+ are re-pointed at the mesh's current range in the stream vertex buffer.
+ This only happens if the mesh or its range has changed.
+*/
+void
+glRenderer::applyStreamMesh(const mesh* msh) {
+    o_assert_dbg(nullptr != msh);
+    o_assert2_dbg(msh->streamFrameIndex == this->frameIndex, "streamed mesh must be updated in each frame it is rendered!\n");
+    o_assert_dbg(InvalidIndex != msh->streamVertexOffset);
+    #if ORYOL_GL_USE_GETATTRIBLOCATION
+    o_error("glRenderer: streamed meshes are not supported with ORYOL_GL_USE_GETATTRIBLOCATION!\n");
+    #endif
+
+    if (glExt::HasExtension(glExt::VertexArrayObject)) {
+        this->bindVertexArrayObject(this->streamVAO);
+    }
+    else {
+        this->bindIndexBuffer(this->streamIndexBuffer.glBuffer());
+    }
+    if ((msh == this->attrMesh) && (msh->streamVertexOffset == this->attrMeshOffset)) {
+        this->curFrameStats.NumRedundantStateChanges++;
+        return;
+    }
+    this->curFrameStats.NumMeshChanges++;
+    this->attrMesh = msh;
+    this->attrMeshSlot = 0;
+    this->attrMeshOffset = msh->streamVertexOffset;
+    ::glBindBuffer(GL_ARRAY_BUFFER, this->streamVertexBuffer.glBuffer());
+    this->vertexBuffer = this->streamVertexBuffer.glBuffer();
+    ORYOL_GL_CHECK_ERROR();
+    for (uint8 attrIndex = 0; attrIndex < VertexAttr::NumVertexAttrs; attrIndex++) {
+        const glVertexAttr& attr = msh->glAttrs[0][attrIndex];
+        if (attr.enabled) {
+            const GLintptr offset = msh->streamVertexOffset + attr.offset;
+            ::glVertexAttribPointer(attr.index, attr.size, attr.type, attr.normalized, attr.stride, (const GLvoid*) offset);
+            ORYOL_GL_CHECK_ERROR();
+            glExt::VertexAttribDivisor(attr.index, 0);
+            ORYOL_GL_CHECK_ERROR();
+            ::glEnableVertexAttribArray(attr.index);
+            ORYOL_GL_CHECK_ERROR();
+        }
+        else {
+            ::glDisableVertexAttribArray(attr.index);
+            ORYOL_GL_CHECK_ERROR();
+        }
+    }
+}
+
 //------------------------------------------------------------------------------
 void
 glRenderer::applyDrawState(drawState* ds) {
@@ -424,6 +562,7 @@ glRenderer::applyDrawState(drawState* ds) {
     o_assert_dbg(Core::IsMainThread());
     o_assert_dbg(nullptr != ds);
     
+    this->curFrameStats.NumApplyDrawState++;
     this->curDrawState = ds;
     this->curProgramBundle = ds->programBundle;
     this->curMesh = ds->mesh;
@@ -431,12 +570,24 @@ glRenderer::applyDrawState(drawState* ds) {
     const DrawStateSetup& setup = ds->Setup;
     if (setup.DepthStencilState != this->depthStencilState) {
         this->applyDepthStencilState(setup.DepthStencilState);
+        this->curFrameStats.NumDepthStencilStateChanges++;
+    }
+    else {
+        this->curFrameStats.NumRedundantStateChanges++;
     }
     if (setup.BlendState != this->blendState) {
         this->applyBlendState(setup.BlendState);
+        this->curFrameStats.NumBlendStateChanges++;
+    }
+    else {
+        this->curFrameStats.NumRedundantStateChanges++;
     }
     if (setup.RasterizerState != this->rasterizerState) {
         this->applyRasterizerState(setup.RasterizerState);
+        this->curFrameStats.NumRasterizerStateChanges++;
+    }
+    else {
+        this->curFrameStats.NumRedundantStateChanges++;
     }
     programBundle* pb = ds->programBundle;
     this->applyProgramBundle(pb, setup.ProgramSelectionMask);
@@ -451,12 +602,59 @@ glRenderer::applyTexture(int32 index, const texture* tex) {
     o_assert_dbg(this->curProgramBundle);
     o_assert_dbg(tex);
     
+    this->curFrameStats.NumApplyTexture++;
     int32 samplerIndex = this->curProgramBundle->getSamplerIndex(index);
     GLuint glTexture = tex->glTex;
     GLenum glTarget = tex->glTarget;
     this->bindTexture(samplerIndex, glTarget, glTexture);
 }
     
+//------------------------------------------------------------------------------
+/**
+ The program bundle keeps a shadow copy of each uniform block per
+ program, the block is only uploaded if it differs from the shadow copy.
+ With UBO support (GL core profile) the uniform buffer is orphaned and
+ rewritten, otherwise the block is a vec4 array in the shader and is
+ written with a single glUniform4fv.
+*/
+void
+glRenderer::applyUniformBlock(int32 slotIndex, const void* data, int32 numBytes) {
+    o_assert_dbg(this->valid);
+    o_assert_dbg(Core::IsMainThread());
+    o_assert_dbg(nullptr != this->curProgramBundle);
+    o_assert_dbg(this->curProgramBundle->getUniformBlockSize(slotIndex) == numBytes);
+
+    this->curFrameStats.NumApplyUniformBlock++;
+    #if ORYOL_OPENGL_CORE_PROFILE
+    const GLuint ubo = this->curProgramBundle->getUniformBlockBuffer(slotIndex);
+    if (0 == ubo) {
+        return;
+    }
+    this->bindUniformBuffer(slotIndex, ubo);
+    #else
+    const GLint glLoc = this->curProgramBundle->getUniformBlockLocation(slotIndex);
+    if (-1 == glLoc) {
+        return;
+    }
+    #endif
+    const int32 progIndex = this->curProgramBundle->getSelectionIndex();
+    if (this->curProgramBundle->updateUniformBlock(progIndex, slotIndex, data, numBytes)) {
+        #if ORYOL_OPENGL_CORE_PROFILE
+        ::glBindBuffer(GL_UNIFORM_BUFFER, ubo);
+        ::glBufferData(GL_UNIFORM_BUFFER, numBytes, nullptr, GL_STREAM_DRAW);
+        ::glBufferSubData(GL_UNIFORM_BUFFER, 0, numBytes, data);
+        #else
+        ::glUniform4fv(glLoc, numBytes / 16, (const GLfloat*) data);
+        #endif
+        ORYOL_GL_CHECK_ERROR();
+        this->curFrameStats.NumUniformBlockUpdates++;
+        this->curFrameStats.UniformBytes += numBytes;
+    }
+    else {
+        this->curFrameStats.NumRedundantStateChanges++;
+    }
+}
+
 //------------------------------------------------------------------------------
 template<> void
 glRenderer::applyVariable(int32 index, const float32& val) {
@@ -464,6 +662,8 @@ glRenderer::applyVariable(int32 index, const float32& val) {
     o_assert_dbg(Core::IsMainThread());
     o_assert_dbg(nullptr != this->curProgramBundle);
     GLint glLoc = this->curProgramBundle->getUniformLocation(index);
+    this->curFrameStats.NumApplyVariable++;
+    this->curFrameStats.UniformBytes += int32(sizeof(val));
     ::glUniform1f(glLoc, val);
 }
     
@@ -474,6 +674,8 @@ glRenderer::applyVariable(int32 index, const glm::vec2& val) {
     o_assert_dbg(Core::IsMainThread());
     o_assert_dbg(nullptr != this->curProgramBundle);
     GLint glLoc = this->curProgramBundle->getUniformLocation(index);
+    this->curFrameStats.NumApplyVariable++;
+    this->curFrameStats.UniformBytes += int32(sizeof(val));
     ::glUniform2f(glLoc, val.x, val.y);
 }
     
@@ -484,6 +686,8 @@ glRenderer::applyVariable(int32 index, const glm::vec3& val) {
     o_assert_dbg(Core::IsMainThread());
     o_assert_dbg(nullptr != this->curProgramBundle);
     GLint glLoc = this->curProgramBundle->getUniformLocation(index);
+    this->curFrameStats.NumApplyVariable++;
+    this->curFrameStats.UniformBytes += int32(sizeof(val));
     ::glUniform3f(glLoc, val.x, val.y, val.z);
 }
     
@@ -494,6 +698,8 @@ glRenderer::applyVariable(int32 index, const glm::vec4& val) {
     o_assert_dbg(Core::IsMainThread());
     o_assert_dbg(nullptr != this->curProgramBundle);
     GLint glLoc = this->curProgramBundle->getUniformLocation(index);
+    this->curFrameStats.NumApplyVariable++;
+    this->curFrameStats.UniformBytes += int32(sizeof(val));
     ::glUniform4f(glLoc, val.x, val.y, val.z, val.w);
 }
     
@@ -504,6 +710,8 @@ glRenderer::applyVariable(int32 index, const int32& val) {
     o_assert_dbg(Core::IsMainThread());
     o_assert_dbg(nullptr != this->curProgramBundle);
     GLint glLoc = this->curProgramBundle->getUniformLocation(index);
+    this->curFrameStats.NumApplyVariable++;
+    this->curFrameStats.UniformBytes += int32(sizeof(val));
     ::glUniform1i(glLoc, val);
 }
     
@@ -514,6 +722,8 @@ glRenderer::applyVariable(int32 index, const glm::ivec2& val) {
     o_assert_dbg(Core::IsMainThread());
     o_assert_dbg(nullptr != this->curProgramBundle);
     GLint glLoc = this->curProgramBundle->getUniformLocation(index);
+    this->curFrameStats.NumApplyVariable++;
+    this->curFrameStats.UniformBytes += int32(sizeof(val));
     ::glUniform2i(glLoc, val.x, val.y);
 }
     
@@ -524,6 +734,8 @@ glRenderer::applyVariable(int32 index, const glm::ivec3& val) {
     o_assert_dbg(Core::IsMainThread());
     o_assert_dbg(nullptr != this->curProgramBundle);
     GLint glLoc = this->curProgramBundle->getUniformLocation(index);
+    this->curFrameStats.NumApplyVariable++;
+    this->curFrameStats.UniformBytes += int32(sizeof(val));
     ::glUniform3i(glLoc, val.x, val.y, val.z);
 }
     
@@ -534,6 +746,8 @@ glRenderer::applyVariable(int32 index, const glm::ivec4& val) {
     o_assert_dbg(Core::IsMainThread());
     o_assert_dbg(nullptr != this->curProgramBundle);
     GLint glLoc = this->curProgramBundle->getUniformLocation(index);
+    this->curFrameStats.NumApplyVariable++;
+    this->curFrameStats.UniformBytes += int32(sizeof(val));
     ::glUniform4i(glLoc, val.x, val.y, val.z, val.w);
 }
     
@@ -544,6 +758,8 @@ glRenderer::applyVariable(int32 index, const glm::mat4& val) {
     o_assert_dbg(Core::IsMainThread());
     o_assert_dbg(nullptr != this->curProgramBundle);
     GLint glLoc = this->curProgramBundle->getUniformLocation(index);
+    this->curFrameStats.NumApplyVariable++;
+    this->curFrameStats.UniformBytes += int32(sizeof(val));
     ::glUniformMatrix4fv(glLoc, 1, GL_FALSE, glm::value_ptr(val));
 }
     
@@ -554,6 +770,8 @@ glRenderer::applyVariable(int32 index, const glm::mat3& val) {
     o_assert_dbg(Core::IsMainThread());
     o_assert_dbg(nullptr != this->curProgramBundle);
     GLint glLoc = this->curProgramBundle->getUniformLocation(index);
+    this->curFrameStats.NumApplyVariable++;
+    this->curFrameStats.UniformBytes += int32(sizeof(val));
     ::glUniformMatrix3fv(glLoc, 1, GL_FALSE, glm::value_ptr(val));
 }
     
@@ -564,6 +782,8 @@ glRenderer::applyVariable(int32 index, const glm::mat2& val) {
     o_assert_dbg(Core::IsMainThread());
     o_assert_dbg(nullptr != this->curProgramBundle);
     GLint glLoc = this->curProgramBundle->getUniformLocation(index);
+    this->curFrameStats.NumApplyVariable++;
+    this->curFrameStats.UniformBytes += int32(sizeof(val));
     ::glUniformMatrix2fv(glLoc, 1, GL_FALSE, glm::value_ptr(val));
 }
     
@@ -575,6 +795,8 @@ glRenderer::applyVariableArray(int32 index, const float32* values, int32 numValu
     o_assert_dbg(nullptr != this->curProgramBundle);
     o_assert_dbg(values && (numValues > 0));
     GLint glLoc = this->curProgramBundle->getUniformLocation(index);
+    this->curFrameStats.NumApplyVariable++;
+    this->curFrameStats.UniformBytes += numValues * int32(sizeof(*values));
     ::glUniform1fv(glLoc, numValues, values);
 }
     
@@ -586,6 +808,8 @@ glRenderer::applyVariableArray(int32 index, const glm::vec2* values, int32 numVa
     o_assert_dbg(nullptr != this->curProgramBundle);
     o_assert_dbg(values && (numValues > 0));
     GLint glLoc = this->curProgramBundle->getUniformLocation(index);
+    this->curFrameStats.NumApplyVariable++;
+    this->curFrameStats.UniformBytes += numValues * int32(sizeof(*values));
     ::glUniform2fv(glLoc, numValues, glm::value_ptr(*values));
 }
     
@@ -597,6 +821,8 @@ glRenderer::applyVariableArray(int32 index, const glm::vec3* values, int32 numVa
     o_assert_dbg(nullptr != this->curProgramBundle);
     o_assert_dbg(values && (numValues > 0));
     GLint glLoc = this->curProgramBundle->getUniformLocation(index);
+    this->curFrameStats.NumApplyVariable++;
+    this->curFrameStats.UniformBytes += numValues * int32(sizeof(*values));
     ::glUniform3fv(glLoc, numValues, glm::value_ptr(*values));
 }
     
@@ -608,6 +834,8 @@ glRenderer::applyVariableArray(int32 index, const glm::vec4* values, int32 numVa
     o_assert_dbg(nullptr != this->curProgramBundle);
     o_assert_dbg(values && (numValues > 0));
     GLint glLoc = this->curProgramBundle->getUniformLocation(index);
+    this->curFrameStats.NumApplyVariable++;
+    this->curFrameStats.UniformBytes += numValues * int32(sizeof(*values));
     ::glUniform4fv(glLoc, numValues, glm::value_ptr(*values));
 }
     
@@ -619,6 +847,8 @@ glRenderer::applyVariableArray(int32 index, const int32* values, int32 numValues
     o_assert_dbg(nullptr != this->curProgramBundle);
     o_assert_dbg(values && (numValues > 0));
     GLint glLoc = this->curProgramBundle->getUniformLocation(index);
+    this->curFrameStats.NumApplyVariable++;
+    this->curFrameStats.UniformBytes += numValues * int32(sizeof(*values));
     ::glUniform1iv(glLoc, numValues, values);
 }
     
@@ -630,6 +860,8 @@ glRenderer::applyVariableArray(int32 index, const glm::ivec2* values, int32 numV
     o_assert_dbg(nullptr != this->curProgramBundle);
     o_assert_dbg(values && (numValues > 0));
     GLint glLoc = this->curProgramBundle->getUniformLocation(index);
+    this->curFrameStats.NumApplyVariable++;
+    this->curFrameStats.UniformBytes += numValues * int32(sizeof(*values));
     ::glUniform2iv(glLoc, numValues, glm::value_ptr(*values));
 }
     
@@ -641,6 +873,8 @@ glRenderer::applyVariableArray(int32 index, const glm::ivec3* values, int32 numV
     o_assert_dbg(nullptr != this->curProgramBundle);
     o_assert_dbg(values && (numValues > 0));
     GLint glLoc = this->curProgramBundle->getUniformLocation(index);
+    this->curFrameStats.NumApplyVariable++;
+    this->curFrameStats.UniformBytes += numValues * int32(sizeof(*values));
     ::glUniform3iv(glLoc, numValues, glm::value_ptr(*values));
 }
     
@@ -652,6 +886,8 @@ glRenderer::applyVariableArray(int32 index, const glm::ivec4* values, int32 numV
     o_assert_dbg(nullptr != this->curProgramBundle);
     o_assert_dbg(values && (numValues > 0));
     GLint glLoc = this->curProgramBundle->getUniformLocation(index);
+    this->curFrameStats.NumApplyVariable++;
+    this->curFrameStats.UniformBytes += numValues * int32(sizeof(*values));
     ::glUniform4iv(glLoc, numValues, glm::value_ptr(*values));
 }
     
@@ -663,6 +899,8 @@ glRenderer::applyVariableArray(int32 index, const glm::mat4* values, int32 numVa
     o_assert_dbg(nullptr != this->curProgramBundle);
     o_assert_dbg(values && (numValues > 0));
     GLint glLoc = this->curProgramBundle->getUniformLocation(index);
+    this->curFrameStats.NumApplyVariable++;
+    this->curFrameStats.UniformBytes += numValues * int32(sizeof(*values));
     ::glUniformMatrix4fv(glLoc, numValues, GL_FALSE, glm::value_ptr(*values));
 }
     
@@ -674,6 +912,8 @@ glRenderer::applyVariableArray(int32 index, const glm::mat3* values, int32 numVa
     o_assert_dbg(nullptr != this->curProgramBundle);
     o_assert_dbg(values && (numValues > 0));
     GLint glLoc = this->curProgramBundle->getUniformLocation(index);
+    this->curFrameStats.NumApplyVariable++;
+    this->curFrameStats.UniformBytes += numValues * int32(sizeof(*values));
     ::glUniformMatrix3fv(glLoc, numValues, GL_FALSE, glm::value_ptr(*values));
 }
     
@@ -685,6 +925,8 @@ glRenderer::applyVariableArray(int32 index, const glm::mat2* values, int32 numVa
     o_assert_dbg(nullptr != this->curProgramBundle);
     o_assert_dbg(values && (numValues > 0));
     GLint glLoc = this->curProgramBundle->getUniformLocation(index);
+    this->curFrameStats.NumApplyVariable++;
+    this->curFrameStats.UniformBytes += numValues * int32(sizeof(*values));
     ::glUniformMatrix2fv(glLoc, numValues, GL_FALSE, glm::value_ptr(*values));
 }
 
@@ -695,6 +937,7 @@ glRenderer::clear(PixelChannel::Mask channels, const glm::vec4& color, float32 d
     o_assert_dbg(Core::IsMainThread());
     o_assert2_dbg(this->rtValid, "No render target set!");
     
+    this->curFrameStats.NumClears++;
     GLbitfield clearMask = 0;
     
     // update GL state
@@ -738,6 +981,20 @@ glRenderer::clear(PixelChannel::Mask channels, const glm::vec4& color, float32 d
     ORYOL_GL_CHECK_ERROR();
 }
     
+//------------------------------------------------------------------------------
+int32
+glRenderer::indexByteOffset(const PrimitiveGroup& primGroup) const {
+    o_assert_dbg(nullptr != this->curMesh);
+    const int32 offset = primGroup.BaseElement * IndexType::ByteSize(this->curMesh->indexBufferAttrs.Type);
+    if (this->curMesh->Setup.UseSharedStreamBuffers) {
+        o_assert2_dbg(InvalidIndex != this->curMesh->streamIndexOffset, "streamed mesh has no index data!\n");
+        return this->curMesh->streamIndexOffset + offset;
+    }
+    else {
+        return offset;
+    }
+}
+
 //------------------------------------------------------------------------------
 void
 glRenderer::draw(const PrimitiveGroup& primGroup) {
@@ -750,8 +1007,7 @@ glRenderer::draw(const PrimitiveGroup& primGroup) {
     const IndexType::Code indexType = this->curMesh->indexBufferAttrs.Type;
     if (indexType != IndexType::None) {
         // indexed geometry
-        const int32 indexByteSize = IndexType::ByteSize(indexType);
-        const GLvoid* indices = (const GLvoid*) (GLintptr) (primGroup.BaseElement * indexByteSize);
+        const GLvoid* indices = (const GLvoid*) (GLintptr) this->indexByteOffset(primGroup);
         ::glDrawElements(primGroup.PrimType, primGroup.NumElements, indexType, indices);
     }
     else {
@@ -759,6 +1015,8 @@ glRenderer::draw(const PrimitiveGroup& primGroup) {
         ::glDrawArrays(primGroup.PrimType, primGroup.BaseElement, primGroup.NumElements);
     }
     ORYOL_GL_CHECK_ERROR();
+    this->curFrameStats.NumDraws++;
+    this->curFrameStats.NumElements += primGroup.NumElements;
 }
 
 //------------------------------------------------------------------------------
@@ -791,8 +1049,7 @@ glRenderer::drawInstanced(const PrimitiveGroup& primGroup, int32 numInstances) {
     const IndexType::Code indexType = this->curMesh->indexBufferAttrs.Type;
     if (indexType != IndexType::None) {
         // indexed geometry
-        const int32 indexByteSize = IndexType::ByteSize(indexType);
-        const GLvoid* indices = (const GLvoid*) (GLintptr) (primGroup.BaseElement * indexByteSize);
+        const GLvoid* indices = (const GLvoid*) (GLintptr) this->indexByteOffset(primGroup);
         glExt::DrawElementsInstanced(primGroup.PrimType, primGroup.NumElements, indexType, indices, numInstances);
     }
     else {
@@ -800,6 +1057,9 @@ glRenderer::drawInstanced(const PrimitiveGroup& primGroup, int32 numInstances) {
         glExt::DrawArraysInstanced(primGroup.PrimType, primGroup.BaseElement, primGroup.NumElements, numInstances);
     }
     ORYOL_GL_CHECK_ERROR();
+    this->curFrameStats.NumDrawsInstanced++;
+    this->curFrameStats.NumInstances += numInstances;
+    this->curFrameStats.NumElements += primGroup.NumElements * numInstances;
 }
     
 //------------------------------------------------------------------------------
@@ -822,7 +1082,7 @@ glRenderer::drawInstanced(int32 primGroupIndex, int32 numInstances) {
 
 //------------------------------------------------------------------------------
 void
-glRenderer::updateVertices(mesh* msh, int32 numBytes, const void* data) {
+glRenderer::updateVertices(mesh* msh, int32 byteOffset, int32 numBytes, const void* data) {
     o_assert_dbg(this->valid);
     o_assert_dbg(Core::IsMainThread());
     o_assert_dbg(nullptr != msh);
@@ -830,13 +1090,25 @@ glRenderer::updateVertices(mesh* msh, int32 numBytes, const void* data) {
     
     const VertexBufferAttrs& attrs = msh->vertexBufferAttrs;
     const Usage::Code vbUsage = attrs.BufferUsage;
-    o_assert_dbg((numBytes > 0) && (numBytes <= attrs.ByteSize()));
+    o_assert_dbg((byteOffset >= 0) && ((byteOffset + numBytes) <= attrs.ByteSize()));
     o_assert_dbg((vbUsage == Usage::Stream) || (vbUsage == Usage::Dynamic) || (vbUsage == Usage::Static));
     
+    if (msh->Setup.UseSharedStreamBuffers) {
+        // streamed mesh: write into a new range of the shared stream buffer
+        o_assert2_dbg(0 == byteOffset, "streamed meshes can only be updated completely!\n");
+        this->bindVertexBuffer(this->streamVertexBuffer.glBuffer());
+        msh->streamVertexOffset = this->streamVertexBuffer.write(data, numBytes, this->curFrameStats);
+        msh->streamFrameIndex = this->frameIndex;
+        this->curFrameStats.NumUpdateVertices++;
+        this->curFrameStats.VertexUpdateBytes += numBytes;
+        return;
+    }
+    
     uint8 slotIndex = msh->activeVertexBufferSlot;
-    if (Usage::Stream == vbUsage) {
+    if ((Usage::Stream == vbUsage) && (0 == byteOffset)) {
         // if usage is streaming, rotate slot index to next dynamic vertex buffer
-        // to implement double/multi-buffering
+        // to implement double/multi-buffering, partial updates write
+        // into the active buffer
         slotIndex++;
         if (slotIndex >= msh->numVertexBufferSlots) {
             slotIndex = 0;
@@ -847,8 +1119,41 @@ glRenderer::updateVertices(mesh* msh, int32 numBytes, const void* data) {
     
     GLuint vb = msh->glVertexBuffers[slotIndex];
     this->bindVertexBuffer(vb);
-    ::glBufferSubData(GL_ARRAY_BUFFER, 0, numBytes, data);
+    ::glBufferSubData(GL_ARRAY_BUFFER, byteOffset, numBytes, data);
     ORYOL_GL_CHECK_ERROR();
+    this->curFrameStats.NumUpdateVertices++;
+    this->curFrameStats.VertexUpdateBytes += numBytes;
+}
+
+//------------------------------------------------------------------------------
+void
+glRenderer::updateIndices(mesh* msh, int32 byteOffset, int32 numBytes, const void* data) {
+    o_assert_dbg(this->valid);
+    o_assert_dbg(Core::IsMainThread());
+    o_assert_dbg(nullptr != msh);
+    o_assert(numBytes > 0);
+    
+    const IndexBufferAttrs& attrs = msh->indexBufferAttrs;
+    const Usage::Code ibUsage = attrs.BufferUsage;
+    o_assert_dbg(IndexType::None != attrs.Type);
+    o_assert_dbg((byteOffset >= 0) && ((byteOffset + numBytes) <= attrs.ByteSize()));
+    o_assert_dbg((ibUsage == Usage::Stream) || (ibUsage == Usage::Dynamic) || (ibUsage == Usage::Static));
+    
+    // IMPORTANT: unbind the current VAO before touching GL_ELEMENT_ARRAY_BUFFER
+    this->invalidateMeshState();
+    if (msh->Setup.UseSharedStreamBuffers) {
+        o_assert2_dbg(0 == byteOffset, "streamed meshes can only be updated completely!\n");
+        this->bindIndexBuffer(this->streamIndexBuffer.glBuffer());
+        msh->streamIndexOffset = this->streamIndexBuffer.write(data, numBytes, this->curFrameStats);
+        msh->streamFrameIndex = this->frameIndex;
+    }
+    else {
+        this->bindIndexBuffer(msh->glIndexBuffer);
+        ::glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, byteOffset, numBytes, data);
+        ORYOL_GL_CHECK_ERROR();
+    }
+    this->curFrameStats.NumUpdateIndices++;
+    this->curFrameStats.IndexUpdateBytes += numBytes;
 }
 
 //------------------------------------------------------------------------------
@@ -900,6 +1205,7 @@ glRenderer::invalidateMeshState() {
     this->vertexArrayObject = 0;
     this->vertexBuffer = 0;
     this->indexBuffer = 0;
+    this->attrMesh = nullptr;
 }
 
 //------------------------------------------------------------------------------
@@ -996,9 +1302,42 @@ glRenderer::bindTexture(int32 samplerIndex, GLenum target, GLuint tex) {
         ORYOL_GL_CHECK_ERROR();
         ::glBindTexture(target, tex);
         ORYOL_GL_CHECK_ERROR();
+        this->curFrameStats.NumTextureChanges++;
+    }
+    else {
+        this->curFrameStats.NumRedundantStateChanges++;
     }
 }
 
+//------------------------------------------------------------------------------
+void
+glRenderer::invalidateUniformBlockState() {
+    o_assert_dbg(this->valid);
+    o_assert_dbg(Core::IsMainThread());
+
+    for (int32 i = 0; i < ProgramBundleSetup::MaxNumUniformBlocks; i++) {
+        this->uniformBuffers[i] = 0;
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+glRenderer::bindUniformBuffer(int32 slotIndex, GLuint ubo) {
+    o_assert_dbg(this->valid);
+    o_assert_dbg(Core::IsMainThread());
+    o_assert_range_dbg(slotIndex, ProgramBundleSetup::MaxNumUniformBlocks);
+
+    #if ORYOL_OPENGL_CORE_PROFILE
+    if (ubo != this->uniformBuffers[slotIndex]) {
+        this->uniformBuffers[slotIndex] = ubo;
+        ::glBindBufferBase(GL_UNIFORM_BUFFER, slotIndex, ubo);
+        ORYOL_GL_CHECK_ERROR();
+    }
+    #else
+    o_error("glRenderer::bindUniformBuffer: uniform buffers not supported!\n");
+    #endif
+}
+
 //------------------------------------------------------------------------------
 void
 glRenderer::setupDepthStencilState() {
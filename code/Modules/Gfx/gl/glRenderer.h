@@ -10,8 +10,12 @@
 #include "Gfx/Core/DepthStencilState.h"
 #include "Gfx/Core/RasterizerState.h"
 #include "Gfx/Core/PrimitiveGroup.h"
+#include "Gfx/Core/GfxFrameStats.h"
+#include "Gfx/Setup/ProgramBundleSetup.h"
+#include "Gfx/Setup/GfxSetup.h"
 #include "Gfx/Attrs/DisplayAttrs.h"
 #include "Gfx/gl/gl_decl.h"
+#include "Gfx/gl/glStreamBuffer.h"
 #include "glm/vec4.hpp"
 
 namespace Oryol {
@@ -31,7 +35,7 @@ public:
     ~glRenderer();
     
     /// setup the renderer
-    void setup();
+    void setup(const GfxSetup& setup);
     /// discard the renderer
     void discard();
     /// return true if renderer has been setup
@@ -45,6 +49,8 @@ public:
     void commitFrame();
     /// get the current render target attributes
     const DisplayAttrs& renderTargetAttrs() const;
+    /// get the statistics of the last committed frame
+    const GfxFrameStats& frameStats() const;
 
     /// apply a render target (default or offscreen)
     void applyRenderTarget(displayMgr* displayManager, texture* rt);
@@ -62,6 +68,8 @@ public:
     template<class T> void applyVariable(int32 index, const T& value);
     /// apply a shader variable array
     template<class T> void applyVariableArray(int32 index, const T* values, int32 numValues);
+    /// apply a uniform block, only uploads the block if its content has changed
+    void applyUniformBlock(int32 slotIndex, const void* data, int32 numBytes);
     /// clear currently assigned render target
     void clear(PixelChannel::Mask channels, const glm::vec4& color, float32 depth, uint8 stencil);
     /// submit a draw call with primitive group index in current mesh
@@ -72,8 +80,10 @@ public:
     void drawInstanced(int32 primGroupIndex, int32 numInstances);
     /// submit a draw call for instanced rendering with direct primitive group
     void drawInstanced(const PrimitiveGroup& primGroup, int32 numInstances);
-    /// update vertex data
-    void updateVertices(mesh* msh, int32 numBytes, const void* data);
+    /// update vertex data, complete or a byte range
+    void updateVertices(mesh* msh, int32 byteOffset, int32 numBytes, const void* data);
+    /// update index data, complete or a byte range
+    void updateIndices(mesh* msh, int32 byteOffset, int32 numBytes, const void* data);
     /// read pixels back from framebuffer, causes a PIPELINE STALL!!!
     void readPixels(displayMgr* displayManager, void* buf, int32 bufNumBytes);
     
@@ -95,6 +105,18 @@ public:
     void invalidateTextureState();
     /// bind a texture to a sampler index
     void bindTexture(int32 samplerIndex, GLenum target, GLuint tex);
+
+    /// invalidate uniform buffer bindings
+    void invalidateUniformBlockState();
+    /// bind a uniform buffer to a uniform block slot (only with UBO support)
+    void bindUniformBuffer(int32 slotIndex, GLuint ubo);
+    
+    /// count resource data uploaded by the resource factories
+    void addUploadBytes(int32 numBytes);
+    /// count state changes skipped before reaching the renderer
+    void addElidedStateChanges(int32 num);
+    /// count draws merged into instanced draws before reaching the renderer
+    void addMergedDraws(int32 num);
     
 private:
     /// setup the initial depth-stencil-state
@@ -115,6 +137,10 @@ private:
     void applyProgramBundle(programBundle* progBundle, uint32 progSelMask);
     /// apply mesh to use for rendering
     void applyMesh(const mesh* msh, const programBundle* progBundle);
+    /// apply a streamed mesh which lives in the shared stream buffers
+    void applyStreamMesh(const mesh* msh);
+    /// get byte offset of a primitive group's first index in the bound index buffer
+    int32 indexByteOffset(const PrimitiveGroup& primGroup) const;
 
     bool valid;
     #if ORYOL_MACOS // FIXME: should be a new 'ORYOL_GL_ISCOREPROFILE' define
@@ -156,11 +182,24 @@ private:
     GLuint vertexBuffer;
     GLuint indexBuffer;
     GLuint vertexArrayObject;
+    const mesh* attrMesh;       // mesh of the current vertex attributes (without VAOs, or in streamVAO)
+    uint8 attrMeshSlot;
+    int32 attrMeshOffset;       // stream buffer offset of the current vertex attributes
     GLuint program;
     
     static const int32 MaxTextureSamplers = 16;
     GLuint samplers2D[MaxTextureSamplers];
     GLuint samplersCube[MaxTextureSamplers];
+
+    GLuint uniformBuffers[ProgramBundleSetup::MaxNumUniformBlocks];
+    
+    int32 frameIndex;
+    glStreamBuffer streamVertexBuffer;
+    glStreamBuffer streamIndexBuffer;
+    GLuint streamVAO;
+    
+    GfxFrameStats curFrameStats;
+    GfxFrameStats lastFrameStats;
 };
 
 //------------------------------------------------------------------------------
@@ -168,6 +207,30 @@ inline const DisplayAttrs&
 glRenderer::renderTargetAttrs() const {
     return this->rtAttrs;
 }
+
+//------------------------------------------------------------------------------
+inline const GfxFrameStats&
+glRenderer::frameStats() const {
+    return this->lastFrameStats;
+}
+
+//------------------------------------------------------------------------------
+inline void
+glRenderer::addUploadBytes(int32 numBytes) {
+    this->curFrameStats.ResourceUploadBytes += numBytes;
+}
+
+//------------------------------------------------------------------------------
+inline void
+glRenderer::addElidedStateChanges(int32 num) {
+    this->curFrameStats.NumElidedStateChanges += num;
+}
+
+//------------------------------------------------------------------------------
+inline void
+glRenderer::addMergedDraws(int32 num) {
+    this->curFrameStats.NumMergedDraws += num;
+}
     
 } // namespace _priv
 } // namespace Oryol
\ No newline at end of file
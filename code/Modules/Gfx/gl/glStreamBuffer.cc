@@ -0,0 +1,170 @@
+//------------------------------------------------------------------------------
+//  glStreamBuffer.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "glStreamBuffer.h"
+#include "Gfx/gl/gl_impl.h"
+#include "Core/Assertion.h"
+#include "Core/Memory/Memory.h"
+
+namespace Oryol {
+namespace _priv {
+
+//------------------------------------------------------------------------------
+glStreamBuffer::glStreamBuffer() :
+target(0),
+buffer(0)
+#if ORYOL_OPENGL_CORE_PROFILE
+,fenceStart(0)
+#else
+,orphaned(false)
+#endif
+{
+    #if ORYOL_OPENGL_CORE_PROFILE
+    for (int32 i = 0; i < streamRingAllocator::MaxNumPendingFrames; i++) {
+        this->fences[i] = nullptr;
+    }
+    #endif
+}
+
+//------------------------------------------------------------------------------
+glStreamBuffer::~glStreamBuffer() {
+    o_assert_dbg(!this->isValid());
+}
+
+//------------------------------------------------------------------------------
+void
+glStreamBuffer::setup(GLenum target_, int32 size) {
+    o_assert_dbg(!this->isValid());
+    o_assert_dbg((GL_ARRAY_BUFFER == target_) || (GL_ELEMENT_ARRAY_BUFFER == target_));
+    o_assert_dbg(size > 0);
+
+    this->target = target_;
+    ::glGenBuffers(1, &this->buffer);
+    ORYOL_GL_CHECK_ERROR();
+    o_assert_dbg(0 != this->buffer);
+    ::glBindBuffer(this->target, this->buffer);
+    ::glBufferData(this->target, size, nullptr, GL_STREAM_DRAW);
+    ORYOL_GL_CHECK_ERROR();
+    this->ring.setup(size);
+}
+
+//------------------------------------------------------------------------------
+void
+glStreamBuffer::discard() {
+    o_assert_dbg(this->isValid());
+    #if ORYOL_OPENGL_CORE_PROFILE
+    while (this->ring.numPendingFrames() > 0) {
+        this->retireOldestFrame(false);
+    }
+    this->fenceStart = 0;
+    #else
+    this->orphaned = false;
+    #endif
+    this->ring.discard();
+    ::glDeleteBuffers(1, &this->buffer);
+    ORYOL_GL_CHECK_ERROR();
+    this->buffer = 0;
+    this->target = 0;
+}
+
+//------------------------------------------------------------------------------
+void
+glStreamBuffer::retireOldestFrame(bool wait) {
+    #if ORYOL_OPENGL_CORE_PROFILE
+    GLsync& fence = this->fences[this->fenceStart];
+    o_assert_dbg(nullptr != fence);
+    if (wait) {
+        GLenum result;
+        do {
+            result = ::glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+            ORYOL_GL_CHECK_ERROR();
+        }
+        while (GL_TIMEOUT_EXPIRED == result);
+        o_assert_dbg(GL_WAIT_FAILED != result);
+    }
+    ::glDeleteSync(fence);
+    fence = nullptr;
+    this->fenceStart = (this->fenceStart + 1) % streamRingAllocator::MaxNumPendingFrames;
+    #endif
+    this->ring.retireFrame();
+}
+
+//------------------------------------------------------------------------------
+int32
+glStreamBuffer::write(const void* data, int32 numBytes, GfxFrameStats& stats) {
+    o_assert_dbg(this->isValid());
+    o_assert_dbg((nullptr != data) && (numBytes > 0));
+
+    #if ORYOL_OPENGL_CORE_PROFILE
+    const int32 usedBefore = this->ring.numFrameBytes();
+    int32 offset = this->ring.alloc(numBytes, streamRingAllocator::DefaultAlignment);
+    while (InvalidIndex == offset) {
+        if (0 == this->ring.numPendingFrames()) {
+            o_error("glStreamBuffer: stream buffer too small for one frame (see GfxSetup::StreamVertexBufferSize/StreamIndexBufferSize)!\n");
+        }
+        this->retireOldestFrame(true);
+        stats.NumStreamBufferWaits++;
+        offset = this->ring.alloc(numBytes, streamRingAllocator::DefaultAlignment);
+    }
+    stats.StreamBufferBytes += this->ring.numFrameBytes() - usedBefore;
+    const GLbitfield access = GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT;
+    void* dst = ::glMapBufferRange(this->target, offset, numBytes, access);
+    ORYOL_GL_CHECK_ERROR();
+    o_assert_dbg(nullptr != dst);
+    Memory::Copy(data, dst, numBytes);
+    ::glUnmapBuffer(this->target);
+    ORYOL_GL_CHECK_ERROR();
+    #else
+    if (!this->orphaned) {
+        // first write in this frame, detach the storage which may
+        // still be used by the GPU and start over
+        ::glBufferData(this->target, this->ring.capacity(), nullptr, GL_STREAM_DRAW);
+        ORYOL_GL_CHECK_ERROR();
+        this->ring.reset();
+        this->orphaned = true;
+    }
+    const int32 usedBefore = this->ring.numFrameBytes();
+    const int32 offset = this->ring.alloc(numBytes, streamRingAllocator::DefaultAlignment);
+    if (InvalidIndex == offset) {
+        o_error("glStreamBuffer: stream buffer too small for one frame (see GfxSetup::StreamVertexBufferSize/StreamIndexBufferSize)!\n");
+    }
+    stats.StreamBufferBytes += this->ring.numFrameBytes() - usedBefore;
+    ::glBufferSubData(this->target, offset, numBytes, data);
+    ORYOL_GL_CHECK_ERROR();
+    #endif
+    return offset;
+}
+
+//------------------------------------------------------------------------------
+void
+glStreamBuffer::commitFrame() {
+    o_assert_dbg(this->isValid());
+
+    #if ORYOL_OPENGL_CORE_PROFILE
+    // release the ranges of frames which the GPU has finished
+    while (this->ring.numPendingFrames() > 0) {
+        const GLenum result = ::glClientWaitSync(this->fences[this->fenceStart], 0, 0);
+        if ((GL_ALREADY_SIGNALED == result) || (GL_CONDITION_SATISFIED == result)) {
+            this->retireOldestFrame(false);
+        }
+        else {
+            break;
+        }
+    }
+    if (this->ring.numFrameBytes() > 0) {
+        if (this->ring.numPendingFrames() == streamRingAllocator::MaxNumPendingFrames) {
+            this->retireOldestFrame(true);
+        }
+        const int32 index = (this->fenceStart + this->ring.numPendingFrames()) % streamRingAllocator::MaxNumPendingFrames;
+        this->ring.commitFrame();
+        this->fences[index] = ::glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        ORYOL_GL_CHECK_ERROR();
+    }
+    #else
+    this->orphaned = false;
+    #endif
+}
+
+} // namespace _priv
+} // namespace Oryol
@@ -0,0 +1,76 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::_priv::glStreamBuffer
+    @ingroup _priv
+    @brief GL buffer object shared by streamed meshes
+
+    A big GL buffer which is sub-allocated in ring order by the
+    streamed meshes' UpdateVertices()/UpdateIndices() calls. On
+    the GL Core Profile, each write maps its range unsynchronized,
+    and a fence is inserted at the end of each frame. A range is
+    only reused after the fence of its frame has signaled. On GLES2
+    and WebGL the buffer is orphaned on the first write of a frame
+    instead and written with glBufferSubData(), the driver then
+    takes care of the synchronization.
+
+    The buffer must be bound to its target before write() is called.
+*/
+#include "Core/Types.h"
+#include "Gfx/Core/streamRingAllocator.h"
+#include "Gfx/Core/GfxFrameStats.h"
+#include "Gfx/gl/gl_decl.h"
+
+namespace Oryol {
+namespace _priv {
+
+class glStreamBuffer {
+public:
+    /// constructor
+    glStreamBuffer();
+    /// destructor
+    ~glStreamBuffer();
+
+    /// create the GL buffer (GL_ARRAY_BUFFER or GL_ELEMENT_ARRAY_BUFFER), binds the buffer!
+    void setup(GLenum target, int32 size);
+    /// destroy the GL buffer
+    void discard();
+    /// return true if the buffer has been setup
+    bool isValid() const;
+    /// get the GL buffer object
+    GLuint glBuffer() const;
+
+    /// copy data into a new range of the bound buffer, returns the byte offset of the range
+    int32 write(const void* data, int32 numBytes, GfxFrameStats& stats);
+    /// finish the current frame (inserts a fence)
+    void commitFrame();
+
+private:
+    /// release the ranges of the oldest pending frame, optionally wait for its fence
+    void retireOldestFrame(bool wait);
+
+    GLenum target;
+    GLuint buffer;
+    streamRingAllocator ring;
+    #if ORYOL_OPENGL_CORE_PROFILE
+    GLsync fences[streamRingAllocator::MaxNumPendingFrames];
+    int32 fenceStart;
+    #else
+    bool orphaned;
+    #endif
+};
+
+//------------------------------------------------------------------------------
+inline bool
+glStreamBuffer::isValid() const {
+    return 0 != this->buffer;
+}
+
+//------------------------------------------------------------------------------
+inline GLuint
+glStreamBuffer::glBuffer() const {
+    return this->buffer;
+}
+
+} // namespace _priv
+} // namespace Oryol
@@ -376,6 +376,7 @@ glTextureFactory::createFromPixelData(texture& tex, const Ptr<Stream>& data) {
                                srcPtr + setup.ImageOffsets[faceIndex][mipIndex]);
                 ORYOL_GL_CHECK_ERROR();
             }
+            this->renderer->addUploadBytes(setup.ImageSizes[faceIndex][mipIndex]);
         }
     }
     data->UnmapRead();
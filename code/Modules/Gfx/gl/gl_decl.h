@@ -23,4 +23,5 @@ typedef double GLdouble;
 typedef double GLclampd;
 typedef void GLvoid;
 #endif
+typedef struct __GLsync* GLsync;
 
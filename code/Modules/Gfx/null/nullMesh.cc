@@ -0,0 +1,33 @@
+//------------------------------------------------------------------------------
+//  nullMesh.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "nullMesh.h"
+
+namespace Oryol {
+namespace _priv {
+
+//------------------------------------------------------------------------------
+nullMesh::nullMesh() :
+numVertexBufferSlots(1),
+activeVertexBufferSlot(0),
+instanceMesh(nullptr) {
+    // empty
+}
+
+//------------------------------------------------------------------------------
+nullMesh::~nullMesh() {
+    o_assert_dbg(nullptr == this->instanceMesh);
+}
+
+//------------------------------------------------------------------------------
+void
+nullMesh::Clear() {
+    this->numVertexBufferSlots = 1;
+    this->activeVertexBufferSlot = 0;
+    this->instanceMesh = nullptr;
+    meshBase::Clear();
+}
+
+} // namespace _priv
+} // namespace Oryol
@@ -0,0 +1,37 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::_priv::nullMesh
+    @ingroup _priv
+    @brief null-backend implementation of mesh
+
+    The null mesh only holds the CPU-side mesh attributes and the
+    vertex buffer slot state, vertex and index data is not retained.
+*/
+#include "Gfx/Resource/meshBase.h"
+
+namespace Oryol {
+namespace _priv {
+
+class nullMesh : public meshBase {
+public:
+    /// constructor
+    nullMesh();
+    /// destructor
+    ~nullMesh();
+
+    static const int32 MaxNumSlots = 4;
+
+    /// clear the object
+    void Clear();
+
+    /// number of vertex buffer slots
+    uint8 numVertexBufferSlots;
+    /// active vertex buffer slot
+    uint8 activeVertexBufferSlot;
+    /// optional instance data mesh
+    const nullMesh* instanceMesh;
+};
+
+} // namespace _priv
+} // namespace Oryol
@@ -0,0 +1,235 @@
+//------------------------------------------------------------------------------
+//  nullMeshFactory.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "nullMeshFactory.h"
+#include "Gfx/Resource/meshPool.h"
+#include "Gfx/Core/renderer.h"
+#include "Resource/ResourceState.h"
+
+namespace Oryol {
+namespace _priv {
+
+//------------------------------------------------------------------------------
+nullMeshFactory::nullMeshFactory() :
+renderer(nullptr),
+meshPool(nullptr),
+isValid(false) {
+    // empty
+}
+
+//------------------------------------------------------------------------------
+nullMeshFactory::~nullMeshFactory() {
+    o_assert_dbg(!this->isValid);
+}
+
+//------------------------------------------------------------------------------
+void
+nullMeshFactory::Setup(class renderer* rendr, class meshPool* mshPool) {
+    o_assert_dbg(!this->isValid);
+    o_assert_dbg(nullptr != rendr);
+    o_assert_dbg(nullptr != mshPool);
+    this->isValid = true;
+    this->renderer = rendr;
+    this->meshPool = mshPool;
+}
+
+//------------------------------------------------------------------------------
+void
+nullMeshFactory::Discard() {
+    o_assert_dbg(this->isValid);
+    this->isValid = false;
+    this->renderer = nullptr;
+    this->meshPool = nullptr;
+}
+
+//------------------------------------------------------------------------------
+bool
+nullMeshFactory::IsValid() const {
+    return this->isValid;
+}
+
+//------------------------------------------------------------------------------
+ResourceState::Code
+nullMeshFactory::SetupResource(mesh& msh) {
+    o_assert_dbg(this->isValid);
+
+    if (msh.Setup.ShouldSetupEmpty()) {
+        return this->createEmptyMesh(msh);
+    }
+    else if (msh.Setup.ShouldSetupFullScreenQuad()) {
+        o_assert_dbg(!msh.Setup.InstanceMesh.IsValid());
+        return this->createFullscreenQuad(msh);
+    }
+    else {
+        o_error("nullMeshFactory::SetupResource(): don't know how to create mesh!");
+        return ResourceState::InvalidState;
+    }
+}
+
+//------------------------------------------------------------------------------
+ResourceState::Code
+nullMeshFactory::SetupResource(mesh& msh, const Ptr<Stream>& data) {
+    o_assert_dbg(msh.Setup.ShouldSetupFromStream());
+    return this->createFromStream(msh, data);
+}
+
+//------------------------------------------------------------------------------
+void
+nullMeshFactory::DestroyResource(mesh& msh) {
+    o_assert_dbg(nullptr != this->renderer);
+    this->renderer->invalidateMeshState();
+    msh.Clear();
+}
+
+//------------------------------------------------------------------------------
+void
+nullMeshFactory::attachInstanceBuffer(mesh& msh) {
+    const Id& instMeshId = msh.Setup.InstanceMesh;
+    if (instMeshId.IsValid()) {
+        o_assert_dbg(this->meshPool->QueryState(instMeshId) == ResourceState::Valid);
+        const mesh* instMesh = this->meshPool->Lookup(instMeshId);
+        o_assert_dbg(instMesh);
+        msh.instanceMesh = instMesh;
+        o_assert2_dbg(!instMesh->Setup.UseSharedStreamBuffers, "streamed meshes can't be used as instance mesh!\n");
+
+        // if instancing is used, geometry mesh cannot be dynamic (same as GL)
+        o_assert_dbg(msh.numVertexBufferSlots == 1);
+
+        // verify that there are no colliding vertex components
+        #if ORYOL_DEBUG
+        const VertexLayout& mshLayout = msh.vertexBufferAttrs.Layout;
+        const VertexLayout& instLayout = instMesh->vertexBufferAttrs.Layout;
+        for (int32 i = 0; i < mshLayout.NumComponents(); i++) {
+            o_assert_dbg(!instLayout.Contains(mshLayout.Component(i).Attr));
+        }
+        #endif
+    }
+}
+
+//------------------------------------------------------------------------------
+ResourceState::Code
+nullMeshFactory::createFullscreenQuad(mesh& mesh) {
+    o_assert_dbg(!mesh.Setup.InstanceMesh.IsValid());
+
+    VertexBufferAttrs vbAttrs;
+    vbAttrs.NumVertices = 4;
+    vbAttrs.BufferUsage = Usage::Immutable;
+    VertexLayout layout;
+    layout.Add(VertexAttr::Position, VertexFormat::Float3);
+    layout.Add(VertexAttr::TexCoord0, VertexFormat::Float2);
+    vbAttrs.Layout = layout;
+    mesh.vertexBufferAttrs = vbAttrs;
+
+    IndexBufferAttrs ibAttrs;
+    ibAttrs.NumIndices = 6;
+    ibAttrs.Type = IndexType::Index16;
+    ibAttrs.BufferUsage = Usage::Immutable;
+    mesh.indexBufferAttrs = ibAttrs;
+
+    mesh.numPrimGroups = 1;
+    mesh.primGroups[0] = PrimitiveGroup(PrimitiveType::Triangles, 0, 6);
+    this->renderer->addUploadBytes(vbAttrs.ByteSize() + ibAttrs.ByteSize());
+
+    return ResourceState::Valid;
+}
+
+//------------------------------------------------------------------------------
+ResourceState::Code
+nullMeshFactory::createEmptyMesh(mesh& mesh) {
+    const MeshSetup& setup = mesh.Setup;
+    o_assert_dbg(setup.NumVertices > 0);
+
+    VertexBufferAttrs vbAttrs;
+    vbAttrs.NumVertices = setup.NumVertices;
+    vbAttrs.Layout = setup.Layout;
+    vbAttrs.BufferUsage = setup.VertexUsage;
+    mesh.vertexBufferAttrs = vbAttrs;
+
+    IndexBufferAttrs ibAttrs;
+    ibAttrs.NumIndices = setup.NumIndices;
+    ibAttrs.Type = setup.IndicesType;
+    ibAttrs.BufferUsage = setup.IndexUsage;
+    mesh.indexBufferAttrs = ibAttrs;
+
+    const int32 numPrimGroups = setup.NumPrimitiveGroups();
+    if (numPrimGroups > 0) {
+        mesh.numPrimGroups = numPrimGroups;
+        for (int32 i = 0; i < numPrimGroups; i++) {
+            mesh.primGroups[i] = setup.PrimitiveGroup(i);
+        }
+    }
+
+    // streamed meshes live in the renderer's shared stream buffers,
+    // other stream update meshes are double-buffered
+    if (setup.UseSharedStreamBuffers) {
+        o_assert_dbg(!setup.InstanceMesh.IsValid());
+    }
+    else if (Usage::Stream == vbAttrs.BufferUsage) {
+        mesh.numVertexBufferSlots = 2;
+    }
+    this->attachInstanceBuffer(mesh);
+
+    // no data is uploaded for empty meshes
+    return ResourceState::Valid;
+}
+
+//------------------------------------------------------------------------------
+ResourceState::Code
+nullMeshFactory::createFromStream(mesh& mesh, const Ptr<Stream>& data) {
+    const MeshSetup& setup = mesh.Setup;
+
+    if (data->Open(OpenMode::ReadOnly)) {
+        const uint8* endPtr = nullptr;
+        const uint8* ptr = data->MapRead(&endPtr);
+        o_assert_dbg(nullptr != ptr);
+
+        VertexBufferAttrs vbAttrs;
+        vbAttrs.NumVertices = setup.NumVertices;
+        vbAttrs.BufferUsage = setup.VertexUsage;
+        vbAttrs.Layout = setup.Layout;
+        mesh.vertexBufferAttrs = vbAttrs;
+
+        IndexBufferAttrs ibAttrs;
+        ibAttrs.NumIndices = setup.NumIndices;
+        ibAttrs.Type = setup.IndicesType;
+        ibAttrs.BufferUsage = setup.IndexUsage;
+        mesh.indexBufferAttrs = ibAttrs;
+
+        const int32 numPrimGroups = setup.NumPrimitiveGroups();
+        mesh.numPrimGroups = numPrimGroups;
+        o_assert_dbg(mesh.numPrimGroups < mesh::MaxNumPrimGroups);
+        for (int32 i = 0; i < numPrimGroups; i++) {
+            mesh.primGroups[i] = setup.PrimitiveGroup(i);
+        }
+
+        // validate the stream data layout like the GL factory does
+        const uint8* vertices = ptr + setup.StreamVertexOffset;
+        const int32 verticesByteSize = setup.NumVertices * setup.Layout.ByteSize();
+        o_assert_dbg(endPtr >= (vertices + verticesByteSize));
+        int32 uploadBytes = verticesByteSize;
+        if (setup.IndicesType != IndexType::None) {
+            o_assert_dbg(setup.StreamIndexOffset != InvalidIndex);
+            o_assert_dbg(setup.StreamIndexOffset >= verticesByteSize);
+            const uint8* indices = ptr + setup.StreamIndexOffset;
+            const int32 indicesByteSize = setup.NumIndices * IndexType::ByteSize(setup.IndicesType);
+            o_assert_dbg(endPtr >= (indices + indicesByteSize));
+            uploadBytes += indicesByteSize;
+        }
+        this->renderer->addUploadBytes(uploadBytes);
+        this->attachInstanceBuffer(mesh);
+
+        data->UnmapRead();
+        data->Close();
+
+        return ResourceState::Valid;
+    }
+    else {
+        // this shouldn't happen
+        o_error("nullMeshFactory::createFromStream(): failed to open stream!\n");
+        return ResourceState::InvalidState;
+    }
+}
+
+} // namespace _priv
+} // namespace Oryol
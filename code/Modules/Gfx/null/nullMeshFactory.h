@@ -0,0 +1,61 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::_priv::nullMeshFactory
+    @ingroup _priv
+    @brief null-backend implementation of meshFactory
+
+    Runs the same CPU-side setup as the GL mesh factory (vertex/index
+    buffer attributes, primitive groups, vertex buffer slots and
+    instance mesh lookup) and reports the vertex and index data
+    sizes as upload bytes to the renderer.
+*/
+#include "Resource/ResourceState.h"
+#include "Gfx/Resource/mesh.h"
+#include "IO/Stream/Stream.h"
+
+namespace Oryol {
+namespace _priv {
+
+class renderer;
+class meshPool;
+class mesh;
+
+class nullMeshFactory {
+public:
+    /// constructor
+    nullMeshFactory();
+    /// destructor
+    ~nullMeshFactory();
+
+    /// setup with a pointer to the state wrapper object
+    void Setup(renderer* rendr, meshPool* mshPool);
+    /// discard the factory
+    void Discard();
+    /// return true if the object has been setup
+    bool IsValid() const;
+
+    /// setup resource
+    ResourceState::Code SetupResource(mesh& mesh);
+    /// setup with 'raw' data
+    ResourceState::Code SetupResource(mesh& mesh, const Ptr<Stream>& data);
+    /// discard the resource
+    void DestroyResource(mesh& mesh);
+
+private:
+    /// lookup and attach instance buffer to mesh
+    void attachInstanceBuffer(mesh& mesh);
+    /// helper method to setup a mesh object as fullscreen quad
+    ResourceState::Code createFullscreenQuad(mesh& mesh);
+    /// helper method to create empty mesh
+    ResourceState::Code createEmptyMesh(mesh& mesh);
+    /// create from stream data
+    ResourceState::Code createFromStream(mesh& mesh, const Ptr<Stream>& data);
+
+    class renderer* renderer;
+    class meshPool* meshPool;
+    bool isValid;
+};
+
+} // namespace _priv
+} // namespace Oryol
@@ -0,0 +1,75 @@
+//------------------------------------------------------------------------------
+//  nullProgramBundle.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "nullProgramBundle.h"
+
+namespace Oryol {
+namespace _priv {
+
+//------------------------------------------------------------------------------
+nullProgramBundle::nullProgramBundle() {
+    this->Clear();
+}
+
+//------------------------------------------------------------------------------
+nullProgramBundle::~nullProgramBundle() {
+    // empty
+}
+
+//------------------------------------------------------------------------------
+void
+nullProgramBundle::Clear() {
+    this->selMask = 0xFFFFFFFF;
+    this->selIndex = 0;
+    this->numProgramEntries = 0;
+    for (int32 progIndex = 0; progIndex < MaxNumPrograms; progIndex++) {
+        programEntry& entry = this->programEntries[progIndex];
+        entry.mask = 0;
+        for (int32 i = 0; i < MaxNumUniforms; i++) {
+            entry.uniformUsed[i] = false;
+            entry.samplerMapping[i] = -1;
+        }
+    }
+    programBundleBase::Clear();
+}
+
+//------------------------------------------------------------------------------
+int32
+nullProgramBundle::addProgram(uint32 mask) {
+    o_assert_dbg(this->numProgramEntries < MaxNumPrograms);
+
+    // make sure the mask is unique
+    for (int32 i = 0; i < this->numProgramEntries; i++) {
+        o_assert_dbg(this->programEntries[i].mask != mask);
+    }
+
+    this->programEntries[this->numProgramEntries].mask = mask;
+    return this->numProgramEntries++;
+}
+
+//------------------------------------------------------------------------------
+void
+nullProgramBundle::bindUniform(int32 progIndex, int32 slotIndex) {
+    o_assert_range_dbg(progIndex, this->numProgramEntries);
+    o_assert_range_dbg(slotIndex, MaxNumUniforms);
+    this->programEntries[progIndex].uniformUsed[slotIndex] = true;
+}
+
+//------------------------------------------------------------------------------
+void
+nullProgramBundle::bindSamplerUniform(int32 progIndex, int32 slotIndex, int32 samplerIndex) {
+    o_assert_range_dbg(progIndex, this->numProgramEntries);
+    o_assert_range_dbg(slotIndex, MaxNumUniforms);
+    this->programEntries[progIndex].uniformUsed[slotIndex] = true;
+    this->programEntries[progIndex].samplerMapping[slotIndex] = samplerIndex;
+}
+
+//------------------------------------------------------------------------------
+int32
+nullProgramBundle::getNumPrograms() const {
+    return this->numProgramEntries;
+}
+
+} // namespace _priv
+} // namespace Oryol
@@ -0,0 +1,107 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::_priv::nullProgramBundle
+    @ingroup _priv
+    @brief null-backend implementation of programBundle
+
+    Keeps the program selection masks and the uniform-slot to
+    texture-sampler mapping of each program, so that program
+    selection and texture binding behave like on the GL backend.
+*/
+#include "Core/Assertion.h"
+#include "Gfx/Resource/programBundleBase.h"
+
+namespace Oryol {
+namespace _priv {
+
+class nullProgramBundle : public programBundleBase {
+public:
+    /// constructor
+    nullProgramBundle();
+    /// destructor
+    ~nullProgramBundle();
+
+    /// clear the object
+    void Clear();
+
+    /// add a program by mask, returns program index
+    int32 addProgram(uint32 mask);
+    /// bind a uniform to a slot index
+    void bindUniform(int32 progIndex, int32 slotIndex);
+    /// bind a sampler uniform to a slot index
+    void bindSamplerUniform(int32 progIndex, int32 slotIndex, int32 samplerIndex);
+
+    /// select program in the bundle
+    bool selectProgram(uint32 mask);
+    /// get the current selection mask
+    uint32 getSelectionMask() const;
+    /// get the index of the currently selected program
+    int32 getSelectionIndex() const;
+    /// return true if a uniform slot is used by the currently selected program
+    bool hasUniform(int32 slotIndex) const;
+    /// get sampler index by slot index in currently selected program (-1 if not exists)
+    int32 getSamplerIndex(int32 slotIndex) const;
+
+    /// get number of programs
+    int32 getNumPrograms() const;
+
+private:
+    static const int32 MaxNumUniforms = 16;
+    static const int32 MaxNumPrograms = 8;
+
+    struct programEntry {
+        uint32 mask;
+        bool uniformUsed[MaxNumUniforms];
+        int32 samplerMapping[MaxNumUniforms];
+    };
+    uint32 selMask;
+    int32 selIndex;
+    int32 numProgramEntries;
+    programEntry programEntries[MaxNumPrograms];
+};
+
+//------------------------------------------------------------------------------
+inline uint32
+nullProgramBundle::getSelectionMask() const {
+    return this->selMask;
+}
+
+//------------------------------------------------------------------------------
+inline int32
+nullProgramBundle::getSelectionIndex() const {
+    return this->selIndex;
+}
+
+//------------------------------------------------------------------------------
+inline bool
+nullProgramBundle::selectProgram(uint32 mask) {
+    // number of programs will be small, so linear is ok
+    if (this->selMask != mask) {
+        for (int32 i = 0; i < this->numProgramEntries; i++) {
+            if (this->programEntries[i].mask == mask) {
+                this->selMask = mask;
+                this->selIndex = i;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+//------------------------------------------------------------------------------
+inline bool
+nullProgramBundle::hasUniform(int32 slotIndex) const {
+    o_assert_range_dbg(slotIndex, MaxNumUniforms);
+    return this->programEntries[this->selIndex].uniformUsed[slotIndex];
+}
+
+//------------------------------------------------------------------------------
+inline int32
+nullProgramBundle::getSamplerIndex(int32 slotIndex) const {
+    o_assert_range_dbg(slotIndex, MaxNumUniforms);
+    return this->programEntries[this->selIndex].samplerMapping[slotIndex];
+}
+
+} // namespace _priv
+} // namespace Oryol
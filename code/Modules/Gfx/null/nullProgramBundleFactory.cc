@@ -0,0 +1,105 @@
+//------------------------------------------------------------------------------
+//  nullProgramBundleFactory.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "nullProgramBundleFactory.h"
+#include "Gfx/Core/renderer.h"
+#include "Gfx/Resource/shader.h"
+#include "Gfx/Resource/shaderPool.h"
+#include "Gfx/Resource/shaderFactory.h"
+
+namespace Oryol {
+namespace _priv {
+
+//------------------------------------------------------------------------------
+nullProgramBundleFactory::nullProgramBundleFactory() :
+renderer(nullptr),
+shdPool(nullptr),
+shdFactory(nullptr),
+isValid(false) {
+    // empty
+}
+
+//------------------------------------------------------------------------------
+nullProgramBundleFactory::~nullProgramBundleFactory() {
+    o_assert_dbg(!this->isValid);
+}
+
+//------------------------------------------------------------------------------
+void
+nullProgramBundleFactory::Setup(class renderer* rendr, shaderPool* pool, shaderFactory* factory) {
+    o_assert_dbg(!this->isValid);
+    o_assert_dbg(nullptr != rendr);
+    o_assert_dbg(nullptr != pool);
+    o_assert_dbg(nullptr != factory);
+    this->isValid = true;
+    this->renderer = rendr;
+    this->shdPool = pool;
+    this->shdFactory = factory;
+}
+
+//------------------------------------------------------------------------------
+void
+nullProgramBundleFactory::Discard() {
+    o_assert_dbg(this->isValid);
+    this->isValid = false;
+    this->renderer = nullptr;
+    this->shdPool = nullptr;
+    this->shdFactory = nullptr;
+}
+
+//------------------------------------------------------------------------------
+bool
+nullProgramBundleFactory::IsValid() const {
+    return this->isValid;
+}
+
+//------------------------------------------------------------------------------
+ResourceState::Code
+nullProgramBundleFactory::SetupResource(programBundle& progBundle) {
+    o_assert_dbg(this->isValid);
+    this->renderer->invalidateProgramState();
+
+    const ProgramBundleSetup& setup = progBundle.Setup;
+    const int32 numProgs = setup.NumPrograms();
+    for (int32 progIndex = 0; progIndex < numProgs; progIndex++) {
+
+        // precompiled shaders must exist, shader sources are ignored
+        #if ORYOL_DEBUG
+        if (setup.VertexShader(progIndex).IsValid()) {
+            o_assert_dbg(nullptr != this->shdPool->Lookup(setup.VertexShader(progIndex)));
+        }
+        if (setup.FragmentShader(progIndex).IsValid()) {
+            o_assert_dbg(nullptr != this->shdPool->Lookup(setup.FragmentShader(progIndex)));
+        }
+        #endif
+
+        progBundle.addProgram(setup.Mask(progIndex));
+
+        // resolve uniform and texture sampler slots
+        int32 samplerIndex = 0;
+        const int32 numUniforms = setup.NumUniforms();
+        for (int32 i = 0; i < numUniforms; i++) {
+            const int16 slotIndex = setup.UniformSlot(i);
+            if (setup.IsTextureUniform(i)) {
+                progBundle.bindSamplerUniform(progIndex, slotIndex, samplerIndex++);
+            }
+            else {
+                progBundle.bindUniform(progIndex, slotIndex);
+            }
+        }
+    }
+    progBundle.setupUniformBlocks(numProgs);
+    return ResourceState::Valid;
+}
+
+//------------------------------------------------------------------------------
+void
+nullProgramBundleFactory::DestroyResource(programBundle& progBundle) {
+    o_assert_dbg(this->isValid);
+    this->renderer->invalidateProgramState();
+    progBundle.Clear();
+}
+
+} // namespace _priv
+} // namespace Oryol
@@ -0,0 +1,49 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::_priv::nullProgramBundleFactory
+    @ingroup _priv
+    @brief null-backend implementation of programBundleFactory
+
+    Registers the program selection masks and resolves the uniform
+    and texture sampler slots like the GL factory, but doesn't compile
+    or link shader code.
+*/
+#include "Resource/ResourceState.h"
+#include "Gfx/Resource/programBundle.h"
+
+namespace Oryol {
+namespace _priv {
+
+class renderer;
+class shaderPool;
+class shaderFactory;
+
+class nullProgramBundleFactory {
+public:
+    /// constructor
+    nullProgramBundleFactory();
+    /// destructor
+    ~nullProgramBundleFactory();
+
+    /// setup with a pointer to the state wrapper object
+    void Setup(class renderer* rendr, shaderPool* shdPool, shaderFactory* shdFactory);
+    /// discard the factory
+    void Discard();
+    /// return true if the object has been setup
+    bool IsValid() const;
+
+    /// setup programBundle resource
+    ResourceState::Code SetupResource(programBundle& progBundle);
+    /// destroy the programBundle
+    void DestroyResource(programBundle& progBundle);
+
+private:
+    class renderer* renderer;
+    shaderPool* shdPool;
+    shaderFactory* shdFactory;
+    bool isValid;
+};
+
+} // namespace _priv
+} // namespace Oryol
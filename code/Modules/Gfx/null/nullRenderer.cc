@@ -0,0 +1,555 @@
+//------------------------------------------------------------------------------
+//  nullRenderer.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "Core/Core.h"
+#include "Core/Memory/Memory.h"
+#include "nullRenderer.h"
+#include "Gfx/Core/displayMgr.h"
+#include "Gfx/Resource/texture.h"
+#include "Gfx/Resource/programBundle.h"
+#include "Gfx/Resource/mesh.h"
+#include "Gfx/Resource/drawState.h"
+
+namespace Oryol {
+namespace _priv {
+
+//------------------------------------------------------------------------------
+nullRenderer::nullRenderer() :
+valid(false),
+rtValid(false),
+curRenderTarget(nullptr),
+curDrawState(nullptr),
+curMesh(nullptr),
+curProgramBundle(nullptr),
+scissorX(0),
+scissorY(0),
+scissorWidth(0),
+scissorHeight(0),
+blendColor(0.0f, 0.0f, 0.0f, 0.0f),
+viewPortX(0),
+viewPortY(0),
+viewPortWidth(0),
+viewPortHeight(0),
+boundMesh(nullptr),
+boundMeshSlot(0),
+boundMeshOffset(InvalidIndex),
+boundProgramBundle(nullptr),
+boundProgramIndex(InvalidIndex),
+frameIndex(0) {
+    for (int32 i = 0; i < MaxTextureSamplers; i++) {
+        this->samplers[i] = nullptr;
+    }
+}
+
+//------------------------------------------------------------------------------
+nullRenderer::~nullRenderer() {
+    o_assert_dbg(!this->valid);
+}
+
+//------------------------------------------------------------------------------
+void
+nullRenderer::setup(const GfxSetup& setup) {
+    o_assert_dbg(!this->valid);
+    o_assert_dbg(Core::IsMainThread());
+
+    this->valid = true;
+    this->frameIndex = 0;
+    if (setup.StreamVertexBufferSize > 0) {
+        this->streamVertices.setup(setup.StreamVertexBufferSize);
+    }
+    if (setup.StreamIndexBufferSize > 0) {
+        this->streamIndices.setup(setup.StreamIndexBufferSize);
+    }
+    this->depthStencilState = DepthStencilState();
+    this->blendState = BlendState();
+    this->rasterizerState = RasterizerState();
+    this->curFrameStats = GfxFrameStats();
+    this->lastFrameStats = GfxFrameStats();
+}
+
+//------------------------------------------------------------------------------
+void
+nullRenderer::discard() {
+    o_assert_dbg(this->valid);
+    o_assert_dbg(Core::IsMainThread());
+
+    this->invalidateMeshState();
+    this->invalidateProgramState();
+    this->invalidateTextureState();
+    this->curRenderTarget = nullptr;
+    this->curDrawState = nullptr;
+    this->curMesh = nullptr;
+    this->curProgramBundle = nullptr;
+    if (this->streamVertices.isValid()) {
+        this->streamVertices.discard();
+    }
+    if (this->streamIndices.isValid()) {
+        this->streamIndices.discard();
+    }
+    this->valid = false;
+}
+
+//------------------------------------------------------------------------------
+bool
+nullRenderer::isValid() const {
+    return this->valid;
+}
+
+//------------------------------------------------------------------------------
+void
+nullRenderer::resetStateCache() {
+    o_assert_dbg(this->valid);
+    o_assert_dbg(Core::IsMainThread());
+
+    this->depthStencilState = DepthStencilState();
+    this->blendState = BlendState();
+    this->rasterizerState = RasterizerState();
+    this->invalidateMeshState();
+    this->invalidateProgramState();
+    this->invalidateTextureState();
+}
+
+//------------------------------------------------------------------------------
+/**
+ The null renderer claims to support all optional features, so that
+ feature-dependent code paths (e.g. compressed texture loading or
+ instancing) can be exercised without a GPU.
+*/
+bool
+nullRenderer::supports(GfxFeature::Code feat) const {
+    o_assert_dbg(this->valid);
+    return true;
+}
+
+//------------------------------------------------------------------------------
+void
+nullRenderer::commitFrame() {
+    o_assert_dbg(this->valid);
+    o_assert_dbg(Core::IsMainThread());
+
+    this->rtValid = false;
+    this->lastFrameStats = this->curFrameStats;
+    this->curFrameStats = GfxFrameStats();
+
+    // the emulated GPU releases stream buffer ranges a few frames later
+    streamRingAllocator* rings[2] = { &this->streamVertices, &this->streamIndices };
+    for (streamRingAllocator* ring : rings) {
+        if (ring->isValid()) {
+            ring->commitFrame();
+            while (ring->numPendingFrames() > NumEmulatedFramesInFlight) {
+                ring->retireFrame();
+            }
+        }
+    }
+    this->frameIndex++;
+}
+
+//------------------------------------------------------------------------------
+void
+nullRenderer::applyViewPort(int32 x, int32 y, int32 width, int32 height) {
+    o_assert_dbg(this->valid);
+
+    if ((x != this->viewPortX) ||
+        (y != this->viewPortY) ||
+        (width != this->viewPortWidth) ||
+        (height != this->viewPortHeight)) {
+
+        this->viewPortX = x;
+        this->viewPortY = y;
+        this->viewPortWidth = width;
+        this->viewPortHeight = height;
+        this->curFrameStats.NumViewPortChanges++;
+    }
+    else {
+        this->curFrameStats.NumRedundantStateChanges++;
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+nullRenderer::applyRenderTarget(displayMgr* displayManager, texture* rt) {
+    o_assert_dbg(this->valid);
+    o_assert_dbg(displayManager);
+
+    this->curFrameStats.NumApplyRenderTarget++;
+
+    // also update view port to cover full render target
+    if (nullptr == rt) {
+        this->rtAttrs = displayManager->GetDisplayAttrs();
+    }
+    else {
+        const TextureAttrs& attrs = rt->textureAttrs;
+        this->rtAttrs.WindowWidth = attrs.Width;
+        this->rtAttrs.WindowHeight = attrs.Height;
+        this->rtAttrs.WindowPosX = 0;
+        this->rtAttrs.WindowPosY = 0;
+        this->rtAttrs.FramebufferWidth = attrs.Width;
+        this->rtAttrs.FramebufferHeight = attrs.Height;
+        this->rtAttrs.ColorPixelFormat = attrs.ColorFormat;
+        this->rtAttrs.DepthPixelFormat = attrs.DepthFormat;
+        this->rtAttrs.Samples = 1;
+        this->rtAttrs.Windowed = false;
+        this->rtAttrs.SwapInterval = 1;
+    }
+
+    // 'bind' the frame buffer
+    if (rt != this->curRenderTarget) {
+        this->curFrameStats.NumRenderTargetChanges++;
+    }
+    else {
+        this->curFrameStats.NumRedundantStateChanges++;
+    }
+    this->curRenderTarget = rt;
+    this->rtValid = true;
+
+    // set viewport to cover whole screen
+    this->applyViewPort(0, 0, this->rtAttrs.FramebufferWidth, this->rtAttrs.FramebufferHeight);
+
+    // reset scissor test
+    if (this->rasterizerState.ScissorTestEnabled) {
+        this->rasterizerState.ScissorTestEnabled = false;
+        this->curFrameStats.NumRasterizerStateChanges++;
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+nullRenderer::applyScissorRect(int32 x, int32 y, int32 width, int32 height) {
+    o_assert_dbg(this->valid);
+
+    if ((x != this->scissorX) ||
+        (y != this->scissorY) ||
+        (width != this->scissorWidth) ||
+        (height != this->scissorHeight)) {
+
+        this->scissorX = x;
+        this->scissorY = y;
+        this->scissorWidth = width;
+        this->scissorHeight = height;
+        this->curFrameStats.NumScissorRectChanges++;
+    }
+    else {
+        this->curFrameStats.NumRedundantStateChanges++;
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+nullRenderer::applyBlendColor(const glm::vec4& c) {
+    o_assert_dbg(this->valid);
+
+    if (c != this->blendColor) {
+        this->blendColor = c;
+        this->curFrameStats.NumBlendColorChanges++;
+    }
+    else {
+        this->curFrameStats.NumRedundantStateChanges++;
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+nullRenderer::applyProgramBundle(programBundle* progBundle, uint32 mask) {
+    o_assert_dbg(this->valid);
+    o_assert_dbg(nullptr != progBundle);
+
+    progBundle->selectProgram(mask);
+    const int32 progIndex = progBundle->getSelectionIndex();
+    if ((progBundle != this->boundProgramBundle) || (progIndex != this->boundProgramIndex)) {
+        this->boundProgramBundle = progBundle;
+        this->boundProgramIndex = progIndex;
+        this->curFrameStats.NumProgramChanges++;
+    }
+    else {
+        this->curFrameStats.NumRedundantStateChanges++;
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+nullRenderer::applyMesh(const mesh* msh) {
+    o_assert_dbg(this->valid);
+
+    if (nullptr == msh) {
+        this->invalidateMeshState();
+    }
+    else {
+        // same as the GL vertex-array-object slot: for instanced
+        // rendering, the slot is the active slot of the instance mesh
+        const uint8 slot = msh->instanceMesh ? msh->instanceMesh->activeVertexBufferSlot : msh->activeVertexBufferSlot;
+        if (msh->Setup.UseSharedStreamBuffers) {
+            o_assert2_dbg(msh->streamFrameIndex == this->frameIndex, "streamed mesh must be updated in each frame it is rendered!\n");
+        }
+        if ((msh != this->boundMesh) || (slot != this->boundMeshSlot) || (msh->streamVertexOffset != this->boundMeshOffset)) {
+            this->boundMesh = msh;
+            this->boundMeshSlot = slot;
+            this->boundMeshOffset = msh->streamVertexOffset;
+            this->curFrameStats.NumMeshChanges++;
+        }
+        else {
+            this->curFrameStats.NumRedundantStateChanges++;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+nullRenderer::applyDrawState(drawState* ds) {
+    o_assert_dbg(this->valid);
+    o_assert_dbg(nullptr != ds);
+
+    this->curFrameStats.NumApplyDrawState++;
+    this->curDrawState = ds;
+    this->curProgramBundle = ds->programBundle;
+    this->curMesh = ds->mesh;
+
+    const DrawStateSetup& setup = ds->Setup;
+    if (setup.DepthStencilState != this->depthStencilState) {
+        this->depthStencilState = setup.DepthStencilState;
+        this->curFrameStats.NumDepthStencilStateChanges++;
+    }
+    else {
+        this->curFrameStats.NumRedundantStateChanges++;
+    }
+    if (setup.BlendState != this->blendState) {
+        this->blendState = setup.BlendState;
+        this->curFrameStats.NumBlendStateChanges++;
+    }
+    else {
+        this->curFrameStats.NumRedundantStateChanges++;
+    }
+    if (setup.RasterizerState != this->rasterizerState) {
+        this->rasterizerState = setup.RasterizerState;
+        this->curFrameStats.NumRasterizerStateChanges++;
+    }
+    else {
+        this->curFrameStats.NumRedundantStateChanges++;
+    }
+    this->applyProgramBundle(ds->programBundle, setup.ProgramSelectionMask);
+    this->applyMesh(ds->mesh);
+}
+
+//------------------------------------------------------------------------------
+void
+nullRenderer::applyTexture(int32 index, const texture* tex) {
+    o_assert_dbg(this->valid);
+    o_assert_dbg(this->curProgramBundle);
+    o_assert_dbg(tex);
+
+    this->curFrameStats.NumApplyTexture++;
+    const int32 samplerIndex = this->curProgramBundle->getSamplerIndex(index);
+    o_assert_range_dbg(samplerIndex, MaxTextureSamplers);
+    if (tex != this->samplers[samplerIndex]) {
+        this->samplers[samplerIndex] = tex;
+        this->curFrameStats.NumTextureChanges++;
+    }
+    else {
+        this->curFrameStats.NumRedundantStateChanges++;
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+nullRenderer::applyUniformBlock(int32 slotIndex, const void* data, int32 numBytes) {
+    o_assert_dbg(this->valid);
+    o_assert_dbg(nullptr != this->curProgramBundle);
+    o_assert_dbg(this->curProgramBundle->getUniformBlockSize(slotIndex) == numBytes);
+
+    this->curFrameStats.NumApplyUniformBlock++;
+    const int32 progIndex = this->curProgramBundle->getSelectionIndex();
+    if (this->curProgramBundle->updateUniformBlock(progIndex, slotIndex, data, numBytes)) {
+        this->curFrameStats.NumUniformBlockUpdates++;
+        this->curFrameStats.UniformBytes += numBytes;
+    }
+    else {
+        this->curFrameStats.NumRedundantStateChanges++;
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+nullRenderer::clear(PixelChannel::Mask channels, const glm::vec4& color, float32 depth, uint8 stencil) {
+    o_assert_dbg(this->valid);
+    o_assert2_dbg(this->rtValid, "No render target set!");
+
+    this->curFrameStats.NumClears++;
+
+    // same write-mask side effects as the GL renderer
+    if ((channels & PixelChannel::RGBA) != 0) {
+        this->blendState.ColorWriteMask = channels & PixelChannel::RGBA;
+    }
+    if ((channels & PixelChannel::Depth) != 0) {
+        this->depthStencilState.DepthWriteEnabled = true;
+    }
+    if ((channels & PixelChannel::Stencil) != 0) {
+        this->depthStencilState.StencilFront.StencilWriteMask = 0xFF;
+        this->depthStencilState.StencilBack.StencilWriteMask = 0xFF;
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+nullRenderer::draw(const PrimitiveGroup& primGroup) {
+    o_assert_dbg(this->valid);
+    o_assert_dbg(nullptr != this->curMesh);
+    o_assert2_dbg(this->rtValid, "No render target set!");
+
+    this->curFrameStats.NumDraws++;
+    this->curFrameStats.NumElements += primGroup.NumElements;
+}
+
+//------------------------------------------------------------------------------
+void
+nullRenderer::draw(int32 primGroupIndex) {
+    o_assert_dbg(this->valid);
+    o_assert_dbg(nullptr != this->curMesh);
+    o_assert2_dbg(this->rtValid, "No render target set!");
+
+    if (primGroupIndex >= this->curMesh->numPrimGroups) {
+        // same as GL renderer, this isn't a serious error
+        return;
+    }
+    this->draw(this->curMesh->primGroups[primGroupIndex]);
+}
+
+//------------------------------------------------------------------------------
+void
+nullRenderer::drawInstanced(const PrimitiveGroup& primGroup, int32 numInstances) {
+    o_assert_dbg(this->valid);
+    o_assert_dbg(nullptr != this->curMesh);
+    o_assert2_dbg(this->rtValid, "No render target set!");
+
+    this->curFrameStats.NumDrawsInstanced++;
+    this->curFrameStats.NumInstances += numInstances;
+    this->curFrameStats.NumElements += primGroup.NumElements * numInstances;
+}
+
+//------------------------------------------------------------------------------
+void
+nullRenderer::drawInstanced(int32 primGroupIndex, int32 numInstances) {
+    o_assert_dbg(this->valid);
+    o_assert_dbg(nullptr != this->curMesh);
+    o_assert2_dbg(this->rtValid, "No render target set!");
+
+    if (primGroupIndex >= this->curMesh->numPrimGroups) {
+        // same as GL renderer, this isn't a serious error
+        return;
+    }
+    this->drawInstanced(this->curMesh->primGroups[primGroupIndex], numInstances);
+}
+
+//------------------------------------------------------------------------------
+int32
+nullRenderer::allocStreamRange(streamRingAllocator& ring, int32 numBytes, int32 alignment) {
+    o_assert2(ring.isValid(), "shared stream buffer not setup (see GfxSetup::StreamVertexBufferSize/StreamIndexBufferSize)!\n");
+    const int32 usedBefore = ring.numFrameBytes();
+    int32 offset = ring.alloc(numBytes, alignment);
+    while (InvalidIndex == offset) {
+        if (0 == ring.numPendingFrames()) {
+            o_error("nullRenderer: shared stream buffer too small for one frame!\n");
+        }
+        // this is where the GL renderer has to wait for a GPU fence
+        ring.retireFrame();
+        this->curFrameStats.NumStreamBufferWaits++;
+        offset = ring.alloc(numBytes, alignment);
+    }
+    this->curFrameStats.StreamBufferBytes += ring.numFrameBytes() - usedBefore;
+    return offset;
+}
+
+//------------------------------------------------------------------------------
+void
+nullRenderer::updateVertices(mesh* msh, int32 byteOffset, int32 numBytes, const void* data) {
+    o_assert_dbg(this->valid);
+    o_assert_dbg(nullptr != msh);
+    o_assert(numBytes > 0);
+    o_assert_dbg(nullptr != data);
+
+    const VertexBufferAttrs& attrs = msh->vertexBufferAttrs;
+    const Usage::Code vbUsage = attrs.BufferUsage;
+    o_assert_dbg((byteOffset >= 0) && ((byteOffset + numBytes) <= attrs.ByteSize()));
+    o_assert_dbg((vbUsage == Usage::Stream) || (vbUsage == Usage::Dynamic) || (vbUsage == Usage::Static));
+
+    if (msh->Setup.UseSharedStreamBuffers) {
+        o_assert2_dbg(0 == byteOffset, "streamed meshes can only be updated completely!\n");
+        msh->streamVertexOffset = this->allocStreamRange(this->streamVertices, numBytes, streamRingAllocator::DefaultAlignment);
+        msh->streamFrameIndex = this->frameIndex;
+    }
+    else if ((Usage::Stream == vbUsage) && (0 == byteOffset)) {
+        // rotate to next vertex buffer slot, like the GL renderer,
+        // partial updates write into the active slot
+        uint8 slotIndex = msh->activeVertexBufferSlot + 1;
+        if (slotIndex >= msh->numVertexBufferSlots) {
+            slotIndex = 0;
+        }
+        msh->activeVertexBufferSlot = slotIndex;
+    }
+    // updating a buffer 'binds' it and thus breaks the mesh binding
+    this->invalidateMeshState();
+    this->curFrameStats.NumUpdateVertices++;
+    this->curFrameStats.VertexUpdateBytes += numBytes;
+}
+
+//------------------------------------------------------------------------------
+void
+nullRenderer::updateIndices(mesh* msh, int32 byteOffset, int32 numBytes, const void* data) {
+    o_assert_dbg(this->valid);
+    o_assert_dbg(nullptr != msh);
+    o_assert(numBytes > 0);
+    o_assert_dbg(nullptr != data);
+
+    const IndexBufferAttrs& attrs = msh->indexBufferAttrs;
+    const Usage::Code ibUsage = attrs.BufferUsage;
+    o_assert_dbg(IndexType::None != attrs.Type);
+    o_assert_dbg((byteOffset >= 0) && ((byteOffset + numBytes) <= attrs.ByteSize()));
+    o_assert_dbg((ibUsage == Usage::Stream) || (ibUsage == Usage::Dynamic) || (ibUsage == Usage::Static));
+
+    if (msh->Setup.UseSharedStreamBuffers) {
+        o_assert2_dbg(0 == byteOffset, "streamed meshes can only be updated completely!\n");
+        msh->streamIndexOffset = this->allocStreamRange(this->streamIndices, numBytes, streamRingAllocator::DefaultAlignment);
+        msh->streamFrameIndex = this->frameIndex;
+    }
+    this->invalidateMeshState();
+    this->curFrameStats.NumUpdateIndices++;
+    this->curFrameStats.IndexUpdateBytes += numBytes;
+}
+
+//------------------------------------------------------------------------------
+void
+nullRenderer::readPixels(displayMgr* displayManager, void* buf, int32 bufNumBytes) {
+    o_assert_dbg(this->valid);
+    o_assert_dbg(displayManager);
+    o_assert_dbg((nullptr != buf) && (bufNumBytes > 0));
+
+    Memory::Clear(buf, bufNumBytes);
+}
+
+//------------------------------------------------------------------------------
+void
+nullRenderer::invalidateMeshState() {
+    o_assert_dbg(this->valid);
+    this->boundMesh = nullptr;
+    this->boundMeshSlot = 0;
+    this->boundMeshOffset = InvalidIndex;
+}
+
+//------------------------------------------------------------------------------
+void
+nullRenderer::invalidateProgramState() {
+    o_assert_dbg(this->valid);
+    this->boundProgramBundle = nullptr;
+    this->boundProgramIndex = InvalidIndex;
+}
+
+//------------------------------------------------------------------------------
+void
+nullRenderer::invalidateTextureState() {
+    o_assert_dbg(this->valid);
+    for (int32 i = 0; i < MaxTextureSamplers; i++) {
+        this->samplers[i] = nullptr;
+    }
+}
+
+} // namespace _priv
+} // namespace Oryol
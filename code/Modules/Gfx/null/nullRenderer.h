@@ -0,0 +1,221 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::_priv::nullRenderer
+    @ingroup _priv
+    @brief headless renderer without GPU
+
+    The null renderer implements the same interface and the same
+    state cache as the GL renderer but doesn't talk to a GPU. Instead
+    it records per-frame call, state-change and upload statistics,
+    which makes it useful for CPU-only benchmarks and headless tests
+    of the Gfx frontend, resource management and render loops.
+
+    The shared stream buffers only exist as ring allocators, the GPU
+    is emulated to release a frame's stream buffer ranges
+    NumEmulatedFramesInFlight frames after it has been committed.
+
+    Select the null backend with the cmake option ORYOL_GFX_NULL.
+*/
+#include "Core/Types.h"
+#include "Core/Assertion.h"
+#include "Gfx/Core/Enums.h"
+#include "Gfx/Core/BlendState.h"
+#include "Gfx/Core/DepthStencilState.h"
+#include "Gfx/Core/RasterizerState.h"
+#include "Gfx/Core/PrimitiveGroup.h"
+#include "Gfx/Core/GfxFrameStats.h"
+#include "Gfx/Core/uniformTypeOf.h"
+#include "Gfx/Core/streamRingAllocator.h"
+#include "Gfx/Setup/GfxSetup.h"
+#include "Gfx/Attrs/DisplayAttrs.h"
+#include "glm/vec4.hpp"
+
+namespace Oryol {
+namespace _priv {
+
+class displayMgr;
+class texture;
+class drawState;
+class mesh;
+class programBundle;
+
+class nullRenderer {
+public:
+    /// constructor
+    nullRenderer();
+    /// destructor
+    ~nullRenderer();
+
+    /// number of frames the emulated GPU lags behind
+    static const int32 NumEmulatedFramesInFlight = 2;
+
+    /// setup the renderer
+    void setup(const GfxSetup& setup);
+    /// discard the renderer
+    void discard();
+    /// return true if renderer has been setup
+    bool isValid() const;
+
+    /// reset the internal state cache
+    void resetStateCache();
+    /// test if a feature is supported
+    bool supports(GfxFeature::Code feat) const;
+    /// commit current frame
+    void commitFrame();
+    /// get the current render target attributes
+    const DisplayAttrs& renderTargetAttrs() const;
+    /// get the statistics of the last committed frame
+    const GfxFrameStats& frameStats() const;
+
+    /// apply a render target (default or offscreen)
+    void applyRenderTarget(displayMgr* displayManager, texture* rt);
+    /// apply viewport
+    void applyViewPort(int32 x, int32 y, int32 width, int32 height);
+    /// apply scissor rect
+    void applyScissorRect(int32 x, int32 y, int32 width, int32 height);
+    /// apply blend color
+    void applyBlendColor(const glm::vec4& color);
+    /// apply draw state
+    void applyDrawState(drawState* ds);
+    /// apply a texture sampler variable (special case)
+    void applyTexture(int32 index, const texture* tex);
+    /// apply a shader variable
+    template<class T> void applyVariable(int32 index, const T& value);
+    /// apply a shader variable array
+    template<class T> void applyVariableArray(int32 index, const T* values, int32 numValues);
+    /// apply a uniform block, only counts an upload if its content has changed
+    void applyUniformBlock(int32 slotIndex, const void* data, int32 numBytes);
+    /// clear currently assigned render target
+    void clear(PixelChannel::Mask channels, const glm::vec4& color, float32 depth, uint8 stencil);
+    /// submit a draw call with primitive group index in current mesh
+    void draw(int32 primGroupIndex);
+    /// submit a draw call with direct primitive group
+    void draw(const PrimitiveGroup& primGroup);
+    /// submit a draw call for instanced rendering with primitive group index in current mesh
+    void drawInstanced(int32 primGroupIndex, int32 numInstances);
+    /// submit a draw call for instanced rendering with direct primitive group
+    void drawInstanced(const PrimitiveGroup& primGroup, int32 numInstances);
+    /// update vertex data, complete or a byte range
+    void updateVertices(mesh* msh, int32 byteOffset, int32 numBytes, const void* data);
+    /// update index data, complete or a byte range
+    void updateIndices(mesh* msh, int32 byteOffset, int32 numBytes, const void* data);
+    /// read pixels back from framebuffer (fills the buffer with zeros)
+    void readPixels(displayMgr* displayManager, void* buf, int32 bufNumBytes);
+
+    /// invalidate bound mesh state
+    void invalidateMeshState();
+    /// invalidate program state
+    void invalidateProgramState();
+    /// invalidate texture state
+    void invalidateTextureState();
+    /// count resource data uploaded by the resource factories
+    void addUploadBytes(int32 numBytes);
+    /// count state changes skipped before reaching the renderer
+    void addElidedStateChanges(int32 num);
+    /// count draws merged into instanced draws before reaching the renderer
+    void addMergedDraws(int32 num);
+
+private:
+    /// apply program to use for rendering
+    void applyProgramBundle(programBundle* progBundle, uint32 progSelMask);
+    /// apply mesh to use for rendering
+    void applyMesh(const mesh* msh);
+    /// allocate a range in a shared stream buffer, retires pending frames if necessary
+    int32 allocStreamRange(streamRingAllocator& ring, int32 numBytes, int32 alignment);
+
+    bool valid;
+    bool rtValid;
+    DisplayAttrs rtAttrs;
+
+    // high-level state cache
+    texture* curRenderTarget;
+    drawState* curDrawState;
+    mesh* curMesh;
+    programBundle* curProgramBundle;
+
+    // emulated low-level state cache
+    BlendState blendState;
+    DepthStencilState depthStencilState;
+    RasterizerState rasterizerState;
+
+    int32 scissorX;
+    int32 scissorY;
+    int32 scissorWidth;
+    int32 scissorHeight;
+
+    glm::vec4 blendColor;
+
+    int32 viewPortX;
+    int32 viewPortY;
+    int32 viewPortWidth;
+    int32 viewPortHeight;
+
+    const mesh* boundMesh;
+    uint8 boundMeshSlot;
+    int32 boundMeshOffset;
+    const programBundle* boundProgramBundle;
+    int32 boundProgramIndex;
+
+    static const int32 MaxTextureSamplers = 16;
+    const texture* samplers[MaxTextureSamplers];
+
+    int32 frameIndex;
+    streamRingAllocator streamVertices;
+    streamRingAllocator streamIndices;
+
+    GfxFrameStats curFrameStats;
+    GfxFrameStats lastFrameStats;
+};
+
+//------------------------------------------------------------------------------
+inline const DisplayAttrs&
+nullRenderer::renderTargetAttrs() const {
+    return this->rtAttrs;
+}
+
+//------------------------------------------------------------------------------
+inline const GfxFrameStats&
+nullRenderer::frameStats() const {
+    return this->lastFrameStats;
+}
+
+//------------------------------------------------------------------------------
+inline void
+nullRenderer::addUploadBytes(int32 numBytes) {
+    this->curFrameStats.ResourceUploadBytes += numBytes;
+}
+
+//------------------------------------------------------------------------------
+inline void
+nullRenderer::addElidedStateChanges(int32 num) {
+    this->curFrameStats.NumElidedStateChanges += num;
+}
+
+//------------------------------------------------------------------------------
+inline void
+nullRenderer::addMergedDraws(int32 num) {
+    this->curFrameStats.NumMergedDraws += num;
+}
+
+//------------------------------------------------------------------------------
+template<class T> inline void
+nullRenderer::applyVariable(int32 index, const T& /*value*/) {
+    o_assert_dbg(this->valid);
+    o_assert_dbg(nullptr != this->curProgramBundle);
+    this->curFrameStats.NumApplyVariable++;
+    this->curFrameStats.UniformBytes += UniformType::ByteSize(uniformTypeOf<T>::Type);
+}
+
+//------------------------------------------------------------------------------
+template<class T> inline void
+nullRenderer::applyVariableArray(int32 index, const T* values, int32 numValues) {
+    o_assert_dbg(this->valid);
+    o_assert_dbg(nullptr != this->curProgramBundle);
+    o_assert_dbg(values && (numValues > 0));
+    this->curFrameStats.NumApplyVariable++;
+    this->curFrameStats.UniformBytes += numValues * UniformType::ByteSize(uniformTypeOf<T>::Type);
+}
+
+} // namespace _priv
+} // namespace Oryol
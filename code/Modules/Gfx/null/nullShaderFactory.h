@@ -0,0 +1,40 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::_priv::nullShaderFactory
+    @ingroup _priv
+    @brief null-backend implementation of shaderFactory
+*/
+#include "Resource/ResourceState.h"
+#include "Gfx/Core/Enums.h"
+
+namespace Oryol {
+namespace _priv {
+
+class shader;
+
+class nullShaderFactory {
+public:
+    /// constructor
+    nullShaderFactory();
+    /// destructor
+    ~nullShaderFactory();
+
+    /// setup the factory
+    void Setup();
+    /// discard the factory
+    void Discard();
+    /// return true if the object has been setup
+    bool IsValid() const;
+
+    /// setup shader resource (no compilation happens)
+    ResourceState::Code SetupResource(shader& shd);
+    /// destroy the shader
+    void DestroyResource(shader& shd);
+
+private:
+    bool isValid;
+};
+
+} // namespace _priv
+} // namespace Oryol
@@ -0,0 +1,185 @@
+//------------------------------------------------------------------------------
+//  nullTextureFactory.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "Core/Core.h"
+#include "nullTextureFactory.h"
+#include "Gfx/Core/renderer.h"
+#include "Gfx/Resource/texture.h"
+#include "Gfx/Resource/texturePool.h"
+#include "Gfx/Core/displayMgr.h"
+#include "Gfx/Attrs/DisplayAttrs.h"
+
+namespace Oryol {
+namespace _priv {
+
+//------------------------------------------------------------------------------
+nullTextureFactory::nullTextureFactory() :
+renderer(nullptr),
+displayManager(nullptr),
+texPool(nullptr),
+isValid(false) {
+    // empty
+}
+
+//------------------------------------------------------------------------------
+nullTextureFactory::~nullTextureFactory() {
+    o_assert_dbg(!this->isValid);
+}
+
+//------------------------------------------------------------------------------
+void
+nullTextureFactory::Setup(class renderer* rendr, displayMgr* displayMgr_, texturePool* texPool_) {
+    o_assert_dbg(!this->isValid);
+    o_assert_dbg(nullptr != rendr);
+    o_assert_dbg(nullptr != displayMgr_);
+    o_assert_dbg(nullptr != texPool_);
+
+    this->isValid = true;
+    this->renderer = rendr;
+    this->displayManager = displayMgr_;
+    this->texPool = texPool_;
+}
+
+//------------------------------------------------------------------------------
+void
+nullTextureFactory::Discard() {
+    o_assert_dbg(this->isValid);
+    this->isValid = false;
+    this->renderer = nullptr;
+    this->displayManager = nullptr;
+    this->texPool = nullptr;
+}
+
+//------------------------------------------------------------------------------
+bool
+nullTextureFactory::IsValid() const {
+    return this->isValid;
+}
+
+//------------------------------------------------------------------------------
+ResourceState::Code
+nullTextureFactory::SetupResource(texture& tex) {
+    o_assert_dbg(this->isValid);
+    o_assert_dbg(!tex.Setup.ShouldSetupFromPixelData());
+
+    if (tex.Setup.ShouldSetupAsRenderTarget()) {
+        return this->createRenderTarget(tex);
+    }
+    else {
+        o_error("nullTextureFactory::SetupResource(): don't know how to create texture!\n");
+        return ResourceState::InvalidState;
+    }
+}
+
+//------------------------------------------------------------------------------
+ResourceState::Code
+nullTextureFactory::SetupResource(texture& tex, const Ptr<Stream>& data) {
+    o_assert_dbg(this->isValid);
+    o_assert_dbg(!tex.Setup.ShouldSetupAsRenderTarget());
+    o_assert_dbg(!tex.Setup.ShouldSetupFromFile());
+
+    if (tex.Setup.ShouldSetupFromPixelData()) {
+        return this->createFromPixelData(tex, data);
+    }
+    else {
+        o_error("nullTextureFactory::SetupResource(): don't know how to create texture!\n");
+        return ResourceState::InvalidState;
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+nullTextureFactory::DestroyResource(texture& tex) {
+    o_assert_dbg(this->isValid);
+    this->renderer->invalidateTextureState();
+    tex.Clear();
+}
+
+//------------------------------------------------------------------------------
+ResourceState::Code
+nullTextureFactory::createRenderTarget(texture& tex) {
+    const TextureSetup& setup = tex.Setup;
+    o_assert_dbg(setup.ShouldSetupAsRenderTarget());
+
+    // get size of new render target
+    int32 width, height;
+    if (setup.IsRelSizeRenderTarget()) {
+        const DisplayAttrs& dispAttrs = this->displayManager->GetDisplayAttrs();
+        width = int32(dispAttrs.FramebufferWidth * setup.RelWidth);
+        height = int32(dispAttrs.FramebufferHeight * setup.RelHeight);
+    }
+    else if (setup.HasSharedDepth()) {
+        // a shared-depth-buffer render target, obtain width and height
+        // from the original render target
+        const texture* sharedDepthProvider = this->texPool->Lookup(setup.DepthRenderTarget);
+        o_assert_dbg(nullptr != sharedDepthProvider);
+        o_assert_dbg(sharedDepthProvider->textureAttrs.HasDepthBuffer);
+        width = sharedDepthProvider->textureAttrs.Width;
+        height = sharedDepthProvider->textureAttrs.Height;
+    }
+    else {
+        width = setup.Width;
+        height = setup.Height;
+    }
+    o_assert_dbg((width > 0) && (height > 0));
+    o_assert_dbg(!setup.HasDepth() || setup.HasSharedDepth() || (PixelFormat::InvalidPixelFormat != setup.DepthFormat));
+
+    TextureAttrs attrs;
+    attrs.Locator = setup.Locator;
+    attrs.Type = TextureType::Texture2D;
+    attrs.ColorFormat = setup.ColorFormat;
+    attrs.DepthFormat = setup.DepthFormat;
+    attrs.TextureUsage = Usage::Immutable;
+    attrs.Width = width;
+    attrs.Height = height;
+    attrs.NumMipMaps = 1;
+    attrs.IsRenderTarget = true;
+    attrs.HasDepthBuffer = setup.HasDepth();
+    attrs.HasSharedDepthBuffer = setup.HasSharedDepth();
+    attrs.IsDepthTexture = false;
+    tex.textureAttrs = attrs;
+
+    return ResourceState::Valid;
+}
+
+//------------------------------------------------------------------------------
+ResourceState::Code
+nullTextureFactory::createFromPixelData(texture& tex, const Ptr<Stream>& data) {
+    const TextureSetup& setup = tex.Setup;
+
+    // walk the image data like the GL factory, to catch broken offsets and sizes
+    data->Open(OpenMode::ReadOnly);
+    const uint8* endPtr = nullptr;
+    const uint8* srcPtr = data->MapRead(&endPtr);
+    o_assert_dbg(nullptr != srcPtr);
+    const int32 numFaces = setup.Type == TextureType::TextureCube ? 6 : 1;
+    const int32 numMipMaps = setup.NumMipMaps;
+    int32 uploadBytes = 0;
+    for (int32 faceIndex = 0; faceIndex < numFaces; faceIndex++) {
+        for (int32 mipIndex = 0; mipIndex < numMipMaps; mipIndex++) {
+            const int32 imgSize = setup.ImageSizes[faceIndex][mipIndex];
+            o_assert_dbg(imgSize > 0);
+            o_assert_dbg((srcPtr + setup.ImageOffsets[faceIndex][mipIndex] + imgSize) <= endPtr);
+            uploadBytes += imgSize;
+        }
+    }
+    data->UnmapRead();
+    data->Close();
+    this->renderer->addUploadBytes(uploadBytes);
+
+    TextureAttrs attrs;
+    attrs.Locator = setup.Locator;
+    attrs.Type = setup.Type;
+    attrs.ColorFormat = setup.ColorFormat;
+    attrs.TextureUsage = Usage::Immutable;
+    attrs.Width = setup.Width;
+    attrs.Height = setup.Height;
+    attrs.NumMipMaps = setup.NumMipMaps;
+    tex.textureAttrs = attrs;
+
+    return ResourceState::Valid;
+}
+
+} // namespace _priv
+} // namespace Oryol
@@ -0,0 +1,59 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::_priv::nullTextureFactory
+    @ingroup _priv
+    @brief null-backend implementation of textureFactory
+
+    Computes the texture attributes of render targets and textures
+    created from pixel data like the GL texture factory, walks the
+    pixel data of all faces and mipmaps, and reports the pixel data
+    size as upload bytes to the renderer.
+*/
+#include "Resource/ResourceState.h"
+#include "IO/Stream/Stream.h"
+#include "Gfx/Resource/texture.h"
+
+namespace Oryol {
+namespace _priv {
+
+class renderer;
+class texture;
+class displayMgr;
+class texturePool;
+
+class nullTextureFactory {
+public:
+    /// constructor
+    nullTextureFactory();
+    /// destructor
+    ~nullTextureFactory();
+
+    /// setup with a pointer to the state wrapper object
+    void Setup(class renderer* rendr, displayMgr* displayMgr, texturePool* texPool);
+    /// discard the factory
+    void Discard();
+    /// return true if the object has been setup
+    bool IsValid() const;
+
+    /// setup resource
+    ResourceState::Code SetupResource(texture& tex);
+    /// setup with input data
+    ResourceState::Code SetupResource(texture& tex, const Ptr<Stream>& data);
+    /// discard the resource
+    void DestroyResource(texture& tex);
+
+private:
+    /// create a render target
+    ResourceState::Code createRenderTarget(texture& tex);
+    /// create texture from raw pixel data
+    ResourceState::Code createFromPixelData(texture& tex, const Ptr<Stream>& data);
+
+    class renderer* renderer;
+    displayMgr* displayManager;
+    texturePool* texPool;
+    bool isValid;
+};
+
+} // namespace _priv
+} // namespace Oryol
@@ -0,0 +1,33 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::IOCacheStats
+    @ingroup IO
+    @brief IO cache counters
+    @see IO::GetCacheStats(), IOSetup
+*/
+#include "Core/Types.h"
+
+namespace Oryol {
+
+class IOCacheStats {
+public:
+    /// requests served from the in-memory cache
+    int32 Hits = 0;
+    /// requests served from the on-disk cache tier
+    int32 DiskHits = 0;
+    /// cache-read requests which had to go to a filesystem
+    int32 Misses = 0;
+    /// entries evicted from the in-memory cache
+    int32 Evictions = 0;
+    /// files removed from the on-disk cache tier
+    int32 DiskEvictions = 0;
+    /// number of entries in the in-memory cache
+    int32 NumEntries = 0;
+    /// number of bytes in the in-memory cache
+    int64 NumBytes = 0;
+    /// number of bytes written to the on-disk cache tier in this session
+    int64 NumDiskBytes = 0;
+};
+
+} // namespace Oryol
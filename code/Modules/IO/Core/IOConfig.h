@@ -11,3 +11,7 @@
 #define ORYOL_STREAM_DEFAULT_MIN_GROW (256)
 /// maximum grow size for streams (in bytes)
 #define ORYOL_STREAM_DEFAULT_MAX_GROW (1<<18)   // 256 kByte
+/// default size of the in-memory IO cache (in bytes, 0: the cache is opt-in)
+#define ORYOL_IO_DEFAULT_CACHE_MAX_BYTES (0)
+/// default size of the optional on-disk IO cache tier (in bytes)
+#define ORYOL_IO_DEFAULT_CACHE_DISK_MAX_BYTES (256<<20)  // 256 MByte
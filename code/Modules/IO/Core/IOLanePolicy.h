@@ -0,0 +1,25 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::IOLanePolicy
+    @ingroup IO
+    @brief how IO requests are assigned to IO lanes
+    @see IOSetup::LanePolicy
+*/
+#include "Core/Types.h"
+
+namespace Oryol {
+
+class IOLanePolicy {
+public:
+    /// lane policy enum
+    enum Code {
+        Fixed,          ///< use the lane index from the request (modulo number of lanes)
+        LeastLoaded,    ///< use the lane with the fewest outstanding requests
+
+        NumLanePolicies,
+        InvalidLanePolicy,
+    };
+};
+
+} // namespace Oryol
@@ -0,0 +1,31 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::IOLaneStats
+    @ingroup IO
+    @brief per-IO-lane queue depth and latency counters
+
+    Latency is measured on the main thread from the time a request
+    is handed to the lane until it is seen as handled, so it includes
+    the time the request waited behind other requests in the lane.
+
+    @see IO::GetLaneStats()
+*/
+#include "Core/Types.h"
+#include "Time/Duration.h"
+
+namespace Oryol {
+
+class IOLaneStats {
+public:
+    /// number of requests handed to the lane which are not handled yet
+    int32 QueueDepth = 0;
+    /// number of requests the lane has completed
+    int32 NumCompleted = 0;
+    /// average latency of completed requests
+    Duration AvgLatency;
+    /// max latency of completed requests
+    Duration MaxLatency;
+};
+
+} // namespace Oryol
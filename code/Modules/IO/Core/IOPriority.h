@@ -0,0 +1,29 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::IOPriority
+    @ingroup IO
+    @brief IO request priority classes
+
+    Pending IO requests are handed to the IO lanes in priority order,
+    so that urgent loads don't have to wait behind background prefetching.
+    @see IOSetup::MaxLaneDepth
+*/
+#include "Core/Types.h"
+
+namespace Oryol {
+
+class IOPriority {
+public:
+    /// priority enum
+    enum Code {
+        High = 0,       ///< urgent loads, dispatched before everything else
+        Normal,         ///< the default priority
+        Low,            ///< background loads, e.g. prefetching
+
+        NumPriorities,
+        InvalidPriority,
+    };
+};
+
+} // namespace Oryol
@@ -9,6 +9,8 @@
 #include "Core/Containers/Map.h"
 #include "Core/Containers/KeyValuePair.h"
 #include "IO/FS/FileSystem.h"
+#include "IO/Core/IOConfig.h"
+#include "IO/Core/IOLanePolicy.h"
 #include <functional>
 
 namespace Oryol {
@@ -21,6 +23,18 @@ public:
     Map<StringAtom, std::function<Ptr<FileSystem>()>> FileSystems;
     /// number of IOLanes
     int32 NumIOLanes = 4;
+    /// how requests are assigned to IO lanes
+    IOLanePolicy::Code LanePolicy = IOLanePolicy::Fixed;
+    /// max number of outstanding requests per IO lane (0 is unlimited), excess requests wait in priority order
+    int32 MaxLaneDepth = 0;
+    /// optional per-scheme lane masks (bit N set: scheme may use lane N), schemes without mask may use all lanes
+    Map<StringAtom, uint32> LaneAffinity;
+    /// max size of the in-memory IO cache in bytes (default 0 disables the cache, cached Streams are shared between requests)
+    int32 CacheMaxBytes = ORYOL_IO_DEFAULT_CACHE_MAX_BYTES;
+    /// optional native directory path for the on-disk cache tier (empty disables the disk tier)
+    String CacheDiskDirectory;
+    /// max number of bytes written to the on-disk cache tier
+    int64 CacheDiskMaxBytes = ORYOL_IO_DEFAULT_CACHE_DISK_MAX_BYTES;
 };
     
 } // namespace Oryol
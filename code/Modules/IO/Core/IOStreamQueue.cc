@@ -0,0 +1,167 @@
+//------------------------------------------------------------------------------
+//  IOStreamQueue.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "IOStreamQueue.h"
+#include "Core/Core.h"
+#include "Core/RunLoop.h"
+#include "IO/IO.h"
+#include "IO/Stream/MemoryStream.h"
+
+namespace Oryol {
+
+//------------------------------------------------------------------------------
+IOStreamQueue::IOStreamQueue() :
+isStarted(false),
+runLoopId(RunLoop::InvalidId),
+maxChunksInFlight(DefaultMaxChunksInFlight) {
+    // empty
+}
+
+//------------------------------------------------------------------------------
+IOStreamQueue::~IOStreamQueue() {
+    o_assert_dbg(!this->isStarted);
+}
+
+//------------------------------------------------------------------------------
+void
+IOStreamQueue::SetMaxChunksInFlight(int32 num) {
+    o_assert(num > 0);
+    this->maxChunksInFlight = num;
+}
+
+//------------------------------------------------------------------------------
+int32
+IOStreamQueue::GetMaxChunksInFlight() const {
+    return this->maxChunksInFlight;
+}
+
+//------------------------------------------------------------------------------
+void
+IOStreamQueue::Start() {
+    o_assert_dbg(!this->isStarted);
+    this->isStarted = true;
+    this->runLoopId = Core::PreRunLoop()->Add([this]() { this->update(); });
+}
+
+//------------------------------------------------------------------------------
+void
+IOStreamQueue::Stop() {
+    o_assert(this->isStarted);
+    this->isStarted = false;
+    Core::PreRunLoop()->Remove(this->runLoopId);
+    for (int32 i = 0; i < this->items.Size(); i++) {
+        this->cancelChunks(i);
+    }
+    this->items.Clear();
+}
+
+//------------------------------------------------------------------------------
+bool
+IOStreamQueue::IsStarted() const {
+    return this->isStarted;
+}
+
+//------------------------------------------------------------------------------
+bool
+IOStreamQueue::Empty() const {
+    return this->items.Empty();
+}
+
+//------------------------------------------------------------------------------
+void
+IOStreamQueue::Add(const URL& url, int32 chunkSize, ChunkFunc onChunk, FailFunc onFail) {
+    // a chunk size of 1 would result in an EndOffset of 0 (== end of file)
+    o_assert(chunkSize > 1);
+    o_assert(onChunk);
+
+    item newItem;
+    newItem.url = url;
+    newItem.chunkSize = chunkSize;
+    newItem.chunkFunc = onChunk;
+    newItem.failFunc = onFail;
+    this->items.Add(std::move(newItem));
+    this->issueChunks(this->items.Size() - 1);
+}
+
+//------------------------------------------------------------------------------
+void
+IOStreamQueue::issueChunks(int32 itemIndex) {
+    item& cur = this->items[itemIndex];
+    while (!cur.endReached && (cur.chunks.Size() < this->maxChunksInFlight)) {
+        Ptr<IOProtocol::Request> ioReq = IOProtocol::Request::Create();
+        ioReq->SetURL(cur.url);
+        ioReq->SetStartOffset(cur.nextOffset);
+        ioReq->SetEndOffset(cur.nextOffset + cur.chunkSize - 1);
+        ioReq->SetCacheReadEnabled(false);
+        ioReq->SetCacheWriteEnabled(false);
+        IO::Put(ioReq);
+        cur.chunks.Enqueue(ioReq);
+
+        // don't run past the 2 GByte limit of the request offsets
+        if (cur.nextOffset > (0x7FFFFFFF - cur.chunkSize)) {
+            cur.endReached = true;
+        }
+        else {
+            cur.nextOffset += cur.chunkSize;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+IOStreamQueue::cancelChunks(int32 itemIndex) {
+    item& cur = this->items[itemIndex];
+    while (!cur.chunks.Empty()) {
+        cur.chunks.Dequeue()->SetCancelled();
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+    This is called per frame from the thread-local run-loop. Chunks are
+    delivered strictly in file order, a chunk which arrives early
+    waits until the chunks in front of it have been delivered.
+*/
+void
+IOStreamQueue::update() {
+    for (int32 i = this->items.Size() - 1; i >= 0; --i) {
+        bool finished = false;
+        while (!finished && !this->items[i].chunks.Empty() && this->items[i].chunks.Front()->Handled()) {
+            item& cur = this->items[i];
+            Ptr<IOProtocol::Request> req = cur.chunks.Dequeue();
+            const IOStatus::Code status = req->GetStatus();
+            if ((IOStatus::OK == status) || (IOStatus::PartialContent == status)) {
+                // HTTP servers answer range requests with PartialContent,
+                // a short chunk is the last one, a too big chunk means
+                // that the filesystem has ignored the byte range
+                const Ptr<Stream>& stream = req->GetStream();
+                finished = stream->Size() != cur.chunkSize;
+                cur.chunkFunc(stream, req->GetStartOffset(), finished);
+            }
+            else if ((IOStatus::RequestedRangeNotSatisfiable == status) && (req->GetStartOffset() > 0)) {
+                // the previous chunk ended exactly at the end of the file
+                finished = true;
+                cur.chunkFunc(MemoryStream::Create(), req->GetStartOffset(), true);
+            }
+            else {
+                finished = true;
+                if (cur.failFunc) {
+                    cur.failFunc(cur.url, status);
+                }
+                else {
+                    o_error("IOStreamQueue::update(): failed to load file '%s'\n", cur.url.AsCStr());
+                }
+            }
+        }
+        if (finished) {
+            this->cancelChunks(i);
+            this->items.Erase(i);
+        }
+        else {
+            this->issueChunks(i);
+        }
+    }
+}
+
+} // namespace Oryol
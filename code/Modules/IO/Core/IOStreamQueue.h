@@ -0,0 +1,99 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::IOStreamQueue
+    @ingroup IO
+    @brief load big files in fixed-size chunks
+
+    An IOStreamQueue works like an IOQueue, but instead of waiting until
+    a whole file has been loaded into a single Stream, the file is
+    loaded in fixed-size chunks which are handed to a callback
+    in file order as soon as they arrive. This way a consumer (e.g. a
+    texture or audio decoder) can start working on the first bytes
+    while the rest of the file is still loading, and only a small
+    window of chunks is held in memory at any time.
+
+    Chunks are loaded through IOProtocol::Request messages with
+    StartOffset/EndOffset set, so this works for every FileSystem
+    which supports byte ranges (LocalFileSystem, AsyncFileSystem
+    and HTTPFileSystem). A FileSystem which ignores byte ranges will
+    return the whole file in the first chunk, which is then delivered as
+    the only (and last) chunk. The chunk callback is called with
+    isLast == true exactly once per file, the last chunk may be
+    empty if the file size is a multiple of the chunk size.
+
+    Chunk streams are released after the callback returns, chunk
+    requests bypass the IO cache.
+
+    @code
+    IOStreamQueue streamQueue;
+    streamQueue.Start();
+    streamQueue.Add("res:big.pak", 1<<20, [](const Ptr<Stream>& chunk, int32 offset, bool isLast) {
+        // feed chunk to decoder...
+    });
+    @endcode
+*/
+#include "Core/Types.h"
+#include "Core/Containers/Array.h"
+#include "Core/Containers/Queue.h"
+#include "IO/IOProtocol.h"
+#include <functional>
+
+namespace Oryol {
+
+class IOStreamQueue {
+public:
+    /// constructor
+    IOStreamQueue();
+    /// destructor
+    ~IOStreamQueue();
+
+    /// callback function signature for a received chunk
+    typedef std::function<void(const Ptr<Stream>& chunk, int32 offset, bool isLast)> ChunkFunc;
+    /// callback function signature for failure
+    typedef std::function<void(const URL& url, IOStatus::Code ioStatus)> FailFunc;
+
+    /// default max number of chunk requests in flight per file
+    static const int32 DefaultMaxChunksInFlight = 4;
+
+    /// set max number of chunk requests in flight per file
+    void SetMaxChunksInFlight(int32 num);
+    /// get max number of chunk requests in flight per file
+    int32 GetMaxChunksInFlight() const;
+
+    /// start queue processing
+    void Start();
+    /// stop queue processing, cancels all loads in progress
+    void Stop();
+    /// return true if queue is in started state
+    bool IsStarted() const;
+
+    /// add a file to be loaded in chunks of chunkSize bytes
+    void Add(const URL& url, int32 chunkSize, ChunkFunc onChunk, FailFunc onFail=FailFunc());
+    /// return true if queue is empty
+    bool Empty() const;
+
+private:
+    /// update the queue, called per frame from runloop
+    void update();
+    /// issue chunk requests until max number of chunks are in flight
+    void issueChunks(int32 itemIndex);
+    /// cancel outstanding chunk requests of an item
+    void cancelChunks(int32 itemIndex);
+
+    bool isStarted;
+    int32 runLoopId;
+    int32 maxChunksInFlight;
+    struct item {
+        URL url;
+        int32 chunkSize = 0;
+        int32 nextOffset = 0;           // offset of next chunk to request
+        bool endReached = false;        // true when the last chunk has been requested
+        Queue<Ptr<IOProtocol::Request>> chunks;    // chunk requests in file order
+        ChunkFunc chunkFunc;
+        FailFunc failFunc;
+    };
+    Array<item> items;
+};
+
+} // namespace Oryol
@@ -0,0 +1,39 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::_priv::byteRange
+    @ingroup _priv
+    @brief resolve a Request's StartOffset/EndOffset against a file size
+
+    Follows the HTTP Range header convention which HTTPFileSystem
+    uses for the same Request attributes: EndOffset is the inclusive
+    last byte, an EndOffset of 0 means 'until end of file', and
+    an EndOffset past the end of the file is clamped.
+*/
+#include "Core/Types.h"
+
+namespace Oryol {
+namespace _priv {
+
+class byteRange {
+public:
+    /// compute start and size of range, return false if the range can't be satisfied
+    static bool Resolve(int64 fileSize, int32 startOffset, int32 endOffset, int64& outStart, int64& outNumBytes) {
+        if (startOffset > fileSize) {
+            return false;
+        }
+        int64 end = fileSize;
+        if ((0 != endOffset) && ((int64(endOffset) + 1) < fileSize)) {
+            end = int64(endOffset) + 1;
+        }
+        if (end < startOffset) {
+            return false;
+        }
+        outStart = startOffset;
+        outNumBytes = end - startOffset;
+        return true;
+    };
+};
+
+} // namespace _priv
+} // namespace Oryol
@@ -0,0 +1,248 @@
+//------------------------------------------------------------------------------
+//  AsyncFileSystem.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "AsyncFileSystem.h"
+#include "IO/FS/LocalFileSystem.h"
+#include "IO/Core/byteRange.h"
+#include "Core/Log.h"
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <thread>
+
+namespace Oryol {
+
+OryolClassImpl(AsyncFileSystem);
+
+//------------------------------------------------------------------------------
+AsyncFileSystem::AsyncFileSystem() :
+backend(Backend::Auto),
+numPending(0) {
+    this->setupBackend(Backend::Auto);
+}
+
+//------------------------------------------------------------------------------
+AsyncFileSystem::AsyncFileSystem(Backend::Code backend_) :
+backend(backend_),
+numPending(0) {
+    this->setupBackend(backend_);
+}
+
+//------------------------------------------------------------------------------
+AsyncFileSystem::~AsyncFileSystem() {
+    // read buffers are owned by the pending requests, must wait
+    // until all reads have finished
+    while (this->numPending > 0) {
+        this->DoWork();
+        if (this->numPending > 0) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+AsyncFileSystem::setupBackend(Backend::Code requested) {
+    #if ORYOL_LINUX
+    if ((Backend::ThreadPool != requested) && this->uring.Setup(QueueDepth)) {
+        this->backend = Backend::IoUring;
+        return;
+    }
+    if (Backend::IoUring == requested) {
+        o_warn("AsyncFileSystem: io_uring not available, falling back to thread pool\n");
+    }
+    #endif
+    this->threadPool.Setup(NumThreads);
+    this->backend = Backend::ThreadPool;
+}
+
+//------------------------------------------------------------------------------
+AsyncFileSystem::Backend::Code
+AsyncFileSystem::GetBackend() const {
+    return this->backend;
+}
+
+//------------------------------------------------------------------------------
+int32
+AsyncFileSystem::NumPending() const {
+    return this->numPending;
+}
+
+//------------------------------------------------------------------------------
+void
+AsyncFileSystem::onRequest(const Ptr<IOProtocol::Request>& msg) {
+    const URL& url = msg->GetURL();
+    if (!url.HasPath()) {
+        msg->SetStatus(IOStatus::BadRequest);
+        msg->SetErrorDesc("AsyncFileSystem: URL has no path");
+        msg->SetHandled();
+        return;
+    }
+
+    // opening the file and querying the size is cheap compared to reading
+    const String path = LocalFileSystem::NativePath(url);
+    const int fd = open(path.AsCStr(), O_RDONLY|O_CLOEXEC);
+    if (-1 == fd) {
+        const IOStatus::Code status = (EACCES == errno) ? IOStatus::Forbidden : IOStatus::NotFound;
+        msg->SetStatus(status);
+        msg->SetErrorDesc(IOStatus::ToString(status));
+        msg->SetHandled();
+        return;
+    }
+    struct stat st;
+    int64 start = 0;
+    int64 numBytes = 0;
+    IOStatus::Code status = IOStatus::OK;
+    if (0 != fstat(fd, &st)) {
+        status = IOStatus::InternalServerError;
+    }
+    else if (!_priv::byteRange::Resolve(st.st_size, msg->GetStartOffset(), msg->GetEndOffset(), start, numBytes)) {
+        status = IOStatus::RequestedRangeNotSatisfiable;
+    }
+    else if (numBytes > 0x7FFFFFFF) {
+        status = IOStatus::RequestEntityTooLarge;
+    }
+    if ((IOStatus::OK != status) || (0 == numBytes)) {
+        close(fd);
+        if (IOStatus::OK == status) {
+            Ptr<MemoryStream> stream = MemoryStream::Create();
+            stream->SetURL(url);
+            msg->SetStream(stream);
+        }
+        else {
+            msg->SetErrorDesc(IOStatus::ToString(status));
+        }
+        msg->SetStatus(status);
+        msg->SetHandled();
+        return;
+    }
+
+    // get a slot for the pending request
+    int32 slotIndex;
+    if (this->freeSlots.Empty()) {
+        slotIndex = this->slots.Size();
+        this->slots.Add(pendingRead());
+    }
+    else {
+        slotIndex = this->freeSlots.Back();
+        this->freeSlots.Erase(this->freeSlots.Size() - 1);
+    }
+    pendingRead& pending = this->slots[slotIndex];
+    pending.req = msg;
+    pending.stream = MemoryStream::Create(int32(numBytes));
+    pending.stream->SetURL(url);
+    pending.stream->Open(OpenMode::WriteOnly);
+    pending.dst = pending.stream->MapWrite(int32(numBytes));
+    pending.fd = fd;
+    pending.offset = start;
+    pending.numBytes = int32(numBytes);
+    pending.bytesRead = 0;
+    this->numPending++;
+    this->submit(slotIndex);
+}
+
+//------------------------------------------------------------------------------
+void
+AsyncFileSystem::submit(int32 slotIndex) {
+    const pendingRead& pending = this->slots[slotIndex];
+    _priv::ioReadOp op;
+    op.id = slotIndex;
+    op.fd = pending.fd;
+    op.dst = pending.dst + pending.bytesRead;
+    op.offset = pending.offset + pending.bytesRead;
+    op.numBytes = pending.numBytes - pending.bytesRead;
+    #if ORYOL_LINUX
+    if (Backend::IoUring == this->backend) {
+        this->uring.Submit(op);
+        return;
+    }
+    #endif
+    this->threadPool.Submit(op);
+}
+
+//------------------------------------------------------------------------------
+void
+AsyncFileSystem::finish(int32 slotIndex, IOStatus::Code status) {
+    pendingRead& pending = this->slots[slotIndex];
+    close(pending.fd);
+    pending.stream->UnmapWrite();
+    pending.stream->Close();
+    if (pending.req->Cancelled()) {
+        status = IOStatus::Cancelled;
+    }
+    if (IOStatus::OK == status) {
+        pending.req->SetStream(pending.stream);
+    }
+    else {
+        pending.req->SetErrorDesc(IOStatus::ToString(status));
+    }
+    pending.req->SetStatus(status);
+    pending.req->SetHandled();
+    this->slots[slotIndex] = pendingRead();
+    this->freeSlots.Add(slotIndex);
+    this->numPending--;
+}
+
+//------------------------------------------------------------------------------
+void
+AsyncFileSystem::onReadComplete(const _priv::ioReadOp& op) {
+    pendingRead& pending = this->slots[op.id];
+    if (op.result > 0) {
+        pending.bytesRead += op.result;
+        if (pending.bytesRead < pending.numBytes) {
+            // short read, read the rest
+            this->submit(op.id);
+        }
+        else {
+            this->finish(op.id, IOStatus::OK);
+        }
+    }
+    else if ((-EINTR == op.result) || (-EAGAIN == op.result)) {
+        this->submit(op.id);
+    }
+    else {
+        // error, or file was truncated while reading
+        o_warn("AsyncFileSystem: failed to read '%s' (%d)\n", pending.req->GetURL().AsCStr(), op.result);
+        this->finish(op.id, IOStatus::InternalServerError);
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+AsyncFileSystem::DoWork() {
+    const int32 maxOps = 64;
+    _priv::ioReadOp ops[maxOps];
+    int32 numOps = 0;
+    do {
+        #if ORYOL_LINUX
+        if (Backend::IoUring == this->backend) {
+            this->uring.Flush();
+            numOps = this->uring.Reap(ops, maxOps);
+        }
+        else
+        #endif
+        {
+            this->threadPool.Flush();
+            numOps = this->threadPool.Reap(ops, maxOps);
+        }
+        for (int32 i = 0; i < numOps; i++) {
+            this->onReadComplete(ops[i]);
+        }
+    }
+    while (numOps == maxOps);
+
+    // submit reads for short-read remainders
+    #if ORYOL_LINUX
+    if (Backend::IoUring == this->backend) {
+        this->uring.Flush();
+    }
+    else
+    #endif
+    {
+        this->threadPool.Flush();
+    }
+}
+
+} // namespace Oryol
@@ -0,0 +1,111 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::AsyncFileSystem
+    @ingroup IO
+    @brief filesystem for local file:// URLs with many reads in flight
+    @see FileSystem, LocalFileSystem
+
+    The AsyncFileSystem doesn't block its IO lane while a file is read.
+    Incoming IOProtocol::Request messages are turned into asynchronous
+    reads into a MemoryStream, all reads received during one lane
+    wake-up are submitted in one batch, and requests are
+    completed (and SetHandled() is called) in the order the reads
+    finish. This way a single IO lane can keep dozens of reads in flight.
+
+    Two backends are available:
+
+    - Backend::IoUring: a Linux io_uring (kernel 5.6 or newer)
+    - Backend::ThreadPool: blocking pread() calls on a small
+      thread pool, this works on all POSIX platforms
+
+    Backend::Auto uses io_uring if available and falls back to the
+    thread pool. Each IO lane creates its own AsyncFileSystem, so
+    to select a specific backend register a creator lambda:
+
+    @code
+    ioSetup.FileSystems.Add("file", [] {
+        return AsyncFileSystem::Create(AsyncFileSystem::Backend::ThreadPool);
+    });
+    @endcode
+
+    Completed reads are picked up in DoWork(), which the IO lane calls
+    each time it wakes up (at least once per frame), StartOffset
+    and EndOffset work like in LocalFileSystem.
+*/
+#include "IO/FS/FileSystem.h"
+#include "IO/Stream/MemoryStream.h"
+#include "IO/posix/preadThreadPool.h"
+#if ORYOL_LINUX
+#include "IO/linux/ioUring.h"
+#endif
+#include "Core/Creator.h"
+
+namespace Oryol {
+
+class AsyncFileSystem : public FileSystem {
+    OryolClassDecl(AsyncFileSystem);
+    OryolClassCreator(AsyncFileSystem);
+public:
+    /// read backends
+    class Backend {
+    public:
+        /// backend enum
+        enum Code {
+            Auto,           ///< io_uring if available, otherwise ThreadPool
+            IoUring,        ///< Linux io_uring (falls back to ThreadPool if not supported)
+            ThreadPool,     ///< pread() on worker threads
+        };
+    };
+    /// max number of reads in flight in the io_uring
+    static const int32 QueueDepth = 128;
+    /// number of worker threads of the ThreadPool backend
+    static const int32 NumThreads = 4;
+
+    /// default constructor (Backend::Auto)
+    AsyncFileSystem();
+    /// construct with backend
+    AsyncFileSystem(Backend::Code backend);
+    /// destructor
+    virtual ~AsyncFileSystem();
+
+    /// get the backend which is actually used
+    Backend::Code GetBackend() const;
+    /// get number of requests which are currently being read
+    int32 NumPending() const;
+
+    /// per-frame update, submits new reads and completes finished requests
+    virtual void DoWork() override;
+    /// called when the IOProtocol::Request message is received
+    virtual void onRequest(const Ptr<IOProtocol::Request>& msg) override;
+
+private:
+    /// setup the read backend
+    void setupBackend(Backend::Code backend);
+    /// submit a read for the remaining bytes of a pending request
+    void submit(int32 slotIndex);
+    /// finish a pending request
+    void finish(int32 slotIndex, IOStatus::Code status);
+    /// handle a completed read
+    void onReadComplete(const _priv::ioReadOp& op);
+
+    struct pendingRead {
+        Ptr<IOProtocol::Request> req;
+        Ptr<MemoryStream> stream;
+        uint8* dst = nullptr;
+        int32 fd = -1;
+        int64 offset = 0;
+        int32 numBytes = 0;
+        int32 bytesRead = 0;
+    };
+    Backend::Code backend;
+    Array<pendingRead> slots;
+    Array<int32> freeSlots;
+    int32 numPending;
+    _priv::preadThreadPool threadPool;
+    #if ORYOL_LINUX
+    _priv::ioUring uring;
+    #endif
+};
+
+} // namespace Oryol
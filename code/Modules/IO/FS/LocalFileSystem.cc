@@ -0,0 +1,63 @@
+//------------------------------------------------------------------------------
+//  LocalFileSystem.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "LocalFileSystem.h"
+#include "IO/Stream/MappedStream.h"
+#include "Core/String/StringBuilder.h"
+#include "Core/Log.h"
+
+namespace Oryol {
+
+OryolClassImpl(LocalFileSystem);
+
+//------------------------------------------------------------------------------
+LocalFileSystem::LocalFileSystem() {
+    // empty
+}
+
+//------------------------------------------------------------------------------
+LocalFileSystem::~LocalFileSystem() {
+    // empty
+}
+
+//------------------------------------------------------------------------------
+String
+LocalFileSystem::NativePath(const URL& url) {
+    #if ORYOL_WINDOWS
+    return url.Path();
+    #else
+    // the URL path doesn't contain the leading slash
+    StringBuilder builder;
+    builder.Append('/');
+    builder.Append(url.Path());
+    return builder.GetString();
+    #endif
+}
+
+//------------------------------------------------------------------------------
+void
+LocalFileSystem::onRequest(const Ptr<IOProtocol::Request>& msg) {
+    const URL& url = msg->GetURL();
+    if (!url.HasPath()) {
+        msg->SetStatus(IOStatus::BadRequest);
+        msg->SetErrorDesc("LocalFileSystem: URL has no path");
+        msg->SetHandled();
+        return;
+    }
+
+    Ptr<MappedStream> stream = MappedStream::Create();
+    stream->SetURL(url);
+    const IOStatus::Code status = stream->MapFile(NativePath(url), msg->GetStartOffset(), msg->GetEndOffset());
+    if (IOStatus::OK == status) {
+        msg->SetStream(stream);
+    }
+    else {
+        o_warn("LocalFileSystem: failed to map '%s' (%s)\n", url.AsCStr(), IOStatus::ToString(status));
+        msg->SetErrorDesc(IOStatus::ToString(status));
+    }
+    msg->SetStatus(status);
+    msg->SetHandled();
+}
+
+} // namespace Oryol
@@ -0,0 +1,47 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::LocalFileSystem
+    @ingroup IO
+    @brief zero-copy filesystem for local file:// URLs
+    @see FileSystem, MappedStream
+
+    The LocalFileSystem serves IOProtocol::Request messages for local
+    files by memory-mapping the requested byte range
+    (StartOffset/EndOffset) into a read-only MappedStream, the
+    file content is never copied into a heap buffer.
+
+    The host part of a file URL is ignored, file:///home/bla.txt
+    and file://localhost/home/bla.txt both refer to /home/bla.txt.
+    On Windows the path must start with a drive letter
+    (file:///C:/bla.txt).
+
+    Register the LocalFileSystem for the 'file' scheme:
+    
+    @code
+    IOSetup ioSetup;
+    ioSetup.FileSystems.Add("file", LocalFileSystem::Creator());
+    @endcode
+*/
+#include "IO/FS/FileSystem.h"
+#include "Core/Creator.h"
+
+namespace Oryol {
+
+class LocalFileSystem : public FileSystem {
+    OryolClassDecl(LocalFileSystem);
+    OryolClassCreator(LocalFileSystem);
+public:
+    /// default constructor
+    LocalFileSystem();
+    /// destructor
+    virtual ~LocalFileSystem();
+
+    /// called when the IOProtocol::Request message is received
+    virtual void onRequest(const Ptr<IOProtocol::Request>& msg) override;
+
+    /// convert a file URL into a native filesystem path
+    static String NativePath(const URL& url);
+};
+
+} // namespace Oryol
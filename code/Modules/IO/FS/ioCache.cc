@@ -0,0 +1,324 @@
+//------------------------------------------------------------------------------
+//  ioCache.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "ioCache.h"
+#include "IO/Stream/MappedStream.h"
+#include "Core/String/StringBuilder.h"
+#include "Core/Log.h"
+#include <cstdio>
+
+namespace Oryol {
+namespace _priv {
+
+/// disk tier files start with a magic number and the key string
+static const uint32 DiskFileMagic = 0x4359524F;   // 'ORYC'
+
+//------------------------------------------------------------------------------
+ioCache::ioCache() :
+valid(false),
+maxBytes(0),
+diskMaxBytes(0),
+lruFront(InvalidIndex),
+lruBack(InvalidIndex) {
+    // empty
+}
+
+//------------------------------------------------------------------------------
+ioCache::~ioCache() {
+    if (this->valid) {
+        this->Discard();
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+ioCache::Setup(int32 maxBytes_, const String& diskDir_, int64 diskMaxBytes_) {
+    o_assert(!this->valid);
+    o_assert(maxBytes_ > 0);
+    this->valid = true;
+    this->maxBytes = maxBytes_;
+    this->diskDir = diskDir_;
+    this->diskMaxBytes = diskMaxBytes_;
+    this->stats = IOCacheStats();
+}
+
+//------------------------------------------------------------------------------
+void
+ioCache::Discard() {
+    o_assert(this->valid);
+    this->Clear();
+    this->entries.Clear();
+    this->freeEntries.Clear();
+    this->diskFiles.Clear();
+    this->valid = false;
+}
+
+//------------------------------------------------------------------------------
+bool
+ioCache::IsValid() const {
+    return this->valid;
+}
+
+//------------------------------------------------------------------------------
+const IOCacheStats&
+ioCache::GetStats() const {
+    return this->stats;
+}
+
+//------------------------------------------------------------------------------
+void
+ioCache::unlink(int32 entryIndex) {
+    entry& e = this->entries[entryIndex];
+    if (InvalidIndex != e.prev) {
+        this->entries[e.prev].next = e.next;
+    }
+    else {
+        this->lruFront = e.next;
+    }
+    if (InvalidIndex != e.next) {
+        this->entries[e.next].prev = e.prev;
+    }
+    else {
+        this->lruBack = e.prev;
+    }
+    e.prev = InvalidIndex;
+    e.next = InvalidIndex;
+}
+
+//------------------------------------------------------------------------------
+void
+ioCache::linkFront(int32 entryIndex) {
+    entry& e = this->entries[entryIndex];
+    e.prev = InvalidIndex;
+    e.next = this->lruFront;
+    if (InvalidIndex != this->lruFront) {
+        this->entries[this->lruFront].prev = entryIndex;
+    }
+    else {
+        this->lruBack = entryIndex;
+    }
+    this->lruFront = entryIndex;
+}
+
+//------------------------------------------------------------------------------
+Ptr<Stream>
+ioCache::remove(int32 entryIndex) {
+    this->unlink(entryIndex);
+    entry& e = this->entries[entryIndex];
+    Ptr<Stream> stream = e.stream;
+    this->index.Erase(e.k);
+    this->stats.NumBytes -= e.size;
+    this->stats.NumEntries--;
+    e = entry();
+    this->freeEntries.Add(entryIndex);
+    return stream;
+}
+
+//------------------------------------------------------------------------------
+void
+ioCache::add(const key& k, const Ptr<Stream>& stream, bool onDisk) {
+    const int32 size = stream->Size();
+    if (size > this->maxBytes) {
+        return;
+    }
+
+    // make room by evicting least recently used entries
+    while ((this->stats.NumBytes + size) > this->maxBytes) {
+        o_assert_dbg(InvalidIndex != this->lruBack);
+        const int32 victim = this->lruBack;
+        const key victimKey = this->entries[victim].k;
+        const bool victimOnDisk = this->entries[victim].onDisk;
+        Ptr<Stream> victimStream = this->remove(victim);
+        this->stats.Evictions++;
+        if (!victimOnDisk && this->diskDir.IsValid()) {
+            this->diskWrite(victimKey, victimStream);
+        }
+    }
+
+    int32 entryIndex;
+    if (this->freeEntries.Empty()) {
+        entryIndex = this->entries.Size();
+        this->entries.Add(entry());
+    }
+    else {
+        entryIndex = this->freeEntries.Back();
+        this->freeEntries.Erase(this->freeEntries.Size() - 1);
+    }
+    entry& e = this->entries[entryIndex];
+    e.k = k;
+    e.stream = stream;
+    e.size = size;
+    e.onDisk = onDisk;
+    this->linkFront(entryIndex);
+    this->index.Add(k, entryIndex);
+    this->stats.NumBytes += size;
+    this->stats.NumEntries++;
+}
+
+//------------------------------------------------------------------------------
+Ptr<Stream>
+ioCache::Lookup(const URL& url, int32 startOffset, int32 endOffset) {
+    o_assert_dbg(this->valid);
+    key k;
+    k.url = url.Get();
+    k.startOffset = startOffset;
+    k.endOffset = endOffset;
+    const int32 mapIndex = this->index.FindIndex(k);
+    if (InvalidIndex != mapIndex) {
+        // move to front of LRU list
+        const int32 entryIndex = this->index.ValueAtIndex(mapIndex);
+        this->unlink(entryIndex);
+        this->linkFront(entryIndex);
+        this->stats.Hits++;
+        return this->entries[entryIndex].stream;
+    }
+    if (this->diskDir.IsValid()) {
+        Ptr<Stream> stream = this->diskLookup(k);
+        if (stream.isValid()) {
+            this->stats.DiskHits++;
+            this->add(k, stream, true);
+            return stream;
+        }
+    }
+    this->stats.Misses++;
+    return Ptr<Stream>();
+}
+
+//------------------------------------------------------------------------------
+void
+ioCache::Insert(const URL& url, int32 startOffset, int32 endOffset, const Ptr<Stream>& stream) {
+    o_assert_dbg(this->valid);
+    o_assert_dbg(stream.isValid());
+    key k;
+    k.url = url.Get();
+    k.startOffset = startOffset;
+    k.endOffset = endOffset;
+    const int32 mapIndex = this->index.FindIndex(k);
+    if (InvalidIndex != mapIndex) {
+        // same resource was loaded twice, the newer stream replaces the old one
+        this->remove(this->index.ValueAtIndex(mapIndex));
+    }
+    this->add(k, stream, false);
+}
+
+//------------------------------------------------------------------------------
+void
+ioCache::Clear() {
+    o_assert_dbg(this->valid);
+    while (InvalidIndex != this->lruFront) {
+        this->remove(this->lruFront);
+    }
+}
+
+//------------------------------------------------------------------------------
+String
+ioCache::keyString(const key& k) const {
+    StringBuilder builder;
+    builder.Format(32, "%d-%d:", k.startOffset, k.endOffset);
+    builder.Append(k.url.AsCStr());
+    return builder.GetString();
+}
+
+//------------------------------------------------------------------------------
+String
+ioCache::diskPath(const String& keyStr) const {
+    // FNV-1a hash of the key string
+    uint64 hash = 0xcbf29ce484222325ULL;
+    const char* str = keyStr.AsCStr();
+    for (int32 i = 0; i < keyStr.Length(); i++) {
+        hash = (hash ^ uint8(str[i])) * 0x100000001b3ULL;
+    }
+    StringBuilder builder;
+    builder.Format(256, "%s/%08x%08x.cache", this->diskDir.AsCStr(), uint32(hash >> 32), uint32(hash));
+    return builder.GetString();
+}
+
+//------------------------------------------------------------------------------
+Ptr<Stream>
+ioCache::diskLookup(const key& k) {
+    const String keyStr = this->keyString(k);
+    const String path = this->diskPath(keyStr);
+    FILE* fp = std::fopen(path.AsCStr(), "rb");
+    if (nullptr == fp) {
+        return Ptr<Stream>();
+    }
+
+    // check the header, the key string protects against hash collisions
+    uint32 header[2] = { 0, 0 };
+    bool match = (2 == std::fread(header, sizeof(uint32), 2, fp)) &&
+                 (DiskFileMagic == header[0]) &&
+                 (int32(header[1]) == keyStr.Length());
+    if (match) {
+        char buf[256];
+        int32 remaining = keyStr.Length();
+        StringBuilder builder;
+        while (match && (remaining > 0)) {
+            const int32 chunk = remaining < int32(sizeof(buf)) ? remaining : int32(sizeof(buf));
+            match = (size_t(chunk) == std::fread(buf, 1, size_t(chunk), fp));
+            builder.Append(buf, 0, chunk);
+            remaining -= chunk;
+        }
+        match = match && (builder.GetString() == keyStr);
+    }
+    std::fclose(fp);
+    if (!match) {
+        return Ptr<Stream>();
+    }
+
+    // map the payload which follows the header
+    Ptr<MappedStream> stream = MappedStream::Create();
+    stream->SetURL(k.url);
+    if (IOStatus::OK != stream->MapFile(path, int32(sizeof(header)) + keyStr.Length(), 0)) {
+        return Ptr<Stream>();
+    }
+    return stream;
+}
+
+//------------------------------------------------------------------------------
+void
+ioCache::diskWrite(const key& k, const Ptr<Stream>& stream) {
+    if (stream->IsOpen() || (0 == stream->Size())) {
+        // stream is currently used by somebody, or empty
+        return;
+    }
+    const String keyStr = this->keyString(k);
+    const String path = this->diskPath(keyStr);
+    FILE* fp = std::fopen(path.AsCStr(), "wb");
+    if (nullptr == fp) {
+        o_warn("ioCache: failed to write '%s'\n", path.AsCStr());
+        return;
+    }
+    const uint32 header[2] = { DiskFileMagic, uint32(keyStr.Length()) };
+    bool ok = 2 == std::fwrite(header, sizeof(uint32), 2, fp);
+    ok &= size_t(keyStr.Length()) == std::fwrite(keyStr.AsCStr(), 1, size_t(keyStr.Length()), fp);
+    stream->Open(OpenMode::ReadOnly);
+    const uint8* maxPtr = nullptr;
+    const uint8* ptr = stream->MapRead(&maxPtr);
+    if (ptr) {
+        ok &= size_t(maxPtr - ptr) == std::fwrite(ptr, 1, size_t(maxPtr - ptr), fp);
+    }
+    stream->UnmapRead();
+    stream->Close();
+    std::fclose(fp);
+    if (!ok) {
+        std::remove(path.AsCStr());
+        return;
+    }
+
+    // remove oldest files if the disk tier is full
+    diskFile file;
+    file.path = path;
+    file.size = int64(sizeof(header)) + keyStr.Length() + stream->Size();
+    this->diskFiles.Enqueue(file);
+    this->stats.NumDiskBytes += file.size;
+    while ((this->stats.NumDiskBytes > this->diskMaxBytes) && !this->diskFiles.Empty()) {
+        diskFile oldest = this->diskFiles.Dequeue();
+        std::remove(oldest.path.AsCStr());
+        this->stats.NumDiskBytes -= oldest.size;
+        this->stats.DiskEvictions++;
+    }
+}
+
+} // namespace _priv
+} // namespace Oryol
@@ -0,0 +1,120 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::_priv::ioCache
+    @ingroup _priv
+    @brief LRU cache for loaded IO streams
+    @see ioRequestRouter, IOCacheStats
+
+    The ioCache keeps the Streams of completed IO requests, keyed by URL
+    and byte range (StartOffset/EndOffset), and hands out the same shared
+    Stream object for repeated requests. The memory tier is bounded by the
+    total Stream size in bytes, the least recently used entries are
+    evicted first.
+
+    If a disk directory is provided, evicted entries are written
+    to an on-disk tier (one file per entry, named by a hash of the key),
+    and a memory miss will look there before going to the filesystem.
+    Entries found on disk are memory-mapped and moved back into the
+    memory tier. The disk tier only tracks the files written in the
+    current session for its size limit, and removes the oldest first.
+    Disk writes happen synchronously when an entry is evicted.
+
+    All methods must be called from the same thread (the main thread
+    through the ioRequestRouter).
+*/
+#include "Core/Containers/Array.h"
+#include "Core/Containers/HashMap.h"
+#include "Core/Containers/Queue.h"
+#include "Core/String/String.h"
+#include "Core/String/StringAtom.h"
+#include "IO/Core/URL.h"
+#include "IO/Core/IOCacheStats.h"
+#include "IO/Stream/Stream.h"
+
+namespace Oryol {
+namespace _priv {
+
+class ioCache {
+public:
+    /// constructor
+    ioCache();
+    /// destructor
+    ~ioCache();
+
+    /// setup the cache, diskDir can be empty to disable the disk tier
+    void Setup(int32 maxBytes, const String& diskDir, int64 diskMaxBytes);
+    /// discard the cache (doesn't remove files in the disk tier)
+    void Discard();
+    /// return true if setup
+    bool IsValid() const;
+
+    /// lookup a stream, returns invalid ptr if not in cache (updates counters)
+    Ptr<Stream> Lookup(const URL& url, int32 startOffset, int32 endOffset);
+    /// add or replace a stream
+    void Insert(const URL& url, int32 startOffset, int32 endOffset, const Ptr<Stream>& stream);
+    /// remove all entries from the memory tier
+    void Clear();
+    /// get cache counters
+    const IOCacheStats& GetStats() const;
+
+private:
+    struct key {
+        StringAtom url;
+        int32 startOffset = 0;
+        int32 endOffset = 0;
+        bool operator==(const key& rhs) const {
+            return (this->url == rhs.url) && (this->startOffset == rhs.startOffset) && (this->endOffset == rhs.endOffset);
+        };
+    };
+    struct keyHasher {
+        uint64 operator()(const key& k) const {
+            // string atoms are unique, so the string pointer can be hashed
+            return uint64(uintptr_t(k.url.AsCStr())) ^ (uint64(uint32(k.startOffset)) << 20) ^ (uint64(uint32(k.endOffset)) << 40);
+        };
+    };
+    struct entry {
+        key k;
+        Ptr<Stream> stream;
+        int32 size = 0;
+        int32 prev = InvalidIndex;
+        int32 next = InvalidIndex;
+        bool onDisk = false;
+    };
+    struct diskFile {
+        String path;
+        int64 size = 0;
+    };
+
+    /// add a new entry at the front of the LRU list
+    void add(const key& k, const Ptr<Stream>& stream, bool onDisk);
+    /// remove an entry from the LRU list
+    void unlink(int32 entryIndex);
+    /// insert an entry at the front of the LRU list
+    void linkFront(int32 entryIndex);
+    /// remove an entry, returns its stream
+    Ptr<Stream> remove(int32 entryIndex);
+    /// get the key string written into disk tier files
+    String keyString(const key& k) const;
+    /// get the disk tier file path for a key string
+    String diskPath(const String& keyStr) const;
+    /// try to load a stream from the disk tier
+    Ptr<Stream> diskLookup(const key& k);
+    /// write a stream to the disk tier
+    void diskWrite(const key& k, const Ptr<Stream>& stream);
+
+    bool valid;
+    int32 maxBytes;
+    String diskDir;
+    int64 diskMaxBytes;
+    HashMap<key, int32, keyHasher> index;
+    Array<entry> entries;
+    Array<int32> freeEntries;
+    int32 lruFront;
+    int32 lruBack;
+    Queue<diskFile> diskFiles;
+    IOCacheStats stats;
+};
+
+} // namespace _priv
+} // namespace Oryol
@@ -3,13 +3,29 @@
 //------------------------------------------------------------------------------
 #include "Pre.h"
 #include "ioRequestRouter.h"
+#include "Time/Clock.h"
 
 namespace Oryol {
 namespace _priv {
 
 //------------------------------------------------------------------------------
-ioRequestRouter::ioRequestRouter(int32 numLanes_) :
-numLanes(numLanes_) {
+ioRequestRouter::ioRequestRouter(const IOSetup& setup) :
+numLanes(setup.NumIOLanes),
+lanePolicy(setup.LanePolicy),
+maxLaneDepth(setup.MaxLaneDepth),
+allLanesMask(0),
+nextLane(0) {
+    o_assert((this->numLanes > 0) && (this->numLanes <= 32));
+    o_assert((this->lanePolicy >= 0) && (this->lanePolicy < IOLanePolicy::NumLanePolicies));
+    o_assert(this->maxLaneDepth >= 0);
+    this->allLanesMask = (32 == this->numLanes) ? 0xFFFFFFFF : ((1u << this->numLanes) - 1);
+    for (const auto& kvp : setup.LaneAffinity) {
+        this->SetLaneAffinity(kvp.Key(), kvp.Value());
+    }
+
+    if (setup.CacheMaxBytes > 0) {
+        this->cache.Setup(setup.CacheMaxBytes, setup.CacheDiskDirectory, setup.CacheDiskMaxBytes);
+    }
 
     // create ioLanes
     this->ioLanes.Reserve(this->numLanes);
@@ -18,6 +34,10 @@ numLanes(numLanes_) {
         newLane->StartThread();
         this->ioLanes.Add(newLane);
     }
+    this->laneStates.Reserve(this->numLanes);
+    for (int32 i = 0; i < this->numLanes; i++) {
+        this->laneStates.Add(laneState());
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -26,6 +46,14 @@ ioRequestRouter::~ioRequestRouter() {
         lane->StopThread();
     }
     this->ioLanes.Clear();
+    for (auto& queue : this->pending) {
+        queue.Clear();
+    }
+    this->outstandingRequests.Clear();
+    this->cacheWrites.Clear();
+    if (this->cache.IsValid()) {
+        this->cache.Discard();
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -42,9 +70,26 @@ ioRequestRouter::Put(const Ptr<Message>& msg) {
     else {
         Ptr<IOProtocol::Request> req = msg.dynamicCast<IOProtocol::Request>();
         if (req.isValid()) {
-            const int32 laneIndex = req->GetLane() % this->numLanes;
-            req->SetActualLane(laneIndex);
-            this->ioLanes[laneIndex]->Put(msg);
+            if (this->cache.IsValid()) {
+                if (req->GetCacheReadEnabled()) {
+                    Ptr<Stream> stream = this->cache.Lookup(req->GetURL(), req->GetStartOffset(), req->GetEndOffset());
+                    if (stream.isValid()) {
+                        // cache hit, no need to bother an IO lane
+                        req->SetStream(stream);
+                        req->SetStatus(IOStatus::OK);
+                        req->SetActualLane(InvalidIndex);
+                        req->SetHandled();
+                        return true;
+                    }
+                }
+                if (req->GetCacheWriteEnabled()) {
+                    this->cacheWrites.Add(req);
+                }
+            }
+            // lanes are selected in DoWork(), right before the lanes get busy
+            const IOPriority::Code prio = req->GetPriority();
+            o_assert_dbg((prio >= 0) && (prio < IOPriority::NumPriorities));
+            this->pending[prio].Enqueue(req);
             return true;
         }
     }
@@ -56,9 +101,200 @@ ioRequestRouter::Put(const Ptr<Message>& msg) {
 //------------------------------------------------------------------------------
 void
 ioRequestRouter::DoWork() {
+    this->updateLanes();
+    this->dispatch();
     for (const auto& lane : this->ioLanes) {
         lane->DoWork();
     }
+    if (this->cache.IsValid()) {
+        this->updateCache();
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+ioRequestRouter::updateLanes() {
+    if (this->outstandingRequests.Empty()) {
+        return;
+    }
+    const TimePoint now = Clock::Now();
+    for (int32 i = this->outstandingRequests.Size() - 1; i >= 0; i--) {
+        const outstanding& item = this->outstandingRequests[i];
+        if (item.req->Handled()) {
+            laneState& lane = this->laneStates[item.laneIndex];
+            const Duration latency = now.Since(item.startTime);
+            lane.queueDepth--;
+            lane.numCompleted++;
+            lane.totalLatency += latency;
+            if (latency > lane.maxLatency) {
+                lane.maxLatency = latency;
+            }
+            this->outstandingRequests.EraseSwap(i);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+ Hands pending requests to the lanes, higher priorities first. Requests
+ which can't be dispatched because their lanes are busy keep their
+ position in the pending queue.
+*/
+void
+ioRequestRouter::dispatch() {
+    const TimePoint now = Clock::Now();
+    for (auto& queue : this->pending) {
+        const int32 num = queue.Size();
+        for (int32 i = 0; i < num; i++) {
+            Ptr<IOProtocol::Request> req = queue.Dequeue();
+            if (req->Cancelled()) {
+                // don't bother a lane with cancelled requests
+                req->SetStatus(IOStatus::Cancelled);
+                req->SetHandled();
+                continue;
+            }
+            const int32 laneIndex = this->selectLane(req);
+            if (InvalidIndex == laneIndex) {
+                queue.Enqueue(std::move(req));
+                continue;
+            }
+            req->SetActualLane(laneIndex);
+            this->laneStates[laneIndex].queueDepth++;
+            this->ioLanes[laneIndex]->Put(req);
+            outstanding item;
+            item.req = std::move(req);
+            item.laneIndex = laneIndex;
+            item.startTime = now;
+            this->outstandingRequests.Add(std::move(item));
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+int32
+ioRequestRouter::selectLane(const Ptr<IOProtocol::Request>& req) {
+    uint32 mask = this->allLanesMask;
+    if (!this->laneAffinity.Empty()) {
+        const int32 index = this->laneAffinity.FindIndex(req->GetURL().Scheme());
+        if (InvalidIndex != index) {
+            mask = this->laneAffinity.ValueAtIndex(index);
+        }
+    }
+
+    int32 laneIndex = InvalidIndex;
+    if (IOLanePolicy::Fixed == this->lanePolicy) {
+        laneIndex = req->GetLane() % this->numLanes;
+        if (0 == (mask & (1u << laneIndex))) {
+            // lane not allowed for this scheme, map to the Nth allowed lane
+            int32 numAllowed = 0;
+            for (int32 i = 0; i < this->numLanes; i++) {
+                numAllowed += (mask >> i) & 1;
+            }
+            int32 nth = req->GetLane() % numAllowed;
+            for (laneIndex = 0; laneIndex < this->numLanes; laneIndex++) {
+                if ((mask & (1u << laneIndex)) && (0 == nth--)) {
+                    break;
+                }
+            }
+        }
+    }
+    else {
+        // least outstanding requests, start searching at a rotating
+        // lane so that ties are spread over all lanes
+        int32 minDepth = 0x7FFFFFFF;
+        for (int32 i = 0; i < this->numLanes; i++) {
+            const int32 curLane = (this->nextLane + i) % this->numLanes;
+            if ((mask & (1u << curLane)) && (this->laneStates[curLane].queueDepth < minDepth)) {
+                minDepth = this->laneStates[curLane].queueDepth;
+                laneIndex = curLane;
+            }
+        }
+        this->nextLane = (this->nextLane + 1) % this->numLanes;
+    }
+    o_assert_dbg(InvalidIndex != laneIndex);
+    if ((this->maxLaneDepth > 0) && (this->laneStates[laneIndex].queueDepth >= this->maxLaneDepth)) {
+        return InvalidIndex;
+    }
+    return laneIndex;
+}
+
+//------------------------------------------------------------------------------
+void
+ioRequestRouter::updateCache() {
+    for (int32 i = this->cacheWrites.Size() - 1; i >= 0; i--) {
+        const Ptr<IOProtocol::Request>& req = this->cacheWrites[i];
+        if (req->Handled()) {
+            if ((IOStatus::OK == req->GetStatus()) && req->GetStream().isValid() && !req->Cancelled()) {
+                this->cache.Insert(req->GetURL(), req->GetStartOffset(), req->GetEndOffset(), req->GetStream());
+            }
+            this->cacheWrites.EraseSwap(i);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+IOCacheStats
+ioRequestRouter::GetCacheStats() const {
+    if (this->cache.IsValid()) {
+        return this->cache.GetStats();
+    }
+    else {
+        return IOCacheStats();
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+ioRequestRouter::ClearCache() {
+    if (this->cache.IsValid()) {
+        this->cache.Clear();
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+ioRequestRouter::SetLaneAffinity(const StringAtom& scheme, uint32 laneMask) {
+    o_assert(scheme.IsValid());
+    laneMask &= this->allLanesMask;
+    if (0 == laneMask) {
+        this->laneAffinity.Erase(scheme);
+    }
+    else if (this->laneAffinity.Contains(scheme)) {
+        this->laneAffinity[scheme] = laneMask;
+    }
+    else {
+        this->laneAffinity.Add(scheme, laneMask);
+    }
+}
+
+//------------------------------------------------------------------------------
+int32
+ioRequestRouter::NumLanes() const {
+    return this->numLanes;
+}
+
+//------------------------------------------------------------------------------
+IOLaneStats
+ioRequestRouter::GetLaneStats(int32 laneIndex) const {
+    const laneState& lane = this->laneStates[laneIndex];
+    IOLaneStats stats;
+    stats.QueueDepth = lane.queueDepth;
+    stats.NumCompleted = lane.numCompleted;
+    if (lane.numCompleted > 0) {
+        stats.AvgLatency = Duration(lane.totalLatency.getRaw() / lane.numCompleted);
+    }
+    stats.MaxLatency = lane.maxLatency;
+    return stats;
+}
+
+//------------------------------------------------------------------------------
+int32
+ioRequestRouter::NumPendingRequests() const {
+    int32 num = 0;
+    for (const auto& queue : this->pending) {
+        num += queue.Size();
+    }
+    return num;
 }
 
 } // namespace _priv
@@ -5,11 +5,27 @@
     @ingroup _priv
     @brief front end router port of the IO system
     
-    @todo: ioRequestRouter description
+    Distributes IO requests to the IO lanes, and notify messages to all
+    IO lanes. Requests with CacheReadEnabled are answered directly from
+    the ioCache if possible, the streams of successful requests with
+    CacheWriteEnabled are added to the ioCache in DoWork().
+
+    Incoming requests are queued by priority and handed to the lanes
+    in DoWork(), right before the lanes transfer their messages to the
+    lane threads. The target lane is selected by the IOLanePolicy,
+    restricted to the lane mask of the request's URL scheme (if any).
+    If a MaxLaneDepth is set, requests stay queued in the router while
+    all their lanes are busy, so that high-priority requests can
+    overtake low-priority requests.
 */
 #include "IO/Core/IOConfig.h"
+#include "IO/Core/IOSetup.h"
+#include "IO/Core/IOLaneStats.h"
+#include "Core/Containers/Queue.h"
+#include "Time/TimePoint.h"
 #include "Messaging/Port.h"
 #include "IO/FS/ioLane.h"
+#include "IO/FS/ioCache.h"
 
 namespace Oryol {
 namespace _priv {
@@ -18,7 +34,7 @@ class ioRequestRouter : public Port {
     OryolClassDecl(ioRequestRouter);
 public:
     /// constructor
-    ioRequestRouter(int32 numLanes);
+    ioRequestRouter(const IOSetup& setup);
     /// destructor
     virtual ~ioRequestRouter();
     
@@ -27,9 +43,54 @@ public:
     /// perform work, this will be invoked on downstream ports
     virtual void DoWork() override;
     
+    /// get IO cache counters
+    IOCacheStats GetCacheStats() const;
+    /// remove all entries from the in-memory IO cache
+    void ClearCache();
+
+    /// set the lanes a URL scheme may use (bit N set: lane N), 0 removes the restriction
+    void SetLaneAffinity(const StringAtom& scheme, uint32 laneMask);
+    /// get number of IO lanes
+    int32 NumLanes() const;
+    /// get queue depth and latency counters of an IO lane
+    IOLaneStats GetLaneStats(int32 laneIndex) const;
+    /// get number of requests waiting in the router for a free lane
+    int32 NumPendingRequests() const;
+
 private:
+    /// check handled state of outstanding requests, and update lane stats
+    void updateLanes();
+    /// hand pending requests to the lanes in priority order
+    void dispatch();
+    /// select a lane for a request, InvalidIndex if all allowed lanes are busy
+    int32 selectLane(const Ptr<IOProtocol::Request>& req);
+    /// add streams of completed requests to the cache
+    void updateCache();
+
+    struct outstanding {
+        Ptr<IOProtocol::Request> req;
+        int32 laneIndex = InvalidIndex;
+        TimePoint startTime;
+    };
+    struct laneState {
+        int32 queueDepth = 0;
+        int32 numCompleted = 0;
+        Duration totalLatency;
+        Duration maxLatency;
+    };
+
     int32 numLanes;
+    IOLanePolicy::Code lanePolicy;
+    int32 maxLaneDepth;
+    uint32 allLanesMask;
+    int32 nextLane;
     Array<Ptr<ioLane>> ioLanes;
+    Array<laneState> laneStates;
+    Map<StringAtom, uint32> laneAffinity;
+    Queue<Ptr<IOProtocol::Request>> pending[IOPriority::NumPriorities];
+    Array<outstanding> outstandingRequests;
+    ioCache cache;
+    Array<Ptr<IOProtocol::Request>> cacheWrites;
 };
     
 } // namespace IO
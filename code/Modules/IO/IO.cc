@@ -19,7 +19,7 @@ IO::Setup(const IOSetup& setup) {
     o_assert(!IsValid());
     
     state = Memory::New<_state>();
-    state->requestRouter = ioRequestRouter::Create(setup.NumIOLanes);
+    state->requestRouter = ioRequestRouter::Create(setup);
     
     // setup initial assigns
     for (const auto& assign : setup.Assigns) {
@@ -124,11 +124,12 @@ IO::IsFileSystemRegistered(const StringAtom& scheme) {
 
 //------------------------------------------------------------------------------
 Ptr<IOProtocol::Request>
-IO::LoadFile(const URL& url, int32 ioLane) {
+IO::LoadFile(const URL& url, int32 ioLane, IOPriority::Code prio) {
     o_assert_dbg(IsValid());
     Ptr<IOProtocol::Request> ioReq = IOProtocol::Request::Create();
     ioReq->SetURL(url);
     ioReq->SetLane(ioLane);
+    ioReq->SetPriority(prio);
     state->requestRouter->Put(ioReq);
     return ioReq;
 }
@@ -140,6 +141,48 @@ IO::Put(const Ptr<IOProtocol::Request>& ioReq) {
     state->requestRouter->Put(ioReq);
 }
 
+//------------------------------------------------------------------------------
+IOCacheStats
+IO::GetCacheStats() {
+    o_assert_dbg(IsValid());
+    return state->requestRouter->GetCacheStats();
+}
+
+//------------------------------------------------------------------------------
+void
+IO::ClearCache() {
+    o_assert_dbg(IsValid());
+    state->requestRouter->ClearCache();
+}
+
+//------------------------------------------------------------------------------
+void
+IO::SetLaneAffinity(const StringAtom& scheme, uint32 laneMask) {
+    o_assert_dbg(IsValid());
+    state->requestRouter->SetLaneAffinity(scheme, laneMask);
+}
+
+//------------------------------------------------------------------------------
+int32
+IO::NumLanes() {
+    o_assert_dbg(IsValid());
+    return state->requestRouter->NumLanes();
+}
+
+//------------------------------------------------------------------------------
+IOLaneStats
+IO::GetLaneStats(int32 laneIndex) {
+    o_assert_dbg(IsValid());
+    return state->requestRouter->GetLaneStats(laneIndex);
+}
+
+//------------------------------------------------------------------------------
+int32
+IO::NumPendingRequests() {
+    o_assert_dbg(IsValid());
+    return state->requestRouter->NumPendingRequests();
+}
+
 //------------------------------------------------------------------------------
 schemeRegistry*
 IO::getSchemeRegistry() {
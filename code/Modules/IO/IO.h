@@ -12,6 +12,9 @@
 #include "Core/String/String.h"
 #include "Core/String/StringAtom.h"
 #include "IO/Core/IOSetup.h"
+#include "IO/Core/IOCacheStats.h"
+#include "IO/Core/IOLaneStats.h"
+#include "IO/Core/IOPriority.h"
 #include "IO/IOProtocol.h"
 #include "IO/FS/ioRequestRouter.h"
 #include "IO/Core/assignRegistry.h"
@@ -46,9 +49,23 @@ public:
     static bool IsFileSystemRegistered(const StringAtom& scheme);
     
     /// start async loading of file from URL (also see IOQueue!)
-    static Ptr<IOProtocol::Request> LoadFile(const URL& url, int32 ioLane=0);
+    static Ptr<IOProtocol::Request> LoadFile(const URL& url, int32 ioLane=0, IOPriority::Code prio=IOPriority::Normal);
     /// push a generic asynchronous IO request
     static void Put(const Ptr<IOProtocol::Request>& ioReq);
+
+    /// get IO cache hit/miss/eviction counters
+    static IOCacheStats GetCacheStats();
+    /// remove all entries from the in-memory IO cache
+    static void ClearCache();
+
+    /// set the IO lanes a URL scheme may use (bit N set: lane N), 0 removes the restriction
+    static void SetLaneAffinity(const StringAtom& scheme, uint32 laneMask);
+    /// get number of IO lanes
+    static int32 NumLanes();
+    /// get queue depth and latency counters of an IO lane
+    static IOLaneStats GetLaneStats(int32 laneIndex);
+    /// get number of requests waiting for a free IO lane
+    static int32 NumPendingRequests();
     
 private:
     friend class _priv::ioLane;
@@ -10,6 +10,7 @@
 #include "Core/Ptr.h"
 #include "IO/Core/URL.h"
 #include "IO/Core/IOStatus.h"
+#include "IO/Core/IOPriority.h"
 #include "IO/Stream/MemoryStream.h"
 
 namespace Oryol {
@@ -59,6 +60,7 @@ public:
         Request() {
             this->msgId = MessageId::RequestId;
             this->lane = 0;
+            this->priority = IOPriority::Normal;
             this->cachereadenabled = true;
             this->cachewriteenabled = true;
             this->startoffset = 0;
@@ -88,6 +90,12 @@ public:
         int32 GetLane() const {
             return this->lane;
         };
+        void SetPriority(const IOPriority::Code& val) {
+            this->priority = val;
+        };
+        const IOPriority::Code& GetPriority() const {
+            return this->priority;
+        };
         void SetCacheReadEnabled(bool val) {
             this->cachereadenabled = val;
         };
@@ -139,6 +147,7 @@ public:
 private:
         URL url;
         int32 lane;
+        IOPriority::Code priority;
         bool cachereadenabled;
         bool cachewriteenabled;
         int32 startoffset;
@@ -0,0 +1,254 @@
+//------------------------------------------------------------------------------
+//  MappedStream.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "MappedStream.h"
+#include "Core/Memory/Memory.h"
+#include "IO/Core/byteRange.h"
+#if ORYOL_POSIX
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#elif ORYOL_WINDOWS
+#include <Windows.h>
+#include "Core/String/StringConverter.h"
+#else
+#include <cstdio>
+#endif
+
+namespace Oryol {
+
+OryolClassImpl(MappedStream);
+
+//------------------------------------------------------------------------------
+MappedStream::MappedStream() :
+base(nullptr),
+baseSize(0),
+data(nullptr),
+fileMapped(false) {
+    // empty
+}
+
+//------------------------------------------------------------------------------
+MappedStream::~MappedStream() {
+    if (this->IsOpen()) {
+        this->Close();
+    }
+    this->unmap();
+}
+
+//------------------------------------------------------------------------------
+void
+MappedStream::unmap() {
+    if (nullptr != this->base) {
+        if (this->fileMapped) {
+            #if ORYOL_POSIX
+            munmap(this->base, size_t(this->baseSize));
+            #elif ORYOL_WINDOWS
+            UnmapViewOfFile(this->base);
+            #endif
+        }
+        else {
+            Memory::Free(this->base);
+        }
+    }
+    this->base = nullptr;
+    this->baseSize = 0;
+    this->data = nullptr;
+    this->fileMapped = false;
+    this->size = 0;
+    this->readPosition = 0;
+}
+
+//------------------------------------------------------------------------------
+/**
+ Maps the requested byte range of a file into memory. The mapping itself
+ must start at a page boundary, so the mapped area may start a bit before
+ the requested range, the stream content always starts at startOffset.
+ Returns an IOStatus code so that the result can be handed directly
+ to an IOProtocol::Request.
+*/
+IOStatus::Code
+MappedStream::MapFile(const String& nativePath, int32 startOffset, int32 endOffset) {
+    o_assert(!this->isOpen);
+    o_assert(nativePath.IsValid());
+    o_assert((startOffset >= 0) && (endOffset >= 0));
+    this->unmap();
+
+    int64 start = 0;
+    int64 numBytes = 0;
+    #if ORYOL_POSIX
+    int fd = open(nativePath.AsCStr(), O_RDONLY);
+    if (-1 == fd) {
+        return (EACCES == errno) ? IOStatus::Forbidden : IOStatus::NotFound;
+    }
+    struct stat st;
+    if (0 != fstat(fd, &st)) {
+        close(fd);
+        return IOStatus::InternalServerError;
+    }
+    if (!_priv::byteRange::Resolve(st.st_size, startOffset, endOffset, start, numBytes)) {
+        close(fd);
+        return IOStatus::RequestedRangeNotSatisfiable;
+    }
+    if (numBytes > 0x7FFFFFFF) {
+        close(fd);
+        return IOStatus::RequestEntityTooLarge;
+    }
+    if (numBytes > 0) {
+        const int64 pageSize = sysconf(_SC_PAGESIZE);
+        const int64 mapStart = start & ~(pageSize - 1);
+        const int64 mapSize = (start - mapStart) + numBytes;
+        void* ptr = mmap(nullptr, size_t(mapSize), PROT_READ, MAP_PRIVATE, fd, off_t(mapStart));
+        if (MAP_FAILED == ptr) {
+            close(fd);
+            return IOStatus::InternalServerError;
+        }
+        // the content is usually parsed right away, start paging it in
+        posix_madvise(ptr, size_t(mapSize), POSIX_MADV_WILLNEED);
+        this->base = (uint8*) ptr;
+        this->baseSize = mapSize;
+        this->data = this->base + (start - mapStart);
+        this->fileMapped = true;
+    }
+    close(fd);
+    #elif ORYOL_WINDOWS
+    WideString widePath = StringConverter::UTF8ToWide(nativePath);
+    HANDLE file = CreateFileW(widePath.AsCStr(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (INVALID_HANDLE_VALUE == file) {
+        return (ERROR_ACCESS_DENIED == GetLastError()) ? IOStatus::Forbidden : IOStatus::NotFound;
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize)) {
+        CloseHandle(file);
+        return IOStatus::InternalServerError;
+    }
+    if (!_priv::byteRange::Resolve(fileSize.QuadPart, startOffset, endOffset, start, numBytes)) {
+        CloseHandle(file);
+        return IOStatus::RequestedRangeNotSatisfiable;
+    }
+    if (numBytes > 0x7FFFFFFF) {
+        CloseHandle(file);
+        return IOStatus::RequestEntityTooLarge;
+    }
+    if (numBytes > 0) {
+        SYSTEM_INFO sysInfo;
+        GetSystemInfo(&sysInfo);
+        const int64 granularity = sysInfo.dwAllocationGranularity;
+        const int64 mapStart = start & ~(granularity - 1);
+        const int64 mapSize = (start - mapStart) + numBytes;
+        HANDLE mapping = CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        void* ptr = nullptr;
+        if (NULL != mapping) {
+            ptr = MapViewOfFile(mapping, FILE_MAP_READ, DWORD(uint64(mapStart) >> 32), DWORD(mapStart & 0xFFFFFFFF), SIZE_T(mapSize));
+            // the view keeps the mapping object alive
+            CloseHandle(mapping);
+        }
+        if (nullptr == ptr) {
+            CloseHandle(file);
+            return IOStatus::InternalServerError;
+        }
+        this->base = (uint8*) ptr;
+        this->baseSize = mapSize;
+        this->data = this->base + (start - mapStart);
+        this->fileMapped = true;
+    }
+    CloseHandle(file);
+    #else
+    // no memory-mapped files on this platform, read the range into a buffer
+    FILE* fp = std::fopen(nativePath.AsCStr(), "rb");
+    if (nullptr == fp) {
+        return IOStatus::NotFound;
+    }
+    std::fseek(fp, 0, SEEK_END);
+    const int64 fileSize = std::ftell(fp);
+    if (!_priv::byteRange::Resolve(fileSize, startOffset, endOffset, start, numBytes)) {
+        std::fclose(fp);
+        return IOStatus::RequestedRangeNotSatisfiable;
+    }
+    if (numBytes > 0) {
+        this->base = (uint8*) Memory::Alloc(int32(numBytes));
+        this->baseSize = numBytes;
+        this->data = this->base;
+        std::fseek(fp, long(start), SEEK_SET);
+        if (size_t(numBytes) != std::fread(this->base, 1, size_t(numBytes), fp)) {
+            std::fclose(fp);
+            this->unmap();
+            return IOStatus::InternalServerError;
+        }
+    }
+    std::fclose(fp);
+    #endif
+
+    this->size = int32(numBytes);
+    this->readPosition = 0;
+    return IOStatus::OK;
+}
+
+//------------------------------------------------------------------------------
+bool
+MappedStream::IsFileMapped() const {
+    return this->fileMapped;
+}
+
+//------------------------------------------------------------------------------
+bool
+MappedStream::Open(OpenMode::Enum mode) {
+    o_assert(OpenMode::ReadOnly == mode);
+    return Stream::Open(mode);
+}
+
+//------------------------------------------------------------------------------
+void
+MappedStream::DiscardContent() {
+    o_assert(!this->isOpen);
+    this->unmap();
+}
+
+//------------------------------------------------------------------------------
+int32
+MappedStream::Read(void* ptr, int32 numBytes) {
+    o_assert(this->isOpen);
+    o_assert((this->readPosition >= 0) && (this->readPosition <= this->size));
+
+    // cap numBytes if EndOfStream or trying to read past stream
+    if ((EndOfStream == numBytes) || ((this->readPosition + numBytes) > this->size)) {
+        numBytes = this->size - this->readPosition;
+    }
+    if (numBytes > 0) {
+        o_assert(nullptr != this->data);
+        Memory::Copy(this->data + this->readPosition, ptr, numBytes);
+        this->readPosition += numBytes;
+    }
+    return numBytes;
+}
+
+//------------------------------------------------------------------------------
+/**
+ Returns a pointer directly into the mapped pages, see Stream::MapRead()
+ for details!
+*/
+const uint8*
+MappedStream::MapRead(const uint8** outMaxValidPtr) {
+    o_assert(this->isOpen);
+    o_assert(!this->isReadMapped);
+    o_assert((this->readPosition >= 0) && (this->readPosition <= this->size));
+
+    this->isReadMapped = true;
+    if (this->readPosition == this->size) {
+        if (nullptr != outMaxValidPtr) {
+            *outMaxValidPtr = nullptr;
+        }
+        return nullptr;
+    }
+    else {
+        if (nullptr != outMaxValidPtr) {
+            *outMaxValidPtr = this->data + this->size;
+        }
+        return this->data + this->readPosition;
+    }
+}
+
+} // namespace Oryol
@@ -0,0 +1,62 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::MappedStream
+    @ingroup IO
+    @brief a read-only Stream on a memory-mapped file range
+
+    A MappedStream maps a byte range of a local file into memory and
+    hands out pointers directly into the mapped pages through MapRead(),
+    so that file content can be parsed without being copied into
+    a heap buffer first. The mapping is released when the stream
+    is destroyed or DiscardContent() is called.
+
+    The byte range follows the IOProtocol::Request StartOffset/EndOffset
+    convention (same as a HTTP Range header): EndOffset is the inclusive
+    last byte, an EndOffset of 0 means 'until end of file'.
+
+    On platforms without memory-mapped files the range is read into
+    an internal buffer instead.
+
+    @see LocalFileSystem
+*/
+#include "IO/Stream/Stream.h"
+#include "IO/Core/IOStatus.h"
+#include "Core/String/String.h"
+
+namespace Oryol {
+
+class MappedStream : public Stream {
+    OryolClassDecl(MappedStream);
+public:
+    /// constructor
+    MappedStream();
+    /// destructor
+    virtual ~MappedStream();
+
+    /// map a byte range of a local file (endOffset is inclusive, 0 means until end of file)
+    IOStatus::Code MapFile(const String& nativePath, int32 startOffset=0, int32 endOffset=0);
+    /// return true if the stream content is backed by a file mapping
+    bool IsFileMapped() const;
+
+    /// open the stream, only OpenMode::ReadOnly is allowed
+    virtual bool Open(OpenMode::Enum mode) override;
+    /// discard the content of the stream (releases the mapping)
+    virtual void DiscardContent() override;
+
+    /// read a number of bytes from the stream (returns bytes read), numBytes can be EndOfStream
+    virtual int32 Read(void* ptr, int32 numBytes) override;
+    /// map a memory area at the current read-position, DOES NOT ADVANCE READ-POS!
+    virtual const uint8* MapRead(const uint8** outMaxValidPtr) override;
+
+private:
+    /// release the mapping or fallback buffer
+    void unmap();
+
+    uint8* base;            // start of mapped pages (or fallback buffer)
+    int64 baseSize;         // size of mapped pages (or fallback buffer)
+    const uint8* data;      // start of requested range inside mapped pages
+    bool fileMapped;
+};
+
+} // namespace Oryol
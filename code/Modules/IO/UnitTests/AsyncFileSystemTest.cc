@@ -0,0 +1,186 @@
+//------------------------------------------------------------------------------
+//  AsyncFileSystemTest.cc
+//  Test asynchronous batched file reads, and compare load times
+//  of many small files with different lane counts and backends.
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "UnitTest++/src/UnitTest++.h"
+#if ORYOL_POSIX
+#include "IO/IO.h"
+#include "IO/FS/AsyncFileSystem.h"
+#include "IO/FS/LocalFileSystem.h"
+#include "Core/Core.h"
+#include "Core/RunLoop.h"
+#include "Core/Log.h"
+#include "Core/String/StringBuilder.h"
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cstdio>
+#include <cstring>
+#include <chrono>
+
+using namespace Oryol;
+
+static const char* BackendNames[] = { "Auto", "IoUring", "ThreadPool" };
+
+//------------------------------------------------------------------------------
+static void
+writeFile(const char* path, int32 size, uint8 seed) {
+    FILE* fp = std::fopen(path, "wb");
+    for (int32 i = 0; i < size; i++) {
+        std::fputc(uint8(seed + i * 3), fp);
+    }
+    std::fclose(fp);
+}
+
+//------------------------------------------------------------------------------
+static void
+testBackend(AsyncFileSystem::Backend::Code backend) {
+    IOSetup ioSetup;
+    ioSetup.NumIOLanes = 1;
+    ioSetup.FileSystems.Add("file", [backend] {
+        return AsyncFileSystem::Create(backend);
+    });
+    IO::Setup(ioSetup);
+
+    // a single lane must have all requests in flight at the same time,
+    // issue them all at once and check that they all complete
+    const int32 numFiles = 64;
+    StringBuilder strBuilder;
+    Array<Ptr<IOProtocol::Request>> reqs;
+    for (int32 i = 0; i < numFiles; i++) {
+        strBuilder.Format(128, "/tmp/oryol_asyncfs_test_%d.bin", i);
+        writeFile(strBuilder.AsCStr(), 1000 + i * 100, uint8(i));
+        strBuilder.Format(128, "file:///tmp/oryol_asyncfs_test_%d.bin", i);
+        reqs.Add(IO::LoadFile(strBuilder.GetString()));
+    }
+    Ptr<IOProtocol::Request> rangeReq = IOProtocol::Request::Create();
+    rangeReq->SetURL("file:///tmp/oryol_asyncfs_test_5.bin");
+    rangeReq->SetStartOffset(100);
+    rangeReq->SetEndOffset(199);
+    IO::Put(rangeReq);
+    Ptr<IOProtocol::Request> badReq = IO::LoadFile("file:///tmp/oryol_does_not_exist.bin");
+    bool allHandled = false;
+    while (!allHandled) {
+        Core::PreRunLoop()->Run();
+        allHandled = rangeReq->Handled() && badReq->Handled();
+        for (const auto& req : reqs) {
+            allHandled &= req->Handled();
+        }
+    }
+
+    bool allOk = true;
+    for (int32 i = 0; i < numFiles; i++) {
+        const Ptr<IOProtocol::Request>& req = reqs[i];
+        allOk &= (IOStatus::OK == req->GetStatus());
+        const Ptr<Stream>& stream = req->GetStream();
+        allOk &= stream->Size() == (1000 + i * 100);
+        stream->Open(OpenMode::ReadOnly);
+        const uint8* maxPtr = nullptr;
+        const uint8* ptr = stream->MapRead(&maxPtr);
+        for (int32 j = 0; j < stream->Size(); j++) {
+            allOk &= ptr[j] == uint8(i + j * 3);
+        }
+        stream->UnmapRead();
+        stream->Close();
+    }
+    CHECK(allOk);
+    CHECK(rangeReq->GetStatus() == IOStatus::OK);
+    const Ptr<Stream>& rangeStream = rangeReq->GetStream();
+    CHECK(rangeStream->Size() == 100);
+    rangeStream->Open(OpenMode::ReadOnly);
+    uint8 buf[100];
+    CHECK(rangeStream->Read(buf, 100) == 100);
+    CHECK(buf[0] == uint8(5 + 100 * 3));
+    CHECK(buf[99] == uint8(5 + 199 * 3));
+    rangeStream->Close();
+    CHECK(badReq->GetStatus() == IOStatus::NotFound);
+
+    IO::Discard();
+    for (int32 i = 0; i < numFiles; i++) {
+        strBuilder.Format(128, "/tmp/oryol_asyncfs_test_%d.bin", i);
+        std::remove(strBuilder.AsCStr());
+    }
+}
+
+//------------------------------------------------------------------------------
+TEST(AsyncFileSystemTest) {
+    Ptr<AsyncFileSystem> fs = AsyncFileSystem::Create(AsyncFileSystem::Backend::ThreadPool);
+    CHECK(fs->GetBackend() == AsyncFileSystem::Backend::ThreadPool);
+    CHECK(fs->NumPending() == 0);
+    fs = AsyncFileSystem::Create();
+    Log::Info("AsyncFileSystem: Backend::Auto selected %s\n", BackendNames[fs->GetBackend()]);
+    fs.Invalidate();
+
+    testBackend(AsyncFileSystem::Backend::ThreadPool);
+    testBackend(AsyncFileSystem::Backend::IoUring);
+}
+
+//------------------------------------------------------------------------------
+TEST(AsyncFileSystemBenchmark) {
+    using namespace std::chrono;
+
+    const int32 numFiles = 4000;
+    const int32 fileSize = 4096;
+    StringBuilder strBuilder;
+    mkdir("/tmp/oryol_asyncfs_bench", 0755);
+    for (int32 i = 0; i < numFiles; i++) {
+        strBuilder.Format(128, "/tmp/oryol_asyncfs_bench/%d.bin", i);
+        writeFile(strBuilder.AsCStr(), fileSize, uint8(i));
+    }
+
+    const int32 laneCounts[] = { 1, 2, 4, 8 };
+    for (int32 numLanes : laneCounts) {
+        for (int32 fsType = 0; fsType < 3; fsType++) {
+            IOSetup ioSetup;
+            ioSetup.NumIOLanes = numLanes;
+            const char* name = nullptr;
+            if (0 == fsType) {
+                ioSetup.FileSystems.Add("file", LocalFileSystem::Creator());
+                name = "LocalFileSystem (mmap)";
+            }
+            else if (1 == fsType) {
+                ioSetup.FileSystems.Add("file", [] {
+                    return AsyncFileSystem::Create(AsyncFileSystem::Backend::ThreadPool);
+                });
+                name = "AsyncFileSystem (ThreadPool)";
+            }
+            else {
+                ioSetup.FileSystems.Add("file", [] {
+                    return AsyncFileSystem::Create(AsyncFileSystem::Backend::IoUring);
+                });
+                name = "AsyncFileSystem (IoUring)";
+            }
+            IO::Setup(ioSetup);
+
+            auto start = high_resolution_clock::now();
+            Array<Ptr<IOProtocol::Request>> reqs;
+            reqs.Reserve(numFiles);
+            for (int32 i = 0; i < numFiles; i++) {
+                strBuilder.Format(128, "file:///tmp/oryol_asyncfs_bench/%d.bin", i);
+                reqs.Add(IO::LoadFile(strBuilder.GetString(), i));
+            }
+            int32 numHandled = 0;
+            int32 numOk = 0;
+            while (numHandled < numFiles) {
+                Core::PreRunLoop()->Run();
+                while ((numHandled < numFiles) && reqs[numHandled]->Handled()) {
+                    numOk += (IOStatus::OK == reqs[numHandled]->GetStatus()) ? 1 : 0;
+                    numHandled++;
+                }
+            }
+            duration<double> dur = high_resolution_clock::now() - start;
+            CHECK(numOk == numFiles);
+            Log::Info("%d files, %d lanes, %-30s %8.2f ms\n", numFiles, numLanes, name, dur.count() * 1000.0);
+            reqs.Clear();
+            IO::Discard();
+        }
+    }
+
+    for (int32 i = 0; i < numFiles; i++) {
+        strBuilder.Format(128, "/tmp/oryol_asyncfs_bench/%d.bin", i);
+        std::remove(strBuilder.AsCStr());
+    }
+    rmdir("/tmp/oryol_asyncfs_bench");
+}
+#endif
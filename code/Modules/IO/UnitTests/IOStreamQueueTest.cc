@@ -0,0 +1,233 @@
+//------------------------------------------------------------------------------
+//  IOStreamQueueTest.cc
+//  Test chunked loading through IOStreamQueue.
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "UnitTest++/src/UnitTest++.h"
+#include "IO/IO.h"
+#include "IO/Core/IOStreamQueue.h"
+#include "IO/FS/LocalFileSystem.h"
+#include "IO/Stream/MemoryStream.h"
+#include "Core/Core.h"
+#include "Core/RunLoop.h"
+#include <cstdio>
+
+using namespace Oryol;
+
+//------------------------------------------------------------------------------
+static uint8
+patternByte(int32 offset) {
+    return uint8((offset * 7) ^ (offset >> 8));
+}
+
+//------------------------------------------------------------------------------
+static int32
+fileSizeFromURL(const URL& url) {
+    // the file size is the URL path, e.g. range://host/10000
+    const String path = url.Path();
+    int32 size = 0;
+    for (const char* p = path.AsCStr(); *p; p++) {
+        size = size * 10 + (*p - '0');
+    }
+    return size;
+}
+
+// serves byte ranges of a generated file, like a HTTP server would
+class RangeFileSystem : public FileSystem {
+    OryolClassDecl(RangeFileSystem);
+    OryolClassCreator(RangeFileSystem);
+public:
+    virtual void onRequest(const Ptr<IOProtocol::Request>& msg) {
+        const int32 fileSize = fileSizeFromURL(msg->GetURL());
+        const int32 start = msg->GetStartOffset();
+        int32 end = fileSize - 1;
+        if ((0 != msg->GetEndOffset()) && (msg->GetEndOffset() < end)) {
+            end = msg->GetEndOffset();
+        }
+        if (start >= fileSize) {
+            msg->SetStatus(IOStatus::RequestedRangeNotSatisfiable);
+        }
+        else {
+            Ptr<MemoryStream> stream = MemoryStream::Create();
+            stream->Open(OpenMode::WriteOnly);
+            uint8* ptr = stream->MapWrite(end - start + 1);
+            for (int32 i = start; i <= end; i++) {
+                *ptr++ = patternByte(i);
+            }
+            stream->UnmapWrite();
+            stream->Close();
+            msg->SetStream(stream);
+            msg->SetStatus(IOStatus::PartialContent);
+        }
+        msg->SetHandled();
+    };
+};
+OryolClassImpl(RangeFileSystem);
+
+// ignores byte ranges and always returns the whole file
+class WholeFileSystem : public FileSystem {
+    OryolClassDecl(WholeFileSystem);
+    OryolClassCreator(WholeFileSystem);
+public:
+    virtual void onRequest(const Ptr<IOProtocol::Request>& msg) {
+        const int32 fileSize = fileSizeFromURL(msg->GetURL());
+        Ptr<MemoryStream> stream = MemoryStream::Create();
+        stream->Open(OpenMode::WriteOnly);
+        uint8* ptr = stream->MapWrite(fileSize);
+        for (int32 i = 0; i < fileSize; i++) {
+            *ptr++ = patternByte(i);
+        }
+        stream->UnmapWrite();
+        stream->Close();
+        msg->SetStream(stream);
+        msg->SetStatus(IOStatus::OK);
+        msg->SetHandled();
+    };
+};
+OryolClassImpl(WholeFileSystem);
+
+//------------------------------------------------------------------------------
+struct chunkResult {
+    int32 numChunks = 0;
+    int32 numLast = 0;
+    int32 numBytes = 0;
+    bool inOrder = true;
+    bool contentOk = true;
+    IOStatus::Code failStatus = IOStatus::InvalidIOStatus;
+};
+
+//------------------------------------------------------------------------------
+static void
+addStream(IOStreamQueue& queue, const URL& url, int32 chunkSize, chunkResult& result) {
+    queue.Add(url, chunkSize, [&result](const Ptr<Stream>& chunk, int32 offset, bool isLast) {
+        result.inOrder &= (offset == result.numBytes) && (0 == result.numLast);
+        chunk->Open(OpenMode::ReadOnly);
+        const uint8* maxPtr = nullptr;
+        const uint8* ptr = chunk->MapRead(&maxPtr);
+        const int32 size = chunk->Size();
+        for (int32 i = 0; i < size; i++) {
+            result.contentOk &= ptr[i] == patternByte(offset + i);
+        }
+        chunk->UnmapRead();
+        chunk->Close();
+        result.numChunks++;
+        result.numBytes += size;
+        result.numLast += isLast ? 1 : 0;
+    },
+    [&result](const URL& url, IOStatus::Code ioStatus) {
+        result.failStatus = ioStatus;
+    });
+}
+
+//------------------------------------------------------------------------------
+TEST(IOStreamQueueTest) {
+    IOSetup ioSetup;
+    ioSetup.NumIOLanes = 2;
+    ioSetup.LanePolicy = IOLanePolicy::LeastLoaded;
+    ioSetup.FileSystems.Add("range", RangeFileSystem::Creator());
+    ioSetup.FileSystems.Add("whole", WholeFileSystem::Creator());
+    IO::Setup(ioSetup);
+
+    IOStreamQueue queue;
+    CHECK(queue.GetMaxChunksInFlight() == IOStreamQueue::DefaultMaxChunksInFlight);
+    queue.SetMaxChunksInFlight(3);
+    queue.Start();
+    chunkResult result0, result1, result2, result3;
+    addStream(queue, "range://host/100000", 4096, result0);
+    addStream(queue, "range://host/8192", 4096, result1);
+    addStream(queue, "whole://host/5000", 1024, result2);
+    addStream(queue, "range://host/100", 4096, result3);
+    CHECK(!queue.Empty());
+
+    // never more than 3 chunk requests per file in flight, the IO lanes
+    // see a request as completed one frame later, so allow for twice
+    // as many outstanding requests
+    int32 maxInFlight = 0;
+    while (!queue.Empty()) {
+        Core::PreRunLoop()->Run();
+        int32 numInFlight = IO::NumPendingRequests();
+        for (int32 i = 0; i < IO::NumLanes(); i++) {
+            numInFlight += IO::GetLaneStats(i).QueueDepth;
+        }
+        if (numInFlight > maxInFlight) {
+            maxInFlight = numInFlight;
+        }
+    }
+    CHECK(maxInFlight <= 4 * 3 * 2);
+    queue.Stop();
+
+    // 100000 bytes in 4096 byte chunks
+    CHECK(result0.numChunks == 25);
+    CHECK(result0.numBytes == 100000);
+    CHECK(result0.numLast == 1);
+    CHECK(result0.inOrder);
+    CHECK(result0.contentOk);
+
+    // size is a multiple of chunk size, last chunk is empty
+    CHECK(result1.numChunks == 3);
+    CHECK(result1.numBytes == 8192);
+    CHECK(result1.numLast == 1);
+    CHECK(result1.inOrder);
+
+    // filesystem without range support, whole file in one chunk
+    CHECK(result2.numChunks == 1);
+    CHECK(result2.numBytes == 5000);
+    CHECK(result2.numLast == 1);
+    CHECK(result2.contentOk);
+
+    // file smaller than chunk
+    CHECK(result3.numChunks == 1);
+    CHECK(result3.numBytes == 100);
+    CHECK(result3.numLast == 1);
+
+    // failed loads
+    IO::Discard();
+    IO::Setup(ioSetup);
+    queue.Start();
+    chunkResult result5;
+    addStream(queue, "range://host/0", 4096, result5);
+    while (!queue.Empty()) {
+        Core::PreRunLoop()->Run();
+    }
+    queue.Stop();
+    CHECK(result5.numChunks == 0);
+    CHECK(result5.failStatus == IOStatus::RequestedRangeNotSatisfiable);
+    IO::Discard();
+}
+
+//------------------------------------------------------------------------------
+#if ORYOL_POSIX
+TEST(IOStreamQueueLocalFileSystemTest) {
+    const int32 fileSize = 300000;
+    FILE* fp = std::fopen("/tmp/oryol_streamqueue_test.bin", "wb");
+    CHECK(nullptr != fp);
+    for (int32 i = 0; i < fileSize; i++) {
+        std::fputc(patternByte(i), fp);
+    }
+    std::fclose(fp);
+
+    IOSetup ioSetup;
+    ioSetup.FileSystems.Add("file", LocalFileSystem::Creator());
+    IO::Setup(ioSetup);
+    IOStreamQueue queue;
+    queue.Start();
+    chunkResult result0, result1;
+    addStream(queue, "file:///tmp/oryol_streamqueue_test.bin", 65536, result0);
+    addStream(queue, "file:///tmp/oryol_does_not_exist.bin", 65536, result1);
+    while (!queue.Empty()) {
+        Core::PreRunLoop()->Run();
+    }
+    queue.Stop();
+    IO::Discard();
+    std::remove("/tmp/oryol_streamqueue_test.bin");
+
+    CHECK(result0.numChunks == 5);
+    CHECK(result0.numBytes == fileSize);
+    CHECK(result0.numLast == 1);
+    CHECK(result0.inOrder);
+    CHECK(result0.contentOk);
+    CHECK(result0.failStatus == IOStatus::InvalidIOStatus);
+    CHECK(result1.numChunks == 0);
+    CHECK(result1.failStatus == IOStatus::NotFound);
+}
+#endif
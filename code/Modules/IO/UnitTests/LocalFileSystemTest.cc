@@ -0,0 +1,74 @@
+//------------------------------------------------------------------------------
+//  LocalFileSystemTest.cc
+//  Test loading through the file:// filesystem.
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "UnitTest++/src/UnitTest++.h"
+#include "IO/IO.h"
+#include "IO/FS/LocalFileSystem.h"
+#include "Core/Core.h"
+#include "Core/RunLoop.h"
+#include <cstdio>
+#include <cstring>
+
+using namespace Oryol;
+
+TEST(LocalFileSystemTest) {
+
+    #if ORYOL_WINDOWS
+    CHECK(LocalFileSystem::NativePath(URL("file:///C:/bla/blub.txt")) == "C:/bla/blub.txt");
+    #else
+    CHECK(LocalFileSystem::NativePath(URL("file:///tmp/blub.txt")) == "/tmp/blub.txt");
+    CHECK(LocalFileSystem::NativePath(URL("file://localhost/tmp/blub.txt")) == "/tmp/blub.txt");
+
+    // write a test file
+    const char* content = "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+    FILE* fp = std::fopen("/tmp/oryol_localfs_test.txt", "wb");
+    CHECK(nullptr != fp);
+    std::fwrite(content, 1, 26, fp);
+    std::fclose(fp);
+
+    IOSetup ioSetup;
+    ioSetup.FileSystems.Add("file", LocalFileSystem::Creator());
+    IO::Setup(ioSetup);
+
+    // load the whole file, and a range of the file
+    Ptr<IOProtocol::Request> req0 = IO::LoadFile("file:///tmp/oryol_localfs_test.txt");
+    Ptr<IOProtocol::Request> req1 = IOProtocol::Request::Create();
+    req1->SetURL("file:///tmp/oryol_localfs_test.txt");
+    req1->SetStartOffset(10);
+    req1->SetEndOffset(14);
+    IO::Put(req1);
+    Ptr<IOProtocol::Request> req2 = IO::LoadFile("file:///tmp/oryol_does_not_exist.txt");
+    while (!(req0->Handled() && req1->Handled() && req2->Handled())) {
+        Core::PreRunLoop()->Run();
+    }
+
+    CHECK(req0->GetStatus() == IOStatus::OK);
+    const Ptr<Stream>& stream0 = req0->GetStream();
+    CHECK(stream0->Size() == 26);
+    stream0->Open(OpenMode::ReadOnly);
+    const uint8* maxPtr = nullptr;
+    const uint8* ptr = stream0->MapRead(&maxPtr);
+    CHECK((maxPtr - ptr) == 26);
+    CHECK(0 == std::memcmp(ptr, content, 26));
+    stream0->UnmapRead();
+    stream0->Close();
+
+    CHECK(req1->GetStatus() == IOStatus::OK);
+    const Ptr<Stream>& stream1 = req1->GetStream();
+    CHECK(stream1->Size() == 5);
+    stream1->Open(OpenMode::ReadOnly);
+    ptr = stream1->MapRead(&maxPtr);
+    CHECK((maxPtr - ptr) == 5);
+    CHECK(0 == std::memcmp(ptr, "KLMNO", 5));
+    stream1->UnmapRead();
+    stream1->Close();
+
+    CHECK(req2->GetStatus() == IOStatus::NotFound);
+    CHECK(!req2->GetStream().isValid());
+
+    IO::Discard();
+    std::remove("/tmp/oryol_localfs_test.txt");
+    #endif
+}
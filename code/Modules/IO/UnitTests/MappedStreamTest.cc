@@ -0,0 +1,82 @@
+//------------------------------------------------------------------------------
+//  MappedStreamTest.cc
+//  Test memory-mapped read-only streams.
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "UnitTest++/src/UnitTest++.h"
+#include "IO/Stream/MappedStream.h"
+#include <cstdio>
+#include <cstring>
+
+using namespace Oryol;
+
+TEST(MappedStreamTest) {
+
+    // write a test file which is bigger than a page
+    const char* path = "oryol_mappedstream_test.bin";
+    const int32 fileSize = 10000;
+    uint8 content[fileSize];
+    for (int32 i = 0; i < fileSize; i++) {
+        content[i] = uint8(i * 7);
+    }
+    FILE* fp = std::fopen(path, "wb");
+    CHECK(nullptr != fp);
+    std::fwrite(content, 1, fileSize, fp);
+    std::fclose(fp);
+
+    // map the whole file
+    Ptr<MappedStream> stream = MappedStream::Create();
+    CHECK(stream->MapFile(path) == IOStatus::OK);
+    CHECK(stream->Size() == fileSize);
+    CHECK(stream->Open(OpenMode::ReadOnly));
+    const uint8* maxValidPtr = nullptr;
+    const uint8* ptr = stream->MapRead(&maxValidPtr);
+    CHECK(nullptr != ptr);
+    CHECK(maxValidPtr == ptr + fileSize);
+    CHECK(0 == std::memcmp(ptr, content, fileSize));
+    stream->UnmapRead();
+    uint8 buf[64];
+    stream->SetReadPosition(100);
+    CHECK(stream->Read(buf, sizeof(buf)) == 64);
+    CHECK(0 == std::memcmp(buf, content + 100, 64));
+    CHECK(stream->GetReadPosition() == 164);
+    stream->SetReadPosition(fileSize - 10);
+    CHECK(stream->Read(buf, sizeof(buf)) == 10);
+    CHECK(stream->IsEndOfStream());
+    CHECK(stream->MapRead(&maxValidPtr) == nullptr);
+    CHECK(maxValidPtr == nullptr);
+    stream->UnmapRead();
+    stream->Close();
+
+    // ranged mapping, not starting at a page boundary (EndOffset is inclusive)
+    CHECK(stream->MapFile(path, 5000, 5999) == IOStatus::OK);
+    CHECK(stream->Size() == 1000);
+    stream->Open(OpenMode::ReadOnly);
+    ptr = stream->MapRead(&maxValidPtr);
+    CHECK(maxValidPtr == ptr + 1000);
+    CHECK(0 == std::memcmp(ptr, content + 5000, 1000));
+    stream->UnmapRead();
+    stream->Close();
+
+    // range end past the end of file is clamped
+    CHECK(stream->MapFile(path, 9990, 20000) == IOStatus::OK);
+    CHECK(stream->Size() == 10);
+    stream->Open(OpenMode::ReadOnly);
+    CHECK(stream->Read(buf, EndOfStream) == 10);
+    CHECK(0 == std::memcmp(buf, content + 9990, 10));
+    stream->Close();
+
+    // invalid range and missing file
+    CHECK(stream->MapFile(path, 20000, 0) == IOStatus::RequestedRangeNotSatisfiable);
+    CHECK(stream->MapFile(path, 200, 100) == IOStatus::RequestedRangeNotSatisfiable);
+    CHECK(stream->Size() == 0);
+    CHECK(stream->MapFile("oryol_does_not_exist.bin") == IOStatus::NotFound);
+
+    // discarding the content releases the mapping
+    CHECK(stream->MapFile(path) == IOStatus::OK);
+    stream->DiscardContent();
+    CHECK(stream->Size() == 0);
+    CHECK(!stream->IsFileMapped());
+
+    std::remove(path);
+}
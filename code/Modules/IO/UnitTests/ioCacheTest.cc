@@ -0,0 +1,219 @@
+//------------------------------------------------------------------------------
+//  ioCacheTest.cc
+//  Test the IO stream cache.
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "UnitTest++/src/UnitTest++.h"
+#include "IO/FS/ioCache.h"
+#include "IO/IO.h"
+#include "IO/Stream/MemoryStream.h"
+#include "Core/Core.h"
+#include "Core/RunLoop.h"
+#include <atomic>
+#include <cstdio>
+
+using namespace Oryol;
+using namespace _priv;
+
+static std::atomic<int32> numCacheTestRequests{0};
+
+class CacheTestFileSystem : public FileSystem {
+    OryolClassDecl(CacheTestFileSystem);
+    OryolClassCreator(CacheTestFileSystem);
+public:
+    virtual void onRequest(const Ptr<IOProtocol::Request>& msg) {
+        numCacheTestRequests++;
+        Ptr<MemoryStream> stream = MemoryStream::Create();
+        stream->Open(OpenMode::WriteOnly);
+        stream->Write(msg->GetURL().AsCStr(), msg->GetURL().Get().Length());
+        stream->Close();
+        msg->SetStream(stream);
+        msg->SetStatus(IOStatus::OK);
+        msg->SetHandled();
+    };
+};
+OryolClassImpl(CacheTestFileSystem);
+
+//------------------------------------------------------------------------------
+static Ptr<Stream>
+makeStream(int32 size, uint8 val) {
+    Ptr<MemoryStream> stream = MemoryStream::Create();
+    stream->Open(OpenMode::WriteOnly);
+    uint8* ptr = stream->MapWrite(size);
+    for (int32 i = 0; i < size; i++) {
+        ptr[i] = val;
+    }
+    stream->UnmapWrite();
+    stream->Close();
+    return stream;
+}
+
+//------------------------------------------------------------------------------
+TEST(ioCacheTest) {
+    ioCache cache;
+    CHECK(!cache.IsValid());
+    cache.Setup(1000, String(), 0);
+    CHECK(cache.IsValid());
+
+    // miss, insert, hit
+    const URL url0("test://bla/0"), url1("test://bla/1"), url2("test://bla/2");
+    CHECK(!cache.Lookup(url0, 0, 0).isValid());
+    CHECK(cache.GetStats().Misses == 1);
+    Ptr<Stream> s0 = makeStream(400, 0);
+    cache.Insert(url0, 0, 0, s0);
+    CHECK(cache.GetStats().NumEntries == 1);
+    CHECK(cache.GetStats().NumBytes == 400);
+    CHECK(cache.Lookup(url0, 0, 0) == s0);
+    CHECK(cache.GetStats().Hits == 1);
+
+    // byte ranges are part of the key
+    CHECK(!cache.Lookup(url0, 10, 20).isValid());
+    Ptr<Stream> s0r = makeStream(11, 1);
+    cache.Insert(url0, 10, 20, s0r);
+    CHECK(cache.Lookup(url0, 10, 20) == s0r);
+    CHECK(cache.Lookup(url0, 0, 0) == s0);
+
+    // least recently used entries are evicted first
+    Ptr<Stream> s1 = makeStream(400, 1);
+    cache.Insert(url1, 0, 0, s1);
+    CHECK(cache.Lookup(url0, 0, 0) == s0);
+    Ptr<Stream> s2 = makeStream(400, 2);
+    cache.Insert(url2, 0, 0, s2);
+    CHECK(cache.GetStats().Evictions == 2);
+    CHECK(!cache.Lookup(url1, 0, 0).isValid());
+    CHECK(!cache.Lookup(url0, 10, 20).isValid());
+    CHECK(cache.Lookup(url0, 0, 0) == s0);
+    CHECK(cache.Lookup(url2, 0, 0) == s2);
+    CHECK(cache.GetStats().NumBytes == 800);
+
+    // too big for the cache
+    cache.Insert(url1, 0, 0, makeStream(2000, 1));
+    CHECK(!cache.Lookup(url1, 0, 0).isValid());
+    CHECK(cache.GetStats().NumEntries == 2);
+
+    // replace existing entry
+    Ptr<Stream> s2b = makeStream(100, 3);
+    cache.Insert(url2, 0, 0, s2b);
+    CHECK(cache.Lookup(url2, 0, 0) == s2b);
+    CHECK(cache.GetStats().NumBytes == 500);
+
+    cache.Clear();
+    CHECK(cache.GetStats().NumEntries == 0);
+    CHECK(cache.GetStats().NumBytes == 0);
+    CHECK(!cache.Lookup(url0, 0, 0).isValid());
+    cache.Discard();
+    CHECK(!cache.IsValid());
+}
+
+//------------------------------------------------------------------------------
+#if ORYOL_POSIX
+TEST(ioCacheDiskTierTest) {
+    ioCache cache;
+    cache.Setup(1000, "/tmp", 1 << 20);
+    const URL url0("test://bla/disk0"), url1("test://bla/disk1");
+    cache.Insert(url0, 0, 0, makeStream(600, 7));
+    cache.Insert(url1, 0, 0, makeStream(600, 8));
+    CHECK(cache.GetStats().Evictions == 1);
+    CHECK(cache.GetStats().NumDiskBytes > 600);
+
+    // the evicted entry comes back from disk, memory-mapped
+    Ptr<Stream> stream = cache.Lookup(url0, 0, 0);
+    CHECK(stream.isValid());
+    CHECK(cache.GetStats().DiskHits == 1);
+    CHECK(stream->Size() == 600);
+    stream->Open(OpenMode::ReadOnly);
+    const uint8* maxPtr = nullptr;
+    const uint8* ptr = stream->MapRead(&maxPtr);
+    bool allOk = (maxPtr - ptr) == 600;
+    for (int32 i = 0; i < 600; i++) {
+        allOk &= ptr[i] == 7;
+    }
+    CHECK(allOk);
+    stream->UnmapRead();
+    stream->Close();
+
+    // ...and pushes url1 to disk
+    CHECK(cache.GetStats().Evictions == 2);
+    CHECK(cache.Lookup(url1, 0, 0).isValid());
+    CHECK(cache.GetStats().DiskHits == 2);
+    CHECK(!cache.Lookup("test://bla/disk2", 0, 0).isValid());
+    CHECK(cache.GetStats().Misses == 1);
+    cache.Discard();
+
+    // a new cache finds the files of the previous session
+    cache.Setup(1000, "/tmp", 1 << 20);
+    CHECK(cache.Lookup(url0, 0, 0).isValid());
+    CHECK(cache.Lookup(url1, 0, 0).isValid());
+    CHECK(cache.GetStats().DiskHits == 2);
+    cache.Discard();
+
+    // with a tiny disk budget, the written files are removed again
+    cache.Setup(1000, "/tmp", 10);
+    cache.Insert(url0, 0, 0, makeStream(600, 7));
+    cache.Insert(url1, 0, 0, makeStream(600, 8));
+    cache.Insert(url0, 0, 0, makeStream(600, 7));
+    CHECK(cache.GetStats().DiskEvictions == 2);
+    CHECK(cache.GetStats().NumDiskBytes == 0);
+    cache.Discard();
+    cache.Setup(1000, "/tmp", 1 << 20);
+    CHECK(!cache.Lookup(url0, 0, 0).isValid());
+    CHECK(!cache.Lookup(url1, 0, 0).isValid());
+    cache.Discard();
+}
+#endif
+
+//------------------------------------------------------------------------------
+TEST(IOCacheFacadeTest) {
+    IOSetup ioSetup;
+    ioSetup.FileSystems.Add("ctest", CacheTestFileSystem::Creator());
+    ioSetup.CacheMaxBytes = 1<<20;
+    IO::Setup(ioSetup);
+
+    // first load goes to the filesystem
+    Ptr<IOProtocol::Request> req0 = IO::LoadFile("ctest://bla/blub.txt");
+    while (!req0->Handled()) {
+        Core::PreRunLoop()->Run();
+    }
+    CHECK(numCacheTestRequests == 1);
+    CHECK(IO::GetCacheStats().Misses == 1);
+
+    // the second is answered from the cache with the same stream
+    Ptr<IOProtocol::Request> req1 = IO::LoadFile("ctest://bla/blub.txt");
+    CHECK(req1->Handled());
+    CHECK(req1->GetStatus() == IOStatus::OK);
+    CHECK(req1->GetStream() == req0->GetStream());
+    CHECK(numCacheTestRequests == 1);
+    CHECK(IO::GetCacheStats().Hits == 1);
+
+    // CacheReadEnabled=false must go to the filesystem
+    Ptr<IOProtocol::Request> req2 = IOProtocol::Request::Create();
+    req2->SetURL("ctest://bla/blub.txt");
+    req2->SetCacheReadEnabled(false);
+    IO::Put(req2);
+    while (!req2->Handled()) {
+        Core::PreRunLoop()->Run();
+    }
+    CHECK(numCacheTestRequests == 2);
+    CHECK(req2->GetStream() != req0->GetStream());
+
+    // CacheWriteEnabled=false must not populate the cache
+    Ptr<IOProtocol::Request> req3 = IOProtocol::Request::Create();
+    req3->SetURL("ctest://bla/other.txt");
+    req3->SetCacheWriteEnabled(false);
+    IO::Put(req3);
+    while (!req3->Handled()) {
+        Core::PreRunLoop()->Run();
+    }
+    Core::PreRunLoop()->Run();
+    CHECK(numCacheTestRequests == 3);
+    Ptr<IOProtocol::Request> req4 = IO::LoadFile("ctest://bla/other.txt");
+    CHECK(!req4->Handled());
+    while (!req4->Handled()) {
+        Core::PreRunLoop()->Run();
+    }
+    CHECK(numCacheTestRequests == 4);
+
+    IO::ClearCache();
+    CHECK(IO::GetCacheStats().NumEntries == 0);
+    IO::Discard();
+}
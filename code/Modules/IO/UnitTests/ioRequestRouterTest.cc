@@ -0,0 +1,234 @@
+//------------------------------------------------------------------------------
+//  ioRequestRouterTest.cc
+//  Test IO lane scheduling and request priorities.
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "UnitTest++/src/UnitTest++.h"
+#include "IO/IO.h"
+#include "Core/Core.h"
+#include "Core/RunLoop.h"
+#include "Core/String/StringBuilder.h"
+#include <atomic>
+#include <mutex>
+
+using namespace Oryol;
+
+// records the order in which requests arrive, and handles them right away
+static std::mutex orderLock;
+static Array<String> requestOrder;
+
+class OrderFileSystem : public FileSystem {
+    OryolClassDecl(OrderFileSystem);
+    OryolClassCreator(OrderFileSystem);
+public:
+    virtual void onRequest(const Ptr<IOProtocol::Request>& msg) {
+        {
+            std::lock_guard<std::mutex> lock(orderLock);
+            requestOrder.Add(msg->GetURL().Path());
+        }
+        msg->SetStatus(IOStatus::OK);
+        msg->SetHandled();
+    };
+};
+OryolClassImpl(OrderFileSystem);
+
+// holds on to requests until the test thread handles them
+static std::mutex parkedLock;
+static Array<Ptr<IOProtocol::Request>> parkedRequests;
+static std::atomic<int32> numParked{0};
+
+class ParkFileSystem : public FileSystem {
+    OryolClassDecl(ParkFileSystem);
+    OryolClassCreator(ParkFileSystem);
+public:
+    virtual void onRequest(const Ptr<IOProtocol::Request>& msg) {
+        std::lock_guard<std::mutex> lock(parkedLock);
+        parkedRequests.Add(msg);
+        numParked++;
+    };
+};
+OryolClassImpl(ParkFileSystem);
+
+//------------------------------------------------------------------------------
+static URL
+makeURL(const char* fmt, int32 i) {
+    StringBuilder strBuilder;
+    strBuilder.Format(64, fmt, i);
+    return URL(strBuilder.GetString());
+}
+
+//------------------------------------------------------------------------------
+static void
+waitParked(int32 num) {
+    while (numParked < num) {
+        Core::PreRunLoop()->Run();
+    }
+}
+
+//------------------------------------------------------------------------------
+static void
+handleParked() {
+    std::lock_guard<std::mutex> lock(parkedLock);
+    for (const auto& req : parkedRequests) {
+        req->SetStatus(IOStatus::OK);
+        req->SetHandled();
+    }
+    parkedRequests.Clear();
+    numParked = 0;
+}
+
+//------------------------------------------------------------------------------
+static void
+waitIdle() {
+    bool busy = true;
+    while (busy) {
+        Core::PreRunLoop()->Run();
+        busy = IO::NumPendingRequests() > 0;
+        for (int32 i = 0; i < IO::NumLanes(); i++) {
+            busy |= IO::GetLaneStats(i).QueueDepth > 0;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+TEST(ioRequestRouterPriorityTest) {
+    IOSetup ioSetup;
+    ioSetup.NumIOLanes = 1;
+    ioSetup.MaxLaneDepth = 1;
+    ioSetup.CacheMaxBytes = 0;
+    IO::Setup(ioSetup);
+    IO::RegisterFileSystem("order", OrderFileSystem::Creator());
+    requestOrder.Clear();
+
+    // background requests, only one of them goes to the lane
+    Array<Ptr<IOProtocol::Request>> reqs;
+    for (int32 i = 0; i < 4; i++) {
+        reqs.Add(IO::LoadFile(makeURL("order://host/low%d", i), 0, IOPriority::Low));
+    }
+    CHECK(IO::NumPendingRequests() == 4);
+    Core::PreRunLoop()->Run();
+    CHECK(IO::NumPendingRequests() == 3);
+    CHECK(IO::GetLaneStats(0).QueueDepth == 1);
+
+    // an urgent request must overtake the waiting background requests
+    reqs.Add(IO::LoadFile(URL("order://host/high"), 0, IOPriority::High));
+    reqs.Add(IO::LoadFile(URL("order://host/normal"), 0, IOPriority::Normal));
+    waitIdle();
+    for (const auto& req : reqs) {
+        CHECK(req->Handled());
+        CHECK(req->GetActualLane() == 0);
+    }
+    CHECK(requestOrder.Size() == 6);
+    if (requestOrder.Size() == 6) {
+        CHECK(requestOrder[0] == "low0");
+        CHECK(requestOrder[1] == "high");
+        CHECK(requestOrder[2] == "normal");
+        CHECK(requestOrder[3] == "low1");
+        CHECK(requestOrder[4] == "low2");
+        CHECK(requestOrder[5] == "low3");
+    }
+    IOLaneStats stats = IO::GetLaneStats(0);
+    CHECK(stats.QueueDepth == 0);
+    CHECK(stats.NumCompleted == 6);
+    CHECK(stats.MaxLatency >= stats.AvgLatency);
+
+    // cancelled requests are dropped before they reach a lane
+    Ptr<IOProtocol::Request> req = IO::LoadFile(URL("order://host/cancelled"));
+    req->SetCancelled();
+    waitIdle();
+    CHECK(req->Handled());
+    CHECK(req->GetStatus() == IOStatus::Cancelled);
+    CHECK(requestOrder.Size() == 6);
+
+    IO::Discard();
+}
+
+//------------------------------------------------------------------------------
+TEST(ioRequestRouterLeastLoadedTest) {
+    IOSetup ioSetup;
+    ioSetup.NumIOLanes = 4;
+    ioSetup.LanePolicy = IOLanePolicy::LeastLoaded;
+    ioSetup.CacheMaxBytes = 0;
+    IO::Setup(ioSetup);
+    IO::RegisterFileSystem("park", ParkFileSystem::Creator());
+    CHECK(IO::NumLanes() == 4);
+
+    // requests all ask for lane 0, but are spread over all lanes
+    for (int32 i = 0; i < 8; i++) {
+        IO::LoadFile(makeURL("park://host/%d", i), 0);
+    }
+    waitParked(8);
+    for (int32 i = 0; i < 4; i++) {
+        CHECK(IO::GetLaneStats(i).QueueDepth == 2);
+    }
+    handleParked();
+    waitIdle();
+    for (int32 i = 0; i < 4; i++) {
+        const IOLaneStats stats = IO::GetLaneStats(i);
+        CHECK(stats.QueueDepth == 0);
+        CHECK(stats.NumCompleted == 2);
+        CHECK(stats.AvgLatency.AsTicks() > 0);
+    }
+
+    // a busy lane is avoided
+    IO::LoadFile(URL("park://host/busy"), 0);
+    waitParked(1);
+    for (int32 i = 0; i < 3; i++) {
+        IO::LoadFile(makeURL("park://host/other%d", i), 0);
+    }
+    waitParked(4);
+    for (int32 i = 0; i < 4; i++) {
+        CHECK(IO::GetLaneStats(i).QueueDepth == 1);
+    }
+    handleParked();
+    waitIdle();
+
+    IO::Discard();
+}
+
+//------------------------------------------------------------------------------
+TEST(ioRequestRouterAffinityTest) {
+    IOSetup ioSetup;
+    ioSetup.NumIOLanes = 4;
+    ioSetup.LanePolicy = IOLanePolicy::LeastLoaded;
+    ioSetup.CacheMaxBytes = 0;
+    ioSetup.LaneAffinity.Add("park", 0x3);
+    IO::Setup(ioSetup);
+    IO::RegisterFileSystem("park", ParkFileSystem::Creator());
+
+    // only lanes 0 and 1 may be used
+    for (int32 i = 0; i < 8; i++) {
+        IO::LoadFile(makeURL("park://host/%d", i), 3);
+    }
+    waitParked(8);
+    CHECK(IO::GetLaneStats(0).QueueDepth == 4);
+    CHECK(IO::GetLaneStats(1).QueueDepth == 4);
+    CHECK(IO::GetLaneStats(2).QueueDepth == 0);
+    CHECK(IO::GetLaneStats(3).QueueDepth == 0);
+    handleParked();
+    waitIdle();
+
+    // change the affinity at runtime
+    IO::SetLaneAffinity("park", 0x8);
+    Ptr<IOProtocol::Request> req = IO::LoadFile(URL("park://host/lane3"), 0);
+    waitParked(1);
+    CHECK(req->GetActualLane() == 3);
+    handleParked();
+    waitIdle();
+    IO::Discard();
+
+    // with the fixed policy, disallowed lanes are mapped to allowed lanes
+    ioSetup.LanePolicy = IOLanePolicy::Fixed;
+    IO::Setup(ioSetup);
+    IO::RegisterFileSystem("park", ParkFileSystem::Creator());
+    Ptr<IOProtocol::Request> req0 = IO::LoadFile(URL("park://host/a"), 1);
+    Ptr<IOProtocol::Request> req1 = IO::LoadFile(URL("park://host/b"), 3);
+    Ptr<IOProtocol::Request> req2 = IO::LoadFile(URL("park://host/c"), 2);
+    waitParked(3);
+    CHECK(req0->GetActualLane() == 1);
+    CHECK(req1->GetActualLane() == 1);
+    CHECK(req2->GetActualLane() == 0);
+    handleParked();
+    waitIdle();
+    IO::Discard();
+}
@@ -0,0 +1,246 @@
+//------------------------------------------------------------------------------
+//  ioUring.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "ioUring.h"
+#include "Core/Assertion.h"
+#include "Core/Memory/Memory.h"
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <cerrno>
+
+namespace Oryol {
+namespace _priv {
+
+//------------------------------------------------------------------------------
+ioUring::ioUring() :
+ringFd(-1),
+sqRing(nullptr),
+sqRingSize(0),
+cqRing(nullptr),
+cqRingSize(0),
+sqes(nullptr),
+sqesSize(0),
+sqHead(nullptr),
+sqTail(nullptr),
+sqArray(nullptr),
+sqMask(0),
+cqHead(nullptr),
+cqTail(nullptr),
+cqes(nullptr),
+cqMask(0),
+cqEntries(0),
+numInRing(0) {
+    // empty
+}
+
+//------------------------------------------------------------------------------
+ioUring::~ioUring() {
+    if (this->IsValid()) {
+        this->Discard();
+    }
+}
+
+//------------------------------------------------------------------------------
+bool
+ioUring::Setup(int32 queueDepth) {
+    o_assert(!this->IsValid());
+    o_assert(queueDepth > 0);
+
+    io_uring_params params;
+    Memory::Clear(&params, sizeof(params));
+    this->ringFd = int(syscall(__NR_io_uring_setup, uint32(queueDepth), &params));
+    if (this->ringFd < 0) {
+        this->ringFd = -1;
+        return false;
+    }
+
+    // check that plain reads are supported
+    const int32 numProbeOps = 256;
+    const int32 probeSize = sizeof(io_uring_probe) + numProbeOps * sizeof(io_uring_probe_op);
+    io_uring_probe* probe = (io_uring_probe*) Memory::Alloc(probeSize);
+    Memory::Clear(probe, probeSize);
+    const bool readSupported =
+        (syscall(__NR_io_uring_register, this->ringFd, IORING_REGISTER_PROBE, probe, numProbeOps) >= 0) &&
+        (probe->last_op >= IORING_OP_READ) &&
+        (0 != (probe->ops[IORING_OP_READ].flags & IO_URING_OP_SUPPORTED));
+    Memory::Free(probe);
+    if (!readSupported) {
+        this->release();
+        return false;
+    }
+
+    // map the submission and completion rings, and the submission entries
+    this->sqRingSize = params.sq_off.array + params.sq_entries * sizeof(uint32);
+    this->cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    const bool singleMmap = 0 != (params.features & IORING_FEAT_SINGLE_MMAP);
+    if (singleMmap && (this->cqRingSize > this->sqRingSize)) {
+        this->sqRingSize = this->cqRingSize;
+    }
+    void* ptr = mmap(nullptr, size_t(this->sqRingSize), PROT_READ|PROT_WRITE, MAP_SHARED|MAP_POPULATE, this->ringFd, IORING_OFF_SQ_RING);
+    if (MAP_FAILED == ptr) {
+        this->release();
+        return false;
+    }
+    this->sqRing = ptr;
+    if (singleMmap) {
+        this->cqRing = this->sqRing;
+        this->cqRingSize = 0;
+    }
+    else {
+        ptr = mmap(nullptr, size_t(this->cqRingSize), PROT_READ|PROT_WRITE, MAP_SHARED|MAP_POPULATE, this->ringFd, IORING_OFF_CQ_RING);
+        if (MAP_FAILED == ptr) {
+            this->release();
+            return false;
+        }
+        this->cqRing = ptr;
+    }
+    this->sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    ptr = mmap(nullptr, size_t(this->sqesSize), PROT_READ|PROT_WRITE, MAP_SHARED|MAP_POPULATE, this->ringFd, IORING_OFF_SQES);
+    if (MAP_FAILED == ptr) {
+        this->release();
+        return false;
+    }
+    this->sqes = ptr;
+
+    uint8* sq = (uint8*) this->sqRing;
+    this->sqHead  = (uint32*) (sq + params.sq_off.head);
+    this->sqTail  = (uint32*) (sq + params.sq_off.tail);
+    this->sqArray = (uint32*) (sq + params.sq_off.array);
+    this->sqMask  = *(uint32*) (sq + params.sq_off.ring_mask);
+    uint8* cq = (uint8*) this->cqRing;
+    this->cqHead  = (uint32*) (cq + params.cq_off.head);
+    this->cqTail  = (uint32*) (cq + params.cq_off.tail);
+    this->cqes    = cq + params.cq_off.cqes;
+    this->cqMask  = *(uint32*) (cq + params.cq_off.ring_mask);
+    this->cqEntries = params.cq_entries;
+    this->numInRing = 0;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+void
+ioUring::release() {
+    if (this->sqes) {
+        munmap(this->sqes, size_t(this->sqesSize));
+    }
+    if (this->cqRing && (this->cqRing != this->sqRing)) {
+        munmap(this->cqRing, size_t(this->cqRingSize));
+    }
+    if (this->sqRing) {
+        munmap(this->sqRing, size_t(this->sqRingSize));
+    }
+    if (this->ringFd >= 0) {
+        close(this->ringFd);
+    }
+    this->ringFd = -1;
+    this->sqRing = nullptr;
+    this->cqRing = nullptr;
+    this->sqes = nullptr;
+    this->sqHead = this->sqTail = this->sqArray = nullptr;
+    this->cqHead = this->cqTail = nullptr;
+    this->cqes = nullptr;
+}
+
+//------------------------------------------------------------------------------
+void
+ioUring::Discard() {
+    o_assert(this->IsValid());
+
+    // the kernel may still write into read buffers, wait for all
+    // reads in flight before the ring goes away
+    ioReadOp ops[64];
+    while (this->numInRing > 0) {
+        this->Flush();
+        if (0 == this->Reap(ops, 64)) {
+            syscall(__NR_io_uring_enter, this->ringFd, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+        }
+    }
+    this->backlog.Clear();
+    this->release();
+}
+
+//------------------------------------------------------------------------------
+bool
+ioUring::IsValid() const {
+    return this->ringFd >= 0;
+}
+
+//------------------------------------------------------------------------------
+void
+ioUring::Submit(const ioReadOp& op) {
+    o_assert_dbg(this->IsValid());
+    this->backlog.Enqueue(op);
+}
+
+//------------------------------------------------------------------------------
+/**
+ Moves reads from the backlog into the submission ring, and tells the
+ kernel about all entries it hasn't consumed yet. The number of reads
+ in the rings is kept below the completion ring size so that
+ completions never overflow.
+*/
+void
+ioUring::Flush() {
+    o_assert_dbg(this->IsValid());
+    io_uring_sqe* sqeArray = (io_uring_sqe*) this->sqes;
+    uint32 tail = *this->sqTail;
+    const uint32 head = __atomic_load_n(this->sqHead, __ATOMIC_ACQUIRE);
+    while (!this->backlog.Empty() &&
+           ((tail - head) <= this->sqMask) &&
+           (uint32(this->numInRing) < this->cqEntries)) {
+        const ioReadOp op = this->backlog.Dequeue();
+        const uint32 index = tail & this->sqMask;
+        io_uring_sqe* sqe = &sqeArray[index];
+        Memory::Clear(sqe, sizeof(io_uring_sqe));
+        sqe->opcode = IORING_OP_READ;
+        sqe->fd = op.fd;
+        sqe->addr = uint64(uintptr_t(op.dst));
+        sqe->len = uint32(op.numBytes);
+        sqe->off = uint64(op.offset);
+        sqe->user_data = (uint64(uint32(op.id)) << 32) | uint32(op.numBytes);
+        this->sqArray[index] = index;
+        tail++;
+        this->numInRing++;
+    }
+    __atomic_store_n(this->sqTail, tail, __ATOMIC_RELEASE);
+    const uint32 toSubmit = tail - __atomic_load_n(this->sqHead, __ATOMIC_ACQUIRE);
+    if (toSubmit > 0) {
+        // if the kernel is busy the entries stay in the ring until the next Flush()
+        syscall(__NR_io_uring_enter, this->ringFd, toSubmit, 0, 0, nullptr, 0);
+    }
+}
+
+//------------------------------------------------------------------------------
+int32
+ioUring::Reap(ioReadOp* outOps, int32 maxOps) {
+    o_assert_dbg(this->IsValid());
+    o_assert_dbg(outOps && (maxOps > 0));
+    const io_uring_cqe* cqeArray = (const io_uring_cqe*) this->cqes;
+    uint32 head = *this->cqHead;
+    const uint32 tail = __atomic_load_n(this->cqTail, __ATOMIC_ACQUIRE);
+    int32 num = 0;
+    while ((head != tail) && (num < maxOps)) {
+        const io_uring_cqe& cqe = cqeArray[head & this->cqMask];
+        ioReadOp& op = outOps[num++];
+        op = ioReadOp();
+        op.id = int32(cqe.user_data >> 32);
+        op.numBytes = int32(cqe.user_data & 0xFFFFFFFF);
+        op.result = cqe.res;
+        head++;
+    }
+    __atomic_store_n(this->cqHead, head, __ATOMIC_RELEASE);
+    this->numInRing -= num;
+    return num;
+}
+
+//------------------------------------------------------------------------------
+int32
+ioUring::NumInFlight() const {
+    return this->numInRing + this->backlog.Size();
+}
+
+} // namespace _priv
+} // namespace Oryol
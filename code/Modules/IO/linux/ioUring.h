@@ -0,0 +1,74 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::_priv::ioUring
+    @ingroup _priv
+    @brief private: asynchronous file reads through a Linux io_uring
+    @see AsyncFileSystem, preadThreadPool
+
+    Talks to the kernel directly through the io_uring syscalls (no liburing
+    dependency). Reads collected with Submit() are written into the
+    submission ring and handed to the kernel with a single
+    io_uring_enter() call in Flush(), completions are read from the
+    completion ring by Reap() without any syscall. Reads which don't fit
+    into the rings are held back until the next Flush().
+
+    Setup() returns false if the kernel doesn't support io_uring or
+    IORING_OP_READ (older than 5.6, or blocked by a seccomp filter),
+    in this case use the preadThreadPool.
+*/
+#include "Core/Containers/Queue.h"
+#include "IO/posix/ioReadOp.h"
+
+namespace Oryol {
+namespace _priv {
+
+class ioUring {
+public:
+    /// constructor
+    ioUring();
+    /// destructor
+    ~ioUring();
+
+    /// setup the rings, returns false if io_uring isn't available
+    bool Setup(int32 queueDepth);
+    /// wait for reads in flight and destroy the rings
+    void Discard();
+    /// return true if setup
+    bool IsValid() const;
+
+    /// queue a read, will be submitted by next Flush()
+    void Submit(const ioReadOp& op);
+    /// submit all queued reads to the kernel
+    void Flush();
+    /// get up to maxOps completed reads, returns number of completed reads
+    int32 Reap(ioReadOp* outOps, int32 maxOps);
+    /// number of submitted reads which haven't been reaped yet
+    int32 NumInFlight() const;
+
+private:
+    /// release ring memory and ring fd
+    void release();
+
+    int ringFd;
+    void* sqRing;
+    int64 sqRingSize;
+    void* cqRing;
+    int64 cqRingSize;
+    void* sqes;
+    int64 sqesSize;
+    uint32* sqHead;
+    uint32* sqTail;
+    uint32* sqArray;
+    uint32 sqMask;
+    uint32* cqHead;
+    uint32* cqTail;
+    void* cqes;
+    uint32 cqMask;
+    uint32 cqEntries;
+    int32 numInRing;
+    Queue<ioReadOp> backlog;
+};
+
+} // namespace _priv
+} // namespace Oryol
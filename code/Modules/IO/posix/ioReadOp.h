@@ -0,0 +1,30 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::_priv::ioReadOp
+    @ingroup _priv
+    @brief private: an asynchronous positional file read
+    @see preadThreadPool, ioUring
+
+    Describes one read of numBytes from a file descriptor at a file
+    offset into a destination buffer. The id is chosen by the caller
+    and handed back with the completion. Completions are only guaranteed
+    to carry the id, numBytes and the result, which is the number of bytes
+    read, or a negative errno code.
+*/
+#include "Core/Types.h"
+
+namespace Oryol {
+namespace _priv {
+
+struct ioReadOp {
+    int32 id = InvalidIndex;
+    int32 fd = -1;
+    uint8* dst = nullptr;
+    int64 offset = 0;
+    int32 numBytes = 0;
+    int32 result = 0;
+};
+
+} // namespace _priv
+} // namespace Oryol
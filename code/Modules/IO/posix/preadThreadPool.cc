@@ -0,0 +1,164 @@
+//------------------------------------------------------------------------------
+//  preadThreadPool.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "preadThreadPool.h"
+#include "Core/Assertion.h"
+#include <unistd.h>
+#include <cerrno>
+
+namespace Oryol {
+namespace _priv {
+
+//------------------------------------------------------------------------------
+preadThreadPool::preadThreadPool() :
+valid(false),
+numInFlight(0)
+#if ORYOL_HAS_THREADS
+, stopRequested(false)
+#endif
+{
+    // empty
+}
+
+//------------------------------------------------------------------------------
+preadThreadPool::~preadThreadPool() {
+    if (this->valid) {
+        this->Discard();
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+preadThreadPool::Setup(int32 numThreads) {
+    o_assert(!this->valid);
+    o_assert(numThreads > 0);
+    this->valid = true;
+    #if ORYOL_HAS_THREADS
+    this->stopRequested = false;
+    this->threads.Reserve(numThreads);
+    for (int32 i = 0; i < numThreads; i++) {
+        this->threads.Add(std::thread(workerFunc, this));
+    }
+    #endif
+}
+
+//------------------------------------------------------------------------------
+void
+preadThreadPool::Discard() {
+    o_assert(this->valid);
+    #if ORYOL_HAS_THREADS
+    {
+        // workers finish all queued reads before they stop
+        std::lock_guard<std::mutex> lock(this->workMutex);
+        this->stopRequested = true;
+    }
+    this->workAvailable.notify_all();
+    for (auto& thread : this->threads) {
+        thread.join();
+    }
+    this->threads.Clear();
+    #endif
+    this->submitQueue.Clear();
+    this->doneQueue.Clear();
+    this->numInFlight = 0;
+    this->valid = false;
+}
+
+//------------------------------------------------------------------------------
+bool
+preadThreadPool::IsValid() const {
+    return this->valid;
+}
+
+//------------------------------------------------------------------------------
+void
+preadThreadPool::read(ioReadOp& op) {
+    ssize_t res;
+    do {
+        res = pread(op.fd, op.dst, size_t(op.numBytes), off_t(op.offset));
+    }
+    while ((res < 0) && (EINTR == errno));
+    op.result = (res < 0) ? -errno : int32(res);
+}
+
+//------------------------------------------------------------------------------
+void
+preadThreadPool::Submit(const ioReadOp& op) {
+    o_assert_dbg(this->valid);
+    this->submitQueue.Enqueue(op);
+    this->numInFlight++;
+}
+
+//------------------------------------------------------------------------------
+void
+preadThreadPool::Flush() {
+    o_assert_dbg(this->valid);
+    if (this->submitQueue.Empty()) {
+        return;
+    }
+    #if ORYOL_HAS_THREADS
+    {
+        std::lock_guard<std::mutex> lock(this->workMutex);
+        while (!this->submitQueue.Empty()) {
+            this->workQueue.Enqueue(this->submitQueue.Dequeue());
+        }
+    }
+    this->workAvailable.notify_all();
+    #else
+    while (!this->submitQueue.Empty()) {
+        ioReadOp op = this->submitQueue.Dequeue();
+        read(op);
+        this->doneQueue.Enqueue(op);
+    }
+    #endif
+}
+
+//------------------------------------------------------------------------------
+int32
+preadThreadPool::Reap(ioReadOp* outOps, int32 maxOps) {
+    o_assert_dbg(this->valid);
+    o_assert_dbg(outOps && (maxOps > 0));
+    int32 num = 0;
+    #if ORYOL_HAS_THREADS
+    std::lock_guard<std::mutex> lock(this->doneMutex);
+    #endif
+    while ((num < maxOps) && !this->doneQueue.Empty()) {
+        outOps[num++] = this->doneQueue.Dequeue();
+    }
+    this->numInFlight -= num;
+    return num;
+}
+
+//------------------------------------------------------------------------------
+int32
+preadThreadPool::NumInFlight() const {
+    return this->numInFlight;
+}
+
+//------------------------------------------------------------------------------
+#if ORYOL_HAS_THREADS
+void
+preadThreadPool::workerFunc(preadThreadPool* self) {
+    while (true) {
+        ioReadOp op;
+        {
+            std::unique_lock<std::mutex> lock(self->workMutex);
+            self->workAvailable.wait(lock, [self] {
+                return self->stopRequested || !self->workQueue.Empty();
+            });
+            if (self->workQueue.Empty()) {
+                // stop requested and no more work
+                return;
+            }
+            op = self->workQueue.Dequeue();
+        }
+        read(op);
+        std::lock_guard<std::mutex> lock(self->doneMutex);
+        self->doneQueue.Enqueue(op);
+    }
+}
+#endif
+
+} // namespace _priv
+} // namespace Oryol
@@ -0,0 +1,73 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::_priv::preadThreadPool
+    @ingroup _priv
+    @brief private: asynchronous file reads with pread() on worker threads
+    @see AsyncFileSystem, ioUring
+
+    Portable fallback for ioUring. Reads are collected with Submit(),
+    handed to a small pool of worker threads in one go with Flush(),
+    and completed reads are picked up (in completion order) with Reap().
+    Submit(), Flush() and Reap() must be called from the same thread.
+    Without threads, Flush() performs the reads right away.
+*/
+#include "Core/Containers/Array.h"
+#include "Core/Containers/Queue.h"
+#include "IO/posix/ioReadOp.h"
+#if ORYOL_HAS_THREADS
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#endif
+
+namespace Oryol {
+namespace _priv {
+
+class preadThreadPool {
+public:
+    /// constructor
+    preadThreadPool();
+    /// destructor
+    ~preadThreadPool();
+
+    /// start the worker threads
+    void Setup(int32 numThreads);
+    /// wait for reads in flight and stop the worker threads
+    void Discard();
+    /// return true if setup
+    bool IsValid() const;
+
+    /// queue a read, will be started by next Flush()
+    void Submit(const ioReadOp& op);
+    /// start all queued reads
+    void Flush();
+    /// get up to maxOps completed reads, returns number of completed reads
+    int32 Reap(ioReadOp* outOps, int32 maxOps);
+    /// number of submitted reads which haven't been reaped yet
+    int32 NumInFlight() const;
+
+private:
+    /// perform a blocking read, sets op.result
+    static void read(ioReadOp& op);
+    #if ORYOL_HAS_THREADS
+    /// worker thread function
+    static void workerFunc(preadThreadPool* self);
+    #endif
+
+    bool valid;
+    int32 numInFlight;
+    Queue<ioReadOp> submitQueue;
+    Queue<ioReadOp> doneQueue;
+    #if ORYOL_HAS_THREADS
+    Array<std::thread> threads;
+    Queue<ioReadOp> workQueue;
+    std::mutex workMutex;
+    std::condition_variable workAvailable;
+    std::mutex doneMutex;
+    bool stopRequested;
+    #endif
+};
+
+} // namespace _priv
+} // namespace Oryol
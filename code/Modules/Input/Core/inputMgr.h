@@ -5,7 +5,13 @@
     @ingroup _priv
     @brief frontend inputMgr class
 */
-#if (ORYOL_WINDOWS || ORYOL_MACOS || ORYOL_LINUX)
+#if ORYOL_GFX_NULL
+#include "Input/base/inputMgrBase.h"
+namespace Oryol {
+namespace _priv {
+class inputMgr : public inputMgrBase { };
+} }
+#elif (ORYOL_WINDOWS || ORYOL_MACOS || ORYOL_LINUX)
 #include "Input/glfw/glfwInputMgr.h"
 namespace Oryol {
 namespace _priv {
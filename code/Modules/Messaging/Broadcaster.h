@@ -9,6 +9,7 @@
     of subscriber Ports.
 */
 #include "Messaging/Port.h"
+#include "Core/Containers/Array.h"
 
 namespace Oryol {
     
@@ -20,9 +20,35 @@ Message::IsMemberOf(ProtocolIdType protId) const {
 }
 
 //------------------------------------------------------------------------------
+/**
+ The handled-function is called before the handled state is published,
+ so that Handled() only returns true once all work on the handler's
+ side has finished.
+*/
 void
 Message::SetHandled() {
+    if (this->handledFunc) {
+        this->handledFunc();
+    }
+    #if ORYOL_HAS_ATOMIC
+    this->handled.store(true, std::memory_order_release);
+    #else
     this->handled = true;
+    #endif
+}
+
+//------------------------------------------------------------------------------
+/**
+ The handled-function must be set before the message is handed to
+ its handler, it is called from whatever thread the message is handled
+ on, and must be thread-safe. Can be used to get notified about
+ completed messages instead of polling Handled(). Handled() still
+ returns false while the handled-function is running.
+*/
+void
+Message::SetHandledFunc(HandledFunc func) {
+    o_assert_dbg(!this->handled);
+    this->handledFunc = func;
 }
 
 //------------------------------------------------------------------------------
@@ -34,13 +60,17 @@ Message::SetCancelled() {
 //------------------------------------------------------------------------------
 bool
 Message::Pending() const {
-    return !this->handled;
+    return !this->Handled();
 }
 
 //------------------------------------------------------------------------------
 bool
 Message::Handled() const {
+    #if ORYOL_HAS_ATOMIC
+    return this->handled.load(std::memory_order_acquire);
+    #else
     return this->handled;
+    #endif
 }
 
 //------------------------------------------------------------------------------
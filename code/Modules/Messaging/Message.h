@@ -8,6 +8,7 @@
 #include "Core/Config.h"
 #include "Core/RefCounted.h"
 #include "Messaging/Types.h"
+#include <functional>
 
 namespace Oryol {
 
@@ -25,8 +26,13 @@ public:
     static MessageIdType ClassMessageId();
     /// get the object message id
     MessageIdType MessageId() const;
+    /// function which is called when the message has been handled
+    typedef std::function<void()> HandledFunc;
+
     /// set message to Handled state
     void SetHandled();
+    /// set optional function called by SetHandled() (on the handler's thread!)
+    void SetHandledFunc(HandledFunc func);
     /// cancel the message
     void SetCancelled();
     /// return true if the message is in Pending state
@@ -45,6 +51,7 @@ public:
 
 protected:
     MessageIdType msgId;
+    HandledFunc handledFunc;
     #if ORYOL_HAS_ATOMIC
     std::atomic<bool> handled;
     std::atomic<bool> cancelled;
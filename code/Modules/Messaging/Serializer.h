@@ -11,6 +11,7 @@
 */
 #include <string.h>
 #include "Core/Types.h"
+#include "Core/Containers/Array.h"
 #include "Core/String/String.h"
 #include "Core/String/StringAtom.h"
 
@@ -17,6 +17,10 @@ OryolClassPoolAllocImpl(ThreadedQueue);
 */
 ThreadedQueue::ThreadedQueue() :
 tickDuration(0),
+numWakeupSpins(0),
+transportMode(TransportMode::Locked),
+ringCapacity(DefaultRingCapacity),
+tickRequested(false),
 threadStarted(false),
 threadStopRequested(false),
 threadStopped(false) {
@@ -28,6 +32,10 @@ threadStopped(false) {
 //------------------------------------------------------------------------------
 ThreadedQueue::ThreadedQueue(const Ptr<Port>& port_) :
 tickDuration(0),
+numWakeupSpins(0),
+transportMode(TransportMode::Locked),
+ringCapacity(DefaultRingCapacity),
+tickRequested(false),
 forwardingPort(port_),
 threadStarted(false),
 threadStopRequested(false),
@@ -63,11 +71,55 @@ ThreadedQueue::GetTickDuration() const {
     return this->tickDuration;
 }
 
+//------------------------------------------------------------------------------
+/**
+ Select how messages are transported from Put() to the worker thread,
+ see the class description for details. This cannot be changed once
+ the thread has been started.
+*/
+void
+ThreadedQueue::SetTransportMode(TransportMode::Code mode) {
+    o_assert(!this->threadStarted);
+    this->transportMode = mode;
+}
+
+//------------------------------------------------------------------------------
+ThreadedQueue::TransportMode::Code
+ThreadedQueue::GetTransportMode() const {
+    return this->transportMode;
+}
+
+//------------------------------------------------------------------------------
+/**
+ The ring capacity is the max number of messages in flight between
+ the senders and the worker thread in LockFree transport mode, if the
+ ring is full, Put() will wait for the worker thread.
+*/
+void
+ThreadedQueue::SetRingCapacity(int32 numMessages) {
+    o_assert(!this->threadStarted);
+    o_assert((numMessages >= 2) && (0 == (numMessages & (numMessages - 1))));
+    this->ringCapacity = numMessages;
+}
+
+//------------------------------------------------------------------------------
+int32
+ThreadedQueue::GetRingCapacity() const {
+    return this->ringCapacity;
+}
+
 //------------------------------------------------------------------------------
 void
 ThreadedQueue::StartThread() {
     o_assert(this->isCreateThread());
     o_assert(!this->threadStarted);
+    if (TransportMode::LockFree == this->transportMode) {
+        this->ring.Setup(this->ringCapacity);
+        // spinning only makes sense if producers can run in parallel
+        #if ORYOL_HAS_THREADS
+        this->numWakeupSpins = std::thread::hardware_concurrency() > 1 ? MaxWakeupSpins : 0;
+        #endif
+    }
     #if ORYOL_HAS_THREADS
         this->thread = std::thread(threadFunc, this);
     #else
@@ -83,6 +135,7 @@ ThreadedQueue::StopThread() {
     this->threadStopRequested = true;
     #if ORYOL_HAS_THREADS
         this->wakeup.notify_one();
+        this->ringWakeup.Signal();
         this->thread.join();
     #else
         this->onThreadLeave();
@@ -93,10 +146,26 @@ ThreadedQueue::StopThread() {
 //------------------------------------------------------------------------------
 bool
 ThreadedQueue::Put(const Ptr<Message>& msg) {
-    o_assert(this->isCreateThread());
     o_assert(this->threadStarted);
     o_assert(!this->threadStopped);
-    this->writeQueue.Enqueue(msg);
+    if (TransportMode::LockFree == this->transportMode) {
+        Ptr<Message> m(msg);
+        while (!this->ring.Enqueue(std::move(m))) {
+            // ring is full, wait until the worker thread made room
+            #if ORYOL_HAS_THREADS
+                o_assert_dbg(!this->isWorkerThread());
+                this->ringWakeup.Signal();
+                std::this_thread::yield();
+            #else
+                this->drainRing();
+            #endif
+        }
+        this->ringWakeup.Signal();
+    }
+    else {
+        o_assert(this->isCreateThread());
+        this->writeQueue.Enqueue(msg);
+    }
     return true;
 }
 
@@ -107,6 +176,17 @@ ThreadedQueue::DoWork() {
     o_assert(this->isCreateThread());
     o_assert(this->threadStarted);
     o_assert(!this->threadStopped);
+    if (TransportMode::LockFree == this->transportMode) {
+        // messages are already in flight, only request a tick
+        #if ORYOL_HAS_THREADS
+            this->tickRequested.store(true, std::memory_order_relaxed);
+            this->ringWakeup.Signal();
+        #else
+            this->drainRing();
+            this->onTick();
+        #endif
+        return;
+    }
     if (!this->writeQueue.Empty()) {
         this->moveWriteToTransferQueue();
     }
@@ -182,6 +262,42 @@ ThreadedQueue::moveTransferToReadQueue() {
     #endif
 }
 
+//------------------------------------------------------------------------------
+/**
+ Called on the worker thread in LockFree transport mode when the ring
+ has been drained. Will busy-spin for a short while since new messages
+ often arrive in bursts, and then go to sleep until a producer signals,
+ a tick is requested through DoWork(), or the tick duration has passed.
+*/
+void
+ThreadedQueue::waitRing() {
+    o_assert_dbg(this->isWorkerThread());
+    for (int32 i = 0; i < this->numWakeupSpins; i++) {
+        if (!this->ring.Empty() || this->tickRequested || this->threadStopRequested) {
+            return;
+        }
+        _priv::wakeupEvent::Pause();
+    }
+    const uint32 key = this->ringWakeup.PrepareWait();
+    if (this->ring.Empty() && !this->tickRequested && !this->threadStopRequested) {
+        this->ringWakeup.CommitWait(key, this->tickDuration);
+    }
+    else {
+        this->ringWakeup.CancelWait();
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+ThreadedQueue::drainRing() {
+    o_assert_dbg(this->isWorkerThread());
+    Ptr<Message> msg;
+    while (this->ring.Dequeue(msg)) {
+        this->onMessage(msg);
+        msg.Invalidate();
+    }
+}
+
 //------------------------------------------------------------------------------
 #if ORYOL_HAS_THREADS
 void
@@ -196,6 +312,15 @@ ThreadedQueue::threadFunc(ThreadedQueue* self) {
     // and forwards them to the forwardingPort
     while (!self->threadStopRequested) {
 
+        if (TransportMode::LockFree == self->transportMode) {
+            // messages go directly through the lock-free ring
+            self->waitRing();
+            self->tickRequested.store(false, std::memory_order_relaxed);
+            self->drainRing();
+            self->onTick();
+            continue;
+        }
+
         // wait for messages to arrive, and if so, transfer to read queue
         std::unique_lock<std::mutex> lock(self->wakeupMutex);
         if (0 != self->tickDuration) {
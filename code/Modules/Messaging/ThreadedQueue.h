@@ -9,8 +9,13 @@
     a thread and forward messages to it. The forwarding port is running
     on the thread.
     
-    The ThreadedQueue port will try to minimize locking by using 3
-    internal queues: the write queue, the transfer queue and the read queue.
+    The ThreadedQueue has 2 transport modes how messages get from the
+    sender thread to the worker thread, the mode must be selected
+    before StartThread() is called:
+
+    TransportMode::Locked (the default) will try to minimize locking by
+    using 3 internal queues: the write queue, the transfer queue and
+    the read queue.
     
     Calling Put() will put a message on the write queue without locking.
     When DoWork() is called (usually once per frame), the sender thread
@@ -21,10 +26,22 @@
     process messages from the read queue without locking.  When the read queue
     is empty it will check the transfer queue for more messages, and if this
     is empty, go to sleep.
+
+    TransportMode::LockFree pushes messages into a bounded lock-free
+    multi-producer/single-consumer ring buffer. Put() may be called from
+    any thread, and messages are visible to the worker thread immediately
+    without waiting for the next DoWork(). The worker thread spins
+    for a short while when the ring runs empty before going to sleep
+    (on a futex on Linux), and producers only pay for a wakeup if the
+    worker is actually sleeping. When the ring is full, Put() will
+    block until the worker has made room.
 */
 #include "Core/Config.h"
 #include "Messaging/Port.h"
 #include "Core/Containers/Queue.h"
+#include "Core/Threading/mpscRingBuffer.h"
+#include "Core/Threading/wakeupEvent.h"
+#include <atomic>
 #if ORYOL_HAS_THREADS
 #include <thread>
 #include <mutex>
@@ -36,6 +53,18 @@ namespace Oryol {
 class ThreadedQueue : public Port {
     OryolClassPoolAllocDecl(ThreadedQueue);
 public:
+    /// message transport modes
+    class TransportMode {
+    public:
+        /// transport mode enum
+        enum Code {
+            Locked,         ///< write/transfer/read queues, Put() only from creator thread
+            LockFree,       ///< lock-free MPSC ring buffer, Put() from any thread
+        };
+    };
+    /// default ring capacity for TransportMode::LockFree
+    static const int32 DefaultRingCapacity = 4096;
+
     /// default constructor (must setup forwardingPort in subclass!)
     ThreadedQueue();
     /// constructor with forwarding port
@@ -47,6 +76,14 @@ public:
     void SetTickDuration(uint32 milliSecs);
     /// get optional tick-rate in millisecs
     uint32 GetTickDuration() const;
+    /// set the message transport mode (default is Locked)
+    void SetTransportMode(TransportMode::Code mode);
+    /// get the message transport mode
+    TransportMode::Code GetTransportMode() const;
+    /// set ring buffer capacity for LockFree transport mode (must be power of 2)
+    void SetRingCapacity(int32 numMessages);
+    /// get ring buffer capacity
+    int32 GetRingCapacity() const;
     /// start the handler thread, this cannot happen in the constructor
     virtual void StartThread();
     /// stop the handler thread, this cannot happen in the destructor
@@ -77,11 +114,24 @@ protected:
     void moveWriteToTransferQueue();
     /// move messages from transfer queue to read queue
     void moveTransferToReadQueue();
-    
+    /// spin, then sleep until the ring has messages, a tick is due or stop was requested
+    void waitRing();
+    /// forward all messages currently in the ring
+    void drainRing();
+
+    /// max number of spin iterations before the worker thread goes to sleep
+    static const int32 MaxWakeupSpins = 2048;
+
     uint32 tickDuration;
+    int32 numWakeupSpins;
+    TransportMode::Code transportMode;
+    int32 ringCapacity;
     Queue<Ptr<Message>> writeQueue;     // written by sender thread
     Queue<Ptr<Message>> transferQueue;  // written by sender, read by worker thread (locked)
     Queue<Ptr<Message>> readQueue;      // read by worker thread
+    _priv::mpscRingBuffer<Ptr<Message>> ring;   // written by any thread, read by worker thread
+    _priv::wakeupEvent ringWakeup;
+    std::atomic<bool> tickRequested;
     Ptr<Port> forwardingPort;                 // runs in thread!
     
     #if ORYOL_HAS_THREADS
@@ -93,7 +143,7 @@ protected:
     std::condition_variable wakeup;
     #endif
     bool threadStarted;
-    bool threadStopRequested;
+    std::atomic<bool> threadStopRequested;
     bool threadStopped;
 };
     
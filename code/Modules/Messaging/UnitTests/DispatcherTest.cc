@@ -73,4 +73,20 @@ TEST(DispatcherTest) {
     disp1 = 0;
 }
 
-
+TEST(MessageHandledFuncTest) {
+    // Handled() must only be true after the handled-function has returned
+    Ptr<TestProtocol::TestMsg1> msg = TestProtocol::TestMsg1::Create();
+    const TestProtocol::TestMsg1* rawMsg = msg.getUnsafe();
+    int32 numCalls = 0;
+    bool handledInFunc = true;
+    msg->SetHandledFunc([rawMsg, &numCalls, &handledInFunc]() {
+        handledInFunc = rawMsg->Handled();
+        numCalls++;
+    });
+    CHECK(msg->Pending());
+    msg->SetHandled();
+    CHECK(1 == numCalls);
+    CHECK(!handledInFunc);
+    CHECK(msg->Handled());
+    CHECK(!msg->Pending());
+}
@@ -77,3 +77,99 @@ TEST(ThreadedQueueTest) {
     threadedQueue = 0;
 }
 
+//------------------------------------------------------------------------------
+static void
+benchmarkTransport(ThreadedQueue::TransportMode::Code mode, const char* modeName) {
+
+    Ptr<Dispatcher<TestProtocol>> disp = Dispatcher<TestProtocol>::Create();
+    disp->Subscribe<TestProtocol::TestMsg1>(&HandleTestMsg1);
+    Ptr<ThreadedQueue> threadedQueue = ThreadedQueue::Create(disp);
+    threadedQueue->SetTransportMode(mode);
+    CHECK(threadedQueue->GetTransportMode() == mode);
+    threadedQueue->StartThread();
+
+    // throughput: 1000 bursts of 1000 messages
+    time_point<high_resolution_clock> start = high_resolution_clock::now();
+    value0 = 0;
+    for (int i = 0; i < 1000; i++) {
+        Ptr<TestProtocol::TestMsg1> msg;
+        for (int j = 0; j < 1000; j++) {
+            msg = TestProtocol::TestMsg1::Create();
+            threadedQueue->Put(msg);
+        }
+        while (!msg->Handled()) {
+            threadedQueue->DoWork();
+            std::this_thread::yield();
+        }
+    }
+    CHECK(value0 == 1000000);
+    duration<double> dur = high_resolution_clock::now() - start;
+    Log::Info("ThreadedQueue(%s): 1000000 msgs created and handled: %f sec\n", modeName, dur.count());
+
+    // latency: round-trip of single messages, DoWork() is called
+    // once per spin like a frame loop would do
+    const int numRoundTrips = 10000;
+    start = high_resolution_clock::now();
+    for (int i = 0; i < numRoundTrips; i++) {
+        Ptr<TestProtocol::TestMsg1> msg = TestProtocol::TestMsg1::Create();
+        threadedQueue->Put(msg);
+        while (!msg->Handled()) {
+            threadedQueue->DoWork();
+        }
+    }
+    dur = high_resolution_clock::now() - start;
+    Log::Info("ThreadedQueue(%s): avg round-trip latency: %f usec\n", modeName, (dur.count() * 1000000.0) / numRoundTrips);
+
+    threadedQueue->StopThread();
+    threadedQueue = 0;
+}
+
+//------------------------------------------------------------------------------
+TEST(ThreadedQueueTransportBenchmark) {
+    benchmarkTransport(ThreadedQueue::TransportMode::Locked, "Locked");
+    benchmarkTransport(ThreadedQueue::TransportMode::LockFree, "LockFree");
+}
+
+//------------------------------------------------------------------------------
+TEST(ThreadedQueueLockFreeMultiProducer) {
+
+    Ptr<Dispatcher<TestProtocol>> disp = Dispatcher<TestProtocol>::Create();
+    disp->Subscribe<TestProtocol::TestMsg1>(&HandleTestMsg1);
+    Ptr<ThreadedQueue> threadedQueue = ThreadedQueue::Create(disp);
+    threadedQueue->SetTransportMode(ThreadedQueue::TransportMode::LockFree);
+    threadedQueue->SetRingCapacity(256);
+    CHECK(threadedQueue->GetRingCapacity() == 256);
+    threadedQueue->StartThread();
+
+    // several producer threads put messages concurrently into a small
+    // ring, this also exercises the back-pressure path when the ring is full
+    const int numThreads = 4;
+    const int numMsgsPerThread = 250000;
+    value0 = 0;
+    time_point<high_resolution_clock> start = high_resolution_clock::now();
+    std::thread threads[numThreads];
+    for (int i = 0; i < numThreads; i++) {
+        threads[i] = std::thread([threadedQueue, numMsgsPerThread]() {
+            Ptr<TestProtocol::TestMsg1> msg;
+            for (int j = 0; j < numMsgsPerThread; j++) {
+                msg = TestProtocol::TestMsg1::Create();
+                threadedQueue->Put(msg);
+            }
+            while (!msg->Handled()) {
+                std::this_thread::yield();
+            }
+        });
+    }
+    for (int i = 0; i < numThreads; i++) {
+        threads[i].join();
+    }
+    duration<double> dur = high_resolution_clock::now() - start;
+    Log::Info("ThreadedQueue(LockFree): %d producers, %d msgs handled: %f sec\n", numThreads, numThreads * numMsgsPerThread, dur.count());
+
+    // the ring is FIFO per producer, so once the last message of each
+    // producer has been handled, all messages have been handled
+    CHECK(value0 == numThreads * numMsgsPerThread);
+
+    threadedQueue->StopThread();
+    threadedQueue = 0;
+}
@@ -3,11 +3,24 @@
 //------------------------------------------------------------------------------
 #include "Pre.h"
 #include "ResourceLoader.h"
+#include "Resource/Core/loaderScheduler.h"
 
 namespace Oryol {
 
 OryolClassImpl(ResourceLoader);
 
+//------------------------------------------------------------------------------
+ResourceLoader::ResourceLoader() :
+priority(0),
+ticket(0) {
+    // empty
+}
+
+//------------------------------------------------------------------------------
+ResourceLoader::~ResourceLoader() {
+    // empty
+}
+
 //------------------------------------------------------------------------------
 const class Locator&
 ResourceLoader::Locator() const {
@@ -32,4 +45,40 @@ ResourceLoader::Cancel() {
     // empty
 }
 
-} // namespace Oryol
\ No newline at end of file
+//------------------------------------------------------------------------------
+bool
+ResourceLoader::NotifiesReady() const {
+    return false;
+}
+
+//------------------------------------------------------------------------------
+void
+ResourceLoader::SetPriority(int32 prio) {
+    this->priority = prio;
+}
+
+//------------------------------------------------------------------------------
+int32
+ResourceLoader::Priority() const {
+    return this->priority;
+}
+
+//------------------------------------------------------------------------------
+/**
+ The returned function only holds a reference to the ready queue of
+ the loader scheduler, not to the loader itself, so it is safe to call
+ after the loader has been cancelled or destroyed. Must be called
+ from Start() or later (that's when the loader has been added to
+ a scheduler).
+*/
+std::function<void()>
+ResourceLoader::ReadyFunc() const {
+    o_assert_dbg(this->readyQueue.isValid());
+    Ptr<_priv::loaderReadyQueue> queue = this->readyQueue;
+    const uint32 t = this->ticket;
+    return [queue, t]() {
+        queue->Push(t);
+    };
+}
+
+} // namespace Oryol
@@ -4,17 +4,34 @@
     @class Oryol::ResourceLoader
     @ingroup Resource
     @brief base class for resource loaders
+
+    Pending loaders are continued on the main thread by their resource
+    container, loaders with a lower Priority() value are continued first.
+    Loaders which return true from NotifiesReady() are only continued
+    after they (or e.g. their IO request) called the function returned
+    by ReadyFunc(), all other loaders are polled once per frame.
 */
 #include "Core/RefCounted.h"
 #include "Resource/Id.h"
 #include "Resource/Locator.h"
 #include "Resource/ResourceState.h"
+#include <functional>
 
 namespace Oryol {
 
+namespace _priv {
+class loaderScheduler;
+class loaderReadyQueue;
+}
+
 class ResourceLoader : public RefCounted {
     OryolClassDecl(ResourceLoader);
 public:
+    /// constructor
+    ResourceLoader();
+    /// destructor
+    virtual ~ResourceLoader();
+
     /// return resource locator
     virtual const class Locator& Locator() const;
     /// start loading, return a resource id
@@ -23,6 +40,21 @@ public:
     virtual ResourceState::Code Continue();
     /// cancel the resource loading process
     virtual void Cancel();
+    /// return true if the loader calls ReadyFunc() instead of being polled
+    virtual bool NotifiesReady() const;
+
+    /// set loader priority (lower values are continued first, default is 0)
+    void SetPriority(int32 prio);
+    /// get loader priority
+    int32 Priority() const;
+    /// get thread-safe function which marks the loader as ready to continue
+    std::function<void()> ReadyFunc() const;
+
+private:
+    friend class _priv::loaderScheduler;
+    int32 priority;
+    uint32 ticket;
+    Ptr<_priv::loaderReadyQueue> readyQueue;
 };
 
-} // namespace Oryol
\ No newline at end of file
+} // namespace Oryol
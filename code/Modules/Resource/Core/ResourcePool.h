@@ -4,28 +4,43 @@
     @class Oryol::ResourcePool
     @ingroup Resource
     @brief generic resource pool
-    @todo ResourcePool description
+
+    A ResourcePool holds resource objects of the same type in slots
+    which are addressed directly by the slot index of a resource Id.
+    The slots are allocated in chunks of ChunkSize resources. The
+    initial pool size is defined in Setup(), when the pool runs out of
+    free slots, a new chunk is added. Existing resources are never
+    moved in memory, so pointers returned by Lookup() remain valid
+    until the resource is unassigned.
+
+    Each slot has a generation counter which goes into the UniqueStamp
+    of an Id, and which is bumped when the slot is freed. Lookup() and
+    the other Id-based functions only need to compare the Id with the
+    Id stored in the slot to reject dangling Ids.
 */
 #include "Core/Ptr.h"
 #include "Core/Containers/Queue.h"
 #include "Core/Containers/Array.h"
+#include "Core/Memory/Memory.h"
 #include "Resource/Id.h"
 #include "Resource/ResourceInfo.h"
 #include "Resource/ResourcePoolInfo.h"
 
 namespace Oryol {
-    
+
 template<class RESOURCE, class SETUP> class ResourcePool {
 public:
     /// max number of resources in a pool
-    static const uint32 MaxNumPoolResources = (1<<16);
+    static const int32 MaxNumPoolResources = (1<<24);
+    /// number of resource slots in a chunk
+    static const int32 ChunkSize = 256;
 
     /// constructor
     ResourcePool();
     /// destructor
     ~ResourcePool();
-    
-    /// setup the resource pool
+
+    /// setup the resource pool with an initial number of slots
     void Setup(Id::TypeT resourceType, int32 poolSize);
     /// discard the resource pool
     void Discard();
@@ -33,14 +48,18 @@ public:
     bool IsValid() const;
     /// update the pool, call once per frame
     void Update();
-    
-    /// allocate a resource id
+
+    /// allocate a resource id, grows the pool if no free slots left
     Id AllocId();
-    
+    /// allocate multiple resource ids at once
+    void AllocIds(Id* outIds, int32 num);
+
     /// assign a resource to a free slot
     RESOURCE& Assign(const Id& id, const SETUP& setup, ResourceState::Code state);
     /// unassign/free a resource slot
     void Unassign(const Id& id);
+    /// unassign/free multiple resource slots at once
+    void UnassignIds(const Id* ids, int32 num);
     /// return pointer to resource object, may return placeholder or nullptr
     RESOURCE* Lookup(const Id& id) const;
     /// update the resource state of a contained resource
@@ -53,33 +72,42 @@ public:
     ResourceInfo QueryResourceInfo(const Id& id) const;
     /// query additional info about the pool (slow)
     ResourcePoolInfo QueryPoolInfo() const;
-    
+
     /// get number of slots in pool
     int32 GetNumSlots() const;
     /// get number of used slots
     int32 GetNumUsedSlots() const;
     /// get number of free slots
     int32 GetNumFreeSlots() const;
-    
+
 protected:
     /// free a resource id
     void freeId(const Id& id);
-    
+    /// add slots to the pool, allocates new chunks as needed
+    void grow(int32 numNewSlots);
+    /// access a slot by index
+    RESOURCE& slot(Id::SlotIndexT slotIndex) const;
+
+    struct chunk {
+        RESOURCE slots[ChunkSize];
+    };
+
     bool isValid;
     int32 frameCounter;
-    int32 uniqueCounter;
+    int32 numSlots;
     Id::TypeT resourceType;
-    
-    Array<RESOURCE> slots;
-    Queue<uint16> freeSlots;
+
+    Array<chunk*> chunks;
+    Array<Id::UniqueStampT> generations;
+    Queue<Id::SlotIndexT> freeSlots;
 };
-    
+
 //------------------------------------------------------------------------------
 template<class RESOURCE, class SETUP>
 ResourcePool<RESOURCE,SETUP>::ResourcePool() :
 isValid(false),
 frameCounter(0),
-uniqueCounter(0),
+numSlots(0),
 resourceType(0xFF) {
     // empty
 }
@@ -95,23 +123,10 @@ template<class RESOURCE, class SETUP> void
 ResourcePool<RESOURCE,SETUP>::Setup(Id::TypeT resType, int32 poolSize) {
     o_assert_dbg(!this->isValid);
     o_assert_dbg(Id::InvalidType != resType);
-    o_assert_dbg(poolSize > 0);
-    
+    o_assert_dbg((poolSize > 0) && (poolSize <= MaxNumPoolResources));
+
     this->resourceType = resType;
-    this->slots.Reserve(poolSize);
-    this->slots.SetAllocStrategy(0, 0);    // disable growing
-    this->freeSlots.Reserve(poolSize);
-    
-    // setup empty slots
-    for (int32 i = 0; i < poolSize; i++) {
-        this->slots.Add();
-    }
-    
-    // setup free slots queue
-    for (uint16 i = 0; i < poolSize; i++) {
-        this->freeSlots.Enqueue(i);
-    }
-    
+    this->grow(poolSize);
     this->isValid = true;
 }
 
@@ -120,11 +135,16 @@ template<class RESOURCE, class SETUP> void
 ResourcePool<RESOURCE,SETUP>::Discard() {
     o_assert_dbg(this->isValid);
     // make sure that all resources had been freed (or should we do this here?)
-    o_assert_dbg(this->freeSlots.Size() == this->slots.Size());
+    o_assert_dbg(this->freeSlots.Size() == this->numSlots);
     this->isValid = false;
-    
-    this->slots.Clear();
+
+    for (chunk* c : this->chunks) {
+        Memory::Delete(c);
+    }
+    this->chunks.Clear();
+    this->generations.Clear();
     this->freeSlots.Clear();
+    this->numSlots = 0;
 }
 
 //------------------------------------------------------------------------------
@@ -140,24 +160,72 @@ ResourcePool<RESOURCE, SETUP>::Update() {
     this->frameCounter++;
 }
 
+//------------------------------------------------------------------------------
+template<class RESOURCE, class SETUP> void
+ResourcePool<RESOURCE,SETUP>::grow(int32 numNewSlots) {
+    o_assert_dbg(numNewSlots > 0);
+    const int32 newNumSlots = this->numSlots + numNewSlots;
+    o_assert2(newNumSlots <= MaxNumPoolResources, "ResourcePool: too many resources!\n");
+
+    // add new chunks, existing chunks are never moved
+    while ((this->chunks.Size() * ChunkSize) < newNumSlots) {
+        this->chunks.Add(Memory::New<chunk>());
+    }
+    this->generations.Reserve(numNewSlots);
+    this->freeSlots.Reserve(numNewSlots);
+    for (int32 i = this->numSlots; i < newNumSlots; i++) {
+        this->generations.Add(0);
+        this->freeSlots.Enqueue(Id::SlotIndexT(i));
+    }
+    this->numSlots = newNumSlots;
+}
+
+//------------------------------------------------------------------------------
+template<class RESOURCE, class SETUP> RESOURCE&
+ResourcePool<RESOURCE,SETUP>::slot(Id::SlotIndexT slotIndex) const {
+    o_assert_dbg(int32(slotIndex) < this->numSlots);
+    return this->chunks[slotIndex / ChunkSize]->slots[slotIndex % ChunkSize];
+}
+
 //------------------------------------------------------------------------------
 template<class RESOURCE, class SETUP> Id
 ResourcePool<RESOURCE,SETUP>::AllocId() {
     o_assert_dbg(this->isValid);
     o_assert_dbg(Id::InvalidType != this->resourceType);
-    Id newId(this->uniqueCounter++, this->freeSlots.Dequeue(), this->resourceType);
-    #if ORYOL_DEBUG
-        const auto& slot = this->slots[newId.SlotIndex];
-        o_assert_dbg(ResourceState::Initial == slot.State);
-    #endif
+    if (this->freeSlots.Empty()) {
+        this->grow(ChunkSize);
+    }
+    const Id::SlotIndexT slotIndex = this->freeSlots.Dequeue();
+    Id newId(this->generations[slotIndex], slotIndex, this->resourceType);
+    o_assert_dbg(ResourceState::Initial == this->slot(slotIndex).State);
     return newId;
 }
 
+//------------------------------------------------------------------------------
+template<class RESOURCE, class SETUP> void
+ResourcePool<RESOURCE,SETUP>::AllocIds(Id* outIds, int32 num) {
+    o_assert_dbg(this->isValid);
+    o_assert_dbg(nullptr != outIds);
+    o_assert_dbg(num >= 0);
+    const int32 numMissing = num - this->freeSlots.Size();
+    if (numMissing > 0) {
+        // grow once by a multiple of the chunk size
+        this->grow(((numMissing + ChunkSize - 1) / ChunkSize) * ChunkSize);
+    }
+    for (int32 i = 0; i < num; i++) {
+        outIds[i] = this->AllocId();
+    }
+}
+
 //------------------------------------------------------------------------------
 template<class RESOURCE, class SETUP> void
 ResourcePool<RESOURCE,SETUP>::freeId(const Id& id) {
     o_assert_dbg(this->isValid);
-    o_assert_dbg(ResourceState::Initial == this->slots[id.SlotIndex].State);
+    o_assert_dbg(ResourceState::Initial == this->slot(id.SlotIndex).State);
+    Id::UniqueStampT& gen = this->generations[id.SlotIndex];
+    if (++gen == Id::InvalidUniqueStamp) {
+        gen = 0;
+    }
     this->freeSlots.Enqueue(id.SlotIndex);
 }
 
@@ -165,8 +233,8 @@ ResourcePool<RESOURCE,SETUP>::freeId(const Id& id) {
 template<class RESOURCE, class SETUP> RESOURCE&
 ResourcePool<RESOURCE,SETUP>::Assign(const Id& id, const SETUP& setup, ResourceState::Code state) {
     o_assert_dbg(this->isValid);
-    
-    auto& slot = this->slots[id.SlotIndex];
+
+    auto& slot = this->slot(id.SlotIndex);
     o_assert_dbg(ResourceState::Valid != slot.State);
     slot.State = state;
     slot.StateStartFrame = this->frameCounter;
@@ -179,8 +247,8 @@ ResourcePool<RESOURCE,SETUP>::Assign(const Id& id, const SETUP& setup, ResourceS
 template<class RESOURCE, class SETUP> void
 ResourcePool<RESOURCE,SETUP>::Unassign(const Id& id) {
     o_assert_dbg(this->isValid);
-    
-    auto& slot = this->slots[id.SlotIndex];
+
+    auto& slot = this->slot(id.SlotIndex);
     if (id == slot.Id) {
         o_assert_dbg(ResourceState::Initial != slot.State);
         slot.Id.Invalidate();
@@ -193,23 +261,31 @@ ResourcePool<RESOURCE,SETUP>::Unassign(const Id& id) {
     }
 }
 
+//------------------------------------------------------------------------------
+template<class RESOURCE, class SETUP> void
+ResourcePool<RESOURCE,SETUP>::UnassignIds(const Id* ids, int32 num) {
+    o_assert_dbg(nullptr != ids);
+    o_assert_dbg(num >= 0);
+    for (int32 i = 0; i < num; i++) {
+        this->Unassign(ids[i]);
+    }
+}
+
 //------------------------------------------------------------------------------
 template<class RESOURCE, class SETUP> RESOURCE*
 ResourcePool<RESOURCE,SETUP>::Lookup(const Id& id) const {
     o_assert_dbg(this->isValid);
     o_assert_dbg(id.Type == this->resourceType);
-    
-    auto& slot = this->slots[id.SlotIndex];
-    if (id == slot.Id) {
-        if (ResourceState::Valid == slot.State) {
-            // resource exists and is valid, all ok
-            return const_cast<RESOURCE*>(&slot);
-        }
-        else {
-            o_warn("ResourcePool::Lookup(): looked up resource is not valid!\n");
-        }
+
+    auto& slot = this->slot(id.SlotIndex);
+    if ((id == slot.Id) && (ResourceState::Valid == slot.State)) {
+        // resource exists and is valid, all ok
+        return &slot;
     }
     // FALLTHROUGH: no valid resource (doesn't exist, is pending, failed etc...)
+    if (id == slot.Id) {
+        o_warn("ResourcePool::Lookup(): looked up resource is not valid!\n");
+    }
     o_error("FIXME FIXME FIXME");
     return nullptr;
 }
@@ -218,7 +294,7 @@ ResourcePool<RESOURCE,SETUP>::Lookup(const Id& id) const {
 template<class RESOURCE, class SETUP> void
 ResourcePool<RESOURCE, SETUP>::UpdateState(const Id& id, ResourceState::Code newState) {
     o_assert_dbg(this->isValid);
-    auto& slot = this->slots[id.SlotIndex];
+    auto& slot = this->slot(id.SlotIndex);
     if (id == slot.Id) {
         o_assert_dbg(ResourceState::Initial != slot.State);
         slot.State = newState;
@@ -234,7 +310,7 @@ template<class RESOURCE, class SETUP> bool
 ResourcePool<RESOURCE, SETUP>::Contains(const Id& id) const {
     o_assert_dbg(this->isValid);
     o_assert_dbg(id.Type == this->resourceType);
-    return id == this->slots[id.SlotIndex].Id;
+    return id == this->slot(id.SlotIndex).Id;
 }
 
 //------------------------------------------------------------------------------
@@ -242,8 +318,8 @@ template<class RESOURCE, class SETUP> ResourceState::Code
 ResourcePool<RESOURCE,SETUP>::QueryState(const Id& id) const {
     o_assert_dbg(this->isValid);
     o_assert_dbg(id.Type == this->resourceType);
-    
-    const auto& slot = this->slots[id.SlotIndex];
+
+    const auto& slot = this->slot(id.SlotIndex);
     if (id == slot.Id) {
         return slot.State;
     }
@@ -257,9 +333,9 @@ template<class RESOURCE, class SETUP> ResourceInfo
 ResourcePool<RESOURCE, SETUP>::QueryResourceInfo(const Id& id) const {
     o_assert_dbg(this->isValid);
     o_assert_dbg(id.Type == this->resourceType);
-    
+
     ResourceInfo info;
-    const auto& slot = this->slots[id.SlotIndex];
+    const auto& slot = this->slot(id.SlotIndex);
     if (id == slot.Id) {
         info.State = slot.State;
         info.StateAge = this->frameCounter - slot.StateStartFrame;
@@ -271,13 +347,14 @@ ResourcePool<RESOURCE, SETUP>::QueryResourceInfo(const Id& id) const {
 template<class RESOURCE, class SETUP> ResourcePoolInfo
 ResourcePool<RESOURCE, SETUP>::QueryPoolInfo() const {
     o_assert_dbg(this->isValid);
-    
+
     ResourcePoolInfo poolInfo;
     poolInfo.ResourceType = this->resourceType;
     poolInfo.NumSlots = this->GetNumSlots();
     poolInfo.NumUsedSlots = this->GetNumUsedSlots();
     poolInfo.NumFreeSlots = this->GetNumFreeSlots();
-    for (const auto& slot : this->slots) {
+    for (int32 i = 0; i < this->numSlots; i++) {
+        const auto& slot = this->slot(i);
         if (ResourceState::InvalidState != slot.State) {
             poolInfo.NumSlotsByState[slot.State]++;
         }
@@ -288,13 +365,13 @@ ResourcePool<RESOURCE, SETUP>::QueryPoolInfo() const {
 //------------------------------------------------------------------------------
 template<class RESOURCE, class SETUP> int32
 ResourcePool<RESOURCE,SETUP>::GetNumSlots() const {
-    return this->slots.Size();
+    return this->numSlots;
 }
 
 //------------------------------------------------------------------------------
 template<class RESOURCE, class SETUP> int32
 ResourcePool<RESOURCE,SETUP>::GetNumUsedSlots() const {
-    return this->slots.Size() - this->freeSlots.Size();
+    return this->numSlots - this->freeSlots.Size();
 }
 
 //------------------------------------------------------------------------------
@@ -0,0 +1,222 @@
+//------------------------------------------------------------------------------
+//  loaderScheduler.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "loaderScheduler.h"
+#include "Core/Assertion.h"
+#include "Time/Clock.h"
+#include <algorithm>
+
+namespace Oryol {
+namespace _priv {
+
+OryolClassImpl(loaderReadyQueue);
+
+//------------------------------------------------------------------------------
+void
+loaderReadyQueue::Push(uint32 ticket) {
+    #if ORYOL_HAS_THREADS
+    std::lock_guard<std::mutex> guard(this->lock);
+    #endif
+    this->tickets.Add(ticket);
+}
+
+//------------------------------------------------------------------------------
+void
+loaderReadyQueue::PopAll(Array<uint32>& outTickets) {
+    #if ORYOL_HAS_THREADS
+    std::lock_guard<std::mutex> guard(this->lock);
+    #endif
+    for (uint32 ticket : this->tickets) {
+        outTickets.Add(ticket);
+    }
+    this->tickets.Clear();
+}
+
+//------------------------------------------------------------------------------
+loaderScheduler::loaderScheduler() :
+valid(false),
+nextTicket(0) {
+    // empty
+}
+
+//------------------------------------------------------------------------------
+loaderScheduler::~loaderScheduler() {
+    o_assert_dbg(!this->valid);
+}
+
+//------------------------------------------------------------------------------
+void
+loaderScheduler::setup() {
+    o_assert_dbg(!this->valid);
+    this->readyQueue = loaderReadyQueue::Create();
+    this->curStats = ResourceLoaderStats();
+    this->totalTimeToReady = Duration();
+    this->valid = true;
+}
+
+//------------------------------------------------------------------------------
+void
+loaderScheduler::discard() {
+    o_assert_dbg(this->valid);
+    for (auto& kvp : this->entries) {
+        kvp.Value().loader->Cancel();
+    }
+    this->entries.Clear();
+    this->polledTickets.Clear();
+    this->readyItems.Clear();
+    this->notifiedTickets.Clear();
+    // late notifications of cancelled loaders go into the orphaned queue
+    this->readyQueue = nullptr;
+    this->valid = false;
+}
+
+//------------------------------------------------------------------------------
+bool
+loaderScheduler::isValid() const {
+    return this->valid;
+}
+
+//------------------------------------------------------------------------------
+Id
+loaderScheduler::add(const Ptr<ResourceLoader>& loader) {
+    o_assert_dbg(this->valid);
+    o_assert_dbg(loader.isValid());
+    o_assert_dbg(!loader->readyQueue.isValid());
+
+    // the loader may already signal readiness from inside Start()
+    const uint32 ticket = this->nextTicket++;
+    loader->ticket = ticket;
+    loader->readyQueue = this->readyQueue;
+    entry e;
+    e.loader = loader;
+    e.startTime = Clock::Now();
+    this->entries.Add(ticket, e);
+    if (!loader->NotifiesReady()) {
+        this->polledTickets.Add(ticket);
+    }
+    return loader->Start();
+}
+
+//------------------------------------------------------------------------------
+void
+loaderScheduler::markReady(uint32 ticket) {
+    const int32 index = this->entries.FindIndex(ticket);
+    if (InvalidIndex != index) {
+        entry& e = this->entries.ValueAtIndex(index);
+        if (!e.ready) {
+            e.ready = true;
+            readyItem item;
+            item.priority = e.loader->Priority();
+            item.ticket = ticket;
+            this->readyItems.Add(item);
+        }
+    }
+    // tickets of finished loaders are silently ignored
+}
+
+//------------------------------------------------------------------------------
+void
+loaderScheduler::finish(uint32 ticket, ResourceState::Code state) {
+    const int32 index = this->entries.FindIndex(ticket);
+    o_assert_dbg(InvalidIndex != index);
+    const entry& e = this->entries.ValueAtIndex(index);
+    const Duration timeToReady = Clock::Since(e.startTime);
+    if (!e.loader->NotifiesReady()) {
+        const int32 polledIndex = this->polledTickets.FindIndexLinear(ticket);
+        o_assert_dbg(InvalidIndex != polledIndex);
+        this->polledTickets.EraseSwap(polledIndex);
+    }
+    e.loader->readyQueue = nullptr;
+    this->entries.EraseIndex(index);
+
+    this->curStats.NumCompleted++;
+    if (ResourceState::Failed == state) {
+        this->curStats.NumFailed++;
+    }
+    this->totalTimeToReady += timeToReady;
+    this->curStats.AvgTimeToReady = Duration(this->totalTimeToReady.getRaw() / this->curStats.NumCompleted);
+    if (timeToReady > this->curStats.MaxTimeToReady) {
+        this->curStats.MaxTimeToReady = timeToReady;
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+ At least one ready loader is continued per frame, even if the budget
+ is smaller than a single Continue() call, so that loading always
+ makes progress.
+*/
+void
+loaderScheduler::update(int32 budgetMicroSecs) {
+    o_assert_dbg(this->valid);
+    o_assert_dbg(budgetMicroSecs >= 0);
+    const TimePoint startTime = Clock::Now();
+    const Duration budget = Duration::FromMicroSeconds(float64(budgetMicroSecs));
+
+    // gather notified and polled loaders
+    this->readyQueue->PopAll(this->notifiedTickets);
+    for (uint32 ticket : this->notifiedTickets) {
+        this->markReady(ticket);
+    }
+    this->notifiedTickets.Clear();
+    for (uint32 ticket : this->polledTickets) {
+        this->markReady(ticket);
+    }
+    if (this->readyItems.Size() > 1) {
+        std::sort(this->readyItems.begin(), this->readyItems.end());
+    }
+
+    // continue ready loaders until the budget is used up
+    int32 numContinued = 0;
+    const int32 numReady = this->readyItems.Size();
+    for (; numContinued < numReady; numContinued++) {
+        if ((budgetMicroSecs > 0) && (numContinued > 0) && (Clock::Since(startTime) >= budget)) {
+            break;
+        }
+        const uint32 ticket = this->readyItems[numContinued].ticket;
+        Ptr<ResourceLoader> loader;
+        {
+            entry& e = this->entries[ticket];
+            e.ready = false;
+            loader = e.loader;
+        }
+        const ResourceState::Code state = loader->Continue();
+        if (ResourceState::Pending != state) {
+            this->finish(ticket, state);
+        }
+    }
+    if (numContinued == numReady) {
+        this->readyItems.Clear();
+    }
+    else if (numContinued > 0) {
+        Array<readyItem> deferred;
+        deferred.Reserve(numReady - numContinued);
+        for (int32 i = numContinued; i < numReady; i++) {
+            deferred.Add(this->readyItems[i]);
+        }
+        this->readyItems = std::move(deferred);
+    }
+
+    // remaining ready loaders stay in the ready queue for the next frame
+    this->curStats.QueueDepth = this->entries.Size();
+    this->curStats.NumDeferred = this->readyItems.Size();
+    this->curStats.NumPolled = this->polledTickets.Size();
+    this->curStats.NumContinued = numContinued;
+    this->curStats.UpdateTime = Clock::Since(startTime);
+}
+
+//------------------------------------------------------------------------------
+int32
+loaderScheduler::numPending() const {
+    return this->entries.Size();
+}
+
+//------------------------------------------------------------------------------
+const ResourceLoaderStats&
+loaderScheduler::stats() const {
+    return this->curStats;
+}
+
+} // namespace _priv
+} // namespace Oryol
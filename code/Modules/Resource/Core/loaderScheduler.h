@@ -0,0 +1,100 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::_priv::loaderScheduler
+    @ingroup _priv
+    @brief continues pending resource loaders by priority and time budget
+
+    Instead of calling Continue() on all pending loaders each frame,
+    loaders which support notification (see ResourceLoader::NotifiesReady())
+    push their ticket into a thread-safe ready queue when they can
+    make progress (e.g. when their IO request has been handled). The
+    scheduler only continues ready loaders (plus the loaders which need
+    to be polled), lower priority values first, until the per-frame time
+    budget is used up. Ready loaders which didn't fit into the budget
+    are continued first in the next frame (if their priority allows).
+
+    @see ResourceLoader, ResourceLoaderStats
+*/
+#include "Core/RefCounted.h"
+#include "Core/Containers/Array.h"
+#include "Core/Containers/HashMap.h"
+#include "Resource/Core/ResourceLoader.h"
+#include "Resource/ResourceLoaderStats.h"
+#include "Time/TimePoint.h"
+#if ORYOL_HAS_THREADS
+#include <mutex>
+#endif
+
+namespace Oryol {
+namespace _priv {
+
+class loaderReadyQueue : public RefCounted {
+    OryolClassDecl(loaderReadyQueue);
+public:
+    /// push ticket of a ready loader (thread-safe)
+    void Push(uint32 ticket);
+    /// move all pushed tickets into array (thread-safe)
+    void PopAll(Array<uint32>& outTickets);
+private:
+    #if ORYOL_HAS_THREADS
+    std::mutex lock;
+    #endif
+    Array<uint32> tickets;
+};
+
+class loaderScheduler {
+public:
+    /// constructor
+    loaderScheduler();
+    /// destructor
+    ~loaderScheduler();
+
+    /// setup the scheduler
+    void setup();
+    /// discard the scheduler, cancels pending loaders
+    void discard();
+    /// return true if setup
+    bool isValid() const;
+
+    /// add and start a loader, returns the result of ResourceLoader::Start()
+    Id add(const Ptr<ResourceLoader>& loader);
+    /// continue ready loaders, call once per frame (0 budget: unlimited)
+    void update(int32 budgetMicroSecs);
+    /// get number of pending loaders
+    int32 numPending() const;
+    /// get loader statistics
+    const ResourceLoaderStats& stats() const;
+
+private:
+    struct entry {
+        Ptr<ResourceLoader> loader;
+        TimePoint startTime;
+        bool ready = false;
+    };
+    struct readyItem {
+        int32 priority;
+        uint32 ticket;
+        bool operator<(const readyItem& rhs) const {
+            // lower priority values first, then in ticket (start) order
+            return (this->priority != rhs.priority) ? (this->priority < rhs.priority) : (this->ticket < rhs.ticket);
+        };
+    };
+    /// mark a pending loader as ready
+    void markReady(uint32 ticket);
+    /// record a finished loader
+    void finish(uint32 ticket, ResourceState::Code state);
+
+    bool valid;
+    uint32 nextTicket;
+    Ptr<loaderReadyQueue> readyQueue;
+    HashMap<uint32, entry> entries;
+    Array<uint32> polledTickets;
+    Array<readyItem> readyItems;
+    Array<uint32> notifiedTickets;
+    Duration totalTimeToReady;
+    ResourceLoaderStats curStats;
+};
+
+} // namespace _priv
+} // namespace Oryol
@@ -38,6 +38,7 @@ resourceRegistry::Discard() {
     this->entries.Clear();
     this->locatorIndexMap.Clear();
     this->idIndexMap.Clear();
+    this->labelHeadMap.Clear();
     this->isValid = false;
 }
 
@@ -54,12 +55,81 @@ resourceRegistry::Add(const Locator& loc, Id id, ResourceLabel label) {
     o_assert_dbg(id.IsValid());
     o_assert(!this->idIndexMap.Contains(id));
     
+    const int32 entryIndex = this->entries.Size();
     this->entries.Add(loc, id, label);
     if (loc.IsShared()) {
         o_assert_dbg(!this->locatorIndexMap.Contains(loc));
-        this->locatorIndexMap.Add(loc, this->entries.Size() - 1);
+        this->locatorIndexMap.Add(loc, entryIndex);
+    }
+    this->idIndexMap.Add(id, entryIndex);
+
+    // link new entry at the front of its label list
+    const int32 headMapIndex = this->labelHeadMap.FindIndex(label.Value);
+    if (InvalidIndex != headMapIndex) {
+        int32& head = this->labelHeadMap.ValueAtIndex(headMapIndex);
+        this->entries[entryIndex].next = head;
+        this->entries[head].prev = entryIndex;
+        head = entryIndex;
+    }
+    else {
+        this->labelHeadMap.Add(label.Value, entryIndex);
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+resourceRegistry::unlinkEntry(int32 entryIndex) {
+    Entry& entry = this->entries[entryIndex];
+    if (InvalidIndex != entry.prev) {
+        this->entries[entry.prev].next = entry.next;
+    }
+    else if (InvalidIndex != entry.next) {
+        this->labelHeadMap[entry.label.Value] = entry.next;
+    }
+    else {
+        // was the only entry with this label
+        this->labelHeadMap.Erase(entry.label.Value);
+    }
+    if (InvalidIndex != entry.next) {
+        this->entries[entry.next].prev = entry.prev;
+    }
+    entry.prev = InvalidIndex;
+    entry.next = InvalidIndex;
+}
+
+//------------------------------------------------------------------------------
+void
+resourceRegistry::removeEntry(int32 entryIndex) {
+    this->unlinkEntry(entryIndex);
+    const Entry& entry = this->entries[entryIndex];
+    this->idIndexMap.Erase(entry.id);
+    if (entry.locator.IsShared()) {
+        this->locatorIndexMap.Erase(entry.locator);
+    }
+    this->entries.EraseSwapBack(entryIndex);
+
+    // fixup the references to the swapped-in entry
+    if (entryIndex != this->entries.Size()) {
+        const int32 swappedIndex = this->entries.Size();
+        const Entry& swapped = this->entries[entryIndex];
+        this->idIndexMap[swapped.id] = entryIndex;
+        if (swapped.locator.IsShared()) {
+            this->locatorIndexMap[swapped.locator] = entryIndex;
+        }
+        if (InvalidIndex != swapped.prev) {
+            this->entries[swapped.prev].next = entryIndex;
+        }
+        else {
+            o_assert_dbg(this->labelHeadMap[swapped.label.Value] == swappedIndex);
+            this->labelHeadMap[swapped.label.Value] = entryIndex;
+        }
+        if (InvalidIndex != swapped.next) {
+            this->entries[swapped.next].prev = entryIndex;
+        }
+        #if ORYOL_DEBUG
+        o_assert(this->checkEntry(entryIndex));
+        #endif
     }
-    this->idIndexMap.Add(id, this->entries.Size() - 1);
 }
 
 //------------------------------------------------------------------------------
@@ -112,46 +182,29 @@ Array<Id>
 resourceRegistry::Remove(ResourceLabel label) {
     o_assert_dbg(this->isValid);
     Array<Id> removed;
-    removed.Reserve(this->entries.Size() < 256 ? this->entries.Size() : 256);
     
-    // for each entry where id.label matches label (from behind
-    // because matching entries will be removed)
-    // FIXME: this can be slow if many resource are live!
-    int32 entryIndex = this->entries.Size() - 1;
-    for (; entryIndex >= 0; entryIndex--) {
-        if ((ResourceLabel::All == label) || (this->entries[entryIndex].label == label)) {
-            Id id = this->entries[entryIndex].id;
-            Locator loc = this->entries[entryIndex].locator;
-            removed.Add(id);
-            
-            // remove entries
-            this->entries.EraseSwapBack(entryIndex);
-            this->idIndexMap.Erase(id);
-            if (loc.IsShared()) {
-                this->locatorIndexMap.Erase(loc);
+    if (ResourceLabel::All == label) {
+        // remove everything (from behind, like single labels)
+        removed.Reserve(this->entries.Size());
+        for (int32 entryIndex = this->entries.Size() - 1; entryIndex >= 0; entryIndex--) {
+            removed.Add(this->entries[entryIndex].id);
+        }
+        this->entries.Clear();
+        this->locatorIndexMap.Clear();
+        this->idIndexMap.Clear();
+        this->labelHeadMap.Clear();
+    }
+    else {
+        // gather the ids in the label list (newest first), then
+        // remove the entries, which may move other entries around
+        const int32 headMapIndex = this->labelHeadMap.FindIndex(label.Value);
+        if (InvalidIndex != headMapIndex) {
+            for (int32 i = this->labelHeadMap.ValueAtIndex(headMapIndex); InvalidIndex != i; i = this->entries[i].next) {
+                removed.Add(this->entries[i].id);
             }
-            
-            // fixup the index maps (see elementBuffer)
-            const int32 swappedIndex = this->entries.Size();
-            if (entryIndex != swappedIndex) {
-                for (auto& elm : this->idIndexMap) {
-                    if (swappedIndex == elm.value) {
-                        elm.value = entryIndex;
-                        break;
-                    }
-                }
-                for (auto& elm : this->locatorIndexMap) {
-                    if (swappedIndex == elm.value) {
-                        elm.value = entryIndex;
-                        break;
-                    }
-                }
+            for (const Id& id : removed) {
+                this->removeEntry(this->idIndexMap[id]);
             }
-            
-            // make sure nothing broke
-            #if ORYOL_DEBUG
-            o_assert(this->checkIntegrity());
-            #endif
         }
     }
     return removed;
@@ -196,27 +249,26 @@ resourceRegistry::GetIdByIndex(int32 index) const {
 //------------------------------------------------------------------------------
 #if ORYOL_DEBUG
 bool
-resourceRegistry::checkIntegrity() const {
-    for (const auto& kvp : this->locatorIndexMap) {
-        const Locator& loc = kvp.key;
-        const int32 entryIndex = kvp.value;
-        const Locator& entryLoc = this->entries[entryIndex].locator;
-        if (entryLoc != loc) {
-            o_error("ResourceRegistry: locator mismatch at index '%d' (%s != %s)\n",
-                    entryIndex, entryLoc.Location().AsCStr(), loc.Location().AsCStr());
-            return false;
-        }
+resourceRegistry::checkEntry(int32 entryIndex) const {
+    const Entry& entry = this->entries[entryIndex];
+    const int32 idEntryIndex = this->idIndexMap[entry.id];
+    if (idEntryIndex != entryIndex) {
+        o_error("ResourceRegistry:: id mismatch at index '%d' (%d,%d,%d != %d)\n",
+                entryIndex, entry.id.UniqueStamp, entry.id.SlotIndex, entry.id.Type, idEntryIndex);
+        return false;
     }
-    for (const auto& kvp : this->idIndexMap) {
-        const Id& id = kvp.key;
-        const int32 entryIndex = kvp.value;
-        const Id& entryId = this->entries[entryIndex].id;
-        if (entryId != id) {
-            o_error("ResourceRegistry:: id mismatch at index '%d' (%d,%d,%d != %d,%d,%d)\n",
-                    entryIndex, entryId.UniqueStamp, entryId.SlotIndex, entryId.Type,
-                    id.UniqueStamp, id.SlotIndex, id.Type);
-            return false;
-        }
+    if (entry.locator.IsShared() && (this->locatorIndexMap[entry.locator] != entryIndex)) {
+        o_error("ResourceRegistry: locator mismatch at index '%d' (%s)\n",
+                entryIndex, entry.locator.Location().AsCStr());
+        return false;
+    }
+    const bool prevOk = (InvalidIndex == entry.prev) ?
+        (this->labelHeadMap[entry.label.Value] == entryIndex) :
+        (this->entries[entry.prev].next == entryIndex);
+    const bool nextOk = (InvalidIndex == entry.next) || (this->entries[entry.next].prev == entryIndex);
+    if (!(prevOk && nextOk)) {
+        o_error("ResourceRegistry: broken label list at index '%d'\n", entryIndex);
+        return false;
     }
     return true;
 }
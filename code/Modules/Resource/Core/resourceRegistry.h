@@ -4,12 +4,18 @@
     @class Oryol::resourceRegistry
     @ingroup _priv
     @brief map resource locators to resource ids for resource sharing
+
+    Entries live in a dense array, shared locators and ids are
+    mapped to entry indices through hash maps. The entries of each
+    resource label are linked into an intrusive doubly-linked list
+    (newest first), so that Remove(label) only touches the entries
+    of that label.
 */
 #include "Resource/Id.h"
 #include "Resource/Locator.h"
 #include "Resource/ResourceLabel.h"
 #include "Core/Containers/Array.h"
-#include "Core/Containers/Map.h"
+#include "Core/Containers/HashMap.h"
 
 namespace Oryol {
 namespace _priv {
@@ -49,30 +55,50 @@ public:
     
 private:
     #if ORYOL_DEBUG
-    /// validate integrity of internal data structures
-    bool checkIntegrity() const;
+    /// validate integrity of an entry and its index map items
+    bool checkEntry(int32 entryIndex) const;
     #endif
     
     struct Entry {
         Entry(const Locator& loc_, Id id_, ResourceLabel label_) :
             locator(loc_),
             id(id_),
-            label(label_) { };
+            label(label_),
+            prev(InvalidIndex),
+            next(InvalidIndex) { };
         
         Locator locator;
         Id id;
         ResourceLabel label;
+        int32 prev;     // previous entry with same label
+        int32 next;     // next entry with same label
+    };
+    struct locatorHasher {
+        uint64 operator()(const Locator& loc) const {
+            // string atoms are unique, so the string pointer can be hashed
+            return uint64(uintptr(loc.Location().AsCStr())) ^ (uint64(loc.Signature()) << 32);
+        };
+    };
+    struct idHasher {
+        uint64 operator()(const Id& id) const {
+            return id.Value;
+        };
     };
     
     /// find an entry by locator
     const Entry* findEntryByLocator(const Locator& loc) const;
     /// find an entry by id
     const Entry* findEntryById(Id id) const;
+    /// remove an entry, swaps in the last entry
+    void removeEntry(int32 entryIndex);
+    /// remove an entry from its label list
+    void unlinkEntry(int32 entryIndex);
     
     bool isValid;
     Array<Entry> entries;
-    Map<Locator, int32> locatorIndexMap;
-    Map<Id, int32> idIndexMap;
+    HashMap<Locator, int32, locatorHasher> locatorIndexMap;
+    HashMap<Id, int32, idHasher> idIndexMap;
+    HashMap<uint32, int32> labelHeadMap;
 };
 } // namespace _priv
 } // namespace Oryol
@@ -6,6 +6,11 @@
     @brief a generic resource identifier
     
     Resource identifiers are abstract handles to a resource object.
+    An Id is a generational handle: the slot index directly addresses
+    a resource slot in its ResourcePool, and the unique stamp is the
+    slot's generation counter which is bumped when a resource is
+    destroyed, so that an old Id never matches a new resource in the
+    same slot (until the 16-bit generation counter wraps around).
 */
 #include "Core/Types.h"
 
@@ -13,17 +18,17 @@ namespace Oryol {
     
 class Id {
 public:
-    /// unique-stamp type (sizeof all types must remain 64 bit)
-    typedef uint32 UniqueStampT;
+    /// unique-stamp (slot generation) type (sizeof all types must remain 64 bit)
+    typedef uint16 UniqueStampT;
     /// slot-index type
-    typedef uint16 SlotIndexT;
+    typedef uint32 SlotIndexT;
     /// resource type type
     typedef uint16 TypeT;
 
     /// invalid unique stamp constant
-    static const UniqueStampT InvalidUniqueStamp = 0xFFFFFFFF;
+    static const UniqueStampT InvalidUniqueStamp = 0xFFFF;
     /// invalid slot index constant
-    static const SlotIndexT InvalidSlotIndex = 0xFFFF;
+    static const SlotIndexT InvalidSlotIndex = 0xFFFFFFFF;
     /// invalid type constant
     static const TypeT InvalidType = 0xFFFF;
 
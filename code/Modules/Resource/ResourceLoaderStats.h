@@ -0,0 +1,40 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::ResourceLoaderStats
+    @ingroup Resource
+    @brief counters of the asynchronous resource loader scheduler
+
+    The time-to-ready is measured on the main thread from the time
+    a loader is started until its Continue() returns Valid or Failed,
+    so it includes the time the loader had to wait in the ready queue
+    because of the per-frame time budget.
+*/
+#include "Core/Types.h"
+#include "Time/Duration.h"
+
+namespace Oryol {
+
+class ResourceLoaderStats {
+public:
+    /// number of started loaders which haven't finished yet
+    int32 QueueDepth = 0;
+    /// number of ready loaders deferred to the next frame by the time budget
+    int32 NumDeferred = 0;
+    /// number of loaders which don't notify and are polled each frame
+    int32 NumPolled = 0;
+    /// number of Continue() calls in the last frame
+    int32 NumContinued = 0;
+    /// overall number of finished loaders (including failed loaders)
+    int32 NumCompleted = 0;
+    /// overall number of loaders which finished with Failed state
+    int32 NumFailed = 0;
+    /// time spent continuing loaders in the last frame
+    Duration UpdateTime;
+    /// average time from start to finished
+    Duration AvgTimeToReady;
+    /// max time from start to finished
+    Duration MaxTimeToReady;
+};
+
+} // namespace Oryol
@@ -55,4 +55,13 @@ TEST(IdTest) {
     CHECK(id3.SlotIndex == 1);
     CHECK(id3.Type == 2);
     CHECK(id3 < id2);
+
+    // slot indices beyond 16 bits
+    CHECK(sizeof(Id) == 8);
+    Id id4(7, 100000, 3);
+    CHECK(id4.IsValid());
+    CHECK(id4.UniqueStamp == 7);
+    CHECK(id4.SlotIndex == 100000);
+    CHECK(id4.Type == 3);
+    CHECK(id4 != Id(8, 100000, 3));
 }
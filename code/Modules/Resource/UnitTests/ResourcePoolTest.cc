@@ -5,6 +5,8 @@
 #include "UnitTest++/src/UnitTest++.h"
 #include "Resource/Core/ResourcePool.h"
 #include "Resource/Core/resourceBase.h"
+#include "Core/Log.h"
+#include <chrono>
 
 using namespace Oryol;
 
@@ -86,4 +88,94 @@ TEST(ResourcePoolTest) {
     
     resourcePool.Discard();
     CHECK(!resourcePool.IsValid());
-}
\ No newline at end of file
+}
+
+TEST(ResourcePoolGrowTest) {
+    const uint16 myResourceType = 3;
+    myResourcePool resourcePool;
+    resourcePool.Setup(myResourceType, 16);
+    CHECK(resourcePool.GetNumSlots() == 16);
+
+    // allocating beyond the initial size adds a chunk, resources don't move
+    Id ids[17];
+    const myResource* ptrs[17];
+    for (int32 i = 0; i < 17; i++) {
+        ids[i] = resourcePool.AllocId();
+        CHECK(ids[i].SlotIndex == Id::SlotIndexT(i));
+        resourcePool.Assign(ids[i], mySetup(i), ResourceState::Valid);
+        ptrs[i] = resourcePool.Lookup(ids[i]);
+    }
+    CHECK(resourcePool.GetNumSlots() == 16 + myResourcePool::ChunkSize);
+    CHECK(resourcePool.GetNumUsedSlots() == 17);
+    for (int32 i = 0; i < 17; i++) {
+        CHECK(resourcePool.Lookup(ids[i]) == ptrs[i]);
+        CHECK(ptrs[i]->Setup.bla == i);
+    }
+
+    resourcePool.UnassignIds(ids, 17);
+    CHECK(resourcePool.GetNumUsedSlots() == 0);
+    resourcePool.Discard();
+
+    // a freed slot gets a new generation, the old id is stale
+    resourcePool.Setup(myResourceType, 1);
+    Id oldId = resourcePool.AllocId();
+    resourcePool.Assign(oldId, mySetup(1), ResourceState::Valid);
+    resourcePool.Unassign(oldId);
+    CHECK(!resourcePool.Contains(oldId));
+    CHECK(resourcePool.QueryState(oldId) == ResourceState::InvalidState);
+    Id newId = resourcePool.AllocId();
+    CHECK(newId.SlotIndex == oldId.SlotIndex);
+    CHECK(newId.UniqueStamp == oldId.UniqueStamp + 1);
+    resourcePool.Assign(newId, mySetup(2), ResourceState::Valid);
+    CHECK(resourcePool.Contains(newId));
+    CHECK(!resourcePool.Contains(oldId));
+    CHECK(resourcePool.GetNumSlots() == 1);
+    resourcePool.Unassign(newId);
+    resourcePool.Discard();
+}
+
+TEST(ResourcePoolBenchmark) {
+    using namespace std::chrono;
+
+    // more than 64k resources in a pool which starts small
+    const int32 numResources = 200000;
+    const uint16 myResourceType = 4;
+    myResourcePool resourcePool;
+    resourcePool.Setup(myResourceType, 128);
+    Array<Id> ids;
+    ids.Reserve(numResources);
+    for (int32 i = 0; i < numResources; i++) {
+        ids.Add();
+    }
+
+    auto start = high_resolution_clock::now();
+    resourcePool.AllocIds(&ids[0], numResources);
+    for (int32 i = 0; i < numResources; i++) {
+        resourcePool.Assign(ids[i], mySetup(i), ResourceState::Valid);
+    }
+    duration<double> allocDur = high_resolution_clock::now() - start;
+    CHECK(resourcePool.GetNumUsedSlots() == numResources);
+    CHECK(ids[numResources - 1].SlotIndex == Id::SlotIndexT(numResources - 1));
+
+    // lookup in pseudo-random order
+    start = high_resolution_clock::now();
+    int64 sum = 0;
+    uint32 index = 0;
+    for (int32 i = 0; i < numResources; i++) {
+        index = (index + 7919) % numResources;
+        sum += resourcePool.Lookup(ids[index])->Setup.bla;
+    }
+    duration<double> lookupDur = high_resolution_clock::now() - start;
+    CHECK(sum == (int64(numResources - 1) * numResources) / 2);
+
+    start = high_resolution_clock::now();
+    resourcePool.UnassignIds(&ids[0], numResources);
+    duration<double> freeDur = high_resolution_clock::now() - start;
+    CHECK(resourcePool.GetNumUsedSlots() == 0);
+    Log::Info("ResourcePool: %d resources, alloc %.2f ns, lookup %.2f ns, free %.2f ns\n",
+        numResources,
+        allocDur.count() * 1e9 / numResources,
+        lookupDur.count() * 1e9 / numResources,
+        freeDur.count() * 1e9 / numResources);
+    resourcePool.Discard();
+}
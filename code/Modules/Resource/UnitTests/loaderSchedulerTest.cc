@@ -0,0 +1,188 @@
+//------------------------------------------------------------------------------
+//  loaderSchedulerTest.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "UnitTest++/src/UnitTest++.h"
+#include "Resource/Core/loaderScheduler.h"
+#include "Core/Containers/Array.h"
+#include "Time/Clock.h"
+#if ORYOL_HAS_THREADS
+#include <thread>
+#endif
+
+using namespace Oryol;
+using namespace _priv;
+
+static Array<int32> continueOrder;
+
+class testLoader : public ResourceLoader {
+    OryolClassDecl(testLoader);
+public:
+    testLoader(int32 id_, bool notifies_, int32 numSteps_, int32 busyMicroSecs_ = 0) :
+    id(id_), notifies(notifies_), numSteps(numSteps_), busyMicroSecs(busyMicroSecs_) { };
+    virtual Id Start() override {
+        return Id(0, this->id, 0);
+    };
+    virtual ResourceState::Code Continue() override {
+        continueOrder.Add(this->id);
+        if (this->busyMicroSecs > 0) {
+            const TimePoint start = Clock::Now();
+            while (Clock::Since(start).AsMicroSeconds() < this->busyMicroSecs) { }
+        }
+        this->numContinued++;
+        if (this->numContinued >= this->numSteps) {
+            return this->fail ? ResourceState::Failed : ResourceState::Valid;
+        }
+        return ResourceState::Pending;
+    };
+    virtual void Cancel() override {
+        this->cancelled = true;
+    };
+    virtual bool NotifiesReady() const override {
+        return this->notifies;
+    };
+    int32 id;
+    bool notifies;
+    int32 numSteps;
+    int32 busyMicroSecs;
+    int32 numContinued = 0;
+    bool fail = false;
+    bool cancelled = false;
+};
+OryolClassImpl(testLoader);
+
+//------------------------------------------------------------------------------
+TEST(loaderSchedulerNotifyTest) {
+    continueOrder.Clear();
+    loaderScheduler scheduler;
+    scheduler.setup();
+    CHECK(scheduler.isValid());
+
+    auto polled = testLoader::Create(0, false, 2);
+    auto notified = testLoader::Create(1, true, 1);
+    CHECK(scheduler.add(polled).SlotIndex == 0);
+    CHECK(scheduler.add(notified).SlotIndex == 1);
+    CHECK(scheduler.numPending() == 2);
+
+    // only the polled loader is continued while the other loader isn't ready
+    scheduler.update(0);
+    CHECK(continueOrder.Size() == 1);
+    CHECK(continueOrder[0] == 0);
+    CHECK(scheduler.stats().NumPolled == 1);
+    CHECK(scheduler.stats().NumContinued == 1);
+    CHECK(scheduler.stats().QueueDepth == 2);
+
+    // signal readiness from another thread, multiple calls have no effect
+    auto readyFunc = notified->ReadyFunc();
+    #if ORYOL_HAS_THREADS
+    std::thread thread([readyFunc]() {
+        readyFunc();
+        readyFunc();
+    });
+    thread.join();
+    #else
+    readyFunc();
+    readyFunc();
+    #endif
+    continueOrder.Clear();
+    scheduler.update(0);
+    CHECK(continueOrder.Size() == 2);
+    CHECK(continueOrder[0] == 0);
+    CHECK(continueOrder[1] == 1);
+    CHECK(scheduler.numPending() == 0);
+    CHECK(scheduler.stats().NumCompleted == 2);
+    CHECK(scheduler.stats().NumFailed == 0);
+    CHECK(scheduler.stats().NumPolled == 0);
+    CHECK(scheduler.stats().QueueDepth == 0);
+
+    // late notifications of finished loaders are ignored
+    readyFunc();
+    continueOrder.Clear();
+    scheduler.update(0);
+    CHECK(continueOrder.Empty());
+    CHECK(scheduler.stats().NumContinued == 0);
+    scheduler.discard();
+    CHECK(!scheduler.isValid());
+}
+
+//------------------------------------------------------------------------------
+TEST(loaderSchedulerPriorityTest) {
+    continueOrder.Clear();
+    loaderScheduler scheduler;
+    scheduler.setup();
+    Array<Ptr<testLoader>> loaders;
+    const int32 prios[] = { 5, -1, 5, 0, 2 };
+    for (int32 i = 0; i < 5; i++) {
+        auto loader = testLoader::Create(i, true, 1);
+        loader->SetPriority(prios[i]);
+        loader->fail = (i == 4);
+        scheduler.add(loader);
+        loaders.Add(loader);
+    }
+    // notify in reverse order, order of notification doesn't matter
+    for (int32 i = 4; i >= 0; i--) {
+        loaders[i]->ReadyFunc()();
+    }
+    scheduler.update(0);
+    CHECK(continueOrder.Size() == 5);
+    CHECK(continueOrder[0] == 1);
+    CHECK(continueOrder[1] == 3);
+    CHECK(continueOrder[2] == 4);
+    CHECK(continueOrder[3] == 0);
+    CHECK(continueOrder[4] == 2);
+    CHECK(scheduler.stats().NumCompleted == 5);
+    CHECK(scheduler.stats().NumFailed == 1);
+    CHECK(scheduler.stats().MaxTimeToReady >= scheduler.stats().AvgTimeToReady);
+    scheduler.discard();
+}
+
+//------------------------------------------------------------------------------
+TEST(loaderSchedulerBudgetTest) {
+    continueOrder.Clear();
+    loaderScheduler scheduler;
+    scheduler.setup();
+    Array<Ptr<testLoader>> loaders;
+    for (int32 i = 0; i < 4; i++) {
+        auto loader = testLoader::Create(i, true, 1, 2000);
+        scheduler.add(loader);
+        loader->ReadyFunc()();
+        loaders.Add(loader);
+    }
+
+    // a budget smaller than one Continue() still makes progress
+    scheduler.update(1);
+    CHECK(continueOrder.Size() == 1);
+    CHECK(scheduler.stats().NumContinued == 1);
+    CHECK(scheduler.stats().NumDeferred == 3);
+    CHECK(scheduler.stats().QueueDepth == 3);
+
+    // a higher-priority loader overtakes the deferred loaders (it must
+    // exceed the budget on its own, otherwise a deferred loader would
+    // be continued in the same update)
+    auto urgent = testLoader::Create(10, true, 1, 2000);
+    urgent->SetPriority(-10);
+    scheduler.add(urgent);
+    urgent->ReadyFunc()();
+    scheduler.update(1);
+    CHECK(continueOrder.Size() == 2);
+    CHECK(continueOrder[1] == 10);
+    CHECK(scheduler.stats().NumDeferred == 3);
+
+    // an unlimited budget drains the ready queue in start order
+    scheduler.update(0);
+    CHECK(continueOrder.Size() == 5);
+    CHECK(continueOrder[2] == 1);
+    CHECK(continueOrder[3] == 2);
+    CHECK(continueOrder[4] == 3);
+    CHECK(scheduler.stats().NumDeferred == 0);
+    // UpdateTime only covers the last update: 3 deferred loaders at 2ms each
+    CHECK(scheduler.stats().UpdateTime.AsMicroSeconds() >= 6000.0);
+    CHECK(scheduler.numPending() == 0);
+
+    // discard cancels pending loaders
+    auto pending = testLoader::Create(11, true, 1);
+    scheduler.add(pending);
+    scheduler.discard();
+    CHECK(pending->cancelled);
+    CHECK(!loaders[0]->cancelled);
+}
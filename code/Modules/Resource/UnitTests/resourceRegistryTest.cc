@@ -4,6 +4,9 @@
 #include "Pre.h"
 #include "UnitTest++/src/UnitTest++.h"
 #include "Resource/Core/resourceRegistry.h"
+#include "Core/Log.h"
+#include "Core/String/StringBuilder.h"
+#include <chrono>
 
 using namespace Oryol;
 using namespace Oryol::_priv;
@@ -76,3 +79,99 @@ TEST(ResourceRegistryTest) {
 
     reg.Discard();
 }
+
+TEST(ResourceRegistryLabelTest) {
+    resourceRegistry reg;
+    reg.Setup(16);
+
+    // interleave resources with 3 labels
+    StringBuilder strBuilder;
+    for (int32 i = 0; i < 12; i++) {
+        strBuilder.Format(32, "res%d", i);
+        reg.Add(Locator(strBuilder.GetString()), Id(0, i, 1), i % 3);
+    }
+    CHECK(reg.GetNumResources() == 12);
+
+    // removed in reverse creation order
+    Array<Id> removed = reg.Remove(1);
+    CHECK(removed.Size() == 4);
+    CHECK(removed[0] == Id(0, 10, 1));
+    CHECK(removed[3] == Id(0, 1, 1));
+    CHECK(reg.GetNumResources() == 8);
+    for (int32 i = 0; i < 12; i++) {
+        strBuilder.Format(32, "res%d", i);
+        const Id id(0, i, 1);
+        if (1 == (i % 3)) {
+            CHECK(!reg.Contains(id));
+            CHECK(!reg.Lookup(Locator(strBuilder.GetString())).IsValid());
+        }
+        else {
+            CHECK(reg.Contains(id));
+            CHECK(reg.Lookup(Locator(strBuilder.GetString())) == id);
+            CHECK(reg.GetLabel(id) == uint32(i % 3));
+        }
+    }
+
+    // a removed label can be used again
+    reg.Add(Locator("new"), Id(1, 1, 1), 1);
+    CHECK(reg.Remove(1).Size() == 1);
+    CHECK(reg.Remove(1).Size() == 0);
+    CHECK(reg.Remove(0).Size() == 4);
+    CHECK(reg.GetNumResources() == 4);
+    CHECK(reg.Lookup(Locator("res11")) == Id(0, 11, 1));
+    removed = reg.Remove(ResourceLabel::All);
+    CHECK(removed.Size() == 4);
+    CHECK(reg.GetNumResources() == 0);
+    CHECK(!reg.Lookup(Locator("res11")).IsValid());
+    reg.Discard();
+}
+
+TEST(ResourceRegistryBenchmark) {
+    using namespace std::chrono;
+
+    // 100k resources in 1000 labels
+    const int32 numResources = 100000;
+    const int32 numLabels = 1000;
+    Array<Locator> locs;
+    locs.Reserve(numResources);
+    StringBuilder strBuilder;
+    for (int32 i = 0; i < numResources; i++) {
+        strBuilder.Format(32, "res%d", i);
+        locs.Add(Locator(strBuilder.GetString()));
+    }
+
+    resourceRegistry reg;
+    reg.Setup(256);
+    auto start = high_resolution_clock::now();
+    for (int32 i = 0; i < numResources; i++) {
+        reg.Add(locs[i], Id(0, i, 1), i / (numResources / numLabels));
+    }
+    duration<double> addDur = high_resolution_clock::now() - start;
+    CHECK(reg.GetNumResources() == numResources);
+
+    start = high_resolution_clock::now();
+    int32 numFound = 0;
+    for (int32 i = 0; i < numResources; i++) {
+        if (reg.Lookup(locs[(i * 7919) % numResources]).IsValid()) {
+            numFound++;
+        }
+    }
+    duration<double> lookupDur = high_resolution_clock::now() - start;
+    CHECK(numFound == numResources);
+
+    // destroy labels in a different order than created
+    start = high_resolution_clock::now();
+    int32 numRemoved = 0;
+    for (int32 i = 0; i < numLabels; i++) {
+        numRemoved += reg.Remove((i * 7) % numLabels).Size();
+    }
+    duration<double> removeDur = high_resolution_clock::now() - start;
+    CHECK(numRemoved == numResources);
+    CHECK(reg.GetNumResources() == 0);
+    Log::Info("resourceRegistry: %d resources, add %.2f ns, lookup %.2f ns, remove by label %.2f ns\n",
+        numResources,
+        addDur.count() * 1e9 / numResources,
+        lookupDur.count() * 1e9 / numResources,
+        removeDur.count() * 1e9 / numResources);
+    reg.Discard();
+}
@@ -6,6 +6,8 @@
     @brief setup parameters for the Synth subsystem
 */
 #include "Core/Types.h"
+#include "Core/String/String.h"
+#include <functional>
 
 namespace Oryol {
     
@@ -13,10 +15,23 @@ class SynthSetup {
 public:
     /// use GPU audio rendering
     bool UseGPUSynthesizer = false;
-    /// number of voices
+    /// number of voices (max 64)
     int32 NumVoices = 4;
+    /// render voices in parallel on the JobSystem with at least this many voices (only with UseAudioThread=false, the audio thread can't run jobs)
+    int32 MinParallelVoices = 16;
     /// number of samples in waveforms (default: 32)
     int32 WaveFormNumSamples = 32;
+    /// render audio on a dedicated thread (if the platform has threads, not with the GPU synthesizer), voices are then always rendered serially
+    bool UseAudioThread = true;
+    /// capacity of the op queue to the audio thread (must be a power of 2)
+    int32 OpQueueCapacity = 4096;
+    
+    /// headless backend: render on demand with RenderOffline() instead of following the wall clock
+    bool RenderOffline = false;
+    /// headless backend: optional path of a WAV file which receives the rendered audio
+    String WavFilePath;
+    /// headless backend: optional function which receives each rendered interleaved stereo buffer
+    std::function<void(const int16* samples, int32 numFrames)> OutputFunc;
 };
     
 } // namespace Oryol
\ No newline at end of file
@@ -0,0 +1,43 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::SynthStats
+    @ingroup Synth
+    @brief audio rendering statistics of the Synth module
+    
+    With an audio thread, the statistics are a snapshot taken
+    while the audio thread keeps running.
+*/
+#include "Core/Types.h"
+#include "Time/Duration.h"
+#include "Synth/Core/synth.h"
+
+namespace Oryol {
+    
+class SynthStats {
+public:
+    /// number of rendered sample buffers
+    int32 NumRenderedBuffers = 0;
+    /// number of rendered samples (per channel)
+    int64 NumRenderedSamples = 0;
+    /// wall-clock time spent synthesizing and mixing
+    Duration RenderTime;
+    /// number of times the audio output ran dry before new samples were rendered
+    int32 NumUnderruns = 0;
+    /// rendered audio which was waiting for playback after the last render
+    Duration Latency;
+    /// number of times AddOp() had to wait because the op queue was full
+    int32 NumQueueStalls = 0;
+    
+    /// get the duration of the rendered audio in seconds
+    float64 AudioSeconds() const {
+        return float64(this->NumRenderedSamples) / float64(_priv::synth::SampleRate);
+    };
+    /// get rendering throughput in seconds of audio per wall-clock second
+    float64 Throughput() const {
+        const float64 renderSeconds = this->RenderTime.AsSeconds();
+        return renderSeconds > 0.0 ? (this->AudioSeconds() / renderSeconds) : 0.0;
+    };
+};
+    
+} // namespace Oryol
\ No newline at end of file
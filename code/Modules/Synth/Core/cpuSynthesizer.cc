@@ -4,36 +4,360 @@
 #include "Pre.h"
 #include "Core/Assertion.h"
 #include "Core/Memory/Memory.h"
+#include "Core/Threading/JobSystem.h"
 #include "cpuSynthesizer.h"
 #if ORYOL_WINDOWS
 #define _USE_MATH_DEFINES
 #endif
 #include <cmath>
-#include <cstdlib>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define ORYOL_SYNTH_SSE2 (1)
+#include <emmintrin.h>
+#if defined(__SSE4_1__)
+#define ORYOL_SYNTH_SSE41 (1)
+#include <smmintrin.h>
+#endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define ORYOL_SYNTH_NEON (1)
+#include <arm_neon.h>
+#endif
 
 namespace Oryol {
 namespace _priv {
 
+#if ORYOL_SYNTH_SSE2
+//------------------------------------------------------------------------------
+/**
+ 32-bit multiply keeping the low 32 bits (SSE2 only has an unsigned
+ 32x32->64 multiply for 2 lanes).
+*/
+static inline __m128i
+mullo_epi32(__m128i a, __m128i b) {
+    #if ORYOL_SYNTH_SSE41
+    return _mm_mullo_epi32(a, b);
+    #else
+    const __m128i even = _mm_mul_epu32(a, b);
+    const __m128i odd = _mm_mul_epu32(_mm_srli_si128(a, 4), _mm_srli_si128(b, 4));
+    return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0,0,2,0)), _mm_shuffle_epi32(odd, _MM_SHUFFLE(0,0,2,0)));
+    #endif
+}
+
+//------------------------------------------------------------------------------
+static inline __m128i
+clamp_epi32(__m128i v, __m128i minVal, __m128i maxVal) {
+    #if ORYOL_SYNTH_SSE41
+    return _mm_min_epi32(_mm_max_epi32(v, minVal), maxVal);
+    #else
+    const __m128i lt = _mm_cmplt_epi32(v, minVal);
+    v = _mm_or_si128(_mm_and_si128(lt, minVal), _mm_andnot_si128(lt, v));
+    const __m128i gt = _mm_cmpgt_epi32(v, maxVal);
+    return _mm_or_si128(_mm_and_si128(gt, maxVal), _mm_andnot_si128(gt, v));
+    #endif
+}
+#endif
+
+//------------------------------------------------------------------------------
+/**
+ Sample a canned wave at BlockSize successive frequency counter values,
+ this must produce the same results as cpuSynthesizer::sample():
+ out[i] = ((wave[((counter + (i+1)*t) >> 12) % numWaveSamples] * amp) >> 15) + bias
+*/
+static void
+waveKernel(const int32* wave, int32 numWaveSamples, uint32 counter, uint32 t, int32 amp, int32 bias, int32* out) {
+    const int32 BlockSize = cpuSynthesizer::BlockSize;
+    const uint32 mask = uint32(numWaveSamples - 1);
+    alignas(16) int32 indices[BlockSize];
+
+    // phase accumulation
+    #if ORYOL_SYNTH_SSE2
+    __m128i c = _mm_setr_epi32(int32(counter + t), int32(counter + 2*t), int32(counter + 3*t), int32(counter + 4*t));
+    const __m128i step = _mm_set1_epi32(int32(4 * t));
+    const __m128i vmask = _mm_set1_epi32(int32(mask));
+    for (int32 i = 0; i < BlockSize; i += 4) {
+        _mm_store_si128((__m128i*)&indices[i], _mm_and_si128(_mm_srli_epi32(c, 12), vmask));
+        c = _mm_add_epi32(c, step);
+    }
+    #elif ORYOL_SYNTH_NEON
+    const uint32 init[4] = { counter + t, counter + 2*t, counter + 3*t, counter + 4*t };
+    uint32x4_t c = vld1q_u32(init);
+    const uint32x4_t step = vdupq_n_u32(4 * t);
+    const uint32x4_t vmask = vdupq_n_u32(mask);
+    for (int32 i = 0; i < BlockSize; i += 4) {
+        vst1q_s32(&indices[i], vreinterpretq_s32_u32(vandq_u32(vshrq_n_u32(c, 12), vmask)));
+        c = vaddq_u32(c, step);
+    }
+    #else
+    for (int32 i = 0; i < BlockSize; i++) {
+        counter += t;
+        indices[i] = int32((counter >> 12) & mask);
+    }
+    #endif
+
+    // wavetable gather (no integer gather in SSE2 or NEON)
+    for (int32 i = 0; i < BlockSize; i++) {
+        out[i] = wave[indices[i]];
+    }
+
+    // scale and bias
+    #if ORYOL_SYNTH_SSE2
+    const __m128i vamp = _mm_set1_epi32(amp);
+    const __m128i vbias = _mm_set1_epi32(bias);
+    for (int32 i = 0; i < BlockSize; i += 4) {
+        __m128i s = _mm_load_si128((const __m128i*)&out[i]);
+        s = _mm_add_epi32(_mm_srai_epi32(mullo_epi32(s, vamp), 15), vbias);
+        _mm_store_si128((__m128i*)&out[i], s);
+    }
+    #elif ORYOL_SYNTH_NEON
+    const int32x4_t vamp = vdupq_n_s32(amp);
+    const int32x4_t vbias = vdupq_n_s32(bias);
+    for (int32 i = 0; i < BlockSize; i += 4) {
+        int32x4_t s = vld1q_s32(&out[i]);
+        s = vaddq_s32(vshrq_n_s32(vmulq_s32(s, vamp), 15), vbias);
+        vst1q_s32(&out[i], s);
+    }
+    #else
+    for (int32 i = 0; i < BlockSize; i++) {
+        out[i] = ((out[i] * amp) >> 15) + bias;
+    }
+    #endif
+}
+
+//------------------------------------------------------------------------------
+/**
+ Combine a block of track samples with the accumulated samples.
+*/
+static void
+combineKernel(SynthOp::OpT op, const int32* s, int32* accum) {
+    const int32 BlockSize = cpuSynthesizer::BlockSize;
+    switch (op) {
+        case SynthOp::Modulate:
+            #if ORYOL_SYNTH_SSE2
+            for (int32 i = 0; i < BlockSize; i += 4) {
+                const __m128i a = _mm_load_si128((const __m128i*)&accum[i]);
+                const __m128i b = _mm_load_si128((const __m128i*)&s[i]);
+                _mm_store_si128((__m128i*)&accum[i], _mm_srai_epi32(mullo_epi32(a, b), 15));
+            }
+            #elif ORYOL_SYNTH_NEON
+            for (int32 i = 0; i < BlockSize; i += 4) {
+                vst1q_s32(&accum[i], vshrq_n_s32(vmulq_s32(vld1q_s32(&accum[i]), vld1q_s32(&s[i])), 15));
+            }
+            #else
+            for (int32 i = 0; i < BlockSize; i++) {
+                accum[i] = (accum[i] * s[i]) >> 15;
+            }
+            #endif
+            break;
+        case SynthOp::Add:
+            #if ORYOL_SYNTH_SSE2
+            {
+                const __m128i minVal = _mm_set1_epi32(synth::MinSampleVal);
+                const __m128i maxVal = _mm_set1_epi32(synth::MaxSampleVal);
+                for (int32 i = 0; i < BlockSize; i += 4) {
+                    const __m128i a = _mm_load_si128((const __m128i*)&accum[i]);
+                    const __m128i b = _mm_load_si128((const __m128i*)&s[i]);
+                    _mm_store_si128((__m128i*)&accum[i], clamp_epi32(_mm_add_epi32(a, b), minVal, maxVal));
+                }
+            }
+            #elif ORYOL_SYNTH_NEON
+            {
+                const int32x4_t minVal = vdupq_n_s32(synth::MinSampleVal);
+                const int32x4_t maxVal = vdupq_n_s32(synth::MaxSampleVal);
+                for (int32 i = 0; i < BlockSize; i += 4) {
+                    const int32x4_t sum = vaddq_s32(vld1q_s32(&accum[i]), vld1q_s32(&s[i]));
+                    vst1q_s32(&accum[i], vminq_s32(vmaxq_s32(sum, minVal), maxVal));
+                }
+            }
+            #else
+            for (int32 i = 0; i < BlockSize; i++) {
+                int32 a = accum[i] + s[i];
+                if (a < synth::MinSampleVal) a = synth::MinSampleVal;
+                else if (a > synth::MaxSampleVal) a = synth::MaxSampleVal;
+                accum[i] = a;
+            }
+            #endif
+            break;
+        case SynthOp::Replace:
+        case SynthOp::ModFreq:
+            for (int32 i = 0; i < BlockSize; i++) {
+                accum[i] = s[i];
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+//------------------------------------------------------------------------------
+cpuSynthesizer::cpuSynthesizer() :
+minParallelVoices(0) {
+    // empty
+}
+
 //------------------------------------------------------------------------------
 void
-cpuSynthesizer::Setup(const SynthSetup& /*setupParams*/) {
+cpuSynthesizer::Setup(const SynthSetup& setupParams) {
+    o_assert(setupParams.NumVoices <= synth::MaxNumVoices);
+    this->minParallelVoices = setupParams.MinParallelVoices;
     this->setupWaves();
     Memory::Clear(this->freqCounters, sizeof(this->freqCounters));
 }
 
 //------------------------------------------------------------------------------
 void
+cpuSynthesizer::SetMinParallelVoices(int32 num) {
+    this->minParallelVoices = num;
+}
+
+//------------------------------------------------------------------------------
+/**
+ Each voice only writes its own sample buffer and frequency counters,
+ so voices can be rendered on different threads without changing the
+ output.
+*/
+void
 cpuSynthesizer::Synthesize(const opBundle& bundle) {
-    for (int32 voiceIndex = 0; voiceIndex < synth::NumVoices; voiceIndex++) {
-        this->synthesizeVoice(voiceIndex, bundle);
+    o_assert_dbg(bundle.NumVoices <= synth::MaxNumVoices);
+    if (JobSystem::IsValid() && (bundle.NumVoices >= this->minParallelVoices) && (bundle.NumVoices > 1)) {
+        JobSystem::ParallelFor(bundle.NumVoices, 1, [this, &bundle](int32 begin, int32 end) {
+            for (int32 voiceIndex = begin; voiceIndex < end; voiceIndex++) {
+                this->synthesizeVoice(voiceIndex, bundle);
+            }
+        });
     }
+    else {
+        for (int32 voiceIndex = 0; voiceIndex < bundle.NumVoices; voiceIndex++) {
+            this->synthesizeVoice(voiceIndex, bundle);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+cpuSynthesizer::SynthesizeReference(const opBundle& bundle) {
+    o_assert_dbg(bundle.NumVoices <= synth::MaxNumVoices);
+    for (int32 voiceIndex = 0; voiceIndex < bundle.NumVoices; voiceIndex++) {
+        this->synthesizeVoiceReference(voiceIndex, bundle);
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+ Same lookup as opBundle::Op(), but also computes the first tick
+ where the result may change: the end of the found op, or the start
+ of the next op if there's currently no active op. Ops of a track
+ are sorted and don't overlap, and tick only moves forward, so the
+ cursor skips each op at most once per buffer.
+*/
+const SynthOp*
+cpuSynthesizer::findOp(const SynthOp*& inOutCursor, const SynthOp* end, int32 tick, int32& inOutRunEnd) {
+    const SynthOp* op = inOutCursor;
+    while ((op < end) && (op->endTick <= tick)) {
+        op++;
+    }
+    inOutCursor = op;
+    if (op < end) {
+        if (tick >= op->startTick) {
+            if (op->endTick < inOutRunEnd) {
+                inOutRunEnd = op->endTick;
+            }
+            return op;
+        }
+        else if (op->startTick < inOutRunEnd) {
+            inOutRunEnd = op->startTick;
+        }
+    }
+    return nullptr;
 }
 
 //------------------------------------------------------------------------------
 void
 cpuSynthesizer::synthesizeVoice(int32 voiceIndex, const opBundle& bundle) {
     o_assert_dbg(synth::BufferSize == bundle.BufferNumBytes);
-    o_assert_range_dbg(voiceIndex, synth::NumVoices);
+    o_assert_range_dbg(voiceIndex, bundle.NumVoices);
+    
+    int16* samplePtr = (int16*) bundle.Buffer[voiceIndex];
+    const int32 endTick = bundle.EndTick[voiceIndex];
+    int32 curTick = bundle.StartTick[voiceIndex];
+    const SynthOp* cursors[synth::NumTracks];
+    for (int32 trackIndex = 0; trackIndex < synth::NumTracks; trackIndex++) {
+        cursors[trackIndex] = bundle.Begin[voiceIndex][trackIndex];
+    }
+    while (curTick < endTick) {
+        // find the active ops, and the run of ticks where they don't change
+        const SynthOp* ops[synth::NumTracks];
+        int32 runEnd = endTick;
+        for (int32 trackIndex = 0; trackIndex < synth::NumTracks; trackIndex++) {
+            ops[trackIndex] = findOp(cursors[trackIndex], bundle.End[voiceIndex][trackIndex], curTick, runEnd);
+        }
+        o_assert_dbg(runEnd > curTick);
+        
+        // render the run in blocks
+        while (curTick < runEnd) {
+            int32 numSamples = runEnd - curTick;
+            if (numSamples > BlockSize) {
+                numSamples = BlockSize;
+            }
+            this->renderBlock(voiceIndex, ops, numSamples, samplePtr);
+            samplePtr += numSamples;
+            curTick += numSamples;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+ All kernels always process BlockSize samples, only the first
+ numSamples samples are written to dst, and the frequency counters
+ are only advanced by numSamples.
+*/
+void
+cpuSynthesizer::renderBlock(int32 voiceIndex, const SynthOp* const* ops, int32 numSamples, int16* dst) {
+    o_assert_dbg((numSamples > 0) && (numSamples <= BlockSize));
+    alignas(16) int32 accum[BlockSize];
+    alignas(16) int32 s[BlockSize];
+    for (int32 i = 0; i < BlockSize; i++) {
+        accum[i] = 0;
+    }
+    for (int32 trackIndex = 0; trackIndex < synth::NumTracks; trackIndex++) {
+        const SynthOp* op = ops[trackIndex];
+        if (nullptr == op) {
+            continue;
+        }
+        if (SynthOp::Const == op->Wave) {
+            // constant value, doesn't update the frequency counter
+            const int32 c = op->Amp + op->Bias;
+            for (int32 i = 0; i < BlockSize; i++) {
+                s[i] = c;
+            }
+        }
+        else if (SynthOp::ModFreq == op->Op) {
+            // the frequency depends on the accumulated value, so the
+            // phase can't be computed in parallel
+            for (int32 i = 0; i < numSamples; i++) {
+                s[i] = this->sample(voiceIndex, trackIndex, accum[i], op);
+            }
+        }
+        else {
+            uint32& counter = this->freqCounters[voiceIndex][trackIndex];
+            const uint32 t = (((uint32(op->Freq) * NumWaveSamples) << 12) / synth::SampleRate);
+            if (SynthOp::Nop != op->Op) {
+                waveKernel(this->waves[op->Wave], NumWaveSamples, counter, t, op->Amp, op->Bias, s);
+            }
+            counter += t * uint32(numSamples);
+        }
+        combineKernel(op->Op, s, accum);
+    }
+    // convert to 16-bit with truncation (not saturation!)
+    for (int32 i = 0; i < numSamples; i++) {
+        dst[i] = int16(accum[i]);
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+cpuSynthesizer::synthesizeVoiceReference(int32 voiceIndex, const opBundle& bundle) {
+    o_assert_dbg(synth::BufferSize == bundle.BufferNumBytes);
+    o_assert_range_dbg(voiceIndex, bundle.NumVoices);
     
     // the sample tick range covered by the buffer
     int16* samplePtr = (int16*) bundle.Buffer[voiceIndex];
@@ -141,9 +465,11 @@ cpuSynthesizer::setupWaves() {
         }
     }
     
-    // noise
+    // noise (from a fixed-seed LCG, so that the output is deterministic)
+    uint32 seed = 0x13579BDF;
     for (int32 i = 0; i < NumWaveSamples; i++) {
-        this->waves[SynthOp::Noise][i] = (std::rand() & 0xFFFF) - 0x7FFF;
+        seed = seed * 1664525 + 1013904223;
+        this->waves[SynthOp::Noise][i] = int32((seed >> 16) & 0xFFFF) - 0x7FFF;
     }
     
     // Pacman arcade machine waveforms, see here:
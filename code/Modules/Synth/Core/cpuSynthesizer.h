@@ -7,7 +7,16 @@
     
     The cpuSynthesize class takes an opBundle object and fills sample
     buffers with samples (one for each voice). Samples are synthesized
-    on the CPU.
+    on the CPU. Voices are independent from each other, with many voices
+    they are rendered in parallel on the JobSystem (if it has been setup).
+    
+    The sample buffer of a voice is split into runs where the op of
+    each track doesn't change (found with a per-track cursor which only
+    moves forward through the ops), each run is rendered in blocks of
+    BlockSize samples with SSE2 or NEON kernels (where available).
+    SynthesizeReference() evaluates every sample tick separately and
+    produces the exact same output, it is only kept for testing and
+    benchmarking.
 */
 #include "Synth/Core/SynthSetup.h"
 #include "Synth/Core/opBundle.h"
@@ -17,22 +26,39 @@ namespace _priv {
     
 class cpuSynthesizer {
 public:
+    /// constructor
+    cpuSynthesizer();
+
     /// setup the synthesizer
     void Setup(const SynthSetup& setupParams);
+    /// set the min number of voices for parallel rendering on the JobSystem
+    void SetMinParallelVoices(int32 num);
     /// synthesize!
     void Synthesize(const opBundle& bundle);
+    /// synthesize sample by sample (slow reference implementation)
+    void SynthesizeReference(const opBundle& bundle);
+
+    /// number of samples rendered at once
+    static const int32 BlockSize = 16;
 
 private:
     /// setup the wave samples
     void setupWaves();
-    /// synthesize a single voice
+    /// synthesize a single voice in blocks
     void synthesizeVoice(int32 voiceIndex, const opBundle& bundle);
+    /// synthesize a single voice sample by sample
+    void synthesizeVoiceReference(int32 voiceIndex, const opBundle& bundle);
+    /// advance a track's op cursor to tick, return the active op, and clamp the end of the run where the op doesn't change
+    static const SynthOp* findOp(const SynthOp*& inOutCursor, const SynthOp* end, int32 tick, int32& inOutRunEnd);
+    /// render up to BlockSize samples with constant ops
+    void renderBlock(int32 voiceIndex, const SynthOp* const* ops, int32 numSamples, int16* dst);
     /// generate a single voice-track sample
     int32 sample(int32 voiceIndex, int32 trackIndex, int32 accum, const SynthOp* op);
     
     static const int32 NumWaveSamples = 32;
+    int32 minParallelVoices;
     int32 waves[SynthOp::NumWaves][NumWaveSamples];
-    uint32 freqCounters[synth::NumVoices][synth::NumTracks];
+    uint32 freqCounters[synth::MaxNumVoices][synth::NumTracks];
 };
     
 } // namespace _priv
@@ -0,0 +1,127 @@
+//------------------------------------------------------------------------------
+//  mixer.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "mixer.h"
+#include "Core/Assertion.h"
+#if ORYOL_WINDOWS
+#define _USE_MATH_DEFINES
+#endif
+#include <cmath>
+
+namespace Oryol {
+namespace _priv {
+
+//------------------------------------------------------------------------------
+mixer::mixer() :
+isValid(false),
+numVoices(0) {
+    // empty
+}
+
+//------------------------------------------------------------------------------
+void
+mixer::Setup(int32 numVoices_) {
+    o_assert_dbg(!this->isValid);
+    o_assert((numVoices_ > 0) && (numVoices_ <= synth::MaxNumVoices));
+    this->isValid = true;
+    this->numVoices = numVoices_;
+    for (int32 i = 0; i < synth::MaxNumVoices; i++) {
+        this->voices[i] = voiceParams();
+        this->updateFactors(i);
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+mixer::Discard() {
+    o_assert_dbg(this->isValid);
+    this->isValid = false;
+    this->numVoices = 0;
+}
+
+//------------------------------------------------------------------------------
+bool
+mixer::IsValid() const {
+    return this->isValid;
+}
+
+//------------------------------------------------------------------------------
+void
+mixer::SetGain(int32 voice, float32 gain) {
+    o_assert_range_dbg(voice, this->numVoices);
+    o_assert_dbg((gain >= 0.0f) && (gain <= 1.0f));
+    this->voices[voice].gain = gain;
+    this->updateFactors(voice);
+}
+
+//------------------------------------------------------------------------------
+float32
+mixer::Gain(int32 voice) const {
+    o_assert_range_dbg(voice, this->numVoices);
+    return this->voices[voice].gain;
+}
+
+//------------------------------------------------------------------------------
+void
+mixer::SetPan(int32 voice, float32 pan) {
+    o_assert_range_dbg(voice, this->numVoices);
+    o_assert_dbg((pan >= -1.0f) && (pan <= 1.0f));
+    this->voices[voice].pan = pan;
+    this->updateFactors(voice);
+}
+
+//------------------------------------------------------------------------------
+float32
+mixer::Pan(int32 voice) const {
+    o_assert_range_dbg(voice, this->numVoices);
+    return this->voices[voice].pan;
+}
+
+//------------------------------------------------------------------------------
+void
+mixer::updateFactors(int32 voice) {
+    voiceParams& params = this->voices[voice];
+    const float32 angle = (params.pan + 1.0f) * float32(M_PI) * 0.25f;
+    params.left = int32(std::cos(angle) * params.gain * 32768.0f + 0.5f);
+    params.right = int32(std::sin(angle) * params.gain * 32768.0f + 0.5f);
+}
+
+//------------------------------------------------------------------------------
+void
+mixer::Mix(const opBundle& bundle, int16* dst) {
+    o_assert_dbg(this->isValid);
+    o_assert_dbg(bundle.NumVoices == this->numVoices);
+    o_assert_dbg(synth::BufferSize == bundle.BufferNumBytes);
+    o_assert_dbg(nullptr != dst);
+    const int32 numSamples = synth::BufferNumSamples;
+
+    for (int32 i = 0; i < synth::NumChannels * numSamples; i++) {
+        this->accum[i] = 0;
+    }
+    for (int32 voiceIndex = 0; voiceIndex < this->numVoices; voiceIndex++) {
+        const voiceParams& params = this->voices[voiceIndex];
+        if ((0 == params.left) && (0 == params.right)) {
+            continue;
+        }
+        const int16* src = (const int16*) bundle.Buffer[voiceIndex];
+        const int32 left = params.left;
+        const int32 right = params.right;
+        int32* acc = this->accum;
+        for (int32 i = 0; i < numSamples; i++) {
+            const int32 s = src[i];
+            acc[0] += (s * left) >> 15;
+            acc[1] += (s * right) >> 15;
+            acc += 2;
+        }
+    }
+    for (int32 i = 0; i < synth::NumChannels * numSamples; i++) {
+        int32 s = this->accum[i];
+        if (s < synth::MinSampleVal) s = synth::MinSampleVal;
+        else if (s > synth::MaxSampleVal) s = synth::MaxSampleVal;
+        dst[i] = int16(s);
+    }
+}
+
+} // namespace _priv
+} // namespace Oryol
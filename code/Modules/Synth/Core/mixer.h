@@ -0,0 +1,62 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::_priv::mixer
+    @ingroup _priv
+    @brief mix mono voice buffers into an interleaved stereo buffer
+    
+    Each voice has a gain and a pan position (constant-power panning),
+    which are converted to 15-bit fixed point left/right factors when
+    they are set. The mixing itself only uses integer math, so the 
+    mixed output doesn't depend on the platform or on the order in 
+    which the voices have been rendered.
+*/
+#include "Core/Types.h"
+#include "Synth/Core/synth.h"
+#include "Synth/Core/opBundle.h"
+
+namespace Oryol {
+namespace _priv {
+
+class mixer {
+public:
+    /// constructor
+    mixer();
+
+    /// setup the mixer
+    void Setup(int32 numVoices);
+    /// discard the mixer
+    void Discard();
+    /// return true if the mixer has been setup
+    bool IsValid() const;
+
+    /// set voice gain (0.0 is silent, 1.0 is full volume, no amplification)
+    void SetGain(int32 voice, float32 gain);
+    /// get voice gain
+    float32 Gain(int32 voice) const;
+    /// set voice pan position (-1.0 is left, 0.0 is center, 1.0 is right)
+    void SetPan(int32 voice, float32 pan);
+    /// get voice pan position
+    float32 Pan(int32 voice) const;
+
+    /// mix the voice buffers of an opBundle into interleaved stereo samples
+    void Mix(const opBundle& bundle, int16* dst);
+
+private:
+    /// update the fixed-point left/right factors of a voice
+    void updateFactors(int32 voice);
+
+    struct voiceParams {
+        float32 gain = 1.0f;
+        float32 pan = 0.0f;
+        int32 left = 0;
+        int32 right = 0;
+    };
+    bool isValid;
+    int32 numVoices;
+    voiceParams voices[synth::MaxNumVoices];
+    int32 accum[synth::NumChannels * synth::BufferNumSamples];
+};
+
+} // namespace _priv
+} // namespace Oryol
@@ -8,6 +8,7 @@
 #include "Core/Assertion.h"
 #include "Synth/Core/SynthOp.h"
 #include "Synth/Core/synth.h"
+#include <algorithm>
 
 namespace Oryol {
 namespace _priv {
@@ -16,10 +17,11 @@ class opBundle {
 public:
     /// constructor
     opBundle() :
+        NumVoices(0),
         BufferNumBytes(0) {
         
         // this is a workaround for VS2013 missing array initializers :/
-        for (int voice = 0; voice < synth::NumVoices; voice++) {
+        for (int voice = 0; voice < synth::MaxNumVoices; voice++) {
             this->StartTick[voice] = 0;
             this->EndTick[voice] = 0;
             this->Buffer[voice] = nullptr;
@@ -30,29 +32,32 @@ public:
         }
     };
 
+    /// number of used voices
+    int32 NumVoices;
     /// sample buffer start tick
-    int32 StartTick[synth::NumVoices];
+    int32 StartTick[synth::MaxNumVoices];
     /// sample buffer end tick
-    int32 EndTick[synth::NumVoices];
+    int32 EndTick[synth::MaxNumVoices];
     /// pointers to start op
-    SynthOp* Begin[synth::NumVoices][synth::NumTracks];
+    SynthOp* Begin[synth::MaxNumVoices][synth::NumTracks];
     /// one-past-end-pointers to end op
-    SynthOp* End[synth::NumVoices][synth::NumTracks];
+    SynthOp* End[synth::MaxNumVoices][synth::NumTracks];
     /// sample buffer pointers
-    void* Buffer[synth::NumVoices];
+    void* Buffer[synth::MaxNumVoices];
     /// sample buffer size in bytes
     int32 BufferNumBytes;
     
-    /// return op at voice, track and tick
+    /// return op at voice, track and tick (binary search, ops are sorted and don't overlap)
     SynthOp* Op(int32 voiceIndex, int32 trackIndex, int32 tick) const {
-        o_assert_range_dbg(voiceIndex, synth::NumVoices);
+        o_assert_range_dbg(voiceIndex, NumVoices);
         o_assert_range_dbg(trackIndex, synth::NumTracks);
         SynthOp* begin = Begin[voiceIndex][trackIndex];
-        const SynthOp* end = End[voiceIndex][trackIndex];
-        for (SynthOp* op = begin; op < end; op++) {
-            if ((tick >= op->startTick) && (tick < op->endTick)) {
-                return op;
-            }
+        SynthOp* end = End[voiceIndex][trackIndex];
+        SynthOp* op = std::upper_bound(begin, end, tick, [](int32 t, const SynthOp& op) {
+            return t < op.endTick;
+        });
+        if ((op < end) && (tick >= op->startTick)) {
+            return op;
         }
         // can't happen
         return nullptr;
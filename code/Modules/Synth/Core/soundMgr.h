@@ -5,16 +5,17 @@
     @ingroup _priv
     @brief internal sound manager wrapper class
 */
-#if (ORYOL_OSX || ORYOL_EMSCRIPTEN)
+#if (ORYOL_OSX || ORYOL_EMSCRIPTEN) && !ORYOL_SYNTH_NULL
 #include "Synth/al/alSoundMgr.h"
 namespace Oryol {
 namespace _priv {
 class soundMgr : public alSoundMgr { };
 } }
 #else
-#include "Synth/base/soundMgrBase.h"
+#define ORYOL_SYNTH_HEADLESS (1)
+#include "Synth/null/nullSoundMgr.h"
 namespace Oryol {
 namespace _priv {
-class soundMgr : public soundMgrBase { };
+class soundMgr : public nullSoundMgr { };
 } }
 #endif
\ No newline at end of file
@@ -22,10 +22,14 @@ public:
     static const int32 SampleSize = 2;
     /// number of samples in one streaming buffer
     static const int32 BufferNumSamples = 2 * 1024;
-    /// byte size of one streaming buffer
+    /// byte size of one (mono) voice buffer
     static const int32 BufferSize = SampleSize * BufferNumSamples;
-    /// number of voices
-    static const int32 NumVoices = 1;
+    /// number of output channels (mixed output is interleaved stereo)
+    static const int32 NumChannels = 2;
+    /// byte size of one mixed streaming buffer
+    static const int32 MixBufferSize = NumChannels * BufferSize;
+    /// max number of voices
+    static const int32 MaxNumVoices = 64;
     /// number of tracks per voice
     static const int32 NumTracks = 4;
     /// max sample value (16 bit signed)
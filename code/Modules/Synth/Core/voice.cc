@@ -25,7 +25,7 @@ voice::~voice() {
 void
 voice::Setup(int32 vcIndex, const SynthSetup& setupAttrs) {
     o_assert_dbg(!this->isValid);
-    o_assert_range_dbg(vcIndex, synth::NumVoices);
+    o_assert_range_dbg(vcIndex, synth::MaxNumVoices);
     
     this->voiceIndex = vcIndex;
     this->isValid = true;
@@ -49,6 +49,14 @@ voice::AddOp(int32 track, const SynthOp& op) {
     this->tracks[track].AddOp(op);
 }
 
+//------------------------------------------------------------------------------
+void
+voice::AddOps(int32 track, const SynthOp* ops, int32 numOps) {
+    o_assert_dbg(this->isValid);
+    o_assert_range_dbg(track, synth::NumTracks);
+    this->tracks[track].AddOps(ops, numOps);
+}
+
 //------------------------------------------------------------------------------
 void
 voice::GatherOps(int32 startTick, int32 endTick, opBundle& inOutBundle) {
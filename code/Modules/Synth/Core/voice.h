@@ -31,6 +31,8 @@ public:
     
     /// add new op to end of track
     void AddOp(int32 track, const SynthOp& op);
+    /// add ops with ascending start ticks to end of track
+    void AddOps(int32 track, const SynthOp* ops, int32 numOps);
     /// gather ops in tick range into opBundle
     void GatherOps(int32 startTick, int32 endTick, opBundle& inOutBundle);
 
@@ -3,6 +3,7 @@
 //------------------------------------------------------------------------------
 #include "Pre.h"
 #include "voiceTrack.h"
+#include "Core/Log.h"
 #include <algorithm>
 
 namespace Oryol {
@@ -10,7 +11,18 @@ namespace _priv {
     
 //------------------------------------------------------------------------------
 voiceTrack::voiceTrack() {
-    this->track.Reserve(32);
+    // empty
+}
+
+//------------------------------------------------------------------------------
+voiceTrack::voiceTrack(const voiceTrack& rhs) {
+    this->copy(rhs);
+}
+
+//------------------------------------------------------------------------------
+voiceTrack::voiceTrack(voiceTrack&& rhs) :
+ops(std::move(rhs.ops)) {
+    // empty
 }
 
 //------------------------------------------------------------------------------
@@ -20,38 +32,131 @@ voiceTrack::~voiceTrack() {
 
 //------------------------------------------------------------------------------
 void
-voiceTrack::AddOp(const SynthOp& op) {
+voiceTrack::operator=(const voiceTrack& rhs) {
+    if (&rhs != this) {
+        this->ops.destroy();
+        this->copy(rhs);
+    }
+}
 
-    // find insertion position, and truncate the track (discard any ops after it)
-    if (!this->track.Empty()) {
-        auto ptr = std::lower_bound(this->track.begin(), this->track.end(), op);
-        int32 index = ptr - this->track.begin();
-        while (index < this->track.Size()) {
-            this->track.Erase(this->track.Size() - 1);
-            o_warn("voiceTrack::Add(): track was truncated\n");
+//------------------------------------------------------------------------------
+void
+voiceTrack::operator=(voiceTrack&& rhs) {
+    if (&rhs != this) {
+        this->ops.destroy();
+        this->ops = std::move(rhs.ops);
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+voiceTrack::copy(const voiceTrack& rhs) {
+    const int32 size = rhs.ops.size();
+    if (size > 0) {
+        this->ops.alloc(size, 0);
+        elementBuffer<SynthOp>::copyConstruct(rhs.ops.elmStart, this->ops.elmStart, size);
+        this->ops.elmEnd = this->ops.elmStart + size;
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+voiceTrack::truncate(int32 tick) {
+    if ((0 == this->ops.size()) || (this->ops.back().startTick < tick)) {
+        // common case, appending at the end
+        return;
+    }
+    SynthOp* first = std::lower_bound(this->ops.elmStart, this->ops.elmEnd, tick,
+        [](const SynthOp& op, int32 t) {
+            return op.startTick < t;
+        });
+    const int32 numTruncated = int32(this->ops.elmEnd - first);
+    if (numTruncated > 0) {
+        while (this->ops.elmEnd > first) {
+            this->ops.popBack();
         }
+        o_warn("voiceTrack::AddOp(): track was truncated (%d ops)\n", numTruncated);
     }
+}
+
+//------------------------------------------------------------------------------
+/**
+ Moving the window to the front costs one copy per op, but this only
+ happens after at least as many ops have expired, so appending ops
+ is amortized O(1).
+*/
+void
+voiceTrack::reserveBack(int32 numOps) {
+    if (this->ops.backSpare() >= numOps) {
+        return;
+    }
+    const int32 size = this->ops.size();
+    const int32 frontSpare = this->ops.frontSpare();
+    if ((frontSpare >= size) && ((frontSpare + this->ops.backSpare()) >= numOps)) {
+        SynthOp* dst = this->ops.bufStart;
+        for (SynthOp* src = this->ops.elmStart; src < this->ops.elmEnd; src++, dst++) {
+            new(dst) SynthOp(*src);
+            src->~SynthOp();
+        }
+        this->ops.elmStart = this->ops.bufStart;
+        this->ops.elmEnd = this->ops.bufStart + size;
+    }
+    else {
+        int32 newCapacity = this->ops.capacity() * 2;
+        if (newCapacity < InitialCapacity) {
+            newCapacity = InitialCapacity;
+        }
+        if (newCapacity < (size + numOps)) {
+            newCapacity = size + numOps;
+        }
+        this->ops.alloc(newCapacity, 0);
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+voiceTrack::AddOp(const SynthOp& op) {
+    this->AddOps(&op, 1);
+}
+
+//------------------------------------------------------------------------------
+void
+voiceTrack::AddOps(const SynthOp* addOps, int32 numOps) {
+    o_assert_dbg(addOps && (numOps > 0));
+
+    // find insertion position, and truncate the track (discard any ops after it)
+    this->truncate(addOps[0].startTick);
+    this->reserveBack(numOps);
     
     // fix the end tick of the previous op
-    if (!this->track.Empty()) {
-        SynthOp& prev = this->track.Back();
-        prev.endTick = op.startTick;
+    for (int32 i = 0; i < numOps; i++) {
+        const SynthOp& op = addOps[i];
+        if (this->ops.size() > 0) {
+            SynthOp& prev = this->ops.back();
+            o_assert_dbg(prev.startTick < op.startTick);
+            prev.endTick = op.startTick;
+        }
+        this->ops.pushBack(op);
     }
-    this->track.Add(op);
 }
 
 //------------------------------------------------------------------------------
 void
 voiceTrack::discardExpiredOps(int32 tick) {
-    while (!this->track.Empty() && (tick > track.Front().endTick)) {
-        this->track.Erase(0);
+    while ((this->ops.size() > 0) && (tick > this->ops.front().endTick)) {
+        this->ops.popFront();
+    }
+    if (0 == this->ops.size()) {
+        // restart at the front of the buffer
+        this->ops.elmStart = this->ops.elmEnd = this->ops.bufStart;
     }
 }
 
 //------------------------------------------------------------------------------
 void
 voiceTrack::DiscardAllOps() {
-    this->track.Clear();
+    this->ops.clear();
+    this->ops.elmStart = this->ops.elmEnd = this->ops.bufStart;
 }
 
 //------------------------------------------------------------------------------
@@ -64,18 +169,12 @@ voiceTrack::GatherOps(int32 startTick, int32 endTick, SynthOp*& outOpBegin, Synt
     this->discardExpiredOps(startTick);
     
     // gather all ops with startTick < endTick
-    if (!this->track.Empty()) {
-        outOpBegin = &this->track.Front();
-        outOpEnd = outOpBegin;
-        const int numOps = this->track.Size();
-        for (int i = 0; i < numOps; i++) {
-            if (this->track[i].startTick < endTick) {
-                outOpEnd++;
-            }
-            else {
-                break;
-            }
-        }
+    if (this->ops.size() > 0) {
+        outOpBegin = this->ops.elmStart;
+        outOpEnd = std::lower_bound(this->ops.elmStart, this->ops.elmEnd, endTick,
+            [](const SynthOp& op, int32 t) {
+                return op.startTick < t;
+            });
     }
 }
 
@@ -9,9 +9,16 @@
     sound synthesis instruction stream). Ops overlap for a cross-fade
     period, when the time cursor is over a cross-fade section, 2
     Ops must be evaluated and will be mixed.
+    
+    Ops are stored in a sliding window of an element buffer: expired
+    ops are popped off the front in O(1), new ops are appended at the
+    back, and the window is only moved back to the start of the buffer
+    when the back is full and the free front space is at least as big
+    as the window. The ops of a track are always contiguous, so that
+    GatherOps() can return a pointer range.
 */
 #include "Synth/Core/SynthOp.h"
-#include "Core/Containers/Array.h"
+#include "Core/Containers/elementBuffer.h"
 
 namespace Oryol {
 namespace _priv {
@@ -20,22 +27,48 @@ class voiceTrack {
 public:
     /// constructor
     voiceTrack();
+    /// copy constructor
+    voiceTrack(const voiceTrack& rhs);
+    /// move constructor
+    voiceTrack(voiceTrack&& rhs);
     /// destructor
     ~voiceTrack();
     
+    /// copy-assignment operator
+    void operator=(const voiceTrack& rhs);
+    /// move-assignment operator
+    void operator=(voiceTrack&& rhs);
+    
     /// append a new op to the track (sorted by start tick of op)
     void AddOp(const SynthOp& op);
+    /// append ops with ascending start ticks (truncates the track only once)
+    void AddOps(const SynthOp* ops, int32 numOps);
     /// discard all ops
     void DiscardAllOps();
     /// gather ops between which overlap a tick range, outOpBegin can be nullptr, outOpEnd is 'one-past-ptr'!
     void GatherOps(int32 startTick, int32 endTick, SynthOp*& outOpBegin, SynthOp*& outOpEnd);
+    /// get number of ops in the track
+    int32 NumOps() const;
     
 private:
+    /// copy ops from other track
+    void copy(const voiceTrack& rhs);
     /// discard ops behind the play cursor (these no longer influence sound output)
     void discardExpiredOps(int32 tick);
+    /// discard all ops which start at or after tick
+    void truncate(int32 tick);
+    /// make room for numOps ops at the back
+    void reserveBack(int32 numOps);
 
-    Array<SynthOp> track;
+    static const int32 InitialCapacity = 32;
+    elementBuffer<SynthOp> ops;
 };
 
+//------------------------------------------------------------------------------
+inline int32
+voiceTrack::NumOps() const {
+    return this->ops.size();
+}
+
 } // namespace _priv
 } // namespace Oryol
\ No newline at end of file
@@ -45,4 +45,34 @@ Synth::AddOp(int32 voice, int32 track, const SynthOp& op, int32 timeOffset) {
     state->soundManager.AddOp(voice, track, op, timeOffset);
 }
 
+//------------------------------------------------------------------------------
+void
+Synth::SetVoiceGain(int32 voice, float32 gain) {
+    o_assert_dbg(IsValid());
+    state->soundManager.SetVoiceGain(voice, gain);
+}
+
+//------------------------------------------------------------------------------
+void
+Synth::SetVoicePan(int32 voice, float32 pan) {
+    o_assert_dbg(IsValid());
+    state->soundManager.SetVoicePan(voice, pan);
+}
+
+//------------------------------------------------------------------------------
+SynthStats
+Synth::Stats() {
+    o_assert_dbg(IsValid());
+    return state->soundManager.Stats();
+}
+
+#if ORYOL_SYNTH_HEADLESS
+//------------------------------------------------------------------------------
+void
+Synth::RenderOffline(float64 seconds) {
+    o_assert_dbg(IsValid());
+    state->soundManager.RenderOffline(seconds);
+}
+#endif
+
 } // namespace Oryol
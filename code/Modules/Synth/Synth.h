@@ -10,6 +10,7 @@
 */
 #include "Synth/Core/soundMgr.h"
 #include "Synth/Core/SynthOp.h"
+#include "Synth/Core/SynthStats.h"
 
 namespace Oryol {
     
@@ -21,10 +22,20 @@ public:
     static void Discard();
     /// check if Synth module is valid
     static bool IsValid();
-    /// update the sound system, call once per frame, advances tick
+    /// update the sound system, call once per frame (renders audio if there's no audio thread)
     static void Update();
-    /// add a sound synthesis Op
+    /// add a sound synthesis Op, timeOffset is in ticks from the current render position
     static void AddOp(int32 voice, int32 track, const SynthOp& op, int32 timeOffset = 0);
+    /// set the mixer gain of a voice (0.0 .. 1.0, default is 1.0)
+    static void SetVoiceGain(int32 voice, float32 gain);
+    /// set the stereo pan position of a voice (-1.0 is left, 1.0 is right, default is 0.0)
+    static void SetVoicePan(int32 voice, float32 pan);
+    /// get audio rendering statistics (latency, underruns, render time)
+    static SynthStats Stats();
+    #if ORYOL_SYNTH_HEADLESS
+    /// headless backend only: render the next seconds of audio as fast as possible (needs SynthSetup::RenderOffline)
+    static void RenderOffline(float64 seconds);
+    #endif
     
 private:
     struct _state {
@@ -0,0 +1,214 @@
+//------------------------------------------------------------------------------
+//  NullSynthTest.cc
+//  Offline rendering through the headless null backend, with a
+//  regression hash of the output and WAV file output, and realtime
+//  rendering on the audio thread, and the silent default without
+//  a headless output.
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "UnitTest++/src/UnitTest++.h"
+#include "Synth/null/nullSoundMgr.h"
+#include "Core/Log.h"
+#include <cstdio>
+#include <cstring>
+#if ORYOL_HAS_THREADS
+#include <atomic>
+#include <thread>
+#include <chrono>
+#endif
+
+using namespace Oryol;
+using namespace _priv;
+
+static const int32 NumVoices = 4;
+#if ORYOL_POSIX
+static const char* WavPath = "/tmp/oryol_nullsynth_test.wav";
+#endif
+
+static uint32 outputHash = 0;
+static int32 outputNumFrames = 0;
+
+//------------------------------------------------------------------------------
+/**
+ FNV-1a hash over all rendered samples, passed in through the
+ OutputFunc.
+*/
+static void
+hashOutput(const int16* samples, int32 numFrames) {
+    const uint8* ptr = (const uint8*) samples;
+    const int32 numBytes = numFrames * synth::NumChannels * synth::SampleSize;
+    for (int32 i = 0; i < numBytes; i++) {
+        outputHash = (outputHash ^ ptr[i]) * 16777619;
+    }
+    outputNumFrames += numFrames;
+}
+
+//------------------------------------------------------------------------------
+static void
+addOps(nullSoundMgr& soundMgr, int32 step) {
+    for (int32 voice = 0; voice < NumVoices; voice++) {
+        SynthOp osc;
+        osc.Op = SynthOp::Replace;
+        osc.Wave = SynthOp::WaveT(SynthOp::Sine + ((voice + step) % 6));
+        osc.Freq = 220 + voice * 110 + step * 20;
+        osc.Amp = synth::MaxSampleVal / 2;
+        soundMgr.AddOp(voice, 0, osc, 1 + voice * 100);
+        SynthOp env;
+        env.Op = SynthOp::Modulate;
+        env.Wave = SynthOp::Triangle;
+        env.Freq = 3 + voice;
+        env.Amp = synth::MaxSampleVal / 2;
+        env.Bias = synth::MaxSampleVal / 2;
+        soundMgr.AddOp(voice, 1, env, 1);
+    }
+}
+
+//------------------------------------------------------------------------------
+TEST(NullSynthTest) {
+    outputHash = 2166136261;
+    outputNumFrames = 0;
+
+    SynthSetup setup;
+    setup.NumVoices = NumVoices;
+    setup.RenderOffline = true;
+    #if ORYOL_POSIX
+    setup.WavFilePath = WavPath;
+    #endif
+    setup.OutputFunc = hashOutput;
+    nullSoundMgr soundMgr;
+    soundMgr.Setup(setup);
+    for (int32 voice = 0; voice < NumVoices; voice++) {
+        soundMgr.SetVoicePan(voice, (float32(voice) / float32(NumVoices - 1)) * 2.0f - 1.0f);
+    }
+
+    // Update() doesn't render anything in offline mode
+    soundMgr.Update();
+    CHECK(soundMgr.Stats().NumRenderedBuffers == 0);
+
+    // render 2 seconds of audio in 4 steps, rounded up to whole buffers
+    for (int32 step = 0; step < 4; step++) {
+        addOps(soundMgr, step);
+        soundMgr.RenderOffline(0.5);
+    }
+    const int32 numBuffersPerStep = (synth::SampleRate / 2 + synth::BufferNumSamples - 1) / synth::BufferNumSamples;
+    const int32 numFrames = 4 * numBuffersPerStep * synth::BufferNumSamples;
+    const SynthStats stats = soundMgr.Stats();
+    CHECK(stats.NumRenderedBuffers == 4 * numBuffersPerStep);
+    CHECK(stats.NumRenderedSamples == numFrames);
+    CHECK(outputNumFrames == numFrames);
+    Log::Info("NullSynthTest: %.2f sec audio in %.3f sec (%.1fx realtime)\n",
+        stats.AudioSeconds(), stats.RenderTime.AsSeconds(), stats.Throughput());
+    soundMgr.Discard();
+
+    // the rendered output must not change unnoticed
+    Log::Info("NullSynthTest: output hash 0x%08x\n", outputHash);
+    CHECK(outputHash == 0x2787cec9);
+
+    // check the WAV file header and size
+    #if ORYOL_POSIX
+    const int32 dataSize = numFrames * synth::NumChannels * synth::SampleSize;
+    std::FILE* fp = std::fopen(WavPath, "rb");
+    CHECK(nullptr != fp);
+    if (fp) {
+        uint8 header[44];
+        CHECK(1 == std::fread(header, sizeof(header), 1, fp));
+        auto get16 = [&header](int32 offset) -> uint32 {
+            return header[offset] | (header[offset + 1] << 8);
+        };
+        auto get32 = [&get16](int32 offset) -> uint32 {
+            return get16(offset) | (get16(offset + 2) << 16);
+        };
+        CHECK(0 == std::memcmp(&header[0], "RIFF", 4));
+        CHECK(get32(4) == uint32(36 + dataSize));
+        CHECK(0 == std::memcmp(&header[8], "WAVEfmt ", 8));
+        CHECK(get16(20) == 1);
+        CHECK(get16(22) == uint32(synth::NumChannels));
+        CHECK(get32(24) == uint32(synth::SampleRate));
+        CHECK(get16(34) == 16);
+        CHECK(0 == std::memcmp(&header[36], "data", 4));
+        CHECK(get32(40) == uint32(dataSize));
+        std::fseek(fp, 0, SEEK_END);
+        CHECK(std::ftell(fp) == long(44 + dataSize));
+        std::fclose(fp);
+        std::remove(WavPath);
+    }
+    #endif
+}
+
+#if !ORYOL_SYNTH_NULL
+//------------------------------------------------------------------------------
+TEST(NullSynthSilentTest) {
+    // without a headless output, nothing is rendered
+    SynthSetup setup;
+    setup.NumVoices = NumVoices;
+    nullSoundMgr soundMgr;
+    soundMgr.Setup(setup);
+    addOps(soundMgr, 0);
+    for (int32 i = 0; i < 4; i++) {
+        soundMgr.Update();
+    }
+    const SynthStats stats = soundMgr.Stats();
+    soundMgr.Discard();
+    CHECK(stats.NumRenderedBuffers == 0);
+    CHECK(stats.NumUnderruns == 0);
+}
+#endif
+
+#if ORYOL_HAS_THREADS
+static std::thread::id mainThreadId;
+static std::atomic<int32> numAudioThreadFrames(0);
+static std::atomic<bool> audibleOutput(false);
+
+//------------------------------------------------------------------------------
+static void
+checkAudioThreadOutput(const int16* samples, int32 numFrames) {
+    if (std::this_thread::get_id() != mainThreadId) {
+        numAudioThreadFrames += numFrames;
+    }
+    for (int32 i = 0; i < numFrames * synth::NumChannels; i++) {
+        if (0 != samples[i]) {
+            audibleOutput = true;
+            break;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+TEST(NullSynthAudioThreadTest) {
+    mainThreadId = std::this_thread::get_id();
+    numAudioThreadFrames = 0;
+    audibleOutput = false;
+
+    SynthSetup setup;
+    setup.NumVoices = NumVoices;
+    setup.OpQueueCapacity = 16;
+    setup.OutputFunc = checkAudioThreadOutput;
+    nullSoundMgr soundMgr;
+    soundMgr.Setup(setup);
+
+    // push many more ops than fit into the queue, the audio
+    // thread must drain the queue while the main thread waits
+    for (int32 i = 0; i < 256; i++) {
+        for (int32 voice = 0; voice < NumVoices; voice++) {
+            SynthOp osc;
+            osc.Op = SynthOp::Replace;
+            osc.Wave = SynthOp::WaveT(SynthOp::Sine + (i % 6));
+            osc.Freq = 220 + voice * 110 + (i % 8) * 20;
+            osc.Amp = synth::MaxSampleVal / 2;
+            soundMgr.AddOp(voice, 0, osc, 1 + i * 64);
+        }
+        soundMgr.SetVoicePan(i % NumVoices, ((i % 3) - 1) * 0.5f);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(250));
+    const SynthStats stats = soundMgr.Stats();
+    soundMgr.Discard();
+
+    Log::Info("NullSynthAudioThreadTest: %d buffers, latency %.1f ms, %d underruns, %d queue stalls\n",
+        stats.NumRenderedBuffers, stats.Latency.AsMilliSeconds(), stats.NumUnderruns, stats.NumQueueStalls);
+    CHECK(stats.NumRenderedBuffers >= 2);
+    CHECK(numAudioThreadFrames == stats.NumRenderedBuffers * synth::BufferNumSamples);
+    CHECK(stats.Latency.AsMilliSeconds() > 0.0);
+    CHECK(stats.NumQueueStalls > 0);
+    CHECK(audibleOutput);
+}
+#endif
@@ -0,0 +1,121 @@
+//------------------------------------------------------------------------------
+//  SynthMixTest.cc
+//  Headless offline rendering of many voices through the mixer.
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "UnitTest++/src/UnitTest++.h"
+#include "Synth/base/soundMgrBase.h"
+#include "Core/Containers/Array.h"
+#include "Core/Threading/JobSystem.h"
+
+using namespace Oryol;
+using namespace _priv;
+
+static const int32 NumVoices = 64;
+static const int32 NumBuffers = 32;
+
+//------------------------------------------------------------------------------
+/**
+ Render NumBuffers buffers of a 64-voice tune, voices are spread
+ over the stereo field, and new ops are added between buffers like
+ a game would do.
+*/
+static void
+renderTune(int32 minParallelVoices, Array<int16>& outSamples) {
+    SynthSetup setup;
+    setup.NumVoices = NumVoices;
+    setup.MinParallelVoices = minParallelVoices;
+    soundMgrBase soundMgr;
+    soundMgr.Setup(setup);
+    for (int32 voice = 0; voice < NumVoices; voice++) {
+        soundMgr.SetVoiceGain(voice, 0.25f);
+        soundMgr.SetVoicePan(voice, (float32(voice) / float32(NumVoices - 1)) * 2.0f - 1.0f);
+    }
+    // the first voice only plays on the left channel
+    soundMgr.SetVoicePan(0, -1.0f);
+
+    outSamples.Clear();
+    int16 samples[synth::NumChannels * synth::BufferNumSamples];
+    for (int32 buf = 0; buf < NumBuffers; buf++) {
+        if (0 == (buf % 4)) {
+            for (int32 voice = 0; voice < NumVoices; voice++) {
+                SynthOp osc;
+                osc.Op = SynthOp::Replace;
+                osc.Wave = SynthOp::WaveT(SynthOp::Sine + ((voice + buf) % 8));
+                osc.Freq = 110 + voice * 23 + buf * 7;
+                osc.Amp = synth::MaxSampleVal / 2;
+                soundMgr.AddOp(voice, 0, osc, 1 + voice * 17);
+                SynthOp env;
+                env.Op = SynthOp::Modulate;
+                env.Wave = SynthOp::Triangle;
+                env.Freq = 2 + (voice % 5);
+                env.Amp = synth::MaxSampleVal / 2;
+                env.Bias = synth::MaxSampleVal / 2;
+                soundMgr.AddOp(voice, 1, env, voice * 5);
+            }
+        }
+        soundMgr.RenderBuffer(samples);
+        for (int16 s : samples) {
+            outSamples.Add(s);
+        }
+    }
+    soundMgr.Discard();
+}
+
+//------------------------------------------------------------------------------
+TEST(SynthMixTest) {
+    JobSetup jobSetup;
+    jobSetup.NumWorkers = 4;
+    JobSystem::Setup(jobSetup);
+
+    Array<int16> serial;
+    Array<int16> parallel0;
+    Array<int16> parallel1;
+    renderTune(NumVoices + 1, serial);
+    renderTune(1, parallel0);
+    renderTune(1, parallel1);
+    JobSystem::Discard();
+
+    // output must be the same no matter how voices are distributed to threads
+    CHECK(serial.Size() == NumBuffers * synth::NumChannels * synth::BufferNumSamples);
+    CHECK(serial.Size() == parallel0.Size());
+    CHECK(serial.Size() == parallel1.Size());
+    int32 numDiffs = 0;
+    for (int32 i = 0; i < serial.Size(); i++) {
+        if ((serial[i] != parallel0[i]) || (serial[i] != parallel1[i])) {
+            numDiffs++;
+        }
+    }
+    CHECK(0 == numDiffs);
+
+    // check that the voices actually made it into both channels
+    int64 energy[synth::NumChannels] = { 0, 0 };
+    for (int32 i = 0; i < serial.Size(); i++) {
+        const int64 s = serial[i];
+        energy[i % synth::NumChannels] += s * s;
+    }
+    CHECK(energy[0] > 0);
+    CHECK(energy[1] > 0);
+
+    // a single full-left voice leaves the right channel silent
+    SynthSetup setup;
+    setup.NumVoices = 1;
+    soundMgrBase soundMgr;
+    soundMgr.Setup(setup);
+    soundMgr.SetVoicePan(0, -1.0f);
+    SynthOp osc;
+    osc.Op = SynthOp::Replace;
+    osc.Wave = SynthOp::Square;
+    soundMgr.AddOp(0, 0, osc, 1);
+    int16 samples[synth::NumChannels * synth::BufferNumSamples];
+    soundMgr.RenderBuffer(samples);
+    soundMgr.Discard();
+    bool leftSound = false;
+    bool rightSilent = true;
+    for (int32 i = 0; i < synth::BufferNumSamples; i++) {
+        leftSound |= (0 != samples[i * 2]);
+        rightSilent &= (0 == samples[i * 2 + 1]);
+    }
+    CHECK(leftSound);
+    CHECK(rightSilent);
+}
@@ -0,0 +1,130 @@
+//------------------------------------------------------------------------------
+//  cpuSynthesizerTest.cc
+//  Test that the block renderer matches the sample-by-sample reference
+//  renderer, and compare their performance.
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "UnitTest++/src/UnitTest++.h"
+#include "Synth/Core/cpuSynthesizer.h"
+#include "Synth/Core/voice.h"
+#include "Core/Containers/Array.h"
+#include "Core/Log.h"
+#include <chrono>
+
+using namespace Oryol;
+using namespace _priv;
+
+//------------------------------------------------------------------------------
+/**
+ Add a tune with ops of all kinds and odd op lengths, so that op
+ changes happen in the middle of blocks.
+*/
+static void
+addOps(voice& v, int32 numSeconds) {
+    const int32 numTicks = numSeconds * synth::SampleRate;
+    const SynthOp::WaveT waves[] = {
+        SynthOp::Sine, SynthOp::SawTooth, SynthOp::Triangle, SynthOp::Square,
+        SynthOp::Noise, SynthOp::Custom0, SynthOp::Custom3, SynthOp::Custom7
+    };
+    const SynthOp::OpT ops[] = {
+        SynthOp::Modulate, SynthOp::Add, SynthOp::Nop, SynthOp::ModFreq, SynthOp::Replace
+    };
+    for (int32 track = 0; track < synth::NumTracks; track++) {
+        const int32 opLength = 997 + track * 3313;
+        int32 i = 0;
+        for (int32 tick = 0; tick < numTicks; tick += opLength, i++) {
+            SynthOp op;
+            if (0 == track) {
+                op.Op = SynthOp::Replace;
+                op.Wave = waves[i % 8];
+                op.Freq = 110 + (i * 37) % 880;
+            }
+            else {
+                op.Op = ops[(i + track) % 5];
+                op.Wave = ((i % 4) == 3) ? SynthOp::Const : waves[(i * 3 + track) % 8];
+                op.Freq = 2 + (i * 13) % 440;
+                op.Amp = synth::MaxSampleVal / (1 + (i % 3));
+                op.Bias = (track == 2) ? (synth::MaxSampleVal / 4) : 0;
+            }
+            op.startTick = tick;
+            v.AddOp(track, op);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+ Render numSeconds of audio in streaming buffers into an offscreen
+ buffer, returns the time spent in the synthesizer.
+*/
+static double
+render(cpuSynthesizer& cpuSynth, bool reference, int32 numSeconds, Array<int16>& outSamples) {
+    SynthSetup setup;
+    voice v;
+    v.Setup(0, setup);
+    addOps(v, numSeconds);
+    cpuSynth.Setup(setup);
+
+    const int32 numBuffers = (numSeconds * synth::SampleRate) / synth::BufferNumSamples;
+    outSamples.Clear();
+    outSamples.Reserve(numBuffers * synth::BufferNumSamples);
+    int16 samples[synth::BufferNumSamples];
+    double time = 0.0;
+    for (int32 i = 0; i < numBuffers; i++) {
+        const int32 startTick = i * synth::BufferNumSamples;
+        opBundle bundle;
+        bundle.NumVoices = 1;
+        bundle.StartTick[0] = startTick;
+        bundle.EndTick[0] = startTick + synth::BufferNumSamples;
+        bundle.Buffer[0] = samples;
+        bundle.BufferNumBytes = synth::BufferSize;
+        v.GatherOps(bundle.StartTick[0], bundle.EndTick[0], bundle);
+        auto start = std::chrono::high_resolution_clock::now();
+        if (reference) {
+            cpuSynth.SynthesizeReference(bundle);
+        }
+        else {
+            cpuSynth.Synthesize(bundle);
+        }
+        time += std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+        for (int16 s : samples) {
+            outSamples.Add(s);
+        }
+    }
+    v.Discard();
+    return time;
+}
+
+//------------------------------------------------------------------------------
+TEST(cpuSynthesizerBlockTest) {
+    cpuSynthesizer cpuSynth;
+    Array<int16> refSamples;
+    Array<int16> blockSamples;
+    render(cpuSynth, true, 2, refSamples);
+    render(cpuSynth, false, 2, blockSamples);
+    CHECK(refSamples.Size() == blockSamples.Size());
+    int32 numDiffs = 0;
+    bool nonZero = false;
+    for (int32 i = 0; i < refSamples.Size(); i++) {
+        if (refSamples[i] != blockSamples[i]) {
+            numDiffs++;
+        }
+        if (0 != refSamples[i]) {
+            nonZero = true;
+        }
+    }
+    CHECK(0 == numDiffs);
+    CHECK(nonZero);
+}
+
+//------------------------------------------------------------------------------
+TEST(cpuSynthesizerBenchmark) {
+    const int32 numSeconds = 30;
+    cpuSynthesizer cpuSynth;
+    Array<int16> samples;
+    const double refTime = render(cpuSynth, true, numSeconds, samples);
+    const double blockTime = render(cpuSynth, false, numSeconds, samples);
+    Log::Info("cpuSynthesizer: %d seconds of audio, reference %.2f ms, blocks %.2f ms (%.1fx)\n",
+        numSeconds, refTime * 1000.0, blockTime * 1000.0, refTime / blockTime);
+    CHECK(blockTime > 0.0);
+}
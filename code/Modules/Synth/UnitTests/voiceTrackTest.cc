@@ -0,0 +1,255 @@
+//------------------------------------------------------------------------------
+//  voiceTrackTest.cc
+//  Test voiceTrack op storage (expiry, truncation, bulk insertion),
+//  and compare it with a plain array which erases expired ops at the front.
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "UnitTest++/src/UnitTest++.h"
+#include "Synth/Core/voiceTrack.h"
+#include "Synth/Core/voice.h"
+#include "Synth/Core/opBundle.h"
+#include "Synth/Core/cpuSynthesizer.h"
+#include "Core/Containers/Array.h"
+#include "Core/Log.h"
+#include <chrono>
+#include <algorithm>
+
+using namespace Oryol;
+using namespace _priv;
+
+//------------------------------------------------------------------------------
+static SynthOp
+makeOp(int32 startTick) {
+    SynthOp op;
+    op.Op = SynthOp::ModFreq;
+    op.Freq = 100 + (startTick % 1000);
+    op.startTick = startTick;
+    return op;
+}
+
+//------------------------------------------------------------------------------
+TEST(voiceTrackTest) {
+    voiceTrack track;
+    CHECK(track.NumOps() == 0);
+    SynthOp* begin = nullptr;
+    SynthOp* end = nullptr;
+    track.GatherOps(0, 100, begin, end);
+    CHECK((nullptr == begin) && (nullptr == end));
+
+    // end ticks are fixed up, gather returns all ops starting before the end tick
+    for (int32 i = 0; i < 10; i++) {
+        track.AddOp(makeOp(i * 100));
+    }
+    CHECK(track.NumOps() == 10);
+    track.GatherOps(50, 350, begin, end);
+    CHECK(end - begin == 4);
+    CHECK(begin[0].startTick == 0);
+    CHECK(begin[0].endTick == 100);
+    CHECK(begin[3].startTick == 300);
+    CHECK(begin[3].endTick == 400);
+
+    // ops which ended before the start tick are expired
+    track.GatherOps(250, 350, begin, end);
+    CHECK(track.NumOps() == 8);
+    CHECK(begin[0].startTick == 200);
+    CHECK(end - begin == 2);
+
+    // adding an op before the last op truncates the track
+    track.AddOp(makeOp(550));
+    CHECK(track.NumOps() == 5);
+    track.GatherOps(250, 2000, begin, end);
+    CHECK(end - begin == 5);
+    CHECK(begin[3].startTick == 500);
+    CHECK(begin[3].endTick == 550);
+    CHECK(begin[4].startTick == 550);
+    CHECK(begin[4].endTick == (1<<30));
+
+    // bulk insertion gives the same result as adding ops one by one
+    voiceTrack bulkTrack;
+    voiceTrack singleTrack;
+    Array<SynthOp> ops;
+    for (int32 i = 0; i < 1000; i++) {
+        ops.Add(makeOp(i * 16));
+    }
+    bulkTrack.AddOp(makeOp(0));
+    bulkTrack.AddOps(&ops[0], ops.Size());
+    for (const SynthOp& op : ops) {
+        singleTrack.AddOp(op);
+    }
+    CHECK(bulkTrack.NumOps() == 1000);
+    CHECK(singleTrack.NumOps() == 1000);
+    SynthOp* bulkBegin = nullptr;
+    SynthOp* bulkEnd = nullptr;
+    bulkTrack.GatherOps(1000, 3000, bulkBegin, bulkEnd);
+    singleTrack.GatherOps(1000, 3000, begin, end);
+    CHECK(bulkEnd - bulkBegin == end - begin);
+    bool same = true;
+    for (int32 i = 0; i < (end - begin); i++) {
+        same &= (bulkBegin[i].startTick == begin[i].startTick) &&
+                (bulkBegin[i].endTick == begin[i].endTick) &&
+                (bulkBegin[i].Freq == begin[i].Freq);
+    }
+    CHECK(same);
+
+    // a long stream of ops, the gathered ops must stay contiguous and sorted
+    voiceTrack streamTrack;
+    bool sorted = true;
+    int32 nextTick = 0;
+    for (int32 buf = 0; buf < 1000; buf++) {
+        const int32 startTick = buf * 256;
+        while (nextTick < startTick + 1024) {
+            streamTrack.AddOp(makeOp(nextTick));
+            nextTick += 24;
+        }
+        streamTrack.GatherOps(startTick, startTick + 256, begin, end);
+        sorted &= (begin->startTick <= startTick) && (begin->endTick >= startTick);
+        for (SynthOp* op = begin; op < end; op++) {
+            sorted &= (op->startTick < startTick + 256) && (op->endTick > op->startTick);
+            sorted &= (op == begin) || (op[-1].endTick == op->startTick);
+        }
+        opBundle bundle;
+        bundle.NumVoices = 1;
+        bundle.Begin[0][0] = begin;
+        bundle.End[0][0] = end;
+        const SynthOp* op = bundle.Op(0, 0, startTick + 100);
+        sorted &= (nullptr != op) && (op->startTick <= startTick + 100) && (op->endTick > startTick + 100);
+    }
+    CHECK(sorted);
+    CHECK(streamTrack.NumOps() < 64);
+    streamTrack.DiscardAllOps();
+    CHECK(streamTrack.NumOps() == 0);
+}
+
+//------------------------------------------------------------------------------
+/**
+ The previous voiceTrack storage: expired ops are erased from the
+ front of an array, and the gathered range is found with a linear scan.
+*/
+class arrayTrack {
+public:
+    void AddOp(const SynthOp& op) {
+        if (!this->track.Empty()) {
+            auto ptr = std::lower_bound(this->track.begin(), this->track.end(), op);
+            while ((ptr - this->track.begin()) < this->track.Size()) {
+                this->track.Erase(this->track.Size() - 1);
+            }
+        }
+        if (!this->track.Empty()) {
+            this->track.Back().endTick = op.startTick;
+        }
+        this->track.Add(op);
+    };
+    void GatherOps(int32 startTick, int32 endTick, SynthOp*& outOpBegin, SynthOp*& outOpEnd) {
+        while (!this->track.Empty() && (startTick > this->track.Front().endTick)) {
+            this->track.Erase(0);
+        }
+        outOpBegin = &this->track.Front();
+        outOpEnd = outOpBegin;
+        for (int32 i = 0; i < this->track.Size(); i++) {
+            if (this->track[i].startTick < endTick) {
+                outOpEnd++;
+            }
+            else {
+                break;
+            }
+        }
+    };
+    Array<SynthOp> track;
+};
+
+//------------------------------------------------------------------------------
+/**
+ A dense op stream (like per-frame ModFreq envelopes) which is queued
+ 2 seconds ahead, new ops are added and a buffer is gathered per frame.
+*/
+template<class TRACK> static double
+streamOps(TRACK& track, int32 numSeconds, int64& outChecksum) {
+    const int32 opLength = 32;
+    const int32 aheadTicks = 2 * synth::SampleRate;
+    const int32 frameTicks = synth::SampleRate / 60;
+    const int32 numFrames = numSeconds * 60;
+    int32 nextTick = 0;
+    outChecksum = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int32 frame = 0; frame < numFrames; frame++) {
+        const int32 startTick = frame * frameTicks;
+        while (nextTick < (startTick + aheadTicks)) {
+            track.AddOp(makeOp(nextTick));
+            nextTick += opLength;
+        }
+        SynthOp* begin = nullptr;
+        SynthOp* end = nullptr;
+        track.GatherOps(startTick, startTick + frameTicks, begin, end);
+        outChecksum += (end - begin) + begin->startTick;
+    }
+    return std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+//------------------------------------------------------------------------------
+TEST(voiceTrackBenchmark) {
+    const int32 numSeconds = 60;
+    arrayTrack oldTrack;
+    voiceTrack newTrack;
+    int64 oldChecksum = 0;
+    int64 newChecksum = 0;
+    const double oldTime = streamOps(oldTrack, numSeconds, oldChecksum);
+    const double newTime = streamOps(newTrack, numSeconds, newChecksum);
+    Log::Info("voiceTrack: %d seconds of ops, array %.2f ms, voiceTrack %.2f ms (%.1fx)\n",
+        numSeconds, oldTime * 1000.0, newTime * 1000.0, oldTime / newTime);
+    CHECK(oldChecksum == newChecksum);
+    CHECK(newTime > 0.0);
+}
+
+//------------------------------------------------------------------------------
+/**
+ Synthesize a voice where every track changes its op every 16 ticks,
+ so that each buffer has more than 100 ops per track.
+*/
+TEST(voiceTrackDenseOpsBenchmark) {
+    const int32 numSeconds = 10;
+    const int32 opLength = 16;
+    SynthSetup setup;
+    voice v;
+    v.Setup(0, setup);
+    cpuSynthesizer cpuSynth;
+    cpuSynth.Setup(setup);
+
+    int16 samples[synth::BufferNumSamples];
+    const int32 numBuffers = (numSeconds * synth::SampleRate) / synth::BufferNumSamples;
+    int32 nextTick = 0;
+    int64 checksum = 0;
+    double time = 0.0;
+    for (int32 buf = 0; buf < numBuffers; buf++) {
+        const int32 startTick = buf * synth::BufferNumSamples;
+        const int32 endTick = startTick + synth::BufferNumSamples;
+        for (int32 track = 0; track < synth::NumTracks; track++) {
+            SynthOp ops[synth::BufferNumSamples / opLength];
+            int32 numOps = 0;
+            for (int32 tick = nextTick; tick < endTick; tick += opLength) {
+                SynthOp& op = ops[numOps++];
+                op.Op = (0 == track) ? SynthOp::Replace : SynthOp::ModFreq;
+                op.Wave = SynthOp::Sine;
+                op.Freq = 110 + ((tick / opLength) % 64) * 4 + track;
+                op.startTick = tick;
+            }
+            v.AddOps(track, ops, numOps);
+        }
+        nextTick = endTick;
+
+        opBundle bundle;
+        bundle.NumVoices = 1;
+        bundle.StartTick[0] = startTick;
+        bundle.EndTick[0] = endTick;
+        bundle.Buffer[0] = samples;
+        bundle.BufferNumBytes = synth::BufferSize;
+        auto start = std::chrono::high_resolution_clock::now();
+        v.GatherOps(startTick, endTick, bundle);
+        cpuSynth.Synthesize(bundle);
+        time += std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+        checksum += samples[buf % synth::BufferNumSamples];
+    }
+    v.Discard();
+    Log::Info("voiceTrack: %d seconds of dense ops (every %d ticks on %d tracks) synthesized in %.2f ms (checksum %d)\n",
+        numSeconds, opLength, synth::NumTracks, time * 1000.0, int32(checksum));
+    CHECK(time > 0.0);
+}
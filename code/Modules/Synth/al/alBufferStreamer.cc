@@ -10,6 +10,7 @@ namespace _priv {
 //------------------------------------------------------------------------------
 alBufferStreamer::alBufferStreamer() :
 isValid(false),
+playbackStarted(false),
 source(0) {
     this->allBuffers.Reserve(MaxNumBuffers);
     this->queuedBuffers.Reserve(MaxNumBuffers);
@@ -31,13 +32,13 @@ alBufferStreamer::Setup(const SynthSetup& setupAttrs) {
     // FIXME: actually use attrs from SynthSetup!
     
     // generate buffers, initially fill buffer with 0
-    int16 silence[synth::BufferNumSamples] = { 0 };
-    o_assert_dbg(sizeof(silence) == synth::BufferSize);
+    int16 silence[synth::NumChannels * synth::BufferNumSamples] = { 0 };
+    o_assert_dbg(sizeof(silence) == synth::MixBufferSize);
     for (int i = 0; i < MaxNumBuffers; i++) {
         ALuint buf = 0;
         alGenBuffers(1, &buf);
         ORYOL_AL_CHECK_ERROR();
-        alBufferData(buf, AL_FORMAT_MONO16, silence, sizeof(silence), synth::SampleRate);
+        alBufferData(buf, AL_FORMAT_STEREO16, silence, sizeof(silence), synth::SampleRate);
         ORYOL_AL_CHECK_ERROR();
         this->allBuffers.Add(buf);
         this->freeBuffers.Enqueue(buf);
@@ -55,6 +56,7 @@ alBufferStreamer::Discard() {
     o_assert_dbg(0 != this->source);
     
     this->isValid = false;
+    this->playbackStarted = false;
     
     alDeleteSources(1, &this->source);
     ORYOL_AL_CHECK_ERROR();
@@ -107,21 +109,22 @@ alBufferStreamer::Update() {
 }
 
 //------------------------------------------------------------------------------
-void
+bool
 alBufferStreamer::Enqueue(const void* ptr, int32 numBytes) {
     o_assert_dbg(this->isValid);
-    o_assert_dbg(synth::BufferSize == numBytes);
+    o_assert_dbg(synth::MixBufferSize == numBytes);
     
     ALuint buf = this->freeBuffers.Dequeue();
     this->queuedBuffers.Enqueue(buf);
 
-    alBufferData(buf, AL_FORMAT_MONO16, ptr, numBytes, synth::SampleRate);
+    alBufferData(buf, AL_FORMAT_STEREO16, ptr, numBytes, synth::SampleRate);
     ORYOL_AL_CHECK_ERROR();
     alSourceQueueBuffers(this->source, 1, &buf);
     ORYOL_AL_CHECK_ERROR();
     
     // start playback if source is not currently playing (either it never was, or it
     // has stopped because it was starved)
+    bool starved = false;
     ALint srcState = 0;
     alGetSourcei(this->source, AL_SOURCE_STATE, &srcState);
     ORYOL_AL_CHECK_ERROR();
@@ -129,7 +132,16 @@ alBufferStreamer::Enqueue(const void* ptr, int32 numBytes) {
         alSourcePlay(this->source);
         ORYOL_AL_CHECK_ERROR();
         Log::Dbg("alBufferStreamer: starting playback\n");
+        starved = this->playbackStarted;
+        this->playbackStarted = true;
     }
+    return starved;
+}
+
+//------------------------------------------------------------------------------
+int32
+alBufferStreamer::NumQueuedBuffers() const {
+    return this->queuedBuffers.Size();
 }
 
     
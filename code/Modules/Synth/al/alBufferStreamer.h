@@ -13,8 +13,10 @@
     
     Latency vs. under-runs: One buffer only holds data for a couple of 
     milliseconds (one or two render-frames). This defines the minimal
-    latency of the system. However, if the game fails to render at this
-    frame rate, buffer underruns can happen resulting in audio artefacts.
+    latency of the system. However, if the streamer isn't updated at this
+    rate, buffer underruns can happen resulting in audio artefacts. With
+    an audio thread the streamer is updated independently from the game's
+    frame rate, without one it is updated from Synth::Update().
     
     Unfortunately, OpenAL doesn't allow to intercept/remove queued buffers
     which are still pending for playback, so a compromise must be made
@@ -46,13 +48,16 @@ public:
     
     /// update the streamer, returns true if new data is needed
     bool Update();
-    /// enqueue new data into the streamer
-    void Enqueue(const void* ptr, int32 numBytes);
+    /// enqueue new data into the streamer, returns true if playback had run dry
+    bool Enqueue(const void* ptr, int32 numBytes);
+    /// get number of buffers queued for playback
+    int32 NumQueuedBuffers() const;
     
 private:
     static const int32 MaxNumBuffers = 8;
 
     bool isValid;
+    bool playbackStarted;
     ALuint source;
     Array<ALuint> allBuffers;
     Queue<ALuint> queuedBuffers;
@@ -6,6 +6,7 @@
 #include "Core/Log.h"
 #include "Core/Assertion.h"
 #include "Core/String/StringBuilder.h"
+#include "Core/Memory/Memory.h"
 
 namespace Oryol {
 namespace _priv {
@@ -14,7 +15,7 @@ namespace _priv {
 alSoundMgr::alSoundMgr() :
 alcDevice(nullptr),
 alcContext(nullptr) {
-    // empty
+    Memory::Clear(this->samples, sizeof(this->samples));
 }
 
 //------------------------------------------------------------------------------
@@ -49,8 +50,14 @@ alSoundMgr::Setup(const SynthSetup& setupAttrs) {
     }
     this->PrintALInfo();
     
-    // setup the buffer streamer
+    // setup the buffer streamer, AL calls from the audio thread
+    // go to the process-wide current context
     this->streamer.Setup(setupAttrs);
+    if (this->canUseAudioThread()) {
+        this->startAudioThread([this]() {
+            return this->pump();
+        });
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -58,7 +65,12 @@ void
 alSoundMgr::Discard() {
     o_assert_dbg(this->isValid);
     
-    this->streamer.Discard();
+    if (this->hasAudioThread()) {
+        this->stopAudioThread();
+    }
+    if (this->streamer.IsValid()) {
+        this->streamer.Discard();
+    }
     if (nullptr != this->alcContext) {
         alcDestroyContext(this->alcContext);
         this->alcContext = nullptr;
@@ -108,33 +120,26 @@ alSoundMgr::PrintALInfo() {
 void
 alSoundMgr::Update() {
     soundMgrBase::Update();
-    if (this->streamer.Update()) {
+    if (!this->hasAudioThread() && this->streamer.IsValid()) {
+        this->pump();
+    }
+}
+
+//------------------------------------------------------------------------------
+int32
+alSoundMgr::pump() {
+    while (this->streamer.Update()) {
     
         // need to 'render' new buffers
-        static int16 samples[synth::NumVoices][synth::BufferNumSamples];
-        const int32 startTick = this->curTick;
-        const int32 endTick   = startTick + synth::BufferNumSamples;
-        opBundle bundle;
-        for (int voiceIndex = 0; voiceIndex < synth::NumVoices; voiceIndex++) {
-            bundle.StartTick[voiceIndex] = startTick;
-            bundle.EndTick[voiceIndex] = endTick;
-            bundle.Buffer[voiceIndex] = samples[voiceIndex];
-            bundle.BufferNumBytes = synth::BufferSize;
-            this->voices[voiceIndex].GatherOps(startTick, endTick, bundle);
-        }
-        
-        // select between cpuSynth and gpuSynth here!
-        if (this->useGpuSynth) {
-            this->gpuSynth.Synthesize(bundle);
+        this->RenderBuffer(this->samples);
+        if (this->streamer.Enqueue(this->samples, sizeof(this->samples))) {
+            this->addUnderrun();
         }
-        else {
-            this->cpuSynth.Synthesize(bundle);
-        }
-        this->curTick += synth::BufferNumSamples;
-        
-        // FIXME: only one voice handled at the moment!
-        this->streamer.Enqueue(samples[0], sizeof(samples[0]));
     }
+    this->setLatency(this->streamer.NumQueuedBuffers() * synth::BufferNumSamples);
+    
+    // poll the buffer queue 4 times per buffer duration
+    return (synth::BufferNumSamples * 1000) / (synth::SampleRate * 4);
 }
 
 } // namespace _priv
@@ -29,10 +29,13 @@ public:
 private:
     /// print AL implementation info
     void PrintALInfo();
+    /// fill the AL buffer queue, returns milliseconds until the next poll
+    int32 pump();
     
     ALCdevice* alcDevice;
     ALCcontext* alcContext;
     alBufferStreamer streamer;
+    int16 samples[synth::NumChannels * synth::BufferNumSamples];
 };
     
 } // namespace _priv
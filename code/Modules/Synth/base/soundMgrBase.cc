@@ -13,7 +13,15 @@ namespace _priv {
 soundMgrBase::soundMgrBase() :
 isValid(false),
 useGpuSynth(false),
-curTick(0) {
+curTick(0),
+publishedTick(0),
+audioThreadRunning(false),
+numRenderedBuffers(0),
+numRenderedSamples(0),
+renderTicks(0),
+numUnderruns(0),
+latencySamples(0),
+numQueueStalls(0) {
     // empty
 }
 
@@ -26,35 +34,69 @@ soundMgrBase::~soundMgrBase() {
 void
 soundMgrBase::Setup(const SynthSetup& setupParams) {
     o_assert(!this->isValid);
+    o_assert((setupParams.NumVoices > 0) && (setupParams.NumVoices <= synth::MaxNumVoices));
     this->isValid = true;
     this->useGpuSynth = setupParams.UseGPUSynthesizer;
     this->setup = setupParams;
     this->curTick = 0;
-    for (int i = 0; i < synth::NumVoices; i++) {
+    this->publishedTick.store(0, std::memory_order_relaxed);
+    this->numRenderedBuffers.store(0, std::memory_order_relaxed);
+    this->numRenderedSamples.store(0, std::memory_order_relaxed);
+    this->renderTicks.store(0, std::memory_order_relaxed);
+    this->numUnderruns.store(0, std::memory_order_relaxed);
+    this->latencySamples.store(0, std::memory_order_relaxed);
+    this->numQueueStalls.store(0, std::memory_order_relaxed);
+    const int32 numVoices = setupParams.NumVoices;
+    this->voices.Reserve(numVoices);
+    for (int i = 0; i < numVoices; i++) {
+        this->voices.Add(voice());
         this->voices[i].Setup(i, setupParams);
     }
     
+    // one mono sample buffer per voice, mixed into the output buffer
+    this->voiceSamples.Reserve(numVoices * synth::BufferNumSamples);
+    for (int i = 0; i < numVoices * synth::BufferNumSamples; i++) {
+        this->voiceSamples.Add(0);
+    }
+    this->bundle.NumVoices = numVoices;
+    this->bundle.BufferNumBytes = synth::BufferSize;
+    for (int i = 0; i < numVoices; i++) {
+        this->bundle.Buffer[i] = &this->voiceSamples[i * synth::BufferNumSamples];
+    }
+    this->voiceMixer.Setup(numVoices);
+    
     // add an initial NOP operation to first track of each voice,
     // this will generate all 0.0 samples instead of 1.0s
     SynthOp nop;
-    for (int i = 0; i < synth::NumVoices; i++) {
+    for (int i = 0; i < numVoices; i++) {
         this->AddOp(i, 0, nop, 0);
     }
     
     this->cpuSynth.Setup(setupParams);
-    this->gpuSynth.Setup(setupParams);
+    if (this->useGpuSynth) {
+        this->gpuSynth.Setup(setupParams);
+    }
+    this->commands.Setup(setupParams.OpQueueCapacity);
 }
 
 //------------------------------------------------------------------------------
 void
 soundMgrBase::Discard() {
     o_assert(this->isValid);
+    o_assert(!this->hasAudioThread());
     this->isValid = false;
     this->setup = SynthSetup();
+    this->commands.Discard();
     for (voice& voice : this->voices) {
         voice.Discard();
     }
-    this->gpuSynth.Discard();
+    this->voices.Clear();
+    this->voiceSamples.Clear();
+    this->bundle = opBundle();
+    this->voiceMixer.Discard();
+    if (this->useGpuSynth) {
+        this->gpuSynth.Discard();
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -72,11 +114,250 @@ soundMgrBase::Update() {
 //------------------------------------------------------------------------------
 void
 soundMgrBase::AddOp(int32 voice, int32 track, const SynthOp& op, int32 timeOffset) {
-    o_assert_range_dbg(voice, synth::NumVoices);
+    o_assert_range_dbg(voice, this->voices.Size());
+    o_assert_range_dbg(track, synth::NumTracks);
+
+    command cmd;
+    cmd.type = command::AddOpCmd;
+    cmd.voice = voice;
+    cmd.track = track;
+    cmd.op = op;
+    if (this->hasAudioThread()) {
+        cmd.op.startTick = this->publishedTick.load(std::memory_order_acquire) + timeOffset;
+        this->submit(std::move(cmd));
+    }
+    else {
+        cmd.op.startTick = this->curTick + timeOffset;
+        this->apply(cmd);
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+soundMgrBase::SetVoiceGain(int32 voice, float32 gain) {
+    o_assert_dbg(this->isValid);
+    o_assert_range_dbg(voice, this->voices.Size());
+    command cmd;
+    cmd.type = command::SetGainCmd;
+    cmd.voice = voice;
+    cmd.value = gain;
+    if (this->hasAudioThread()) {
+        this->submit(std::move(cmd));
+    }
+    else {
+        this->apply(cmd);
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+soundMgrBase::SetVoicePan(int32 voice, float32 pan) {
+    o_assert_dbg(this->isValid);
+    o_assert_range_dbg(voice, this->voices.Size());
+    command cmd;
+    cmd.type = command::SetPanCmd;
+    cmd.voice = voice;
+    cmd.value = pan;
+    if (this->hasAudioThread()) {
+        this->submit(std::move(cmd));
+    }
+    else {
+        this->apply(cmd);
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+ If the queue is full, the audio thread is woken up to drain it,
+ and the caller yields until there's room again.
+*/
+void
+soundMgrBase::submit(command&& cmd) {
+    if (!this->commands.Enqueue(std::move(cmd))) {
+        this->numQueueStalls.fetch_add(1, std::memory_order_relaxed);
+        do {
+            this->audioWakeup.Signal();
+            #if ORYOL_HAS_THREADS
+            std::this_thread::yield();
+            #endif
+        }
+        while (!this->commands.Enqueue(std::move(cmd)));
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+soundMgrBase::apply(const command& cmd) {
+    switch (cmd.type) {
+        case command::AddOpCmd:
+            this->voices[cmd.voice].AddOp(cmd.track, cmd.op);
+            break;
+        case command::SetGainCmd:
+            this->voiceMixer.SetGain(cmd.voice, cmd.value);
+            break;
+        case command::SetPanCmd:
+            this->voiceMixer.SetPan(cmd.voice, cmd.value);
+            break;
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+ Consecutive ops with ascending start ticks for the same voice
+ track are inserted in bulk.
+*/
+void
+soundMgrBase::applyQueued() {
+    static const int32 MaxBatchSize = 64;
+    SynthOp batch[MaxBatchSize];
+    int32 batchSize = 0;
+    int32 batchVoice = 0;
+    int32 batchTrack = 0;
+    command cmd;
+    while (this->commands.Dequeue(cmd)) {
+        const bool isAddOp = command::AddOpCmd == cmd.type;
+        if ((batchSize > 0) && !(isAddOp &&
+            (cmd.voice == batchVoice) &&
+            (cmd.track == batchTrack) &&
+            (cmd.op.startTick > batch[batchSize - 1].startTick) &&
+            (batchSize < MaxBatchSize))) {
+            this->voices[batchVoice].AddOps(batchTrack, batch, batchSize);
+            batchSize = 0;
+        }
+        if (isAddOp) {
+            batchVoice = cmd.voice;
+            batchTrack = cmd.track;
+            batch[batchSize++] = cmd.op;
+        }
+        else {
+            this->apply(cmd);
+        }
+    }
+    if (batchSize > 0) {
+        this->voices[batchVoice].AddOps(batchTrack, batch, batchSize);
+    }
+}
 
-    SynthOp addOp = op;
-    addOp.startTick = this->curTick + timeOffset;
-    this->voices[voice].AddOp(track, addOp);
+//------------------------------------------------------------------------------
+void
+soundMgrBase::RenderBuffer(int16* dst) {
+    o_assert_dbg(this->isValid);
+    o_assert_dbg(nullptr != dst);
+
+    const TimePoint startTime = Clock::Now();
+    this->applyQueued();
+    const int32 startTick = this->curTick;
+    const int32 endTick   = startTick + synth::BufferNumSamples;
+    for (int voiceIndex = 0; voiceIndex < this->voices.Size(); voiceIndex++) {
+        this->bundle.StartTick[voiceIndex] = startTick;
+        this->bundle.EndTick[voiceIndex] = endTick;
+        this->voices[voiceIndex].GatherOps(startTick, endTick, this->bundle);
+    }
+    
+    // select between cpuSynth and gpuSynth here!
+    if (this->useGpuSynth) {
+        this->gpuSynth.Synthesize(this->bundle);
+    }
+    else {
+        this->cpuSynth.Synthesize(this->bundle);
+    }
+    this->voiceMixer.Mix(this->bundle, dst);
+    this->curTick += synth::BufferNumSamples;
+    this->publishedTick.store(this->curTick, std::memory_order_release);
+    
+    this->numRenderedBuffers.fetch_add(1, std::memory_order_relaxed);
+    this->numRenderedSamples.fetch_add(synth::BufferNumSamples, std::memory_order_relaxed);
+    this->renderTicks.fetch_add(Clock::Since(startTime).AsTicks(), std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+SynthStats
+soundMgrBase::Stats() const {
+    SynthStats stats;
+    stats.NumRenderedBuffers = this->numRenderedBuffers.load(std::memory_order_relaxed);
+    stats.NumRenderedSamples = this->numRenderedSamples.load(std::memory_order_relaxed);
+    stats.RenderTime = Duration(this->renderTicks.load(std::memory_order_relaxed));
+    stats.NumUnderruns = this->numUnderruns.load(std::memory_order_relaxed);
+    stats.Latency = Duration::FromSeconds(float64(this->latencySamples.load(std::memory_order_relaxed)) / float64(synth::SampleRate));
+    stats.NumQueueStalls = this->numQueueStalls.load(std::memory_order_relaxed);
+    return stats;
+}
+
+//------------------------------------------------------------------------------
+void
+soundMgrBase::addUnderrun() {
+    this->numUnderruns.fetch_add(1, std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+void
+soundMgrBase::setLatency(int32 numSamples) {
+    this->latencySamples.store(numSamples, std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+/**
+ The GPU synthesizer needs the GL context of the main thread, so it
+ can't render on the audio thread.
+*/
+bool
+soundMgrBase::canUseAudioThread() const {
+    #if ORYOL_HAS_THREADS
+    return this->setup.UseAudioThread && !this->useGpuSynth;
+    #else
+    return false;
+    #endif
+}
+
+//------------------------------------------------------------------------------
+/**
+ The audio thread isn't known to the JobSystem, so voices are
+ synthesized serially on the audio thread.
+*/
+void
+soundMgrBase::startAudioThread(pumpFunc func) {
+    o_assert(this->isValid);
+    o_assert(this->canUseAudioThread());
+    o_assert(!this->hasAudioThread());
+    o_assert(func);
+    #if ORYOL_HAS_THREADS
+    this->cpuSynth.SetMinParallelVoices(synth::MaxNumVoices + 1);
+    this->publishedTick.store(this->curTick, std::memory_order_relaxed);
+    
+    this->audioThreadRunning.store(true, std::memory_order_release);
+    this->audioThread = std::thread([this, func]() {
+        while (this->audioThreadRunning.load(std::memory_order_acquire)) {
+            this->applyQueued();
+            const int32 waitMilliSec = func();
+            const uint32 key = this->audioWakeup.PrepareWait();
+            if (this->audioThreadRunning.load(std::memory_order_relaxed) && this->commands.Empty()) {
+                this->audioWakeup.CommitWait(key, waitMilliSec > 0 ? waitMilliSec : 1);
+            }
+            else {
+                this->audioWakeup.CancelWait();
+            }
+        }
+        // apply ops which came in after the last render
+        this->applyQueued();
+    });
+    #endif
+}
+
+//------------------------------------------------------------------------------
+void
+soundMgrBase::stopAudioThread() {
+    o_assert(this->hasAudioThread());
+    #if ORYOL_HAS_THREADS
+    this->audioThreadRunning.store(false, std::memory_order_release);
+    this->audioWakeup.Signal();
+    this->audioThread.join();
+    #endif
+}
+
+//------------------------------------------------------------------------------
+bool
+soundMgrBase::hasAudioThread() const {
+    return this->audioThreadRunning.load(std::memory_order_relaxed);
 }
 
 } // namespace _priv
@@ -4,12 +4,32 @@
     @class Oryol::_priv::soundMgrBase
     @ingroup _priv
     @brief sound manager base class
+    
+    Backends can render on a dedicated audio thread, which is woken
+    up by the deadlines of the audio output (see startAudioThread()).
+    AddOp(), SetVoiceGain() and SetVoicePan() then push commands into
+    a lock-free queue, ops are stamped with the last render tick
+    published by the audio thread. The audio thread applies queued
+    commands before rendering the next buffer.
+    
+    Without an audio thread, commands are applied right away, and
+    the backend renders from Update() on the main thread.
 */
 #include "Synth/Core/SynthSetup.h"
 #include "Synth/Core/SynthOp.h"
+#include "Synth/Core/SynthStats.h"
 #include "Synth/Core/voice.h"
+#include "Synth/Core/mixer.h"
 #include "Synth/Core/cpuSynthesizer.h"
 #include "Synth/Core/gpuSynthesizer.h"
+#include "Core/Containers/Array.h"
+#include "Core/Threading/mpscRingBuffer.h"
+#include "Core/Threading/wakeupEvent.h"
+#include <atomic>
+#include <functional>
+#if ORYOL_HAS_THREADS
+#include <thread>
+#endif
 
 namespace Oryol {
 namespace _priv {
@@ -33,15 +53,75 @@ public:
     
     /// add an op to a voice track
     void AddOp(int32 voice, int32 track, const SynthOp& op, int32 timeOffset);
+    /// set voice gain (0.0 .. 1.0)
+    void SetVoiceGain(int32 voice, float32 gain);
+    /// set voice pan position (-1.0 .. 1.0)
+    void SetVoicePan(int32 voice, float32 pan);
+    /// synthesize and mix the next BufferNumSamples stereo samples (MixBufferSize bytes), advances tick
+    void RenderBuffer(int16* dst);
+    /// get a snapshot of the rendering statistics (any thread)
+    SynthStats Stats() const;
     
 protected:
+    /// renders all buffers which are due, returns milliseconds until the next deadline
+    typedef std::function<int32()> pumpFunc;
+    /// return true if an audio thread can be used with the current setup
+    bool canUseAudioThread() const;
+    /// start the audio thread, which calls the pump function until stopped
+    void startAudioThread(pumpFunc func);
+    /// stop the audio thread (blocks until it has finished)
+    void stopAudioThread();
+    /// return true if the audio thread is running
+    bool hasAudioThread() const;
+    /// count an audio output underrun (audio thread)
+    void addUnderrun();
+    /// set the number of rendered samples waiting for playback (audio thread)
+    void setLatency(int32 numSamples);
+    
+    /// a queued op or mixer change
+    struct command {
+        enum typeT {
+            AddOpCmd,
+            SetGainCmd,
+            SetPanCmd,
+        } type = AddOpCmd;
+        int32 voice = 0;
+        int32 track = 0;
+        float32 value = 0.0f;
+        SynthOp op;
+    };
+    /// push a command to the audio thread, waits if the queue is full
+    void submit(command&& cmd);
+    /// apply a command to the voices and mixer
+    void apply(const command& cmd);
+    /// apply all queued commands (audio thread)
+    void applyQueued();
+    
     bool isValid;
     SynthSetup setup;
     bool useGpuSynth;
     int32 curTick;
-    voice voices[synth::NumVoices];
+    Array<voice> voices;
+    Array<int16> voiceSamples;
+    opBundle bundle;
+    mixer voiceMixer;
     cpuSynthesizer cpuSynth;
     gpuSynthesizer gpuSynth;
+    
+    mpscRingBuffer<command> commands;
+    std::atomic<int32> publishedTick;
+    std::atomic<bool> audioThreadRunning;
+    wakeupEvent audioWakeup;
+    #if ORYOL_HAS_THREADS
+    std::thread audioThread;
+    #endif
+    
+    std::atomic<int32> numRenderedBuffers;
+    std::atomic<int64> numRenderedSamples;
+    std::atomic<int64> renderTicks;
+    std::atomic<int32> numUnderruns;
+    std::atomic<int32> latencySamples;
+    std::atomic<int32> numQueueStalls;
 };
     
 } // namespace _priv
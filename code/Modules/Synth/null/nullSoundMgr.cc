@@ -0,0 +1,196 @@
+//------------------------------------------------------------------------------
+//  nullSoundMgr.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "nullSoundMgr.h"
+#include "Core/Log.h"
+#include "Core/Assertion.h"
+#include "Core/Memory/Memory.h"
+#include "Time/Clock.h"
+
+namespace Oryol {
+namespace _priv {
+
+//------------------------------------------------------------------------------
+nullSoundMgr::nullSoundMgr() :
+rendering(false),
+wavFile(nullptr),
+wavNumBytes(0) {
+    Memory::Clear(this->samples, sizeof(this->samples));
+}
+
+//------------------------------------------------------------------------------
+nullSoundMgr::~nullSoundMgr() {
+    o_assert_dbg(nullptr == this->wavFile);
+}
+
+//------------------------------------------------------------------------------
+void
+nullSoundMgr::Setup(const SynthSetup& setupAttrs) {
+    o_assert_dbg(!this->isValid);
+    o_assert_dbg(nullptr == this->wavFile);
+
+    soundMgrBase::Setup(setupAttrs);
+    
+    // without a headless output, stay silent like a missing audio device
+    #if ORYOL_SYNTH_NULL
+    this->rendering = true;
+    #else
+    this->rendering = setupAttrs.RenderOffline || setupAttrs.WavFilePath.IsValid() || bool(setupAttrs.OutputFunc);
+    #endif
+    if (!this->rendering) {
+        return;
+    }
+    if (setupAttrs.WavFilePath.IsValid()) {
+        this->wavFile = std::fopen(setupAttrs.WavFilePath.AsCStr(), "wb");
+        if (nullptr == this->wavFile) {
+            o_warn("nullSoundMgr: failed to open WAV file '%s'!\n", setupAttrs.WavFilePath.AsCStr());
+        }
+        else {
+            // header is patched with the final data size in Discard()
+            this->wavNumBytes = 0;
+            if (!this->writeWavHeader()) {
+                o_warn("nullSoundMgr: failed to write WAV header to '%s'!\n", setupAttrs.WavFilePath.AsCStr());
+            }
+        }
+    }
+    this->startTime = Clock::Now();
+    if (!setupAttrs.RenderOffline && this->canUseAudioThread()) {
+        this->startAudioThread([this]() {
+            return this->pump();
+        });
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+nullSoundMgr::Discard() {
+    o_assert_dbg(this->isValid);
+    
+    if (this->hasAudioThread()) {
+        this->stopAudioThread();
+    }
+    if (nullptr != this->wavFile) {
+        std::fseek(this->wavFile, 0, SEEK_SET);
+        if (!this->writeWavHeader()) {
+            o_warn("nullSoundMgr: failed to patch WAV header!\n");
+        }
+        std::fclose(this->wavFile);
+        this->wavFile = nullptr;
+    }
+    this->wavNumBytes = 0;
+    this->rendering = false;
+    
+    soundMgrBase::Discard();
+}
+
+//------------------------------------------------------------------------------
+void
+nullSoundMgr::Update() {
+    soundMgrBase::Update();
+    if (this->rendering && !this->setup.RenderOffline && !this->hasAudioThread()) {
+        this->pump();
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+ The virtual playback position follows the wall clock, buffers are
+ rendered ahead until at least one buffer is waiting for playback,
+ like an audio device would request them. If playback has already
+ overtaken the rendered samples, this counts as an underrun. Like
+ on a real device, playback starts with the first rendered buffer.
+*/
+int32
+nullSoundMgr::pump() {
+    if (0 == this->curTick) {
+        this->startTime = Clock::Now();
+    }
+    const float64 elapsed = Clock::Since(this->startTime).AsSeconds();
+    const int64 playTick = int64(elapsed * synth::SampleRate);
+    if (int64(this->curTick) < playTick) {
+        this->addUnderrun();
+    }
+    while (int64(this->curTick) < (playTick + synth::BufferNumSamples)) {
+        this->renderAndOutput();
+    }
+    const int64 numQueued = int64(this->curTick) - playTick;
+    this->setLatency(int32(numQueued));
+    
+    // next deadline is when only one buffer is left for playback
+    return int32(((numQueued - synth::BufferNumSamples) * 1000) / synth::SampleRate);
+}
+
+//------------------------------------------------------------------------------
+void
+nullSoundMgr::RenderOffline(float64 seconds) {
+    o_assert_dbg(this->isValid);
+    o_assert2_dbg(this->setup.RenderOffline, "nullSoundMgr: SynthSetup::RenderOffline not set!\n");
+    o_assert_dbg(seconds >= 0.0);
+    
+    const int64 numSamples = int64(seconds * synth::SampleRate);
+    const int64 numBuffers = (numSamples + synth::BufferNumSamples - 1) / synth::BufferNumSamples;
+    for (int64 i = 0; i < numBuffers; i++) {
+        this->renderAndOutput();
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+nullSoundMgr::renderAndOutput() {
+    this->RenderBuffer(this->samples);
+    if (this->setup.OutputFunc) {
+        this->setup.OutputFunc(this->samples, synth::BufferNumSamples);
+    }
+    if (nullptr != this->wavFile) {
+        // WAV sample data is little-endian, like all supported platforms
+        if (1 == std::fwrite(this->samples, sizeof(this->samples), 1, this->wavFile)) {
+            this->wavNumBytes += sizeof(this->samples);
+        }
+        else {
+            o_warn("nullSoundMgr: failed to write WAV data, closing file!\n");
+            std::fclose(this->wavFile);
+            this->wavFile = nullptr;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+bool
+nullSoundMgr::writeWavHeader() {
+    o_assert_dbg(nullptr != this->wavFile);
+    
+    const uint32 dataSize = uint32(this->wavNumBytes);
+    const uint32 numChannels = synth::NumChannels;
+    const uint32 bitsPerSample = synth::SampleSize * 8;
+    const uint32 blockAlign = numChannels * synth::SampleSize;
+    const uint32 byteRate = synth::SampleRate * blockAlign;
+    uint8 header[44];
+    auto put16 = [&header](int32 offset, uint32 val) {
+        header[offset + 0] = uint8(val & 0xFF);
+        header[offset + 1] = uint8((val >> 8) & 0xFF);
+    };
+    auto put32 = [&header](int32 offset, uint32 val) {
+        header[offset + 0] = uint8(val & 0xFF);
+        header[offset + 1] = uint8((val >> 8) & 0xFF);
+        header[offset + 2] = uint8((val >> 16) & 0xFF);
+        header[offset + 3] = uint8((val >> 24) & 0xFF);
+    };
+    Memory::Copy("RIFF", &header[0], 4);
+    put32(4, 36 + dataSize);
+    Memory::Copy("WAVE", &header[8], 4);
+    Memory::Copy("fmt ", &header[12], 4);
+    put32(16, 16);
+    put16(20, 1);
+    put16(22, numChannels);
+    put32(24, synth::SampleRate);
+    put32(28, byteRate);
+    put16(32, blockAlign);
+    put16(34, bitsPerSample);
+    Memory::Copy("data", &header[36], 4);
+    put32(40, dataSize);
+    return 1 == std::fwrite(header, sizeof(header), 1, this->wavFile);
+}
+
+} // namespace _priv
+} // namespace Oryol
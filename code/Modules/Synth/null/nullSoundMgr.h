@@ -0,0 +1,61 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::_priv::nullSoundMgr
+    @ingroup _priv
+    @brief headless sound manager without an audio device
+    
+    This is the default sound manager on platforms without an audio
+    backend, where it stays silent and doesn't render anything, like
+    the audio device was missing. Rendering is only enabled when the
+    Synth module is compiled with ORYOL_SYNTH_NULL, or when SynthSetup
+    asks for headless output (WavFilePath, OutputFunc or RenderOffline).
+    
+    When enabled, renders into an optional WAV file and/or the SynthSetup::OutputFunc
+    instead of an audio device. In realtime mode, rendering follows a
+    virtual playback clock which advances with the wall clock, on the
+    audio thread if there is one (the OutputFunc is then called on the
+    audio thread), otherwise in Update(). With SynthSetup::RenderOffline,
+    the clock only advances through RenderOffline(), which renders as
+    fast as possible on the calling thread.
+*/
+#include "Synth/base/soundMgrBase.h"
+#include "Time/TimePoint.h"
+#include <cstdio>
+
+namespace Oryol {
+namespace _priv {
+    
+class nullSoundMgr : public soundMgrBase {
+public:
+    /// constructor
+    nullSoundMgr();
+    /// destructor
+    ~nullSoundMgr();
+    
+    /// setup the sound system
+    void Setup(const SynthSetup& setupAttrs);
+    /// discard the sound system
+    void Discard();
+    /// update the sound system (realtime mode only)
+    void Update();
+    /// render the next seconds of audio as fast as possible (offline mode only)
+    void RenderOffline(float64 seconds);
+    
+private:
+    /// render buffers which are due on the virtual clock, returns milliseconds until the next deadline
+    int32 pump();
+    /// render one buffer and pass it to the outputs
+    void renderAndOutput();
+    /// write the WAV header with the current data size
+    bool writeWavHeader();
+    
+    bool rendering;
+    TimePoint startTime;
+    std::FILE* wavFile;
+    int64 wavNumBytes;
+    int16 samples[synth::NumChannels * synth::BufferNumSamples];
+};
+    
+} // namespace _priv
+} // namespace Oryol
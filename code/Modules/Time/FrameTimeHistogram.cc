@@ -0,0 +1,96 @@
+//------------------------------------------------------------------------------
+//  FrameTimeHistogram.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "FrameTimeHistogram.h"
+#include "Core/Assertion.h"
+
+namespace Oryol {
+
+//------------------------------------------------------------------------------
+FrameTimeHistogram::FrameTimeHistogram() {
+    this->Reset();
+}
+
+//------------------------------------------------------------------------------
+void
+FrameTimeHistogram::Reset() {
+    for (int32 i = 0; i < NumBuckets; i++) {
+        this->buckets[i] = 0;
+    }
+    this->numFrames = 0;
+    this->total = Duration();
+    this->max = Duration();
+}
+
+//------------------------------------------------------------------------------
+void
+FrameTimeHistogram::Add(Duration frameTime) {
+    int32 index = int32(frameTime.AsMilliSeconds()) / BucketWidthMs;
+    if (index < 0) {
+        index = 0;
+    }
+    else if (index >= NumBuckets) {
+        index = NumBuckets - 1;
+    }
+    this->buckets[index]++;
+    this->numFrames++;
+    this->total += frameTime;
+    if (frameTime > this->max) {
+        this->max = frameTime;
+    }
+}
+
+//------------------------------------------------------------------------------
+int32
+FrameTimeHistogram::BucketCount(int32 bucketIndex) const {
+    o_assert_range_dbg(bucketIndex, NumBuckets);
+    return this->buckets[bucketIndex];
+}
+
+//------------------------------------------------------------------------------
+int32
+FrameTimeHistogram::NumFramesAbove(Duration d) const {
+    int32 first = int32(d.AsMilliSeconds()) / BucketWidthMs;
+    if (first < 0) {
+        first = 0;
+    }
+    int32 num = 0;
+    for (int32 i = first; i < NumBuckets; i++) {
+        num += this->buckets[i];
+    }
+    return num;
+}
+
+//------------------------------------------------------------------------------
+Duration
+FrameTimeHistogram::Average() const {
+    if (0 == this->numFrames) {
+        return Duration();
+    }
+    return Duration(this->total.getRaw() / this->numFrames);
+}
+
+//------------------------------------------------------------------------------
+Duration
+FrameTimeHistogram::Percentile(float64 p) const {
+    o_assert_dbg((p >= 0.0) && (p <= 1.0));
+    if (0 == this->numFrames) {
+        return Duration();
+    }
+    int32 rank = int32(p * this->numFrames + 0.5);
+    if (rank < 1) {
+        rank = 1;
+    }
+    int32 num = 0;
+    for (int32 i = 0; i < NumBuckets - 1; i++) {
+        num += this->buckets[i];
+        if (num >= rank) {
+            return Duration::FromMilliSeconds(float64((i + 1) * BucketWidthMs));
+        }
+    }
+    // the overflow bucket has no upper bound
+    return this->max;
+}
+
+} // namespace Oryol
@@ -0,0 +1,71 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Oryol::FrameTimeHistogram
+    @ingroup Time
+    @brief histogram of frame durations for spotting frame spikes
+
+    Frame durations are sorted into buckets of 1 millisecond width,
+    durations above the last bucket are counted in the last bucket
+    (but the exact max duration is tracked separately). Percentiles
+    are returned at bucket resolution (upper bound of the bucket).
+    
+    @code
+    TimePoint lastFrame = Clock::Now();
+    ...
+    histogram.Add(Clock::LapTime(lastFrame));
+    @endcode
+*/
+#include "Core/Types.h"
+#include "Time/Duration.h"
+
+namespace Oryol {
+
+class FrameTimeHistogram {
+public:
+    /// number of buckets
+    static const int32 NumBuckets = 100;
+    /// bucket width in milliseconds
+    static const int32 BucketWidthMs = 1;
+
+    /// constructor
+    FrameTimeHistogram();
+
+    /// add a frame duration
+    void Add(Duration frameTime);
+    /// reset the histogram
+    void Reset();
+
+    /// get number of added frames
+    int32 NumFrames() const;
+    /// get number of frames in a bucket
+    int32 BucketCount(int32 bucketIndex) const;
+    /// get number of frames which took longer than a duration (bucket resolution)
+    int32 NumFramesAbove(Duration d) const;
+    /// get the longest frame duration
+    Duration Max() const;
+    /// get the average frame duration
+    Duration Average() const;
+    /// get frame duration percentile (p between 0.0 and 1.0)
+    Duration Percentile(float64 p) const;
+
+private:
+    int32 buckets[NumBuckets];
+    int32 numFrames;
+    Duration total;
+    Duration max;
+};
+
+//------------------------------------------------------------------------------
+inline int32
+FrameTimeHistogram::NumFrames() const {
+    return this->numFrames;
+}
+
+//------------------------------------------------------------------------------
+inline Duration
+FrameTimeHistogram::Max() const {
+    return this->max;
+}
+
+} // namespace Oryol
@@ -0,0 +1,39 @@
+//------------------------------------------------------------------------------
+//  FrameTimeHistogramTest.cc
+//------------------------------------------------------------------------------
+#include "Pre.h"
+#include "UnitTest++/src/UnitTest++.h"
+#include "Time/FrameTimeHistogram.h"
+
+using namespace Oryol;
+
+TEST(FrameTimeHistogramTest) {
+    FrameTimeHistogram hist;
+    CHECK(hist.NumFrames() == 0);
+    CHECK(hist.Average() == Duration());
+    CHECK(hist.Percentile(0.5) == Duration());
+
+    // 98 frames at 16.5ms, one 40ms spike, one 250ms spike
+    for (int32 i = 0; i < 98; i++) {
+        hist.Add(Duration::FromMilliSeconds(16.5));
+    }
+    hist.Add(Duration::FromMilliSeconds(40.0));
+    hist.Add(Duration::FromMilliSeconds(250.0));
+    CHECK(hist.NumFrames() == 100);
+    CHECK(hist.BucketCount(16) == 98);
+    CHECK(hist.BucketCount(40) == 1);
+    CHECK(hist.BucketCount(FrameTimeHistogram::NumBuckets - 1) == 1);
+    CHECK(hist.Max() == Duration::FromMilliSeconds(250.0));
+    CHECK(hist.NumFramesAbove(Duration::FromMilliSeconds(33.0)) == 2);
+    CHECK(hist.NumFramesAbove(Duration::FromMilliSeconds(17.0)) == 2);
+    CHECK(hist.NumFramesAbove(Duration::FromMilliSeconds(16.0)) == 100);
+    CHECK(hist.Percentile(0.5) == Duration::FromMilliSeconds(17.0));
+    CHECK(hist.Percentile(0.99) == Duration::FromMilliSeconds(41.0));
+    CHECK(hist.Percentile(1.0) == Duration::FromMilliSeconds(250.0));
+    CHECK_CLOSE(hist.Average().AsMilliSeconds(), 19.07, 0.001);
+
+    hist.Reset();
+    CHECK(hist.NumFrames() == 0);
+    CHECK(hist.BucketCount(16) == 0);
+    CHECK(hist.Max() == Duration());
+}
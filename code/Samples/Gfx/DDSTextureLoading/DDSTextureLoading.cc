@@ -7,6 +7,9 @@
 #include "IO/IO.h"
 #include "HTTP/HTTPFileSystem.h"
 #include "Gfx/Gfx.h"
+#include "Dbg/Dbg.h"
+#include "Time/Clock.h"
+#include "Time/FrameTimeHistogram.h"
 #include "Assets/Gfx/ShapeBuilder.h"
 #include "Assets/Gfx/TextureLoader.h"
 #include "glm/mat4x4.hpp"
@@ -22,6 +25,7 @@ public:
     AppState::Code OnCleanup();
 private:
     glm::mat4 computeMVP(const glm::vec3& pos);
+    void showFrameTimes();
     
     float32 distVal = 0.0f;
     Id drawState;
@@ -29,6 +33,8 @@ private:
     StaticArray<Id, NumTextures> texId;
     glm::mat4 view;
     glm::mat4 proj;
+    TimePoint lastFrameTime;
+    FrameTimeHistogram frameTimes;
 };
 OryolMain(DDSTextureLoadingApp);
 
@@ -36,6 +42,7 @@ OryolMain(DDSTextureLoadingApp);
 AppState::Code
 DDSTextureLoadingApp::OnRunning() {
     
+    this->frameTimes.Add(Clock::LapTime(this->lastFrameTime));
     this->distVal += 0.01f;
     
     Gfx::ApplyDefaultRenderTarget();
@@ -78,6 +85,8 @@ DDSTextureLoadingApp::OnRunning() {
             }
         }
     }
+    this->showFrameTimes();
+    Dbg::DrawTextBuffer();
     Gfx::CommitFrame();
     
     // continue running or quit?
@@ -97,6 +106,7 @@ DDSTextureLoadingApp::OnInit() {
     // setup rendering system
     auto gfxSetup = GfxSetup::Window(600, 400, "Oryol DDS Loading Sample");
     Gfx::Setup(gfxSetup);
+    Dbg::Setup();
 
     // setup resources
     TextureSetup texBluePrint;
@@ -143,6 +153,7 @@ DDSTextureLoadingApp::OnInit() {
     const float32 fbHeight = (const float32) Gfx::DisplayAttrs().FramebufferHeight;
     this->proj = glm::perspectiveFov(glm::radians(45.0f), fbWidth, fbHeight, 0.01f, 100.0f);
     this->view = glm::mat4();
+    this->lastFrameTime = Clock::Now();
     
     return App::OnInit();
 }
@@ -150,6 +161,7 @@ DDSTextureLoadingApp::OnInit() {
 //------------------------------------------------------------------------------
 AppState::Code
 DDSTextureLoadingApp::OnCleanup() {
+    Dbg::Discard();
     Gfx::Discard();
     IO::Discard();    
     return App::OnCleanup();
@@ -162,3 +174,45 @@ DDSTextureLoadingApp::computeMVP(const glm::vec3& pos) {
     return this->proj * this->view * modelTform;
 }
 
+//------------------------------------------------------------------------------
+/**
+ Texture files are parsed on the IO threads, so loading the textures
+ shouldn't cause frame spikes on the main thread.
+*/
+void
+DDSTextureLoadingApp::showFrameTimes() {
+    static const int32 numRanges = 7;
+    // the last bucket counts all frames at or above its start (overflow bucket)
+    static const int32 rangeEnd[numRanges] = { 8, 16, 24, 33, 50, FrameTimeHistogram::NumBuckets - 1, FrameTimeHistogram::NumBuckets };
+    const int32 numFrames = this->frameTimes.NumFrames();
+    Dbg::PrintF("frames: %d, loading: %d\r\n"
+                "avg: %.2fms, p50: %.0fms, p99: %.0fms, max: %.2fms\r\n\n",
+                numFrames, Gfx::Resource().QueryLoaderStats().QueueDepth,
+                this->frameTimes.Average().AsMilliSeconds(),
+                this->frameTimes.Percentile(0.5).AsMilliSeconds(),
+                this->frameTimes.Percentile(0.99).AsMilliSeconds(),
+                this->frameTimes.Max().AsMilliSeconds());
+    int32 bucket = 0;
+    for (int32 range = 0; range < numRanges; range++) {
+        const int32 start = bucket;
+        int32 num = 0;
+        for (; bucket < rangeEnd[range]; bucket++) {
+            num += this->frameTimes.BucketCount(bucket);
+        }
+        if (range < (numRanges - 1)) {
+            Dbg::PrintF("%3d-%3dms %6d ", start, rangeEnd[range], num);
+        }
+        else {
+            Dbg::PrintF("  >=%3dms %6d ", start, num);
+        }
+        // at least one char for ranges with any frames, so spikes are visible
+        int32 barLength = numFrames > 0 ? (num * 32) / numFrames : 0;
+        if ((num > 0) && (0 == barLength)) {
+            barLength = 1;
+        }
+        for (int32 i = 0; i < barLength; i++) {
+            Dbg::Print("#");
+        }
+        Dbg::Print("\r\n");
+    }
+}
@@ -27,6 +27,7 @@ private:
     void updateParticles();
 
     Id drawState;
+    GfxRenderQueue renderQueue;
     glm::mat4 view;
     glm::mat4 proj;
     glm::mat4 model;
@@ -37,6 +38,7 @@ private:
     TimePoint lastFrameTimePoint;
     static const int32 NumParticlesEmittedPerFrame = 100;
     static const int32 MaxNumParticles = 1024 * 1024;
+    static const int32 MaxNumInstancesPerDraw = 64 * 1024;
     struct {
         glm::vec4 pos;
         glm::vec4 vec;
@@ -65,12 +67,19 @@ DrawCallPerfApp::OnRunning() {
     Gfx::ApplyDefaultRenderTarget();
     Gfx::Clear(PixelChannel::All, glm::vec4(0.0f));
     Gfx::ApplyDrawState(this->drawState);
-    Gfx::ApplyVariable(Shaders::Main::ModelViewProjection, this->modelViewProj);
+    Shaders::Main::FrameParams frameParams;
+    frameParams.ModelViewProjection = this->modelViewProj;
+    Gfx::ApplyUniformBlock(frameParams);
+    this->renderQueue.Reset();
+    this->renderQueue.ApplyDefaultRenderTarget();
     for (int32 i = 0; i < this->curNumParticles; i++) {
-        Gfx::ApplyVariable(Shaders::Main::ParticleTranslate, this->particles[i].pos);
-        Gfx::Draw(0);
+        this->renderQueue.BeginDraw(this->drawState);
+        this->renderQueue.ApplyInstanceData(this->particles[i].pos);
+        this->renderQueue.Draw(0);
     }
+    Gfx::SubmitRenderQueue(this->renderQueue);
     drawTime = Clock::Since(drawStart);
+    const GfxFrameStats& stats = Gfx::FrameStats();
     
     Dbg::DrawTextBuffer();
     Gfx::CommitFrame();
@@ -80,17 +89,25 @@ DrawCallPerfApp::OnRunning() {
     if (mouse.Attached && mouse.ButtonDown(Mouse::Button::LMB)) {
         this->updateEnabled = !this->updateEnabled;
     }
+    // toggle auto-instancing
+    if (mouse.Attached && mouse.ButtonDown(Mouse::Button::RMB)) {
+        this->renderQueue.SetAutoInstancing(!this->renderQueue.AutoInstancing());
+    }
     
     Duration frameTime = Clock::LapTime(this->lastFrameTimePoint);
     Dbg::TextColor(glm::vec4(1.0f, 1.0f, 0.0f, 1.0f));
-    Dbg::PrintF("\n %d draws\n\r upd=%.3fms\n\r draw=%.3fms\n\r frame=%.3fms\n\r"
-                " LMB/tap: toggle particle update",
+    Dbg::PrintF("\n %d particles\n\r %d instanced draws (%d merged, auto-instancing %s)\n\r"
+                " upd=%.3fms\n\r draw=%.3fms\n\r frame=%.3fms\n\r"
+                " LMB/tap: toggle particle update\n\r RMB: toggle auto-instancing",
                 this->curNumParticles,
+                stats.NumDrawsInstanced,
+                stats.NumMergedDraws,
+                this->renderQueue.AutoInstancing() ? "on" : "off",
                 updTime.AsMilliSeconds(),
                 drawTime.AsMilliSeconds(),
                 frameTime.AsMilliSeconds());
     Dbg::TextColor(glm::vec4(1.0f, 0.0f, 0.0f, 1.0f));
-    Dbg::PrintF("\n\n\r NOTE: this demo will bring down GL fairly quickly!\n");
+    Dbg::PrintF("\n\n\r NOTE: without auto-instancing this demo will bring down GL fairly quickly!\n");
     
     return Gfx::QuitRequested() ? AppState::Cleanup : AppState::Running;
 }
@@ -142,6 +159,16 @@ DrawCallPerfApp::OnInit() {
     Dbg::Setup();
     Input::Setup();
 
+    // check instancing extension
+    if (!Gfx::Supports(GfxFeature::Instancing)) {
+        o_error("ERROR: instanced_arrays extension required!\n");
+    }
+
+    // create the instance data mesh which the render queue streams merged draws into
+    auto instanceMeshSetup = MeshSetup::Empty(MaxNumInstancesPerDraw, Usage::Stream);
+    instanceMeshSetup.Layout.Add(VertexAttr::Instance0, VertexFormat::Float4);
+    Id instanceMesh = Gfx::Resource().Create(instanceMeshSetup);
+
     // create resources
     const glm::mat4 rot90 = glm::rotate(glm::mat4(), glm::radians(90.0f), glm::vec3(1.0f, 0.0f, 0.0f));
     ShapeBuilder shapeBuilder;
@@ -150,13 +177,16 @@ DrawCallPerfApp::OnInit() {
         .Add(VertexAttr::Position, VertexFormat::Float3)
         .Add(VertexAttr::Color0, VertexFormat::Float4);
     shapeBuilder.Transform(rot90).Sphere(0.05f, 3, 2).Build();
-    Id mesh = Gfx::Resource().Create(shapeBuilder.Result());
+    auto shapeBuilderResult = shapeBuilder.Result();
+    shapeBuilderResult.Setup.InstanceMesh = instanceMesh;
+    Id mesh = Gfx::Resource().Create(shapeBuilderResult);
     Id prog = Gfx::Resource().Create(Shaders::Main::CreateSetup());
     auto dss = DrawStateSetup::FromMeshAndProg(mesh, prog);
     dss.RasterizerState.CullFaceEnabled = true;
     dss.DepthStencilState.DepthWriteEnabled = true;
     dss.DepthStencilState.DepthCmpFunc = CompareFunc::LessEqual;
     this->drawState = Gfx::Resource().Create(dss);
+    this->renderQueue.Reserve(MaxNumParticles);
     
     // setup projection and view matrices
     const float32 fbWidth = (const float32) Gfx::DisplayAttrs().FramebufferWidth;
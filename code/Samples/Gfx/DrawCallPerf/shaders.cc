@@ -1,5 +1,5 @@
 //-----------------------------------------------------------------------------
-// #version:15# machine generated, do not edit!
+// #version:16# machine generated, do not edit!
 //-----------------------------------------------------------------------------
 #include "Pre.h"
 #include "shaders.h"
@@ -8,13 +8,14 @@ namespace Oryol {
 namespace Shaders {
 const char* vs_100_src = 
 "#define _POSITION gl_Position\n"
-"uniform mat4 mvp;\n"
-"uniform vec4 particleTranslate;\n"
+"uniform vec4 frameParams[4];\n"
+"#define mvp mat4(frameParams[0],frameParams[1],frameParams[2],frameParams[3])\n"
 "attribute vec4 position;\n"
 "attribute vec4 color0;\n"
+"attribute vec4 instance0;\n"
 "varying vec4 color;\n"
 "void main() {\n"
-"_POSITION = mvp * (position + particleTranslate);\n"
+"_POSITION = mvp * (position + instance0);\n"
 "color = color0;\n"
 "}\n"
 ;
@@ -29,13 +30,14 @@ const char* fs_100_src =
 const char* vs_120_src = 
 "#version 120\n"
 "#define _POSITION gl_Position\n"
-"uniform mat4 mvp;\n"
-"uniform vec4 particleTranslate;\n"
+"uniform vec4 frameParams[4];\n"
+"#define mvp mat4(frameParams[0],frameParams[1],frameParams[2],frameParams[3])\n"
 "attribute vec4 position;\n"
 "attribute vec4 color0;\n"
+"attribute vec4 instance0;\n"
 "varying vec4 color;\n"
 "void main() {\n"
-"_POSITION = mvp * (position + particleTranslate);\n"
+"_POSITION = mvp * (position + instance0);\n"
 "color = color0;\n"
 "}\n"
 ;
@@ -50,13 +52,14 @@ const char* fs_120_src =
 const char* vs_150_src = 
 "#version 150\n"
 "#define _POSITION gl_Position\n"
-"uniform mat4 mvp;\n"
-"uniform vec4 particleTranslate;\n"
+"layout(std140) uniform frameParams_block { vec4 frameParams[4]; };\n"
+"#define mvp mat4(frameParams[0],frameParams[1],frameParams[2],frameParams[3])\n"
 "in vec4 position;\n"
 "in vec4 color0;\n"
+"in vec4 instance0;\n"
 "out vec4 color;\n"
 "void main() {\n"
-"_POSITION = mvp * (position + particleTranslate);\n"
+"_POSITION = mvp * (position + instance0);\n"
 "color = color0;\n"
 "}\n"
 ;
@@ -74,8 +77,8 @@ ProgramBundleSetup Main::CreateSetup() {
     setup.AddProgramFromSources(0, ShaderLang::GLSL100, vs_100_src, fs_100_src);
     setup.AddProgramFromSources(0, ShaderLang::GLSL120, vs_120_src, fs_120_src);
     setup.AddProgramFromSources(0, ShaderLang::GLSL150, vs_150_src, fs_150_src);
-    setup.AddUniform("mvp", ModelViewProjection);
-    setup.AddUniform("particleTranslate", ParticleTranslate);
+    static_assert(sizeof(FrameParams) == 64, "uniform block size mismatch");
+    setup.AddUniformBlock("frameParams", FrameParams::_bindSlotIndex, sizeof(FrameParams));
     return setup;
 }
 }
@@ -1,15 +1,21 @@
 #pragma once
 //-----------------------------------------------------------------------------
-/*  #version:15#
+/*  #version:16#
     machine generated, do not edit!
 */
 #include "Gfx/Setup/ProgramBundleSetup.h"
+#include "glm/vec2.hpp"
+#include "glm/vec3.hpp"
+#include "glm/vec4.hpp"
+#include "glm/mat4x4.hpp"
 namespace Oryol {
 namespace Shaders {
     class Main {
     public:
-        static const int32 ModelViewProjection = 0;
-        static const int32 ParticleTranslate = 1;
+        struct FrameParams {
+            static const int32 _bindSlotIndex = 0;
+            glm::mat4 ModelViewProjection;
+        };
         static ProgramBundleSetup CreateSetup();
     };
 }
@@ -84,11 +84,9 @@ ResourceStressApp::OnInit() {
 
     // setup Gfx system
     auto gfxSetup = GfxSetup::Window(600, 400, "Oryol Resource Stress Test");
-    gfxSetup.SetPoolSize(GfxResourceType::Mesh, MaxNumObjects + 32);
-    gfxSetup.SetPoolSize(GfxResourceType::Texture, MaxNumObjects + 32);
-    gfxSetup.SetPoolSize(GfxResourceType::DrawState, MaxNumObjects + 32);
     gfxSetup.SetPoolSize(GfxResourceType::ProgramBundle, 4);
     gfxSetup.SetPoolSize(GfxResourceType::Shader, 8);
+    gfxSetup.LoaderFrameBudget = 2000;  // max 2ms per frame for texture creation
     Gfx::Setup(gfxSetup);
     
     // setup debug text rendering
@@ -127,16 +125,11 @@ ResourceStressApp::createObjects() {
     if (this->objects.Size() >= MaxNumObjects) {
         return;
     }
-    if (Gfx::Resource().QueryFreeSlots(GfxResourceType::Mesh) == 0) {
-        return;
-    }
-    if (Gfx::Resource().QueryFreeSlots(GfxResourceType::Texture) == 0) {
-        return;
-    }
 
     // create a cube object
     // NOTE: we're deliberatly not sharing resources to actually
-    // put some stress on the resource system
+    // put some stress on the resource system, the mesh, texture and
+    // draw state pools start with the default size and grow on demand
     Object obj;
     obj.label = Gfx::Resource().PushLabel();
     ShapeBuilder shapeBuilder;
@@ -203,11 +196,21 @@ ResourceStressApp::showInfo() {
                 "    setup:   %d\r\n"
                 "    pending: %d\r\n"
                 "    valid:   %d\r\n"
-                "    failed:  %d",
+                "    failed:  %d\r\n\n",
                 mshPoolInfo.NumSlots, mshPoolInfo.NumFreeSlots, mshPoolInfo.NumUsedSlots,
                 mshPoolInfo.NumSlotsByState[ResourceState::Initial],
                 mshPoolInfo.NumSlotsByState[ResourceState::Setup],
                 mshPoolInfo.NumSlotsByState[ResourceState::Pending],
                 mshPoolInfo.NumSlotsByState[ResourceState::Valid],
                 mshPoolInfo.NumSlotsByState[ResourceState::Failed]);
+
+    const ResourceLoaderStats& loaderStats = Gfx::Resource().QueryLoaderStats();
+    Dbg::PrintF("loaders\r\n"
+                "  queue: %d, deferred: %d, continued: %d\r\n"
+                "  completed: %d, failed: %d\r\n"
+                "  time-to-ready avg: %.2fms, max: %.2fms",
+                loaderStats.QueueDepth, loaderStats.NumDeferred, loaderStats.NumContinued,
+                loaderStats.NumCompleted, loaderStats.NumFailed,
+                loaderStats.AvgTimeToReady.AsMilliSeconds(),
+                loaderStats.MaxTimeToReady.AsMilliSeconds());
 }
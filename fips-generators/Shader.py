@@ -2,7 +2,7 @@
 Code generator for shader libraries.
 '''
 
-Version = 15
+Version = 16
 
 import os
 import sys
@@ -20,6 +20,18 @@ glslSlangTypes = {
     150: 'ShaderLang::GLSL150'
 }
 
+# uniform block member types, and how a member is read from the vec4 array
+uniformBlockTypes = {
+    'float': { 'size': 1, 'cpp': 'float32',   'swizzle': '.x' },
+    'vec2':  { 'size': 1, 'cpp': 'glm::vec2', 'swizzle': '.xy' },
+    'vec3':  { 'size': 1, 'cpp': 'glm::vec3', 'swizzle': '.xyz' },
+    'vec4':  { 'size': 1, 'cpp': 'glm::vec4', 'swizzle': '' },
+    'mat4':  { 'size': 4, 'cpp': 'glm::mat4', 'swizzle': None }
+}
+
+# must match ProgramBundleSetup::MaxNumUniformBlocks
+maxNumUniformBlocks = 4
+
 macroKeywords = {
     '$position': '_POSITION',
     '$color': '_COLOR',
@@ -148,6 +160,31 @@ class Uniform :
     def dump(self) :
         dumpObj(self)
 
+#-------------------------------------------------------------------------------
+class UniformBlock :
+    '''
+    A uniform block, a group of uniforms which is uploaded as a whole.
+    Each member occupies one or more vec4 slots.
+    '''
+    def __init__(self, name, bind, filePath, lineNumber) :
+        self.name = name
+        self.bind = bind
+        self.uniforms = []
+        self.filePath = filePath
+        self.lineNumber = lineNumber
+
+    def getTag(self) :
+        return 'uniform_block'
+
+    def getNumVec4(self) :
+        num = 0
+        for uniform in self.uniforms :
+            num += uniformBlockTypes[uniform.type]['size']
+        return num
+
+    def dump(self) :
+        dumpObj(self)
+
 #-------------------------------------------------------------------------------
 class Attr :
     '''
@@ -172,6 +209,8 @@ class VertexShader(Snippet) :
         self.name = name
         self.highPrecision = []
         self.uniforms = []
+        self.uniformBlockRefs = []
+        self.uniformBlocks = []
         self.inputs = []
         self.outputs = []
         self.resolvedDeps = []
@@ -202,6 +241,8 @@ class FragmentShader(Snippet) :
         self.name = name
         self.highPrecision = []
         self.uniforms = []
+        self.uniformBlockRefs = []
+        self.uniformBlocks = []
         self.inputs = []
         self.resolvedDeps = []        
         self.generatedSource = {}
@@ -244,6 +285,7 @@ class Bundle() :
         self.name = name
         self.programs = []
         self.uniforms = []
+        self.uniformBlocks = []
 
     def getTag(self) :
         return 'bundle'
@@ -364,6 +406,29 @@ class Parser :
         self.shaderLib.bundles[name] = bundle
         self.current = bundle            
 
+    #---------------------------------------------------------------------------
+    def onUniformBlock(self, args) :
+        if len(args) != 2:
+            util.fmtError("@uniform_block must have 2 args (name binding)")
+        if self.current is not None :
+            util.fmtError("cannot nest @uniform_block (missing @end tag in '{}'?)".format(self.current.name))
+        name = args[0]
+        bind = args[1]
+        if name in self.shaderLib.uniformBlocks :
+            util.fmtError("@uniform_block '{}' already defined!".format(name))
+        block = UniformBlock(name, bind, self.fileName, self.lineNumber)
+        self.shaderLib.uniformBlocks[name] = block
+        self.current = block
+
+    #---------------------------------------------------------------------------
+    def onUseUniformBlock(self, args) :
+        if not self.current or not self.current.getTag() in ['vs', 'fs'] :
+            util.fmtError("@use_uniform_block must come after @vs or @fs!")
+        if len(args) < 1:
+            util.fmtError("@use_uniform_block must have at least one arg!")
+        for arg in args :
+            self.current.uniformBlockRefs.append(Reference(arg, self.fileName, self.lineNumber))
+
     #---------------------------------------------------------------------------
     def onIn(self, args) :
         if not self.current or not self.current.getTag() in ['vs', 'fs'] :
@@ -401,13 +466,15 @@ class Parser :
 
     #---------------------------------------------------------------------------
     def onUniform(self, args) :
-        if not self.current or not self.current.getTag() in ['block', 'vs', 'fs'] :
-            util.fmtError("@uniform must come after @block, @vs or @fs tag!")
+        if not self.current or not self.current.getTag() in ['block', 'vs', 'fs', 'uniform_block'] :
+            util.fmtError("@uniform must come after @block, @vs, @fs or @uniform_block tag!")
         if len(args) != 3:
             util.fmtError("@uniform must have 3 args (type name binding)")
         type = args[0]
         name = args[1]
         bind = args[2]
+        if self.current.getTag() == 'uniform_block' and type not in uniformBlockTypes :
+            util.fmtError("invalid @uniform type '{}' in @uniform_block '{}' (must be {})".format(type, self.current.name, ', '.join(sorted(uniformBlockTypes.keys()))))
         if checkListDup(name, self.current.uniforms) :
             util.fmtError("@uniform '{}' already defined in '{}'!".format(name, self.current.name))
         self.current.uniforms.append(Uniform(type, name, bind, self.fileName, self.lineNumber))
@@ -433,8 +500,8 @@ class Parser :
 
     #---------------------------------------------------------------------------
     def onEnd(self, args) :
-        if not self.current or not self.current.getTag() in ['block', 'vs', 'fs', 'bundle'] :
-            util.fmtError("@end must come after @block, @vs, @fs or @bundle!")
+        if not self.current or not self.current.getTag() in ['block', 'vs', 'fs', 'bundle', 'uniform_block'] :
+            util.fmtError("@end must come after @block, @vs, @fs, @bundle or @uniform_block!")
         if len(args) != 0:
             util.fmtError("@end must not have arguments")
         self.current = None
@@ -461,6 +528,10 @@ class Parser :
                 self.onFragmentShader(args)
             elif tag == 'bundle':
                 self.onBundle(args)
+            elif tag == 'uniform_block':
+                self.onUniformBlock(args)
+            elif tag == 'use_uniform_block':
+                self.onUseUniformBlock(args)
             elif tag == 'use':
                 self.onUse(args)
             elif tag == 'in':
@@ -507,6 +578,8 @@ class Parser :
             line = self.parseTags(line)
             if line != '':
                 if self.current is not None:
+                    if self.current.getTag() == 'uniform_block' :
+                        util.fmtError("only @uniform tags allowed in @uniform_block '{}'".format(self.current.name))
                     self.current.lines.append(Line(line, self.fileName, self.lineNumber))
 
     #---------------------------------------------------------------------------
@@ -541,6 +614,30 @@ class Generator :
             dstLines.append(srcLine)
         return dstLines
 
+    #---------------------------------------------------------------------------
+    def genUniformBlocks(self, lines, shd, glslVersion) :
+        '''
+        A uniform block is a vec4 array, in a std140 uniform block on GLSL 1.50,
+        and a plain uniform array otherwise. The block members are
+        #defines which read from the vec4 array.
+        '''
+        for block in shd.uniformBlocks :
+            numVec4 = block.getNumVec4()
+            if glslVersion >= 150 :
+                lines.append(Line('layout(std140) uniform {}_block {{ vec4 {}[{}]; }};'.format(block.name, block.name, numVec4), block.filePath, block.lineNumber))
+            else :
+                lines.append(Line('uniform vec4 {}[{}];'.format(block.name, numVec4), block.filePath, block.lineNumber))
+            index = 0
+            for uniform in block.uniforms :
+                typeInfo = uniformBlockTypes[uniform.type]
+                if typeInfo['swizzle'] is None :
+                    columns = ','.join(['{}[{}]'.format(block.name, index + i) for i in range(0, typeInfo['size'])])
+                    lines.append(Line('#define {} {}({})'.format(uniform.name, uniform.type, columns), uniform.filePath, uniform.lineNumber))
+                else :
+                    lines.append(Line('#define {} {}[{}]{}'.format(uniform.name, block.name, index, typeInfo['swizzle']), uniform.filePath, uniform.lineNumber))
+                index += typeInfo['size']
+        return lines
+
     #---------------------------------------------------------------------------
     def genVertexShaderSource(self, vs, glslVersion) :
         lines = []
@@ -565,6 +662,7 @@ class Generator :
         # write uniforms
         for uniform in vs.uniforms :
             lines.append(Line('uniform {} {};'.format(uniform.type, uniform.name, uniform.bind), uniform.filePath, uniform.lineNumber))
+        lines = self.genUniformBlocks(lines, vs, glslVersion)
 
         # write vertex shader inputs
         for input in vs.inputs :
@@ -611,6 +709,7 @@ class Generator :
         # write uniforms
         for uniform in fs.uniforms :
             lines.append(Line('uniform {} {};'.format(uniform.type, uniform.name, uniform.bind), uniform.filePath, uniform.lineNumber))
+        lines = self.genUniformBlocks(lines, fs, glslVersion)
 
         # write fragment shader inputs
         for input in fs.inputs :
@@ -639,6 +738,7 @@ class ShaderLibrary :
     def __init__(self, inputs) :
         self.sources = inputs
         self.blocks = {}
+        self.uniformBlocks = {}
         self.vertexShaders = {}
         self.fragmentShaders = {}
         self.bundles = {}
@@ -745,6 +845,32 @@ class ShaderLibrary :
             for uniform in self.fragmentShaders[program.fs].uniforms :
                 self.checkAddUniform(uniform, bundle.uniforms)
 
+    def resolveShaderUniformBlocks(self, shd) :
+        '''
+        Resolves the uniform block references of a vertex or fragment shader.
+        '''
+        for ref in shd.uniformBlockRefs :
+            if not ref.name in self.uniformBlocks :
+                util.setErrorLocation(ref.path, ref.lineNumber)
+                util.fmtError("unknown uniform block '{}'".format(ref.name))
+            block = self.uniformBlocks[ref.name]
+            if block not in shd.uniformBlocks :
+                shd.uniformBlocks.append(block)
+
+    def resolveBundleUniformBlocks(self, bundle) :
+        '''
+        Gathers all uniform blocks from all shaders in the bundle, the
+        position in the bundle's block list is the block's slot index.
+        '''
+        for program in bundle.programs :
+            shds = [self.vertexShaders[program.vs], self.fragmentShaders[program.fs]]
+            for shd in shds :
+                for block in shd.uniformBlocks :
+                    if block not in bundle.uniformBlocks :
+                        bundle.uniformBlocks.append(block)
+        if len(bundle.uniformBlocks) > maxNumUniformBlocks :
+            util.fmtError("too many uniform blocks in bundle '{}' (max {})".format(bundle.name, maxNumUniformBlocks))
+
     def resolveMacros(self, shd) :
         '''
         Adds any macros used by dependent blocks to the shader.
@@ -772,10 +898,13 @@ class ShaderLibrary :
             self.resolveMacros(fs)
         for vs in self.vertexShaders.values() :
             self.resolveShaderUniforms(vs)
+            self.resolveShaderUniformBlocks(vs)
         for fs in self.fragmentShaders.values() :
             self.resolveShaderUniforms(fs)
+            self.resolveShaderUniformBlocks(fs)
         for bundle in self.bundles.values() :
             self.resolveBundleUniforms(bundle)
+            self.resolveBundleUniformBlocks(bundle)
 
     def generateShaderSources(self) :
         '''
@@ -809,6 +938,11 @@ def writeHeaderTop(f, shdLib) :
     f.write('    machine generated, do not edit!\n')
     f.write('*/\n')
     f.write('#include "Gfx/Setup/ProgramBundleSetup.h"\n')
+    if shdLib.uniformBlocks :
+        f.write('#include "glm/vec2.hpp"\n')
+        f.write('#include "glm/vec3.hpp"\n')
+        f.write('#include "glm/vec4.hpp"\n')
+        f.write('#include "glm/mat4x4.hpp"\n')
     f.write('namespace Oryol {\n')
     f.write('namespace Shaders {\n')
 
@@ -824,6 +958,20 @@ def writeBundleHeader(f, shdLib, bundle) :
     f.write('    public:\n')
     for i in range(0, len(bundle.uniforms)) :
         f.write('        static const int32 {} = {};\n'.format(bundle.uniforms[i].bind, i))
+    for i in range(0, len(bundle.uniformBlocks)) :
+        block = bundle.uniformBlocks[i]
+        f.write('        struct {} {{\n'.format(block.bind))
+        f.write('            static const int32 _bindSlotIndex = {};\n'.format(i))
+        for uniform in block.uniforms :
+            typeInfo = uniformBlockTypes[uniform.type]
+            f.write('            {} {};\n'.format(typeInfo['cpp'], uniform.bind))
+            if uniform.type == 'float' :
+                f.write('            float32 _pad_{}[3];\n'.format(uniform.bind))
+            elif uniform.type == 'vec2' :
+                f.write('            float32 _pad_{}[2];\n'.format(uniform.bind))
+            elif uniform.type == 'vec3' :
+                f.write('            float32 _pad_{}[1];\n'.format(uniform.bind))
+        f.write('        };\n')
     f.write('        static ProgramBundleSetup CreateSetup();\n')
     f.write('    };\n')
 
@@ -887,6 +1035,9 @@ def writeBundleSource(f, shdLib, bundle) :
             f.write('    setup.AddTextureUniform("{}", {});\n'.format(uniform.name, uniform.bind))
         else :
             f.write('    setup.AddUniform("{}", {});\n'.format(uniform.name, uniform.bind))
+    for block in bundle.uniformBlocks :
+        f.write('    static_assert(sizeof({}) == {}, "uniform block size mismatch");\n'.format(block.bind, block.getNumVec4() * 16))
+        f.write('    setup.AddUniformBlock("{}", {}::_bindSlotIndex, sizeof({}));\n'.format(block.name, block.bind, block.bind))
     f.write('    return setup;\n')
     f.write('}\n')
 
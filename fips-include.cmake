@@ -59,6 +59,19 @@ if (FIPS_WINDOWS)
     endif()
 endif()
 
+# headless null Gfx backend (no window, no GPU)
+option(ORYOL_GFX_NULL "Use the headless null Gfx backend" OFF)
+if (ORYOL_GFX_NULL)
+    set(ORYOL_OPENGL 0)
+    add_definitions(-DORYOL_GFX_NULL=1)
+endif()
+
+# headless null Synth backend (no audio device, optional WAV output)
+option(ORYOL_SYNTH_NULL "Use the headless null Synth backend" OFF)
+if (ORYOL_SYNTH_NULL)
+    add_definitions(-DORYOL_SYNTH_NULL=1)
+endif()
+
 # OpenGL defines
 if (ORYOL_OPENGL)
     add_definitions(-DORYOL_OPENGL=1)